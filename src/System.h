@@ -22,6 +22,8 @@ struct EmulatedSystem {
         bool (*emuReadBattery)(const char *);
         // write battery file
         bool (*emuWriteBattery)(const char *);
+        // write battery file in the background
+        bool (*emuWriteBatteryAsync)(const char *);
 #ifdef __LIBRETRO__
         // load state
         bool (*emuReadState)(const uint8_t *, unsigned);
@@ -37,6 +39,8 @@ struct EmulatedSystem {
         bool (*emuReadMemState)(char *, int);
         // write memory state (rewind)
         bool (*emuWriteMemState)(char *, int, long &);
+        // write uncompressed memory state, read back by emuReadMemState
+        bool (*emuWriteMemStateRaw)(char *, int, long &);
         // write PNG file
         bool (*emuWritePNG)(const char *);
         // write BMP file
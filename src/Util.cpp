@@ -111,6 +111,27 @@ FILE* utilOpenFile(const char *filename, const char *mode)
     return f;
 }
 
+// Renames oldName to newName, replacing newName if it exists
+bool utilRenameFile(const char *oldName, const char *newName)
+{
+#ifdef _WIN32
+    wchar_t *wold = utf8ToUtf16(oldName);
+    if (!wold) return false;
+    wchar_t *wnew = utf8ToUtf16(newName);
+    if (!wnew) {
+        delete[] wold;
+        return false;
+    }
+
+    bool ok = MoveFileExW(wold, wnew, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    delete[] wold;
+    delete[] wnew;
+    return ok;
+#else
+    return rename(oldName, newName) == 0;
+#endif // _WIN32
+}
+
 // Get user-specific config dir manually.
 // apple:   ~/Library/Application Support/
 // windows: %APPDATA%/
@@ -756,6 +777,49 @@ void utilWriteData(gzFile gzFile, variable_desc *data)
         }
 }
 
+// Not endian safe, same as the gzFile versions above
+void utilWriteIntMem(uint8_t *&data, int val)
+{
+        memcpy(data, &val, sizeof(int));
+        data += sizeof(int);
+}
+
+void utilWriteMem(uint8_t *&data, const void *in_data, unsigned size)
+{
+        memcpy(data, in_data, size);
+        data += size;
+}
+
+void utilWriteDataMem(uint8_t *&data, variable_desc *desc)
+{
+        while (desc->address) {
+                utilWriteMem(data, desc->address, desc->size);
+                desc++;
+        }
+}
+
+int utilReadIntMem(const uint8_t *&data)
+{
+        int res;
+        memcpy(&res, data, sizeof(int));
+        data += sizeof(int);
+        return res;
+}
+
+void utilReadMem(void *buf, const uint8_t *&data, unsigned size)
+{
+        memcpy(buf, data, size);
+        data += size;
+}
+
+void utilReadDataMem(const uint8_t *&data, variable_desc *desc)
+{
+        while (desc->address) {
+                utilReadMem(desc->address, data, desc->size);
+                desc++;
+        }
+}
+
 gzFile utilAutoGzOpen(const char *file, const char *mode)
 {
 #ifdef _WIN32
@@ -895,6 +959,8 @@ void utilUpdateSystemColorMaps(bool lcd)
                         gbafilter_pal32(systemColorMap32, 0x10000);
         } break;
         }
+
+        gfxColorMapsChanged(lcd);
 }
 
 // Check for existence of file.
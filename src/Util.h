@@ -44,7 +44,6 @@ void utilGBAFindSave(const int);
 void utilUpdateSystemColorMaps(bool lcd = false);
 bool utilFileExists(const char *filename);
 
-#ifdef __LIBRETRO__
 void utilWriteIntMem(uint8_t *&data, int);
 void utilWriteMem(uint8_t *&data, const void *in_data, unsigned size);
 void utilWriteDataMem(uint8_t *&data, variable_desc *);
@@ -52,8 +51,10 @@ void utilWriteDataMem(uint8_t *&data, variable_desc *);
 int utilReadIntMem(const uint8_t *&data);
 void utilReadMem(void *buf, const uint8_t *&data, unsigned size);
 void utilReadDataMem(const uint8_t *&data, variable_desc *);
-#else
+
+#ifndef __LIBRETRO__
 FILE* utilOpenFile(const char *filename, const char *mode);
+bool utilRenameFile(const char *oldName, const char *newName);
 gzFile utilAutoGzOpen(const char *file, const char *mode);
 gzFile utilGzOpen(const char *file, const char *mode);
 gzFile utilMemGzOpen(char *memory, int available, const char *mode);
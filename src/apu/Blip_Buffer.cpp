@@ -201,8 +201,9 @@ void Blip_Synth_Fast_::volume_unit( double new_unit )
 
 #if !BLIP_BUFFER_FAST
 
-Blip_Synth_::Blip_Synth_( short* p, int w ) :
+Blip_Synth_::Blip_Synth_( short* p, int w, short* k ) :
 	impulses( p ),
+	kernels( k ),
 	width( w )
 {
 	volume_unit_ = 0.0;
@@ -286,6 +287,32 @@ void Blip_Synth_::adjust_impulse()
 	//for ( int i = blip_res; i--; printf( "\n" ) )
 	//  for ( int j = 0; j < width / 2; j++ )
 	//      printf( "%5ld,", impulses [j * blip_res + i + 1] );
+
+	build_kernels();
+}
+
+void Blip_Synth_::build_kernels()
+{
+	if ( !kernels )
+		return;
+
+	// same taps as the scalar offset_resampled(), first half read forward
+	// from the end of impulses, second half backward from the start
+	int const mid = width / 2 - 1;
+	int const kernel_width = (width + 7) & ~7;
+	for ( int phase = 0; phase < blip_res; phase++ )
+	{
+		short* out = kernels + phase * kernel_width;
+		for ( int i = 0; i < kernel_width; i++ )
+		{
+			if ( i <= mid )
+				out [i] = impulses [blip_res - phase + blip_res * i];
+			else if ( i < width )
+				out [i] = impulses [phase + blip_res * (width - 1 - i)];
+			else
+				out [i] = 0;
+		}
+	}
 }
 
 void Blip_Synth_::treble_eq( blip_eq_t const& eq )
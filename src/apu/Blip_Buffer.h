@@ -183,6 +183,20 @@ class Blip_Buffer
 #endif
 #endif
 
+// Use SSE2 for adding impulses and in the stereo mixers. Every x86-64 CPU has it,
+// 32-bit x86 builds get it with -msse2. Results are the same as without.
+#ifndef BLIP_SSE2
+#if !BLIP_BUFFER_FAST && (defined(__SSE2__) || defined(_M_X64))
+#define BLIP_SSE2 1
+#else
+#define BLIP_SSE2 0
+#endif
+#endif
+
+#if BLIP_SSE2
+#include <emmintrin.h>
+#endif
+
 // Internal
 typedef blip_ulong blip_resampled_time_t;
 int const blip_widest_impulse_ = 16;
@@ -212,12 +226,13 @@ class Blip_Synth_
         int delta_factor;
 
         void volume_unit(double);
-        Blip_Synth_(short *impulses, int width);
+        Blip_Synth_(short *impulses, int width, short *kernels = 0);
         void treble_eq(blip_eq_t const &);
 
         private:
         double volume_unit_;
         short *const impulses;
+        short *const kernels;
         int const width;
         blip_long kernel_unit;
         int impulses_size() const
@@ -225,6 +240,7 @@ class Blip_Synth_
                 return blip_res / 2 * width + 1;
         }
         void adjust_impulse();
+        void build_kernels();
 };
 
 // Quality level, better = slower. In general, use blip_good_quality.
@@ -296,12 +312,24 @@ template <int quality, int range> class Blip_Synth
         Blip_Synth_ impl;
         typedef short imp_t;
         imp_t impulses[blip_res * (quality / 2) + 1];
+#if BLIP_SSE2
+        // impulses rearranged into one row per phase, in the order they are
+        // added to the buffer and padded with zeroes to whole vectors
+        enum { kernel_width = (quality + 7) & ~7 };
+        imp_t kernels[blip_res][kernel_width];
+
+        public:
+        Blip_Synth() : impl(impulses, quality, kernels[0])
+        {
+        }
+#else
 
         public:
         Blip_Synth() : impl(impulses, quality)
         {
         }
 #endif
+#endif
 };
 
 // Low-pass equalization parameters
@@ -486,6 +514,37 @@ inline void Blip_Synth<quality, range>::offset_resampled(blip_resampled_time_t t
 #else
 
         int const fwd = (blip_widest_impulse_ - quality) / 2;
+
+#if BLIP_SSE2
+
+        // 32-bit products from 16-bit multiplies: delta = hi * 0x10000 + lo, with
+        // lo taken as signed so that k * lo is exact in its two halves
+        short const lo = (short)delta;
+        short const hi = (short)(((blip_ulong)delta - (blip_ulong)(blip_long)lo) >> 16);
+        __m128i const delta_lo = _mm_set1_epi16(lo);
+        __m128i const delta_hi = _mm_set1_epi16(hi);
+        __m128i const zero = _mm_setzero_si128();
+
+        // the padding adds zero past the last tap, which is still inside
+        // blip_buffer_extra_
+        __m128i const *kernel = (__m128i const *)kernels[phase];
+        __m128i *out = (__m128i *)(buf + fwd);
+        for (int i = 0; i < kernel_width / 8; i++) {
+                __m128i k = _mm_loadu_si128(kernel + i);
+                __m128i prod_lo = _mm_mullo_epi16(k, delta_lo);
+                __m128i prod_hi = _mm_mulhi_epi16(k, delta_lo);
+                __m128i prod_hi2 = _mm_mullo_epi16(k, delta_hi);
+                __m128i first = _mm_add_epi32(_mm_unpacklo_epi16(prod_lo, prod_hi),
+                                              _mm_unpacklo_epi16(zero, prod_hi2));
+                __m128i second = _mm_add_epi32(_mm_unpackhi_epi16(prod_lo, prod_hi),
+                                               _mm_unpackhi_epi16(zero, prod_hi2));
+                _mm_storeu_si128(out + i * 2, _mm_add_epi32(_mm_loadu_si128(out + i * 2), first));
+                _mm_storeu_si128(out + i * 2 + 1,
+                                 _mm_add_epi32(_mm_loadu_si128(out + i * 2 + 1), second));
+        }
+
+#else
+
         int const rev = fwd + quality - 2;
         int const mid = quality / 2 - 1;
 
@@ -577,6 +636,8 @@ inline void Blip_Synth<quality, range>::offset_resampled(blip_resampled_time_t t
         buf[rev + 1] = t1;
 #endif
 
+#endif
+
 #endif
 }
 
@@ -550,6 +550,61 @@ void Effects_Buffer::mix_effects( blip_sample_t* out_, int pair_count )
 		// add echo
 		if ( echo_phase && !no_echo )
 		{
+		#if BLIP_SSE2
+			// both channels at once, in lanes 0 and 2 since those are the ones
+			// _mm_mul_epu32() multiplies; the low half of its product is the
+			// same as for a signed multiply
+			stereo_fixed_t* const echo_pairs = (stereo_fixed_t*) echo.begin();
+			int const pairs_size = echo_size / stereo;
+			int in_pos = echo_pos / stereo;
+			int out_pos [stereo];
+			for ( int i = 0; i < stereo; i++ )
+			{
+				blargg_long out_offset = echo_pos + s.delay [i];
+				if ( out_offset >= echo_size )
+					out_offset -= echo_size;
+				out_pos [i] = out_offset / stereo;
+			}
+
+			__m128i const feedback = _mm_set1_epi32( s.feedback );
+			__m128i const treble   = _mm_set1_epi32( s.treble );
+			__m128i low_pass = _mm_setr_epi32( s.low_pass [0], 0, s.low_pass [1], 0 );
+
+			// break into chunks at wrap-around of any of the three positions
+			int remain = pair_count;
+			do
+			{
+				int count = min( remain, pairs_size - in_pos );
+				count = min( count, pairs_size - out_pos [0] );
+				count = min( count, pairs_size - out_pos [1] );
+				remain -= count;
+
+				stereo_fixed_t const* BLIP_RESTRICT in = &echo_pairs [in_pos];
+				fixed_t* BLIP_RESTRICT out_0 = echo_pairs [out_pos [0]];
+				fixed_t* BLIP_RESTRICT out_1 = echo_pairs [out_pos [1]];
+				for ( int n = 0; n < count; n++ )
+				{
+					__m128i x = _mm_loadl_epi64( (__m128i const*) in [n] );
+					x = _mm_unpacklo_epi32( x, x );
+					x = _mm_srai_epi32( _mm_sub_epi32( x, low_pass ), fixed_shift );
+					low_pass = _mm_add_epi32( low_pass, _mm_mul_epu32( x, treble ) );
+					x = _mm_mul_epu32( _mm_srai_epi32( low_pass, fixed_shift ), feedback );
+					out_0 [n * stereo] = _mm_cvtsi128_si32( x );
+					out_1 [n * stereo + 1] = _mm_cvtsi128_si32( _mm_unpackhi_epi64( x, x ) );
+				}
+
+				in_pos     += count;
+				out_pos [0] += count;
+				out_pos [1] += count;
+				if ( in_pos      >= pairs_size ) in_pos      -= pairs_size;
+				if ( out_pos [0] >= pairs_size ) out_pos [0] -= pairs_size;
+				if ( out_pos [1] >= pairs_size ) out_pos [1] -= pairs_size;
+			}
+			while ( remain );
+
+			s.low_pass [0] = _mm_cvtsi128_si32( low_pass );
+			s.low_pass [1] = _mm_cvtsi128_si32( _mm_unpackhi_epi64( low_pass, low_pass ) );
+		#else
 			fixed_t const feedback = s.feedback;
 			fixed_t const treble   = s.treble;
 
@@ -598,6 +653,7 @@ void Effects_Buffer::mix_effects( blip_sample_t* out_, int pair_count )
 				s.low_pass [i] = low_pass;
 			}
 			while ( --i >= 0 );
+		#endif
 		}
 	}
 	while ( --echo_phase >= 0 );
@@ -617,7 +673,18 @@ void Effects_Buffer::mix_effects( blip_sample_t* out_, int pair_count )
 			in  += count;
 			out += count;
 			int offset = -count;
-			do
+		#if BLIP_SSE2
+			// four pairs at a time, saturating pack does the clamp
+			for ( ; offset <= -4; offset += 4 )
+			{
+				__m128i pairs_01 = _mm_loadu_si128( (__m128i const*) in [offset    ] );
+				__m128i pairs_23 = _mm_loadu_si128( (__m128i const*) in [offset + 2] );
+				pairs_01 = _mm_srai_epi32( pairs_01, fixed_shift );
+				pairs_23 = _mm_srai_epi32( pairs_23, fixed_shift );
+				_mm_storeu_si128( (__m128i*) out [offset], _mm_packs_epi32( pairs_01, pairs_23 ) );
+			}
+		#endif
+			for ( ; offset; ++offset )
 			{
 				fixed_t in_0 = FROM_FIXED( in [offset] [0] );
 				fixed_t in_1 = FROM_FIXED( in [offset] [1] );
@@ -628,7 +695,6 @@ void Effects_Buffer::mix_effects( blip_sample_t* out_, int pair_count )
 				BLIP_CLAMP( in_1, in_1 );
 				out [offset] [1] = (blip_sample_t) in_1;
 			}
-			while ( ++offset );
 
 			in = (stereo_fixed_t*) echo.begin();
 			count = remain;
@@ -237,6 +237,91 @@ void Stereo_Mixer::mix_mono( blip_sample_t* out_, int count )
 	BLIP_READER_END( center, *bufs [2] );
 }
 
+#if BLIP_SSE2
+
+void Stereo_Mixer::mix_stereo( blip_sample_t* out, int count )
+{
+	// run the left, right and center integrators side by side in one register,
+	// four samples at a time, then saturate left + center and right + center
+	// to 16 bits with a pack
+	int const bass = BLIP_READER_BASS( *bufs [2] );
+	BLIP_READER_BEGIN( left,   *bufs [0] );
+	BLIP_READER_BEGIN( right,  *bufs [1] );
+	BLIP_READER_BEGIN( center, *bufs [2] );
+
+	// read_pairs() already counted these samples as read
+	BLIP_READER_ADJ_( left,   samples_read - count );
+	BLIP_READER_ADJ_( right,  samples_read - count );
+	BLIP_READER_ADJ_( center, samples_read - count );
+
+	__m128i const shift = _mm_cvtsi32_si128( bass );
+	__m128i const zero  = _mm_setzero_si128();
+	__m128i accum = _mm_setr_epi32( left_reader_accum, right_reader_accum, center_reader_accum, 0 );
+
+	#define STEP( s, in ) \
+		{\
+			s = accum;\
+			accum = _mm_add_epi32( _mm_sub_epi32( accum, _mm_sra_epi32( accum, shift ) ), in );\
+		}
+
+	// left + center in lane 0, right + center in lane 1
+	#define SIDES( s ) _mm_add_epi32( s, _mm_shuffle_epi32( s, _MM_SHUFFLE( 2, 2, 2, 2 ) ) )
+
+	int i = 0;
+	for ( ; i + 4 <= count; i += 4 )
+	{
+		__m128i l = _mm_loadu_si128( (__m128i const*) (left_reader_buf   + i) );
+		__m128i r = _mm_loadu_si128( (__m128i const*) (right_reader_buf  + i) );
+		__m128i c = _mm_loadu_si128( (__m128i const*) (center_reader_buf + i) );
+
+		// transpose into left, right, center, 0 for each sample
+		__m128i lr_01 = _mm_unpacklo_epi32( l, r );
+		__m128i lr_23 = _mm_unpackhi_epi32( l, r );
+		__m128i c_01  = _mm_unpacklo_epi32( c, zero );
+		__m128i c_23  = _mm_unpackhi_epi32( c, zero );
+
+		__m128i s0, s1, s2, s3;
+		STEP( s0, _mm_unpacklo_epi64( lr_01, c_01 ) );
+		STEP( s1, _mm_unpackhi_epi64( lr_01, c_01 ) );
+		STEP( s2, _mm_unpacklo_epi64( lr_23, c_23 ) );
+		STEP( s3, _mm_unpackhi_epi64( lr_23, c_23 ) );
+
+		__m128i pairs_01 = _mm_unpacklo_epi64( SIDES( s0 ), SIDES( s1 ) );
+		__m128i pairs_23 = _mm_unpacklo_epi64( SIDES( s2 ), SIDES( s3 ) );
+		pairs_01 = _mm_srai_epi32( pairs_01, blip_sample_bits - 16 );
+		pairs_23 = _mm_srai_epi32( pairs_23, blip_sample_bits - 16 );
+		_mm_storeu_si128( (__m128i*) (out + i * stereo), _mm_packs_epi32( pairs_01, pairs_23 ) );
+	}
+
+	#undef STEP
+	#undef SIDES
+
+	left_reader_accum   = _mm_cvtsi128_si32( accum );
+	right_reader_accum  = _mm_cvtsi128_si32( _mm_shuffle_epi32( accum, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	center_reader_accum = _mm_cvtsi128_si32( _mm_shuffle_epi32( accum, _MM_SHUFFLE( 2, 2, 2, 2 ) ) );
+
+	for ( ; i < count; i++ )
+	{
+		blargg_long l = BLIP_READER_READ_RAW( left  ) + BLIP_READER_READ_RAW( center );
+		blargg_long r = BLIP_READER_READ_RAW( right ) + BLIP_READER_READ_RAW( center );
+		l >>= blip_sample_bits - 16;
+		r >>= blip_sample_bits - 16;
+		BLIP_READER_NEXT_IDX_( left,   bass, i );
+		BLIP_READER_NEXT_IDX_( right,  bass, i );
+		BLIP_READER_NEXT_IDX_( center, bass, i );
+		BLIP_CLAMP( l, l );
+		BLIP_CLAMP( r, r );
+		out [i * stereo    ] = (blip_sample_t) l;
+		out [i * stereo + 1] = (blip_sample_t) r;
+	}
+
+	BLIP_READER_END( left,   *bufs [0] );
+	BLIP_READER_END( right,  *bufs [1] );
+	BLIP_READER_END( center, *bufs [2] );
+}
+
+#else
+
 void Stereo_Mixer::mix_stereo( blip_sample_t* out_, int count )
 {
 	blip_sample_t* BLIP_RESTRICT out = out_ + count * stereo;
@@ -279,3 +364,5 @@ void Stereo_Mixer::mix_stereo( blip_sample_t* out_, int count )
 		break;
 	}
 }
+
+#endif
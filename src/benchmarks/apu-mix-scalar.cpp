@@ -0,0 +1,3 @@
+// The scalar build of apu-mix.cpp, see there
+#define APU_MIX_SCALAR
+#include "apu-mix.cpp"
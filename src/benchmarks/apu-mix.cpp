@@ -0,0 +1,260 @@
+// Measures the SSE2 paths of the blargg APU: adding band-limited steps with
+// Blip_Synth, mixing left, right and center for the GBA, and the echo and
+// clamp of the effects buffer the GB sound goes through.  apu-mix-scalar.cpp
+// compiles this file again with BLIP_SSE2 0, which gives the loops used
+// before, and the output of both is compared before timing.
+//
+// usage: apu-mix-bench [frames]
+
+#ifdef APU_MIX_SCALAR
+#define BLIP_SSE2 0
+// own names for everything the two builds define differently
+#define Blip_Synth Scalar_Blip_Synth
+#define Multi_Buffer Scalar_Multi_Buffer
+#define Mono_Buffer Scalar_Mono_Buffer
+#define Tracked_Blip_Buffer Scalar_Tracked_Blip_Buffer
+#define Stereo_Mixer Scalar_Stereo_Mixer
+#define Stereo_Buffer Scalar_Stereo_Buffer
+#define Silent_Buffer Scalar_Silent_Buffer
+#define Effects_Buffer Scalar_Effects_Buffer
+#define Simple_Effects_Buffer Scalar_Simple_Effects_Buffer
+#define APU_MIX_NS scalar
+#else
+#define APU_MIX_NS sse2
+#endif
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../apu/Blip_Buffer.h"
+#include "../apu/Effects_Buffer.h"
+#include "../apu/Multi_Buffer.h"
+
+#ifdef APU_MIX_SCALAR
+#include "../apu/Effects_Buffer.cpp"
+#include "../apu/Multi_Buffer.cpp"
+#endif
+
+struct Event {
+    blip_time_t time;
+    int delta;
+    int channel;
+};
+
+static const long clockRate = 4194304;
+static const long sampleRate = 44100;
+static const blip_time_t frameClocks = 70224;
+static const int framePairs = (int)((long long)sampleRate * frameClocks / clockRate);
+
+namespace APU_MIX_NS {
+
+template <int quality> static void addSteps(const Event* events, int count, Blip_Buffer* buf)
+{
+    static Blip_Synth<quality, 256> synth;
+    synth.volume(0.5);
+    for (int i = 0; i < count; i++)
+        synth.offset(events[i].time, events[i].delta, buf);
+}
+
+// adds the steps of a frame to buf, the time of each is within the frame
+void synth(int quality, const Event* events, int count, Blip_Buffer* buf)
+{
+    switch (quality) {
+    case blip_med_quality:
+        addSteps<blip_med_quality>(events, count, buf);
+        break;
+    case blip_good_quality:
+        addSteps<blip_good_quality>(events, count, buf);
+        break;
+    case blip_high_quality:
+        addSteps<blip_high_quality>(events, count, buf);
+        break;
+    }
+}
+
+// frames of steps through the buffer the GBA (effects false) or the GB
+// (effects true) uses, returns the nanoseconds spent reading samples
+double mix(bool effects, const Event* events, int perFrame, int frames, blip_sample_t* out)
+{
+    static Blip_Synth<blip_good_quality, 256> synth;
+    synth.volume(0.5);
+
+    Multi_Buffer* buffer;
+    if (effects) {
+        static int const types[4] = {
+            Multi_Buffer::wave_type + 1, Multi_Buffer::wave_type + 2,
+            Multi_Buffer::wave_type + 3, Multi_Buffer::mixed_type + 1
+        };
+        Simple_Effects_Buffer* fx = new Simple_Effects_Buffer;
+        fx->set_sample_rate(sampleRate);
+        fx->clock_rate(clockRate);
+        fx->set_channel_count(4, types);
+        fx->config().enabled = true;
+        fx->config().echo = 0.4f;
+        fx->config().stereo = 0.6f;
+        fx->config().surround = true;
+        fx->apply_config();
+        buffer = fx;
+    } else {
+        buffer = new Stereo_Buffer;
+        buffer->set_sample_rate(sampleRate);
+        buffer->clock_rate(clockRate);
+    }
+
+    double ns = 0;
+    for (int f = 0; f < frames; f++) {
+        const Event* e = events + (f % 16) * perFrame;
+        for (int i = 0; i < perFrame; i++) {
+            Multi_Buffer::channel_t ch = buffer->channel(e[i].channel & 3);
+            Blip_Buffer* buf = (e[i].channel & 4) ? ch.left : (e[i].channel & 8) ? ch.right : ch.center;
+            synth.offset(e[i].time, e[i].delta, buf);
+            buf->set_modified();
+        }
+        buffer->end_frame(frameClocks);
+
+        auto start = std::chrono::steady_clock::now();
+        long n = buffer->read_samples(out, buffer->samples_avail());
+        ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        out += n;
+    }
+
+    delete buffer;
+    return ns;
+}
+
+} // namespace APU_MIX_NS
+
+#ifndef APU_MIX_SCALAR
+
+namespace scalar {
+void synth(int quality, const Event* events, int count, Blip_Buffer* buf);
+double mix(bool effects, const Event* events, int perFrame, int frames, blip_sample_t* out);
+}
+
+// sixteen frames of events, steps of a few square waves
+static Event* makeEvents(int perFrame)
+{
+    Event* events = new Event[16 * perFrame];
+    for (int i = 0; i < 16 * perFrame; i++) {
+        events[i].time = (blip_time_t)((long long)(i % perFrame) * frameClocks / perFrame);
+        events[i].delta = rand() % 511 - 255;
+        events[i].channel = rand() & 15;
+    }
+    return events;
+}
+
+static bool sameBuffers(Blip_Buffer& a, Blip_Buffer& b)
+{
+    return !memcmp(a.buffer_, b.buffer_, (a.buffer_size_ + blip_buffer_extra_) * sizeof(a.buffer_[0]));
+}
+
+// best of several runs, in nanoseconds per step
+static double timeSynth(bool scalar, int quality, const Event* events, int count, Blip_Buffer* buf)
+{
+    double best = 0;
+
+    for (int run = 0; run < 5; run++) {
+        buf->clear();
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < 16; f++) {
+            if (scalar)
+                scalar::synth(quality, events + f * count / 16, count / 16, buf);
+            else
+                sse2::synth(quality, events + f * count / 16, count / 16, buf);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / count;
+        if (run == 0 || ns < best)
+            best = ns;
+    }
+
+    return best;
+}
+
+// best of several runs, in nanoseconds per stereo sample read
+static double timeMix(bool scalar, bool effects, const Event* events, int perFrame, int frames,
+    blip_sample_t* out)
+{
+    double best = 0;
+    long pairs = (long)frames * framePairs;
+
+    for (int run = 0; run < 5; run++) {
+        double ns = scalar ? scalar::mix(effects, events, perFrame, frames, out)
+                           : sse2::mix(effects, events, perFrame, frames, out);
+        ns /= pairs;
+        if (run == 0 || ns < best)
+            best = ns;
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : 600;
+    int failed = 0;
+
+    if (frames <= 0)
+        frames = 600;
+
+    srand(1);
+
+    // steps of every other sample or so, as from 8-bit PCM
+    const int steps = 16 * 400;
+    Event* stepEvents = makeEvents(steps / 16);
+
+    Blip_Buffer bufScalar, bufSse2;
+    bufScalar.set_sample_rate(sampleRate, 1000 / 4);
+    bufScalar.clock_rate(clockRate);
+    bufSse2.set_sample_rate(sampleRate, 1000 / 4);
+    bufSse2.clock_rate(clockRate);
+
+    static const int qualities[] = { blip_med_quality, blip_good_quality, blip_high_quality };
+
+    printf("test         old ns  new ns  speedup\n");
+    for (int q = 0; q < 3; q++) {
+        bufScalar.clear();
+        bufSse2.clear();
+        scalar::synth(qualities[q], stepEvents, steps, &bufScalar);
+        sse2::synth(qualities[q], stepEvents, steps, &bufSse2);
+        if (!sameBuffers(bufScalar, bufSse2)) {
+            printf("synth %-4d   output differs\n", qualities[q]);
+            failed++;
+            continue;
+        }
+
+        double oldNs = timeSynth(true, qualities[q], stepEvents, steps, &bufScalar);
+        double newNs = timeSynth(false, qualities[q], stepEvents, steps, &bufSse2);
+        printf("synth %-4d   %6.2f  %6.2f  %6.2fx\n", qualities[q], oldNs, newNs, oldNs / newNs);
+    }
+
+    // read_samples() hands out whole frames here, some spare room
+    long size = (long)(frames + 1) * (framePairs + 1) * 2;
+    blip_sample_t* outScalar = new blip_sample_t[size];
+    blip_sample_t* outSse2 = new blip_sample_t[size];
+    Event* mixEvents = makeEvents(64);
+
+    for (int effects = 0; effects < 2; effects++) {
+        const char* name = effects ? "effects" : "stereo";
+
+        memset(outScalar, 0, size * sizeof(blip_sample_t));
+        memset(outSse2, 0, size * sizeof(blip_sample_t));
+        scalar::mix(effects != 0, mixEvents, 64, frames, outScalar);
+        sse2::mix(effects != 0, mixEvents, 64, frames, outSse2);
+        if (memcmp(outScalar, outSse2, size * sizeof(blip_sample_t))) {
+            printf("%-11s  output differs\n", name);
+            failed++;
+            continue;
+        }
+
+        double oldNs = timeMix(true, effects != 0, mixEvents, 64, frames, outScalar);
+        double newNs = timeMix(false, effects != 0, mixEvents, 64, frames, outSse2);
+        printf("%-11s  %6.2f  %6.2f  %6.2fx\n", name, oldNs, newNs, oldNs / newNs);
+    }
+
+    return failed ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,172 @@
+// Measures the lineMix to pix conversion done at the end of every GBA
+// scanline against the unrolled table lookups CPULoop() used before.
+//
+// usage: gfx-convert-bench [lines]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../System.h"
+#include "../gba/GBA.h"
+
+uint16_t systemColorMap16[0x10000];
+uint32_t systemColorMap32[0x10000];
+int systemRedShift = 19;
+int systemGreenShift = 11;
+int systemBlueShift = 3;
+int systemColorDepth = 32;
+
+uint32_t lineMix[240];
+
+static uint8_t pixOld[240 * 4 + 4];
+static uint8_t pixNew[240 * 4 + 4];
+
+static void oldLine16(uint16_t* dest)
+{
+    for (int x = 0; x < 240;) {
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+    }
+}
+
+static void oldLine24(uint8_t* dest)
+{
+    for (int x = 0; x < 240;) {
+        *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
+        dest += 3;
+        *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
+        dest += 3;
+        *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
+        dest += 3;
+        *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
+        dest += 3;
+    }
+}
+
+static void oldLine32(uint32_t* dest)
+{
+    for (int x = 0; x < 240;) {
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+    }
+}
+
+static void buildMaps(int depth, bool lcd)
+{
+    systemColorDepth = depth;
+    if (depth == 16) {
+        systemRedShift = 11;
+        systemGreenShift = 6;
+        systemBlueShift = 0;
+    } else {
+        systemRedShift = 19;
+        systemGreenShift = 11;
+        systemBlueShift = 3;
+    }
+
+    for (int i = 0; i < 0x10000; i++) {
+        uint32_t color = ((i & 0x1f) << systemRedShift) |
+                         (((i & 0x3e0) >> 5) << systemGreenShift) |
+                         (((i & 0x7c00) >> 10) << systemBlueShift);
+        // stand-in for the LCD filter, any table that is not a bit shuffle
+        if (lcd)
+            color ^= (i * 0x9E3779B1) & ((depth == 16) ? 0x0821 : 0x00010101);
+        if (depth == 16)
+            systemColorMap16[i] = color;
+        else
+            systemColorMap32[i] = color;
+    }
+
+    gfxColorMapsChanged(lcd);
+}
+
+static void convert(int depth, bool old, uint8_t* pix)
+{
+    switch (depth) {
+    case 16:
+        if (old)
+            oldLine16((uint16_t*)pix);
+        else
+            gfxConvertLine16((uint16_t*)pix);
+        break;
+    case 24:
+        if (old)
+            oldLine24(pix);
+        else
+            gfxConvertLine24(pix);
+        break;
+    case 32:
+        if (old)
+            oldLine32((uint32_t*)pix);
+        else
+            gfxConvertLine32((uint32_t*)pix);
+        break;
+    }
+}
+
+// best of several runs, in nanoseconds per line
+static double timeLines(int depth, bool old, int lines)
+{
+    double best = 0;
+
+    for (int run = 0; run < 5; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < lines; i++) {
+            lineMix[i % 240] ^= i;
+            convert(depth, old, old ? pixOld : pixNew);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / lines;
+        if (run == 0 || ns < best)
+            best = ns;
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    int lines = (argc > 1) ? atoi(argv[1]) : 200000;
+    int failed = 0;
+
+    if (lines <= 0)
+        lines = 200000;
+
+    srand(1);
+    for (int x = 0; x < 240; x++)
+        lineMix[x] = (rand() << 16) ^ rand();
+
+    static const int depths[] = { 16, 24, 32 };
+
+    printf("depth  lcd    old ns/line  new ns/line  speedup\n");
+    for (int d = 0; d < 3; d++) {
+        for (int lcd = 0; lcd < 2; lcd++) {
+            int depth = depths[d];
+            buildMaps(depth, lcd != 0);
+
+            memset(pixOld, 0, sizeof(pixOld));
+            memset(pixNew, 0, sizeof(pixNew));
+            convert(depth, true, pixOld);
+            convert(depth, false, pixNew);
+            // the old 24 bit loop writes one byte past the line
+            if (memcmp(pixOld, pixNew, 240 * depth / 8)) {
+                printf("%5d  %-5s  output differs\n", depth, lcd ? "on" : "off");
+                failed++;
+                continue;
+            }
+
+            double oldNs = timeLines(depth, true, lines);
+            double newNs = timeLines(depth, false, lines);
+            printf("%5d  %-5s  %11.1f  %11.1f  %6.2fx\n", depth, lcd ? "on" : "off",
+                oldNs, newNs, oldNs / newNs);
+        }
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#include "AudioRateControl.h"
+#include "SoundDriver.h"
+
+const double AudioRateControl::maxDelta = 0.01;
+
+// rate change per unit of fill away from half, and how fast the skew moves
+// per write; found by simulating a driver that reads whole periods of 2048
+// pairs from a 100 ms buffer, with clocks up to 0.8% apart
+static const double fillGain = 0.02;
+static const double skewGain = 4e-5;
+
+AudioRateControl::AudioRateControl()
+{
+    reset();
+}
+
+void AudioRateControl::reset()
+{
+    m_fill = 0.5;
+    m_skew = 0.0;
+    m_ratio = 1.0;
+    m_pos = 0;
+    m_in.assign(HISTORY * 2, 0);
+}
+
+void AudioRateControl::update(const SoundDriverStats& stats)
+{
+    if (stats.capacity <= 0)
+        return;
+
+    double fill = (double)stats.buffered / stats.capacity;
+    if (fill > 1.0)
+        fill = 1.0;
+
+    // about a second of writes at 60 a second
+    m_fill += (fill - m_fill) / 64;
+
+    // the skew slowly learns how far apart the two clocks are, the rest
+    // steers the buffer back to half full
+    double error = 0.5 - m_fill;
+    m_skew = std::min(std::max(m_skew + error * skewGain, -maxDelta), maxDelta);
+    m_ratio = 1.0 + std::min(std::max(m_skew + error * fillGain, -maxDelta), maxDelta);
+}
+
+uint16_t* AudioRateControl::resample(const uint16_t* in, int pairs, int& outPairs)
+{
+    int const total = HISTORY + pairs;
+    m_in.resize(total * 2);
+    memcpy(&m_in[HISTORY * 2], in, pairs * 2 * sizeof(int16_t));
+
+    // at most pairs * ratio + 1 pairs come out, and the ratio is never
+    // above 1 + maxDelta
+    m_out.resize(((int)ceil(pairs * (1.0 + maxDelta)) + 2) * 2);
+
+    uint64_t const step = (uint64_t)(4294967296.0 / m_ratio + 0.5);
+    int n = 0;
+
+    // between input pairs i + 1 and i + 2, the cubic also needs i and i + 3
+    for (uint64_t i = m_pos >> 32; i + 3 < (uint64_t)total; i = m_pos >> 32) {
+        const int16_t* p = &m_in[i * 2];
+        float t = (uint32_t)m_pos * (1.0f / 4294967296.0f);
+
+        for (int c = 0; c < 2; c++) {
+            float p0 = p[c], p1 = p[c + 2], p2 = p[c + 4], p3 = p[c + 6];
+            float v = p1 + 0.5f * t * (p2 - p0 + t * (2 * p0 - 5 * p1 + 4 * p2 - p3 + t * (3 * (p1 - p2) + p3 - p0)));
+            int s = (int)floorf(v + 0.5f);
+            if (s > 32767)
+                s = 32767;
+            else if (s < -32768)
+                s = -32768;
+            m_out[n * 2 + c] = (uint16_t)s;
+        }
+
+        n++;
+        m_pos += step;
+    }
+
+    // keep the last pairs for the start of the next call
+    m_pos -= (uint64_t)pairs << 32;
+    memmove(&m_in[0], &m_in[pairs * 2], HISTORY * 2 * sizeof(int16_t));
+    m_in.resize(HISTORY * 2);
+
+    outPairs = n;
+    return &m_out[0];
+}
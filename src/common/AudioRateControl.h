@@ -0,0 +1,62 @@
+#ifndef AUDIORATECONTROL_H
+#define AUDIORATECONTROL_H
+
+#include <stdint.h>
+#include <vector>
+
+struct SoundDriverStats;
+
+// Dynamic rate control between the emulated sound and a driver that plays
+// it from a buffer of its own.
+//
+// The emulator makes exactly the samples of the emulated time it ran, but
+// when something else paces it, vsync for instance, its second is not quite
+// the sound card's second and the driver's buffer slowly runs dry or over,
+// one heard as crackle and the other as the writer blocking.  A GBA game
+// synced to a 60 Hz display runs 0.46% fast.  This stretches or squeezes the
+// sound by at most maxDelta so that the buffer stays half full on average:
+// a slowly learned skew makes up for the difference of the clocks, and a
+// small correction on top of it for how far the buffer is from half full.
+// The fill level wobbles by a whole period of the sound card as it reads,
+// so it is smoothed over about a second of writes before it steers the rate.
+//
+// Samples are 16-bit stereo pairs, resampled with a cubic through the four
+// pairs around each output pair.
+class AudioRateControl {
+public:
+    // most the rate is changed by, 1%
+    static const double maxDelta;
+
+    AudioRateControl();
+
+    // Starts over at the nominal rate with an empty history, after the
+    // driver was reset or the sound was paused
+    void reset();
+
+    // Steers the rate from the state of the driver's buffer, called before
+    // each resample()
+    void update(const SoundDriverStats& stats);
+
+    // Resamples pairs stereo pairs from in, returns the output and sets
+    // outPairs to how many pairs it has.  The output lasts until the next
+    // call.
+    uint16_t* resample(const uint16_t* in, int pairs, int& outPairs);
+
+    // Output pairs per input pair
+    double ratio() const { return m_ratio; }
+
+private:
+    enum { HISTORY = 3 };
+
+    double m_fill;
+    double m_skew;
+    double m_ratio;
+    // where the next output pair is, in input pairs after the first one of
+    // the history, with 32 bits of fraction
+    uint64_t m_pos;
+    // the last pairs of the previous call followed by the new ones
+    std::vector<int16_t> m_in;
+    std::vector<uint16_t> m_out;
+};
+
+#endif // AUDIORATECONTROL_H
@@ -0,0 +1,120 @@
+#ifndef AUDIORING_H
+#define AUDIORING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <vector>
+
+// Sample queue between the emulator, which writes, and a sound driver that
+// plays the samples from its own thread.  There must be only one thread on
+// each side, neither of them ever waits on the other or takes a lock.
+//
+// The storage is a power of two so the positions can count up forever and
+// are masked on access, which also tells a full ring from an empty one.
+// Only the requested size of it is filled, which sets the latency.
+// Each position is only stored by its own side and they sit on separate
+// cache lines, so the two threads do not keep stealing a line from each
+// other.
+class AudioRing {
+public:
+    AudioRing()
+        : m_size(0)
+        , m_mask(0)
+    {
+        clear();
+    }
+
+    // Holds up to size samples from now on and empties the ring.  Not safe
+    // while either side is using it.
+    void reset(size_t size)
+    {
+        size_t storage = 1;
+        while (storage < size)
+            storage <<= 1;
+
+        m_buffer.assign(storage, 0);
+        m_size = size;
+        m_mask = storage - 1;
+        clear();
+    }
+
+    void clear()
+    {
+        m_read.store(0, std::memory_order_relaxed);
+        m_write.store(0, std::memory_order_relaxed);
+        m_underruns.store(0, std::memory_order_relaxed);
+        m_dropped.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return m_size; }
+
+    // Samples waiting to be read, exact on the reading side and a lower
+    // bound on the writing side
+    size_t used() const
+    {
+        return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+    }
+
+    // Room for samples, exact on the writing side
+    size_t avail() const { return capacity() - used(); }
+
+    // Writer side.  Queues up to count samples and returns how many fit,
+    // the ones that did not are counted as dropped.  Samples are queued in
+    // steps of granularity, 2 keeps stereo pairs together.
+    size_t write(const uint16_t* samples, size_t count, size_t granularity = 2)
+    {
+        size_t write = m_write.load(std::memory_order_relaxed);
+        size_t room = capacity() - (write - m_read.load(std::memory_order_acquire));
+        size_t n = count < room ? count : room - room % granularity;
+
+        size_t pos = write & m_mask;
+        size_t first = n < m_buffer.size() - pos ? n : m_buffer.size() - pos;
+        memcpy(m_buffer.data() + pos, samples, first * sizeof(uint16_t));
+        memcpy(m_buffer.data(), samples + first, (n - first) * sizeof(uint16_t));
+
+        m_write.store(write + n, std::memory_order_release);
+
+        if (n < count)
+            m_dropped.fetch_add((unsigned)(count - n), std::memory_order_relaxed);
+        return n;
+    }
+
+    // Reader side.  Takes up to count samples and returns how many there
+    // were, a short read is counted as an underrun.
+    size_t read(uint16_t* samples, size_t count)
+    {
+        size_t read = m_read.load(std::memory_order_relaxed);
+        size_t queued = m_write.load(std::memory_order_acquire) - read;
+        size_t n = count < queued ? count : queued;
+
+        size_t pos = read & m_mask;
+        size_t first = n < m_buffer.size() - pos ? n : m_buffer.size() - pos;
+        memcpy(samples, m_buffer.data() + pos, first * sizeof(uint16_t));
+        memcpy(samples + first, m_buffer.data(), (n - first) * sizeof(uint16_t));
+
+        m_read.store(read + n, std::memory_order_release);
+
+        if (n < count)
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+        return n;
+    }
+
+    // Reads that came up short since the last clear()
+    unsigned underruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    // Samples that did not fit since the last clear()
+    unsigned dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<uint16_t> m_buffer;
+    size_t m_size;
+    size_t m_mask;
+    // each side's position and counter share a line of their own
+    alignas(64) std::atomic<size_t> m_read;
+    std::atomic<unsigned> m_underruns;
+    alignas(64) std::atomic<size_t> m_write;
+    std::atomic<unsigned> m_dropped;
+};
+
+#endif // AUDIORING_H
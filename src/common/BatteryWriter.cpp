@@ -0,0 +1,138 @@
+#include <stdio.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "../NLS.h"
+#include "../System.h"
+#include "../Util.h"
+#include "BatteryWriter.h"
+
+BatteryWriter batteryWriter;
+
+BatteryWriter::BatteryWriter()
+    : m_busy(false)
+    , m_stop(false)
+{
+}
+
+BatteryWriter::~BatteryWriter()
+{
+    if (!m_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+bool BatteryWriter::write(const char* fileName, std::vector<uint8_t>& data)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    if (!m_thread.joinable())
+        m_thread = std::thread(&BatteryWriter::worker, this);
+
+    // the one not taken yet is older than this one
+    bool queued = false;
+    for (size_t i = 0; i < m_queue.size(); i++) {
+        if (m_queue[i].fileName == fileName) {
+            m_queue[i].data.swap(data);
+            queued = true;
+            break;
+        }
+    }
+
+    if (!queued) {
+        m_queue.push_back(Save());
+        m_queue.back().fileName = fileName;
+        m_queue.back().data.swap(data);
+    }
+    data.clear();
+    m_wake.notify_one();
+
+    return report(lock);
+}
+
+bool BatteryWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_done.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+    return report(lock);
+}
+
+bool BatteryWriter::report(std::unique_lock<std::mutex>& lock)
+{
+    if (m_failed.empty())
+        return true;
+
+    std::vector<std::string> failed;
+    failed.swap(m_failed);
+
+    lock.unlock();
+    for (size_t i = 0; i < failed.size(); i++)
+        systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"),
+            failed[i].c_str());
+    lock.lock();
+
+    return false;
+}
+
+void BatteryWriter::worker()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+            break;
+
+        Save next;
+        next.fileName.swap(m_queue.front().fileName);
+        next.data.swap(m_queue.front().data);
+        m_queue.pop_front();
+        m_busy = true;
+
+        lock.unlock();
+        bool ok = save(next);
+        lock.lock();
+
+        if (!ok)
+            m_failed.push_back(next.fileName);
+        m_busy = false;
+        m_done.notify_all();
+    }
+}
+
+bool BatteryWriter::save(const Save& save)
+{
+    std::string temp = save.fileName + ".tmp";
+    FILE* file = utilOpenFile(temp.c_str(), "wb");
+
+    if (!file)
+        return false;
+
+    bool ok = fwrite(save.data.data(), 1, save.data.size(), file) == save.data.size();
+
+    // on disk before it replaces the old one
+    ok = fflush(file) == 0 && ok;
+#ifdef _WIN32
+    ok = _commit(_fileno(file)) == 0 && ok;
+#else
+    ok = fsync(fileno(file)) == 0 && ok;
+#endif
+    ok = fclose(file) == 0 && ok;
+
+    if (ok)
+        ok = utilRenameFile(temp.c_str(), save.fileName.c_str());
+
+    if (!ok)
+        remove(temp.c_str());
+
+    return ok;
+}
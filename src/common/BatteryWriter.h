@@ -0,0 +1,58 @@
+#ifndef BATTERYWRITER_H
+#define BATTERYWRITER_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes battery files on a thread of its own.
+//
+// The cores copy the save chip into memory, which takes no time, and hand
+// the copy over with write().  The thread writes it to a temporary file next
+// to the battery file and renames that over it, so a crash or a full disk
+// in the middle of a write leaves the previous save as it was.  Games that
+// write their save chip a few bytes at a time ask for a save after every
+// burst of writes, if a new save for a file comes while the last one is
+// still waiting only the new one is written.
+//
+// Errors are reported with systemMessage() on the thread calling write()
+// or flush(), the next time either of them is called.
+class BatteryWriter {
+public:
+    BatteryWriter();
+    ~BatteryWriter();
+
+    // Queues data to be written to fileName and returns at once, the data
+    // is taken and left empty.  false if an earlier write failed.
+    bool write(const char* fileName, std::vector<uint8_t>& data);
+    // Waits until everything queued so far is written, false if any of it
+    // or an earlier write failed
+    bool flush();
+
+private:
+    struct Save {
+        std::string fileName;
+        std::vector<uint8_t> data;
+    };
+
+    void worker();
+    bool report(std::unique_lock<std::mutex>& lock);
+    static bool save(const Save& save);
+
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::deque<Save> m_queue;
+    std::vector<std::string> m_failed;
+    bool m_busy;
+    bool m_stop;
+};
+
+extern BatteryWriter batteryWriter;
+
+#endif // BATTERYWRITER_H
@@ -95,6 +95,7 @@ enum named_opts
 	OPT_MAX_SCALE,
 	OPT_MOVIE_RECORD_DIR,
 	OPT_OPT_FLASH_SIZE,
+	OPT_PRESENT_BUFFERS,
 	OPT_REWIND_TIMER,
 	OPT_ROM_DIR_GB,
 	OPT_ROM_DIR_GBA,
@@ -115,7 +116,9 @@ enum named_opts
 	OPT_WINDOW_WIDTH,
 	OPT_SPEEDUP_THROTTLE,
 	OPT_SPEEDUP_FRAME_SKIP,
-	OPT_NO_SPEEDUP_THROTTLE_FRAME_SKIP
+	OPT_NO_SPEEDUP_THROTTLE_FRAME_SKIP,
+	OPT_SPEEDUP_MUTE,
+	OPT_NO_AUDIO_RATE_CONTROL
 };
 
 #define SOUND_MAX_VOLUME 2.0
@@ -152,6 +155,7 @@ const char* romDirGBC;
 const char* saveDir;
 const char* screenShotDir;
 const char* soundRecordDir;
+int acceleratedSwi = 0;
 int active = 1;
 int agbPrint;
 int autoFire;
@@ -177,6 +181,7 @@ int filter = kStretch2x;
 int filterWidth;
 int frameSkip = 1;
 int frameskipadjust;
+int frameStats = 0;
 int fsAdapter;
 int fsColorDepth;
 int fsForceChange;
@@ -191,7 +196,7 @@ int glFilter;
 int ifbType = kIFBNone;
 int joypadDefault;
 int languageOption;
-int layerEnable = 0xff00;
+GBA_LOCAL int layerEnable = 0xff00;
 int layerSettings = 0xff00;
 int linkAuto;
 int linkHacks = 1;
@@ -210,6 +215,7 @@ int optPrintUsage;
 int paused;
 int pauseWhenInactive = 0;
 int preparedCheats = 0;
+int presentBuffers = 0;
 int recentFreeze;
 int renderedFrames;
 int rewindCount;
@@ -238,7 +244,7 @@ int surfaceSizeX;
 int surfaceSizeY;
 int threadPriority;
 int tripleBuffering;
-int useBios = 0;
+GBA_LOCAL int useBios = 0;
 int useBiosFileGB;
 int useBiosFileGBA;
 int useBiosFileGBC;
@@ -261,6 +267,8 @@ uint32_t throttle = 100;
 uint32_t speedup_throttle = 100;
 uint32_t speedup_frame_skip = 9;
 bool speedup_throttle_frame_skip = false;
+bool speedup_mute = false;
+bool audio_rate_control = true;
 bool allowKeyboardBackgroundInput = false;
 bool allowJoystickBackgroundInput = true;
 
@@ -285,6 +293,7 @@ char* arg0 = NULL;
 
 struct option argOptions[] = {
 
+	{ "accelerated-swi", no_argument, &acceleratedSwi, 1 },
 	{ "agb-print", required_argument, 0, OPT_AGB_PRINT },
 	{ "auto-frame-skip", required_argument, 0, OPT_AUTO_FRAME_SKIP },
 	{ "auto-load-most-recent", no_argument, &autoLoadMostRecent, 1 },
@@ -320,6 +329,7 @@ struct option argOptions[] = {
 	{ "flash-128k", no_argument, &optFlashSize, 1 },
 	{ "flash-64k", no_argument, &optFlashSize, 0 },
 	{ "flash-size", required_argument, 0, 'S' },
+	{ "frame-stats", no_argument, &frameStats, 1 },
 	{ "frameskip", required_argument, 0, 's' },
 	{ "fs-adapter", required_argument, 0, OPT_FS_ADAPTER },
 	{ "fs-color-depth", required_argument, 0, OPT_FS_COLOR_DEPTH },
@@ -366,6 +376,7 @@ struct option argOptions[] = {
 	{ "opt-flash-size", required_argument, 0, OPT_OPT_FLASH_SIZE },
 	{ "patch", required_argument, 0, 'i' },
 	{ "pause-when-inactive", no_argument, &pauseWhenInactive, 1 },
+	{ "present-buffers", required_argument, 0, OPT_PRESENT_BUFFERS },
 	{ "profile", optional_argument, 0, 'p' },
 	{ "recent-freeze", no_argument, &recentFreeze, 1 },
 	{ "rewind-timer", required_argument, 0, OPT_REWIND_TIMER },
@@ -399,6 +410,8 @@ struct option argOptions[] = {
 	{ "speedup-throttle", required_argument, 0, OPT_SPEEDUP_THROTTLE },
 	{ "speedup-frame-skip", required_argument, 0, OPT_SPEEDUP_FRAME_SKIP },
 	{ "no-speedup-throttle-frame-skip", no_argument, 0, OPT_NO_SPEEDUP_THROTTLE_FRAME_SKIP },
+	{ "speedup-mute", no_argument, 0, OPT_SPEEDUP_MUTE },
+	{ "no-audio-rate-control", no_argument, 0, OPT_NO_AUDIO_RATE_CONTROL },
 	{ "triple-buffering", no_argument, &tripleBuffering, 1 },
 	{ "use-bios", no_argument, &useBios, 1 },
 	{ "use-bios-file-gb", no_argument, &useBiosFileGB, 1 },
@@ -479,6 +492,7 @@ void ValidateConfig()
 
 void LoadConfig()
 {
+	acceleratedSwi = ReadPref("acceleratedSwi", 0);
 	agbPrint = ReadPrefHex("agbPrint");
 	allowKeyboardBackgroundInput = ReadPref("allowKeyboardBackgroundInput", false);
 	allowJoystickBackgroundInput = ReadPref("allowJoystickBackgroundInput", true);
@@ -502,6 +516,7 @@ void LoadConfig()
 	filterMT = ReadPref("filterEnableMultiThreading", 0);
 	filter = ReadPref("filter", 0);
 	frameSkip = ReadPref("frameSkip", 0);
+	frameStats = ReadPref("frameStats", 0);
 	fsAdapter = ReadPref("fsAdapter", 0);
 	fsColorDepth = ReadPref("fsColorDepth", 32);
 	fsFrequency = ReadPref("fsFrequency", 60);
@@ -544,6 +559,7 @@ void LoadConfig()
 	openGL = ReadPrefHex("openGL");
 	optFlashSize = ReadPref("flashSize", 0);
 	pauseWhenInactive = ReadPref("pauseWhenInactive", 1);
+	presentBuffers = ReadPref("presentBuffers", 0);
 	recentFreeze = ReadPref("recentFreeze", 0);
 	rewindTimer = ReadPref("rewindTimer", 0);
 	romDirGB = ReadPrefString("romDirGB");
@@ -566,6 +582,8 @@ void LoadConfig()
 	speedup_throttle = ReadPref("speedupThrottle", 100);
 	speedup_frame_skip = ReadPref("speedupFrameSkip", 9);
 	speedup_throttle_frame_skip = ReadPref("speedupThrottleFrameSkip", 0);
+	speedup_mute = ReadPref("speedupMute", 0);
+	audio_rate_control = ReadPref("audioRateControl", 1);
 	tripleBuffering = ReadPref("tripleBuffering", 0);
 	useBios = ReadPrefHex("useBiosGBA");
 	useBiosFileGB = ReadPref("useBiosGB", 0);
@@ -1189,6 +1207,13 @@ int ReadOpts(int argc, char ** argv)
 			}
 			break;
 
+		case OPT_PRESENT_BUFFERS:
+			// --present-buffers
+			if (optarg) {
+				presentBuffers = atoi(optarg);
+			}
+			break;
+
 		case OPT_THREAD_PRIORITY:
 			// --thread-priority
 			if (optarg) {
@@ -1381,6 +1406,12 @@ int ReadOpts(int argc, char ** argv)
                 case OPT_NO_SPEEDUP_THROTTLE_FRAME_SKIP:
 			speedup_throttle_frame_skip = false;
                         break;
+                case OPT_SPEEDUP_MUTE:
+			speedup_mute = true;
+                        break;
+                case OPT_NO_AUDIO_RATE_CONTROL:
+			audio_rate_control = false;
+                        break;
 		}
 	}
 	return op;
@@ -41,6 +41,7 @@ extern const char *romDirGBA;
 extern const char *romDirGBC;
 extern const char *soundRecordDir;
 extern int *rewindSerials;
+extern int acceleratedSwi;
 extern int active;
 extern int agbPrint;
 extern int autoFire;
@@ -67,6 +68,7 @@ extern int filter;
 extern int filterWidth;
 extern int frameSkip;
 extern int frameskipadjust;
+extern int frameStats;
 extern int fsAdapter;
 extern int fsColorDepth;
 extern int fsForceChange;
@@ -81,7 +83,7 @@ extern int glFilter;
 extern int ifbType;
 extern int joypadDefault;
 extern int languageOption;
-extern int layerEnable;
+extern GBA_LOCAL int layerEnable;
 extern int layerSettings;
 extern int linkAuto;
 extern int linkHacks;
@@ -128,7 +130,7 @@ extern int surfaceSizeX;
 extern int surfaceSizeY;
 extern int threadPriority;
 extern int tripleBuffering;
-extern int useBios;
+extern GBA_LOCAL int useBios;
 extern int useBiosFileGB;
 extern int useBiosFileGBA;
 extern int useBiosFileGBC;
@@ -150,10 +152,13 @@ extern uint32_t throttle;
 extern uint32_t speedup_throttle;
 extern uint32_t speedup_frame_skip;
 extern bool speedup_throttle_frame_skip;
+extern bool speedup_mute;
+extern bool audio_rate_control;
 extern bool allowKeyboardBackgroundInput;
 extern bool allowJoystickBackgroundInput;
 
 extern int preparedCheats;
+extern int presentBuffers;
 extern const char *preparedCheatCodes[MAX_CHEATS];
 
 // allow up to 100 IPS/UPS/PPF patches given on commandline
@@ -0,0 +1,98 @@
+#include <chrono>
+
+#include "FrameTimes.h"
+
+// upper bounds, the last bucket takes everything slower
+const uint32_t FrameTimes::bounds[BUCKETS] = {
+    500, 1000, 2000, 4000, 8000, 12000, 16700, 20000, 25000, 33400, 50000, 100000, UINT32_MAX
+};
+
+static const char* const stageNames[FrameTimes::STAGES] = { "emulate", "filter", "present" };
+
+FrameTimes::FrameTimes()
+{
+    clear();
+}
+
+void FrameTimes::clear()
+{
+    for (int s = 0; s < STAGES; s++) {
+        for (int b = 0; b < BUCKETS; b++)
+            m_counts[s][b].store(0, std::memory_order_relaxed);
+        m_max[s].store(0, std::memory_order_relaxed);
+    }
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+void FrameTimes::add(Stage stage, uint32_t usec)
+{
+    int b = 0;
+    while (usec > bounds[b])
+        b++;
+    m_counts[stage][b].fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t max = m_max[stage].load(std::memory_order_relaxed);
+    while (usec > max && !m_max[stage].compare_exchange_weak(max, usec, std::memory_order_relaxed))
+        ;
+}
+
+uint32_t FrameTimes::count(Stage stage) const
+{
+    uint32_t n = 0;
+    for (int b = 0; b < BUCKETS; b++)
+        n += m_counts[stage][b].load(std::memory_order_relaxed);
+    return n;
+}
+
+uint32_t FrameTimes::percentile(Stage stage, int percent) const
+{
+    uint32_t counts[BUCKETS];
+    uint64_t n = 0;
+    for (int b = 0; b < BUCKETS; b++)
+        n += counts[b] = m_counts[stage][b].load(std::memory_order_relaxed);
+    if (!n)
+        return 0;
+
+    uint64_t want = (n * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS - 1; b++) {
+        seen += counts[b];
+        if (seen >= want)
+            return bounds[b];
+    }
+    return m_max[stage].load(std::memory_order_relaxed);
+}
+
+void FrameTimes::summary(char* buffer, size_t size) const
+{
+    unsigned ms[STAGES][2];
+    for (int s = 0; s < STAGES; s++) {
+        ms[s][0] = (percentile((Stage)s, 50) + 999) / 1000;
+        ms[s][1] = (percentile((Stage)s, 99) + 999) / 1000;
+    }
+    snprintf(buffer, size, "E%u/%u F%u/%u P%u/%u ms", ms[EMULATE][0], ms[EMULATE][1],
+        ms[FILTER][0], ms[FILTER][1], ms[PRESENT][0], ms[PRESENT][1]);
+}
+
+void FrameTimes::print(FILE* f) const
+{
+    fprintf(f, "Frame times in ms, %u frames dropped\n", dropped());
+    fprintf(f, "%-8s", "");
+    for (int b = 0; b < BUCKETS - 1; b++)
+        fprintf(f, " %6.1f", bounds[b] / 1000.0);
+    fprintf(f, "   more    max\n");
+
+    for (int s = 0; s < STAGES; s++) {
+        fprintf(f, "%-8s", stageNames[s]);
+        for (int b = 0; b < BUCKETS; b++)
+            fprintf(f, " %6u", m_counts[s][b].load(std::memory_order_relaxed));
+        fprintf(f, " %6.1f\n", m_max[s].load(std::memory_order_relaxed) / 1000.0);
+    }
+}
+
+uint64_t FrameTimes::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
@@ -0,0 +1,57 @@
+#ifndef FRAMETIMES_H
+#define FRAMETIMES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+
+// Histogram of how long each stage of a frame takes: running the emulator
+// up to the frame, filtering it and drawing the on-screen text, and handing
+// it to the display.  The stages may be timed on different threads, add()
+// never takes a lock.
+//
+// The buckets are finer around a 60Hz frame, percentiles are given as the
+// upper bound of the bucket they fall in.
+class FrameTimes {
+public:
+    enum Stage {
+        EMULATE,
+        FILTER,
+        PRESENT,
+        STAGES
+    };
+
+    FrameTimes();
+
+    void clear();
+
+    void add(Stage stage, uint32_t usec);
+    // A frame replaced by a newer one before it was shown
+    void drop() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+
+    uint32_t count(Stage stage) const;
+    uint32_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    // Time in microseconds under which percent % of the frames took the
+    // stage, 0 if none did
+    uint32_t percentile(Stage stage, int percent) const;
+
+    // One short line for the screen, the median and 99th percentile of
+    // each stage in milliseconds
+    void summary(char* buffer, size_t size) const;
+    // The whole histogram, a line per stage
+    void print(FILE* f) const;
+
+    // Microseconds from a steady clock
+    static uint64_t now();
+
+private:
+    enum { BUCKETS = 13 };
+    static const uint32_t bounds[BUCKETS];
+
+    std::atomic<uint32_t> m_counts[STAGES][BUCKETS];
+    std::atomic<uint32_t> m_max[STAGES];
+    std::atomic<uint32_t> m_dropped;
+};
+
+#endif // FRAMETIMES_H
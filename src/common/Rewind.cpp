@@ -0,0 +1,275 @@
+#include <string.h>
+
+#include "Rewind.h"
+
+// A delta is a list of runs, each one the number of unchanged bytes to skip
+// and the number of changed bytes that follow as varints, then the changed
+// bytes XORed with the previous snapshot.  Keyframes use the same
+// encoding against an all zero state, which drops the unused parts of the
+// state, unless that does not make them smaller.
+
+// unchanged bytes are first skipped in blocks of this size
+#define REWIND_BLOCK 256
+
+static const uint8_t rewindZero[REWIND_BLOCK] = { 0 };
+
+// Keyframe encodes against all zeros, with prev unused
+template <bool Keyframe>
+static inline const uint8_t* rewindBlock(const uint8_t* prev, size_t i)
+{
+    return Keyframe ? rewindZero : prev + i;
+}
+
+template <bool Keyframe>
+static inline uint8_t rewindByte(const uint8_t* prev, size_t i)
+{
+    return Keyframe ? 0 : prev[i];
+}
+
+// true if any of the 8 bytes at i changed
+template <bool Keyframe>
+static inline bool rewindChanged64(const uint8_t* cur, const uint8_t* prev, size_t i)
+{
+    uint64_t a, b = 0;
+    memcpy(&a, cur + i, sizeof(a));
+    if (!Keyframe)
+        memcpy(&b, prev + i, sizeof(b));
+    return a != b;
+}
+
+static inline uint8_t* rewindPutVarint(uint8_t* out, size_t v)
+{
+    while (v >= 0x80) {
+        *out++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *out++ = (uint8_t)v;
+    return out;
+}
+
+static inline const uint8_t* rewindGetVarint(const uint8_t* in, size_t& v)
+{
+    v = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t b = *in++;
+        v |= (size_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return in;
+    }
+}
+
+// Returns false if the delta would not be smaller than the state
+template <bool Keyframe>
+static bool rewindEncode(const uint8_t* cur, const uint8_t* prev, size_t size, uint8_t* out, size_t& length)
+{
+    if (size <= 20)
+        return false;
+
+    uint8_t* start = out;
+    // leaves room for the two varints of a run
+    uint8_t* end = out + size - 20;
+    size_t i = 0;
+
+    for (;;) {
+        size_t skip = i;
+        while (i + REWIND_BLOCK <= size && !memcmp(cur + i, rewindBlock<Keyframe>(prev, i), REWIND_BLOCK))
+            i += REWIND_BLOCK;
+        while (i < size && cur[i] == rewindByte<Keyframe>(prev, i))
+            i++;
+        if (i == size)
+            break;
+        skip = i - skip;
+
+        // a run ends at the next 8 unchanged bytes, less the unchanged ones
+        // before them
+        size_t changed = i++;
+        while (i + 8 <= size && rewindChanged64<Keyframe>(cur, prev, i))
+            i += 8;
+        if (i + 8 > size)
+            i = size;
+        while (cur[i - 1] == rewindByte<Keyframe>(prev, i - 1))
+            i--;
+
+        if ((size_t)(end - out) <= i - changed)
+            return false;
+        out = rewindPutVarint(out, skip);
+        out = rewindPutVarint(out, i - changed);
+        for (size_t k = changed; k < i; k++)
+            *out++ = cur[k] ^ rewindByte<Keyframe>(prev, k);
+    }
+
+    length = out - start;
+    return true;
+}
+
+static void rewindApply(uint8_t* state, const uint8_t* in, size_t size)
+{
+    const uint8_t* end = in + size;
+    size_t pos = 0;
+
+    while (in < end) {
+        size_t skip, changed;
+        in = rewindGetVarint(in, skip);
+        in = rewindGetVarint(in, changed);
+        pos += skip;
+        for (size_t k = 0; k < changed; k++)
+            state[pos + k] ^= in[k];
+        pos += changed;
+        in += changed;
+    }
+}
+
+RewindBuffer::RewindBuffer()
+    : m_lastSize(0)
+    , m_keyframeInterval(1)
+    , m_sinceKeyframe(0)
+{
+}
+
+bool RewindBuffer::reset(size_t capacity, size_t stateSize, int keyframeInterval)
+{
+    clear();
+    m_keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+
+    if (capacity < stateSize * 2)
+        return false;
+
+    try {
+        m_data.resize(capacity);
+        m_last.resize(stateSize);
+        m_state.resize(stateSize);
+        m_delta.resize(stateSize);
+    } catch (...) {
+        m_data.clear();
+        m_last.clear();
+        m_state.clear();
+        m_delta.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void RewindBuffer::clear()
+{
+    m_entries.clear();
+    m_lastSize = 0;
+    m_sinceKeyframe = 0;
+}
+
+// Finds room for size bytes after the newest entry, wrapping to the start
+// of the ring and dropping old entries as needed
+bool RewindBuffer::reserve(size_t size, size_t& offset)
+{
+    if (size > m_data.size())
+        return false;
+
+    for (;;) {
+        if (m_entries.empty()) {
+            offset = 0;
+            return true;
+        }
+
+        size_t head = m_entries.front().offset;
+        size_t tail = m_entries.back().offset + m_entries.back().size;
+
+        if (head < tail) {
+            if (m_data.size() - tail >= size) {
+                offset = tail;
+                return true;
+            }
+            if (head >= size) {
+                offset = 0;
+                return true;
+            }
+        } else if (head - tail >= size) {
+            offset = tail;
+            return true;
+        }
+
+        dropOldest();
+    }
+}
+
+void RewindBuffer::dropOldest()
+{
+    // the deltas up to the next keyframe cannot be decoded without it
+    m_entries.pop_front();
+    while (!m_entries.empty() && !m_entries.front().keyframe)
+        m_entries.pop_front();
+}
+
+bool RewindBuffer::push(size_t size, uint32_t frame)
+{
+    if (!size || size > m_state.size())
+        return false;
+
+    Entry entry;
+    entry.stateSize = size;
+    entry.frame = frame;
+    entry.keyframe = m_entries.empty() || size != m_lastSize || m_sinceKeyframe + 1 >= m_keyframeInterval;
+    entry.raw = false;
+
+    if (!entry.keyframe && rewindEncode<false>(&m_state[0], &m_last[0], size, &m_delta[0], entry.size)) {
+        if (!reserve(entry.size, entry.offset))
+            return false;
+        // the delta is useless if its base went too
+        entry.keyframe = m_entries.empty();
+    } else
+        entry.keyframe = true;
+
+    if (entry.keyframe) {
+        entry.raw = !rewindEncode<true>(&m_state[0], NULL, size, &m_delta[0], entry.size);
+        if (entry.raw)
+            entry.size = size;
+        if (!reserve(entry.size, entry.offset))
+            return false;
+    }
+
+    memcpy(&m_data[entry.offset], entry.raw ? &m_state[0] : &m_delta[0], entry.size);
+    m_sinceKeyframe = entry.keyframe ? 0 : m_sinceKeyframe + 1;
+
+    m_entries.push_back(entry);
+    m_last.swap(m_state);
+    m_lastSize = size;
+    return true;
+}
+
+// Rebuilds the snapshot at index into m_last
+void RewindBuffer::decode(size_t index)
+{
+    size_t key = index;
+    while (!m_entries[key].keyframe)
+        key--;
+
+    if (m_entries[key].raw)
+        memcpy(&m_last[0], &m_data[m_entries[key].offset], m_entries[key].size);
+    else {
+        memset(&m_last[0], 0, m_entries[key].stateSize);
+        rewindApply(&m_last[0], &m_data[m_entries[key].offset], m_entries[key].size);
+    }
+    for (size_t i = key + 1; i <= index; i++)
+        rewindApply(&m_last[0], &m_data[m_entries[i].offset], m_entries[i].size);
+
+    m_lastSize = m_entries[index].stateSize;
+    m_sinceKeyframe = (int)(index - key);
+}
+
+char* RewindBuffer::rewind(uint32_t frames, size_t& size)
+{
+    if (m_entries.empty())
+        return NULL;
+
+    uint32_t target = m_entries.back().frame - frames;
+    size_t count = m_entries.size();
+    while (count > 1 && (int32_t)(m_entries[count - 1].frame - target) > 0)
+        count--;
+
+    if (count < m_entries.size()) {
+        m_entries.resize(count);
+        decode(count - 1);
+    }
+
+    size = m_lastSize;
+    return (char*)&m_last[0];
+}
@@ -0,0 +1,74 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+// History of emulator memory states for rewinding.
+//
+// Snapshots are the uncompressed states written by emuWriteMemStateRaw().
+// Every keyframeInterval-th one is a keyframe that can be restored on its
+// own, the ones in between are stored as the XOR against the snapshot
+// before them with the runs of unchanged bytes left out.  Consecutive
+// frames only differ in a few places, so a delta is usually a small part
+// of a state, and nothing is run through zlib.  A delta that would not be
+// smaller than the state is stored as a keyframe instead.  Everything
+// shares one ring of the given capacity, when it is full the oldest
+// keyframe is dropped together with its deltas.
+class RewindBuffer {
+public:
+    RewindBuffer();
+
+    // Drops all snapshots and allocates the ring and the state buffers,
+    // false if they could not be allocated.
+    bool reset(size_t capacity, size_t stateSize, int keyframeInterval);
+    void clear();
+
+    // Number of snapshots held
+    int count() const { return (int)m_entries.size(); }
+    // Frame the newest snapshot was taken at, count() must not be 0
+    uint32_t frame() const { return m_entries.back().frame; }
+
+    // Buffer of stateSize bytes to write the next snapshot into
+    char* state() { return (char*)&m_state[0]; }
+    size_t stateSize() const { return m_state.size(); }
+
+    // Stores the first size bytes of state() as the newest snapshot, taken
+    // once the emulator finished the given frame
+    bool push(size_t size, uint32_t frame);
+
+    // Drops the snapshots taken less than frames frames before the newest
+    // one, all but the oldest one if it is not as old, and returns the one
+    // that is now the newest.  size is set to its length.  NULL if there
+    // are no snapshots.
+    char* rewind(uint32_t frames, size_t& size);
+
+private:
+    struct Entry {
+        size_t offset;
+        size_t size;
+        size_t stateSize;
+        uint32_t frame;
+        bool keyframe;
+        // keyframe stored as is
+        bool raw;
+    };
+
+    bool reserve(size_t size, size_t& offset);
+    void dropOldest();
+    void decode(size_t index);
+
+    std::vector<uint8_t> m_data;
+    std::deque<Entry> m_entries;
+    // the newest snapshot, deltas are taken against it
+    std::vector<uint8_t> m_last;
+    size_t m_lastSize;
+    std::vector<uint8_t> m_state;
+    std::vector<uint8_t> m_delta;
+    int m_keyframeInterval;
+    int m_sinceKeyframe;
+};
+
+#endif // REWIND_H
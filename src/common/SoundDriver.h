@@ -20,6 +20,21 @@
 
 #include <stdint.h> // for uint16_t
 
+/**
+ * State of a driver's output buffer, counted in samples.
+ */
+struct SoundDriverStats
+{
+        /** Samples queued ahead of the output, the latency */
+        int buffered;
+        /** Size of the buffer */
+        int capacity;
+        /** Times the output ran out of samples */
+        unsigned underruns;
+        /** Samples dropped because the buffer was full */
+        unsigned dropped;
+};
+
 /**
  * Sound driver abstract interface for the core to use to output sound.
  * Subclass this to implement a new sound driver.
@@ -59,6 +74,12 @@ class SoundDriver
         virtual void write(uint16_t *finalWave, int length) = 0;
 
         virtual void setThrottle(unsigned short throttle) = 0;
+
+        /**
+         * Fill stats with the state of the output buffer.
+         * @return false if the driver does not keep one
+         */
+        virtual bool getStats(SoundDriverStats& /*stats*/) { return false; }
 };
 
 #endif // __VBA_SOUND_DRIVER_H__
@@ -29,8 +29,11 @@ extern int emulating;
 const double SoundSDL::buftime = 0.100;
 
 SoundSDL::SoundSDL():
-    samples_buf(0),
     sound_device(-1),
+    data_available(nullptr),
+    data_read(nullptr),
+    reader_waiting(false),
+    writer_waiting(false),
     current_rate(throttle),
     initialized(false)
 {}
@@ -43,14 +46,6 @@ bool SoundSDL::should_wait() {
     return emulating && !speedup && current_rate && !gba_joybus_active;
 }
 
-std::size_t SoundSDL::buffer_size() {
-    SDL_LockMutex(mutex);
-    std::size_t size = samples_buf.used();
-    SDL_UnlockMutex(mutex);
-
-    return size;
-}
-
 void SoundSDL::read(uint16_t* stream, int length) {
     if (length <= 0)
         return;
@@ -61,58 +56,70 @@ void SoundSDL::read(uint16_t* stream, int length) {
     if (!initialized || !emulating)
         return;
 
-    if (!buffer_size()) {
-        if (should_wait())
-            SDL_SemWait(data_available);
-        else
-            return;
-    }
+    while (!samples_buf.used() && should_wait()) {
+        reader_waiting = true;
 
-    SDL_LockMutex(mutex);
+        // the writer may have queued something before it saw the flag
+        if (!samples_buf.used())
+            SDL_SemWait(data_available);
 
-    samples_buf.read(stream, std::min((std::size_t)(length / 2), samples_buf.used()));
+        reader_waiting = false;
+    }
 
-    SDL_UnlockMutex(mutex);
+    samples_buf.read(stream, length / 2);
 
-    SDL_SemPost(data_read);
+    if (writer_waiting.exchange(false))
+        SDL_SemPost(data_read);
 }
 
 void SoundSDL::write(uint16_t * finalWave, int length) {
     if (!initialized)
         return;
 
-    SDL_LockMutex(mutex);
-
     if (SDL_GetAudioDeviceStatus(sound_device) != SDL_AUDIO_PLAYING)
 	SDL_PauseAudioDevice(sound_device, 0);
 
-    unsigned int samples = length / 4;
-    std::size_t avail;
+    std::size_t samples = length / 2;
 
-    while ((avail = samples_buf.avail() / 2) < samples) {
-	samples_buf.write(finalWave, avail * 2);
+    for (;;) {
+	std::size_t written = samples_buf.write(finalWave, std::min(samples, samples_buf.avail() & ~(std::size_t)1));
 
-	finalWave += avail * 2;
-	samples -= avail;
+	finalWave += written;
+	samples -= written;
 
-	SDL_UnlockMutex(mutex);
+	if (reader_waiting.exchange(false))
+	    SDL_SemPost(data_available);
 
-	SDL_SemPost(data_available);
+	if (!samples)
+	    return;
 
-	if (should_wait())
-	    SDL_SemWait(data_read);
-	else
+	if (!should_wait()) {
 	    // Drop the remainder of the audio data
+	    samples_buf.write(finalWave, samples);
 	    return;
+	}
 
-	SDL_LockMutex(mutex);
-    }
+	writer_waiting = true;
 
-    samples_buf.write(finalWave, samples * 2);
+	// the callback may have made room before it saw the flag
+	if (samples_buf.avail() < 2)
+	    SDL_SemWait(data_read);
 
-    SDL_UnlockMutex(mutex);
+	writer_waiting = false;
+    }
 }
 
+bool SoundSDL::getStats(SoundDriverStats& stats) {
+    if (!initialized)
+        return false;
+
+    stats.buffered  = samples_buf.used();
+    stats.capacity  = samples_buf.capacity();
+    stats.underruns = samples_buf.underruns();
+    stats.dropped   = samples_buf.dropped();
+
+    return true;
+}
 
 bool SoundSDL::init(long sampleRate) {
     if (initialized) deinit();
@@ -140,9 +147,10 @@ bool SoundSDL::init(long sampleRate) {
 
     samples_buf.reset(std::ceil(buftime * sampleRate * 2));
 
-    mutex          = SDL_CreateMutex();
     data_available = SDL_CreateSemaphore(0);
-    data_read      = SDL_CreateSemaphore(1);
+    data_read      = SDL_CreateSemaphore(0);
+    reader_waiting = false;
+    writer_waiting = false;
 
     // turn off audio events because we are not processing them
 #if SDL_VERSION_ATLEAST(2, 0, 4)
@@ -159,12 +167,10 @@ void SoundSDL::deinit() {
 
     initialized = false;
 
-    SDL_LockMutex(mutex);
     int is_emulating = emulating;
     emulating = 0;
     SDL_SemPost(data_available);
     SDL_SemPost(data_read);
-    SDL_UnlockMutex(mutex);
 
     SDL_Delay(100);
 
@@ -173,9 +179,6 @@ void SoundSDL::deinit() {
     SDL_DestroySemaphore(data_read);
     data_read      = nullptr;
 
-    SDL_DestroyMutex(mutex);
-    mutex = nullptr;
-
     SDL_CloseAudioDevice(sound_device);
 
     emulating = is_emulating;
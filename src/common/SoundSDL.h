@@ -18,7 +18,9 @@
 #ifndef __VBA_SOUND_SDL_H__
 #define __VBA_SOUND_SDL_H__
 
-#include "ringbuffer.h"
+#include <atomic>
+
+#include "AudioRing.h"
 #include "SoundDriver.h"
 
 #include "SDL.h"
@@ -34,22 +36,27 @@ public:
         virtual void resume();
         virtual void write(uint16_t *finalWave, int length);
         virtual void setThrottle(unsigned short throttle_);
+        virtual bool getStats(SoundDriverStats& stats);
 
 protected:
         static void soundCallback(void* data, uint8_t* stream, int length);
         virtual void read(uint16_t* stream, int length);
         virtual bool should_wait();
-        virtual std::size_t buffer_size();
         virtual void deinit();
 
 private:
-        RingBuffer<uint16_t> samples_buf;
+        // written by the emulator, read by the audio callback
+        AudioRing samples_buf;
 
         SDL_AudioDeviceID sound_device = 0;
 
-        SDL_mutex* mutex;
+        // only used to sleep while the ring is empty or full, the side
+        // that sleeps raises its flag and the other side posts when it
+        // finds it raised
         SDL_sem* data_available;
         SDL_sem* data_read;
+        std::atomic<bool> reader_waiting;
+        std::atomic<bool> writer_waiting;
         SDL_AudioSpec audio_spec;
 
         unsigned short current_rate;
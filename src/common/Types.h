@@ -25,4 +25,14 @@
 #include "cstdint.h"
 #endif
 
+// Marks the state of a running GBA core.  With MULTI_INSTANCE every thread
+// gets its own copy, so several cores can run in one process, each on a
+// thread of its own (see gba/Instance.h).  Whatever is declared extern with
+// it has to be constant initialized.
+#if defined(MULTI_INSTANCE) && defined(__cplusplus)
+#define GBA_LOCAL thread_local
+#else
+#define GBA_LOCAL
+#endif
+
 #endif // __VBA_TYPES_H__
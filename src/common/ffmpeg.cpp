@@ -3,6 +3,10 @@
 #define STREAM_FRAME_RATE 60
 #define STREAM_PIXEL_FORMAT AV_PIX_FMT_YUV420P
 #define IN_SOUND_FORMAT AV_SAMPLE_FMT_S16
+// frames the emulator may be ahead of the encoder
+#define QUEUE_FRAMES 8
+// slots video leaves free, so audio does not wait behind it
+#define QUEUE_AUDIO_SLOTS 2
 
 struct supportedCodecs {
     AVCodecID codecId;
@@ -243,6 +247,8 @@ recording::MediaRet recording::MediaRecorder::setup_video_stream_info(int width,
         default:
             break;
     }
+    // what AddFrame() reads, borders included
+    videoFrameSize = (tbord + height) * (width + rbord) * pixsize;
     return MRET_OK;
 }
 
@@ -331,6 +337,13 @@ recording::MediaRecorder::MediaRecorder() : isRecording(false),
     posInAudioBuffer = 0;
     samplesInAudioBuffer = 0;
     audioBufferSize = 0;
+    // encoder
+    queueHead = queueCount = 0;
+    videoFrameSize = 0;
+    skippedFrames = 0;
+    encoderStop = false;
+    encoderError = MRET_OK;
+    stats = MediaStats();
 }
 
 // video : return error code to user
@@ -373,12 +386,36 @@ recording::MediaRet recording::MediaRecorder::Record(const char *fname, int widt
         Stop();
         return ret;
     }
+    start_encoder();
     return MRET_OK;
 }
 
 recording::MediaRet recording::MediaRecorder::AddFrame(const uint8_t *vid)
 {
     if (!isRecording) return MRET_OK;
+    std::unique_lock<std::mutex> lock(queueLock);
+    if (encoderError != MRET_OK) return encoderError;
+    if (queueCount >= (int)queue.size() - QUEUE_AUDIO_SLOTS)
+    {
+        // the encoder is behind, the last frame stands in for this one
+        skippedFrames++;
+        stats.dropped++;
+        return MRET_OK;
+    }
+    // the slot is not the encoder's until it is pushed
+    QueuedFrame *f = next_frame();
+    lock.unlock();
+    memcpy(f->data.data(), vid, videoFrameSize);
+    f->audio = false;
+    f->skipped = skippedFrames;
+    skippedFrames = 0;
+    lock.lock();
+    push_frame();
+    return MRET_OK;
+}
+
+recording::MediaRet recording::MediaRecorder::encode_video(const uint8_t *vid)
+{
     // fill and encode frame variables
     int got_packet = 0, ret = 0;
     AVPacket pkt;
@@ -415,6 +452,8 @@ recording::MediaRet recording::MediaRecorder::AddFrame(const uint8_t *vid)
 
 void recording::MediaRecorder::Stop()
 {
+    // encode whatever is still queued
+    stop_encoder();
     if (oc)
     {
         // write the trailer; must be called before av_codec_close()
@@ -542,6 +581,7 @@ recording::MediaRet recording::MediaRecorder::Record(const char *fname)
         Stop();
         return ret;
     }
+    start_encoder();
     return MRET_OK;
 }
 
@@ -550,6 +590,26 @@ recording::MediaRet recording::MediaRecorder::Record(const char *fname)
 recording::MediaRet recording::MediaRecorder::AddFrame(const uint16_t *aud, int length)
 {
     if (!isRecording) return MRET_OK;
+    std::unique_lock<std::mutex> lock(queueLock);
+    // a gap would be heard, so audio waits for the encoder
+    while (queueCount == (int)queue.size() && encoderError == MRET_OK)
+        queueSpace.wait(lock);
+    if (encoderError != MRET_OK) return encoderError;
+    QueuedFrame *f = next_frame();
+    lock.unlock();
+    if ((int)f->data.size() < length)
+        f->data.resize(length);
+    memcpy(f->data.data(), aud, length);
+    f->audio = true;
+    f->length = length;
+    f->skipped = 0;
+    lock.lock();
+    push_frame();
+    return MRET_OK;
+}
+
+recording::MediaRet recording::MediaRecorder::encode_audio(const uint16_t *aud, int length)
+{
     AVCodecContext *c = aenc;
     int samples_size = av_samples_get_buffer_size(NULL, c->channels, audioframeTmp->nb_samples, IN_SOUND_FORMAT, 1);
 
@@ -649,3 +709,87 @@ void recording::MediaRecorder::flush_frames()
     while (avcodec_receive_packet(aenc, &pkt) >= 0)
         avcodec_send_frame(aenc, NULL);
 }
+
+recording::MediaStats recording::MediaRecorder::GetStats()
+{
+    std::lock_guard<std::mutex> lock(queueLock);
+    stats.queued = queueCount;
+    return stats;
+}
+
+void recording::MediaRecorder::start_encoder()
+{
+    queue.assign(QUEUE_FRAMES, QueuedFrame());
+    for (size_t i = 0; i < queue.size(); ++i)
+        queue[i].data.resize(videoFrameSize);
+    queueHead = queueCount = 0;
+    skippedFrames = 0;
+    encoderStop = false;
+    encoderError = MRET_OK;
+    stats = MediaStats();
+    encoder = std::thread(&MediaRecorder::encode_loop, this);
+}
+
+void recording::MediaRecorder::stop_encoder()
+{
+    if (!encoder.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        encoderStop = true;
+    }
+    queueReady.notify_one();
+    encoder.join();
+    queue.clear();
+    queueHead = queueCount = 0;
+}
+
+// called with queueLock held
+recording::MediaRecorder::QueuedFrame *recording::MediaRecorder::next_frame()
+{
+    return &queue[(queueHead + queueCount) % queue.size()];
+}
+
+// called with queueLock held
+void recording::MediaRecorder::push_frame()
+{
+    queueCount++;
+    if (queueCount > stats.maxQueued)
+        stats.maxQueued = queueCount;
+    queueReady.notify_one();
+}
+
+void recording::MediaRecorder::encode_loop()
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+    for (;;)
+    {
+        while (!queueCount && !encoderStop)
+            queueReady.wait(lock);
+        // on stop, the queue is emptied first
+        if (!queueCount)
+            break;
+        QueuedFrame &f = queue[queueHead];
+        MediaRet err = encoderError;
+        lock.unlock();
+        // after an error frames are only taken off the queue
+        MediaRet ret = MRET_OK;
+        if (err == MRET_OK)
+        {
+            if (f.audio)
+                ret = encode_audio((const uint16_t *)f.data.data(), f.length);
+            else
+            {
+                npts += f.skipped;
+                ret = encode_video(f.data.data());
+            }
+        }
+        lock.lock();
+        if (ret != MRET_OK)
+            encoderError = ret;
+        queueHead = (queueHead + 1) % queue.size();
+        queueCount--;
+        stats.encoded++;
+        queueSpace.notify_one();
+    }
+}
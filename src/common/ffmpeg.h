@@ -31,8 +31,11 @@ extern "C" {
 #include <libswresample/swresample.h>
 }
 
-#include <vector>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace recording {
 
@@ -55,6 +58,19 @@ enum MediaRet {
         MRET_ERR_BUFSIZE    // buffer overflow (fatal)
 };
 
+// encoder queue counters, kept after Stop() until the next recording
+struct MediaStats {
+        int queued;    // frames waiting for the encoder
+        int maxQueued; // most frames that were waiting at once
+        int encoded;   // frames handed to the codecs
+        int dropped;   // video frames dropped because the queue was full
+};
+
+// Frames given to AddFrame() are copied to a small queue and encoded by a
+// thread of its own, so a slow codec does not hold up the emulator.  When
+// the queue is nearly full video frames are dropped, the previous one is
+// shown for them, while audio waits for a free slot so the sound has no
+// gaps.  Errors of the encoder are returned by the next AddFrame().
 class MediaRecorder
 {
         public:
@@ -85,8 +101,15 @@ class MediaRecorder
         {
                 sampleRate = newSampleRate;
         }
+        MediaStats GetStats();
 
         private:
+        struct QueuedFrame {
+                bool audio;
+                int length;   // bytes of audio
+                int skipped;  // video frames dropped just before this one
+                std::vector<uint8_t> data;
+        };
         bool isRecording;
         int sampleRate;
         AVFormatContext *oc;
@@ -117,6 +140,17 @@ class MediaRecorder
         int posInAudioBuffer;
         int samplesInAudioBuffer;
         int audioBufferSize;
+        // encoder thread and its queue
+        std::vector<QueuedFrame> queue;
+        int queueHead, queueCount;
+        int videoFrameSize;
+        int skippedFrames;
+        std::mutex queueLock;
+        std::condition_variable queueReady, queueSpace;
+        std::thread encoder;
+        bool encoderStop;
+        MediaRet encoderError;
+        MediaStats stats;
 
         MediaRet setup_common(const char *fname);
         MediaRet setup_video_stream_info(int width, int height, int depth);
@@ -126,6 +160,14 @@ class MediaRecorder
         // flush last frames to avoid
         // "X frames left in the queue on closing"
         void flush_frames();
+        void start_encoder();
+        void stop_encoder();
+        void encode_loop();
+        // slot after the queued frames, there must be a free one
+        QueuedFrame *next_frame();
+        void push_frame();
+        MediaRet encode_video(const uint8_t *vid);
+        MediaRet encode_audio(const uint16_t *aud, int length);
 };
 
 }
@@ -268,6 +268,8 @@ const char *mode;
                         strategy = Z_FILTERED;
                 } else if (*p == 'h') {
                         strategy = Z_HUFFMAN_ONLY;
+                } else if (*p == 'T') {
+                        s->transparent = 1;
                 } else {
                         *m++ = *p; /* copy the mode */
                 }
@@ -275,7 +277,13 @@ const char *mode;
         if (s->mode == '\0')
                 return destroy(s), (gzFile)Z_NULL;
 
-        if (s->mode == 'w') {
+        /* 'T' writes the data uncompressed, memgzread reads it back
+         * through its transparent path */
+        if (s->mode == 'r')
+                s->transparent = 0;
+
+        s->stream.state = Z_NULL;
+        if (s->mode == 'w' && !s->transparent) {
 #ifdef NO_DEFLATE
                 err = Z_STREAM_ERROR;
 #else
@@ -292,7 +300,7 @@ const char *mode;
                 if (err != Z_OK || s->outbuf == Z_NULL) {
                         return destroy(s), (gzFile)Z_NULL;
                 }
-        } else {
+        } else if (s->mode == 'r') {
                 s->stream.next_in = s->inbuf = (Byte *)ALLOC(Z_BUFSIZE);
 
                 err = inflateInit2(&(s->stream), -MAX_WBITS);
@@ -315,7 +323,9 @@ const char *mode;
                 return destroy(s), (gzFile)Z_NULL;
         }
 
-        if (s->mode == 'w') {
+        if (s->mode == 'w' && s->transparent) {
+                s->startpos = 0L;
+        } else if (s->mode == 'w') {
                 /* Write a very simple .gz header:
                  */
                 memPrintf(s->file,
@@ -590,6 +600,11 @@ unsigned len;
         if (s == NULL || s->mode != 'w')
                 return Z_STREAM_ERROR;
 
+        if (s->transparent) {
+                len = (unsigned)memWrite(buf, 1, len, s->file);
+                return (int)len;
+        }
+
         s->stream.next_in = (Bytef *)buf;
         s->stream.avail_in = len;
 
@@ -625,6 +640,9 @@ int flush;
         if (s == NULL || s->mode != 'w')
                 return Z_STREAM_ERROR;
 
+        if (s->transparent)
+                return Z_OK;
+
         s->stream.avail_in = 0; /* should be zero already anyway */
 
         for (;;) {
@@ -700,7 +718,7 @@ int ZEXPORT memgzclose(file) gzFile file;
         if (s == NULL)
                 return Z_STREAM_ERROR;
 
-        if (s->mode == 'w') {
+        if (s->mode == 'w' && !s->transparent) {
 #ifdef NO_DEFLATE
                 return Z_STREAM_ERROR;
 #else
@@ -26,3 +26,11 @@ void xbrz6x32(uint8_t *srcPtr, uint32_t srcPitch, uint8_t * /* deltaPtr */, uint
 {
     xbrz::scale(6, (const uint32_t *)srcPtr, (uint32_t *)dstPtr, width, height, xbrz::ColorFormat::RGB, srcPitch, dstPitch);
 }
+
+// Only rows [first, last) of the picture, which is read around them as a
+// whole, so separate bands come out as the whole picture scaled at once.
+// srcPtr and dstPtr are the top of the pictures.
+void xbrz32Rows(int factor, uint8_t *srcPtr, uint32_t srcPitch, uint8_t *dstPtr, uint32_t dstPitch, int width, int height, int first, int last)
+{
+    xbrz::scale(factor, (const uint32_t *)srcPtr, (uint32_t *)dstPtr, width, height, xbrz::ColorFormat::RGB, srcPitch, dstPitch, xbrz::ScalerCfg(), first, last);
+}
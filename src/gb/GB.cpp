@@ -9,6 +9,9 @@
 #include "../NLS.h"
 #include "../System.h"
 #include "../Util.h"
+#ifndef __LIBRETRO__
+#include "../common/BatteryWriter.h"
+#endif
 #include "../common/ConfigManager.h"
 #include "../gba/GBALink.h"
 #include "../gba/Sound.h"
@@ -23,7 +26,7 @@
 #define _stricmp strcasecmp
 #endif
 
-extern uint8_t* pix;
+extern GBA_LOCAL uint8_t* pix;
 bool gbUpdateSizes();
 bool inBios = false;
 
@@ -2082,6 +2085,19 @@ uint8_t gbReadMemory(uint16_t address)
     return gbMemoryMap[address >> 12][address & 0x0fff];
 }
 
+// Pages of the memory map gbReadMemory() reads straight through, the ROM
+// banks and the work RAM.  Everything else has side effects or checks.
+#define GB_QUICK_READ_PAGES 0x30ff
+
+// Used by the opcode fetch and the instructions, most of which read from
+// ROM or work RAM
+static inline uint8_t gbReadMemoryQuick(uint16_t address)
+{
+    if (((GB_QUICK_READ_PAGES >> (address >> 12)) & 1) && !gbCheatMap[address])
+        return gbMemoryMap[address >> 12][address & 0x0fff];
+    return gbReadMemory(address);
+}
+
 void gbVblank_interrupt()
 {
     gbCheatWrite(false); // Emulates GS codes.
@@ -2862,154 +2878,80 @@ void gbReset()
 }
 
 #ifndef __LIBRETRO__
-void gbWriteSaveMBC1(const char* name)
+static void gbBatteryAppend(std::vector<uint8_t>& image, const void* data, size_t size)
 {
-    if (gbRam) {
-        FILE* gzFile = utilOpenFile(name, "wb");
-
-        if (gzFile == NULL) {
-            systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-            return;
-        }
-
-        fwrite(gbRam,
-            1,
-            (gbRamSizeMask + 1),
-            gzFile);
-
-        fclose(gzFile);
-    }
+    const uint8_t* bytes = (const uint8_t*)data;
+    image.insert(image.end(), bytes, bytes + size);
 }
 
-void gbWriteSaveMBC2(const char* name)
+static bool gbBatteryMBC1(std::vector<uint8_t>& image)
 {
-    if (gbRam) {
-        FILE* file = utilOpenFile(name, "wb");
-
-        if (file == NULL) {
-            systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-            return;
-        }
-
-        fwrite(gbMemoryMap[0x0a],
-            1,
-            512,
-            file);
+    if (!gbRam)
+        return false;
 
-        fclose(file);
-    }
+    gbBatteryAppend(image, gbRam, gbRamSizeMask + 1);
+    return true;
 }
 
-void gbWriteSaveMBC3(const char* name, bool extendedSave)
+static bool gbBatteryMBC2(std::vector<uint8_t>& image)
 {
-    if (gbRam || extendedSave) {
-        FILE* gzFile = utilOpenFile(name, "wb");
-        if (gbRam) {
-
-            if (gzFile == NULL) {
-                systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-                return;
-            }
-
-            fwrite(gbRam,
-                1,
-                (gbRamSizeMask + 1),
-                gzFile);
-        }
-
-        if (extendedSave)
-            fwrite(&gbDataMBC3.mapperSeconds,
-                1,
-                MBC3_RTC_DATA_SIZE,
-                gzFile);
+    if (!gbRam)
+        return false;
 
-        fclose(gzFile);
-    }
+    gbBatteryAppend(image, gbMemoryMap[0x0a], 512);
+    return true;
 }
 
-void gbWriteSaveMBC5(const char* name)
+static bool gbBatteryMBC3(std::vector<uint8_t>& image, bool extendedSave)
 {
-    if (gbRam) {
-        FILE* gzFile = utilOpenFile(name, "wb");
-
-        if (gzFile == NULL) {
-            systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-            return;
-        }
+    if (!gbRam && !extendedSave)
+        return false;
 
-        fwrite(gbRam,
-            1,
-            (gbRamSizeMask + 1),
-            gzFile);
+    if (gbRam)
+        gbBatteryAppend(image, gbRam, gbRamSizeMask + 1);
 
-        fclose(gzFile);
-    }
+    if (extendedSave)
+        gbBatteryAppend(image, &gbDataMBC3.mapperSeconds, MBC3_RTC_DATA_SIZE);
+    return true;
 }
 
-void gbWriteSaveMBC7(const char* name)
+static bool gbBatteryMBC5(std::vector<uint8_t>& image)
 {
-    if (gbRam) {
-        FILE* file = utilOpenFile(name, "wb");
+    if (!gbRam)
+        return false;
 
-        if (file == NULL) {
-            systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-            return;
-        }
+    gbBatteryAppend(image, gbRam, gbRamSizeMask + 1);
+    return true;
+}
 
-        fwrite(&gbMemory[0xa000],
-            1,
-            256,
-            file);
+static bool gbBatteryMBC7(std::vector<uint8_t>& image)
+{
+    if (!gbRam)
+        return false;
 
-        fclose(file);
-    }
+    gbBatteryAppend(image, &gbMemory[0xa000], 256);
+    return true;
 }
 
-void gbWriteSaveTAMA5(const char* name, bool extendedSave)
+static bool gbBatteryTAMA5(std::vector<uint8_t>& image, bool extendedSave)
 {
-    FILE* gzFile = utilOpenFile(name, "wb");
-
-    if (gzFile == NULL) {
-        systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-        return;
-    }
     if (gbRam)
-        fwrite(gbRam,
-            1,
-            (gbRamSizeMask + 1),
-            gzFile);
+        gbBatteryAppend(image, gbRam, gbRamSizeMask + 1);
 
-    fwrite(gbTAMA5ram,
-        1,
-        (gbTAMA5ramSize),
-        gzFile);
+    gbBatteryAppend(image, gbTAMA5ram, gbTAMA5ramSize);
 
     if (extendedSave)
-        fwrite(&gbDataTAMA5.mapperSeconds,
-            1,
-            TAMA5_RTC_DATA_SIZE,
-            gzFile);
-
-    fclose(gzFile);
+        gbBatteryAppend(image, &gbDataTAMA5.mapperSeconds, TAMA5_RTC_DATA_SIZE);
+    return true;
 }
 
-void gbWriteSaveMMM01(const char* name)
+static bool gbBatteryMMM01(std::vector<uint8_t>& image)
 {
-    if (gbRam) {
-        FILE* gzFile = utilOpenFile(name, "wb");
-
-        if (gzFile == NULL) {
-            systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), name);
-            return;
-        }
-
-        fwrite(gbRam,
-            1,
-            (gbRamSizeMask + 1),
-            gzFile);
+    if (!gbRam)
+        return false;
 
-        fclose(gzFile);
-    }
+    gbBatteryAppend(image, gbRam, gbRamSizeMask + 1);
+    return true;
 }
 
 bool gbReadSaveMBC1(const char* name)
@@ -3358,54 +3300,72 @@ void gbInit()
 }
 
 #ifndef __LIBRETRO__
-bool gbWriteBatteryFile(const char* file, bool extendedSave)
+// The battery file as it goes on disk, false if the cartridge has none
+static bool gbBatteryImage(std::vector<uint8_t>& image, bool extendedSave)
 {
-    if (gbBattery) {
-        switch (gbRomType) {
-        case 0x03:
-            gbWriteSaveMBC1(file);
-            break;
-        case 0x06:
-            gbWriteSaveMBC2(file);
-            break;
-        case 0x0d:
-            gbWriteSaveMMM01(file);
-            break;
-        case 0x0f:
-        case 0x10:
-            gbWriteSaveMBC3(file, extendedSave);
-            break;
-        case 0x13:
-        case 0xfc:
-            gbWriteSaveMBC3(file, false);
-            break;
-        case 0x1b:
-        case 0x1e:
-            gbWriteSaveMBC5(file);
-            break;
-        case 0x22:
-            gbWriteSaveMBC7(file);
-            break;
-        case 0xfd:
-            gbWriteSaveTAMA5(file, extendedSave);
-            break;
-        case 0xff:
-            gbWriteSaveMBC1(file);
-            break;
-        }
+    image.clear();
+
+    if (!gbBattery)
+        return false;
+
+    switch (gbRomType) {
+    case 0x03:
+        return gbBatteryMBC1(image);
+    case 0x06:
+        return gbBatteryMBC2(image);
+    case 0x0d:
+        return gbBatteryMMM01(image);
+    case 0x0f:
+    case 0x10:
+        return gbBatteryMBC3(image, extendedSave);
+    case 0x13:
+    case 0xfc:
+        return gbBatteryMBC3(image, false);
+    case 0x1b:
+    case 0x1e:
+        return gbBatteryMBC5(image);
+    case 0x22:
+        return gbBatteryMBC7(image);
+    case 0xfd:
+        return gbBatteryTAMA5(image, extendedSave);
+    case 0xff:
+        return gbBatteryMBC1(image);
     }
-    return true;
+    return false;
 }
 
-bool gbWriteBatteryFile(const char* file)
+bool gbWriteBatteryFile(const char* file, bool extendedSave)
 {
-    if (!gbBatteryError) {
-        gbWriteBatteryFile(file, true);
+    std::vector<uint8_t> image;
+
+    if (!gbBatteryImage(image, extendedSave))
         return true;
-    } else
+
+    bool ok = batteryWriter.write(file, image);
+    return batteryWriter.flush() && ok;
+}
+
+bool gbWriteBatteryFile(const char* file)
+{
+    if (!gbBatteryError)
+        return gbWriteBatteryFile(file, true);
+    else
         return false;
 }
 
+bool gbWriteBatteryFileAsync(const char* file)
+{
+    std::vector<uint8_t> image;
+
+    if (gbBatteryError)
+        return false;
+
+    if (!gbBatteryImage(image, true))
+        return true;
+
+    return batteryWriter.write(file, image);
+}
+
 bool gbReadBatteryFile(const char* file)
 {
     bool res = false;
@@ -3688,9 +3648,9 @@ static bool gbWriteSaveState(gzFile gzFile)
     return true;
 }
 
-bool gbWriteMemSaveState(char* memory, int available, long& reserved)
+static bool gbWriteMemSaveState(char* memory, int available, long& reserved, const char* mode)
 {
-    gzFile gzFile = utilMemGzOpen(memory, available, "w");
+    gzFile gzFile = utilMemGzOpen(memory, available, mode);
 
     if (gzFile == NULL) {
         return false;
@@ -3708,6 +3668,16 @@ bool gbWriteMemSaveState(char* memory, int available, long& reserved)
     return res;
 }
 
+bool gbWriteMemSaveState(char* memory, int available, long& reserved)
+{
+    return gbWriteMemSaveState(memory, available, reserved, "w");
+}
+
+bool gbWriteMemSaveStateRaw(char* memory, int available, long& reserved)
+{
+    return gbWriteMemSaveState(memory, available, reserved, "wT");
+}
+
 bool gbWriteSaveState(const char* name)
 {
     gzFile gzFile = utilGzOpen(name, "wb");
@@ -4673,7 +4643,7 @@ void gbEmulate(int ticksToStop)
             opcode2 = 0;
             execute = true;
 
-            opcode2 = opcode1 = opcode = gbReadMemory(PC.W++);
+            opcode2 = opcode1 = opcode = gbReadMemoryQuick(PC.W++);
 
             // If HALT state was launched while IME = 0 and (register_IF & register_IE & 0x1F),
             // PC.W is not incremented for the first byte of the next instruction.
@@ -4687,7 +4657,7 @@ void gbEmulate(int ticksToStop)
             switch (opcode) {
             case 0xCB:
                 // extended opcode
-                opcode2 = opcode = gbReadMemory(PC.W++);
+                opcode2 = opcode = gbReadMemoryQuick(PC.W++);
                 clockTicks = gbCyclesCB[opcode];
                 break;
             }
@@ -5835,6 +5805,11 @@ bool gbWriteMemSaveState(char*, int, long&)
 	return false;
 }
 
+bool gbWriteMemSaveStateRaw(char*, int, long&)
+{
+    return false;
+}
+
 bool gbReadMemSaveState(char*, int)
 {
     return false;
@@ -5849,6 +5824,11 @@ bool gbWriteBatteryFile(const char*)
 {
     return false;
 }
+
+bool gbWriteBatteryFileAsync(const char*)
+{
+    return false;
+}
 #endif
 
 struct EmulatedSystem GBSystem = {
@@ -5862,6 +5842,8 @@ struct EmulatedSystem GBSystem = {
     gbReadBatteryFile,
     // emuWriteBattery
     gbWriteBatteryFile,
+    // emuWriteBatteryAsync
+    gbWriteBatteryFileAsync,
     // emuReadState
     gbReadSaveState,
     // emuWriteState
@@ -5870,6 +5852,8 @@ struct EmulatedSystem GBSystem = {
     gbReadMemSaveState,
     // emuWriteMemState
     gbWriteMemSaveState,
+    // emuWriteMemStateRaw
+    gbWriteMemSaveStateRaw,
     // emuWritePNG
     gbWritePNGFile,
     // emuWriteBMP
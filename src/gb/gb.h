@@ -45,8 +45,10 @@ bool gbReadSaveState(const char*);
 #endif
 bool gbWriteBatteryFile(const char*);
 bool gbWriteBatteryFile(const char*, bool);
+bool gbWriteBatteryFileAsync(const char*);
 bool gbReadBatteryFile(const char*);
 bool gbWriteMemSaveState(char*, int, long&);
+bool gbWriteMemSaveStateRaw(char*, int, long&);
 bool gbReadMemSaveState(char*, int);
 void gbSgbRenderBorder();
 bool gbWritePNGFile(const char*);
@@ -36,7 +36,7 @@ AF.B.B0 |= ZeroTable[HL.B.B0];
 break;
 case 0x06:
 // RLC (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (tempValue & 0x80) ? GB_C_FLAG : 0;
 tempValue = (tempValue << 1) | (tempValue >> 7);
 AF.B.B0 |= ZeroTable[tempValue];
@@ -86,7 +86,7 @@ AF.B.B0 |= ZeroTable[HL.B.B0];
 break;
 case 0x0e:
 // RRC (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (tempValue & 0x01 ? GB_C_FLAG : 0);
 tempValue = (tempValue >> 1) | (tempValue << 7);
 AF.B.B0 |= ZeroTable[tempValue];
@@ -160,7 +160,7 @@ if (HL.B.B0 & 0x80) {
 break;
 case 0x16:
 // RL (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 if (tempValue & 0x80) {
     tempValue = (tempValue << 1) | (AF.B.B0 & GB_C_FLAG ? 1 : 0);
     AF.B.B0 = ZeroTable[tempValue] | GB_C_FLAG;
@@ -242,7 +242,7 @@ if (HL.B.B0 & 0x01) {
 break;
 case 0x1e:
 // RR (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 if (tempValue & 0x01) {
     tempValue = (tempValue >> 1) | (AF.B.B0 & GB_C_FLAG ? 0x80 : 0);
     AF.B.B0 = ZeroTable[tempValue] | GB_C_FLAG;
@@ -300,7 +300,7 @@ AF.B.B0 |= ZeroTable[HL.B.B0];
 break;
 case 0x26:
 // SLA (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (tempValue & 0x80 ? GB_C_FLAG : 0);
 tempValue <<= 1;
 AF.B.B0 |= ZeroTable[tempValue];
@@ -350,7 +350,7 @@ AF.B.B0 |= ZeroTable[HL.B.B0];
 break;
 case 0x2e:
 // SRA (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (tempValue & 0x01 ? GB_C_FLAG : 0);
 tempValue = (tempValue >> 1) | (tempValue & 0x80);
 AF.B.B0 |= ZeroTable[tempValue];
@@ -394,7 +394,7 @@ AF.B.B0 = ZeroTable[HL.B.B0];
 break;
 case 0x36:
 // SWAP (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue = (tempValue & 0xf0) >> 4 | (tempValue & 0x0f) << 4;
 AF.B.B0 = ZeroTable[tempValue];
 gbWriteMemory(HL.W, tempValue);
@@ -442,7 +442,7 @@ AF.B.B0 |= ZeroTable[HL.B.B0];
 break;
 case 0x3e:
 // SRL (HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (tempValue & 0x01) ? GB_C_FLAG : 0;
 tempValue >>= 1;
 AF.B.B0 |= ZeroTable[tempValue];
@@ -480,7 +480,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 0) ? 0 : GB_Z_FLA
 break;
 case 0x46:
 // BIT 0,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 0) ? 0 : GB_Z_FLAG);
 break;
 case 0x47:
@@ -513,7 +513,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 1) ? 0 : GB_Z_FLA
 break;
 case 0x4e:
 // BIT 1,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 1) ? 0 : GB_Z_FLAG);
 break;
 case 0x4f:
@@ -546,7 +546,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 2) ? 0 : GB_Z_FLA
 break;
 case 0x56:
 // BIT 2,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 2) ? 0 : GB_Z_FLAG);
 break;
 case 0x57:
@@ -579,7 +579,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 3) ? 0 : GB_Z_FLA
 break;
 case 0x5e:
 // BIT 3,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 3) ? 0 : GB_Z_FLAG);
 break;
 case 0x5f:
@@ -612,7 +612,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 4) ? 0 : GB_Z_FLA
 break;
 case 0x66:
 // BIT 4,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 4) ? 0 : GB_Z_FLAG);
 break;
 case 0x67:
@@ -645,7 +645,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 5) ? 0 : GB_Z_FLA
 break;
 case 0x6e:
 // BIT 5,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 5) ? 0 : GB_Z_FLAG);
 break;
 case 0x6f:
@@ -678,7 +678,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 6) ? 0 : GB_Z_FLA
 break;
 case 0x76:
 // BIT 6,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 6) ? 0 : GB_Z_FLAG);
 break;
 case 0x77:
@@ -711,7 +711,7 @@ AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (HL.B.B0 & (1 << 7) ? 0 : GB_Z_FLA
 break;
 case 0x7e:
 // BIT 7,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 AF.B.B0 = (AF.B.B0 & GB_C_FLAG) | GB_H_FLAG | (tempValue & (1 << 7) ? 0 : GB_Z_FLAG);
 break;
 case 0x7f:
@@ -744,7 +744,7 @@ HL.B.B0 &= ~(1 << 0);
 break;
 case 0x86:
 // RES 0,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 0);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -778,7 +778,7 @@ HL.B.B0 &= ~(1 << 1);
 break;
 case 0x8e:
 // RES 1,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 1);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -812,7 +812,7 @@ HL.B.B0 &= ~(1 << 2);
 break;
 case 0x96:
 // RES 2,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 2);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -846,7 +846,7 @@ HL.B.B0 &= ~(1 << 3);
 break;
 case 0x9e:
 // RES 3,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 3);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -880,7 +880,7 @@ HL.B.B0 &= ~(1 << 4);
 break;
 case 0xa6:
 // RES 4,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 4);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -914,7 +914,7 @@ HL.B.B0 &= ~(1 << 5);
 break;
 case 0xae:
 // RES 5,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 5);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -948,7 +948,7 @@ HL.B.B0 &= ~(1 << 6);
 break;
 case 0xb6:
 // RES 6,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 6);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -982,7 +982,7 @@ HL.B.B0 &= ~(1 << 7);
 break;
 case 0xbe:
 // RES 7,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue &= ~(1 << 7);
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1016,7 +1016,7 @@ HL.B.B0 |= 1 << 0;
 break;
 case 0xc6:
 // SET 0,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 0;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1050,7 +1050,7 @@ HL.B.B0 |= 1 << 1;
 break;
 case 0xce:
 // SET 1,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 1;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1084,7 +1084,7 @@ HL.B.B0 |= 1 << 2;
 break;
 case 0xd6:
 // SET 2,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 2;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1118,7 +1118,7 @@ HL.B.B0 |= 1 << 3;
 break;
 case 0xde:
 // SET 3,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 3;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1152,7 +1152,7 @@ HL.B.B0 |= 1 << 4;
 break;
 case 0xe6:
 // SET 4,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 4;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1186,7 +1186,7 @@ HL.B.B0 |= 1 << 5;
 break;
 case 0xee:
 // SET 5,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 5;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1220,7 +1220,7 @@ HL.B.B0 |= 1 << 6;
 break;
 case 0xf6:
 // SET 6,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 6;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1254,7 +1254,7 @@ HL.B.B0 |= 1 << 7;
 break;
 case 0xfe:
 // SET 7,(HL)
-tempValue = gbReadMemory(HL.W);
+tempValue = gbReadMemoryQuick(HL.W);
 tempValue |= 1 << 7;
 gbWriteMemory(HL.W, tempValue);
 break;
@@ -1264,7 +1264,7 @@ AF.B.B1 |= 1 << 7;
 break;
 default:
 if (gbSystemMessage == false) {
-    systemMessage(0, N_("Unknown opcode %02x at %04x"), gbReadMemory(PC.W - 1), PC.W - 1);
+    systemMessage(0, N_("Unknown opcode %02x at %04x"), gbReadMemoryQuick(PC.W - 1), PC.W - 1);
     gbSystemMessage = true;
 }
 return;
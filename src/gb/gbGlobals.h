@@ -9,7 +9,7 @@ extern int gbRamSize;
 extern int gbRamSizeMask;
 extern int gbTAMA5ramSize;
 
-extern uint8_t* bios;
+extern GBA_LOCAL uint8_t* bios;
 
 extern uint8_t* gbRom;
 extern uint8_t* gbRam;
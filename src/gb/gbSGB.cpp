@@ -7,7 +7,7 @@
 #include "gb.h"
 #include "gbGlobals.h"
 
-extern uint8_t* pix;
+extern GBA_LOCAL uint8_t* pix;
 extern bool speedup;
 extern bool gbSgbResetFlag;
 
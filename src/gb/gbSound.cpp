@@ -19,6 +19,7 @@ static Gb_Apu* gb_apu;
 
 static float soundVolume_ = -1;
 static int prevSoundEnable = -1;
+static bool synthesizing = true; // channels are connected
 static bool declicking = false;
 
 int const chan_count = 4;
@@ -43,12 +44,19 @@ void gbSoundEvent(int st, uint16_t address, int data)
 static void end_frame(blip_time_t time)
 {
     gb_apu->end_frame(time);
-    stereo_buffer->end_frame(time);
+
+    // nothing was added to it with the channels disconnected
+    if (synthesizing)
+        stereo_buffer->end_frame(time);
 }
 
 static void apply_effects()
 {
     prevSoundEnable = soundGetEnable();
+    if (synthesizing != soundSynthesizing()) {
+        synthesizing = soundSynthesizing();
+        stereo_buffer->clear();
+    }
     gb_effects_config_current = gb_effects_config;
 
     stereo_buffer->config().enabled = gb_effects_config_current.enabled;
@@ -59,7 +67,7 @@ static void apply_effects()
 
     for (int i = 0; i < chan_count; i++) {
         Multi_Buffer::channel_t ch = { 0, 0, 0 };
-        if (prevSoundEnable >> i & 1)
+        if (synthesizing && (prevSoundEnable >> i & 1))
             ch = stereo_buffer->channel(i);
         gb_apu->set_output(ch.center, ch.left, ch.right, i);
     }
@@ -84,12 +92,14 @@ void gbSoundTick(int st)
         // Run sound hardware to present
         end_frame((blip_time_t)(st * ticks_to_time));
 
-        flush_samples(stereo_buffer);
+        if (synthesizing)
+            flush_samples(stereo_buffer);
 
         // Update effects config if it was changed
         if (memcmp(&gb_effects_config_current, &gb_effects_config,
                 sizeof gb_effects_config)
-            || soundGetEnable() != prevSoundEnable)
+            || soundGetEnable() != prevSoundEnable
+            || soundSynthesizing() != synthesizing)
             apply_effects();
 
         if (soundVolume_ != soundGetVolume())
@@ -101,6 +101,7 @@ sw, sword, int32_t, int                 --> signed word
 #include <string.h>
 
 #include "BreakpointStructures.h"
+#include "CodeCache.h"
 #include "remote.h"
 
 #if (defined __WIN32__ || defined _WIN32)
@@ -151,11 +152,21 @@ struct intToString compareFlagMapping[] = {
 //case 'r':	flag = 0x2;	break; // mem read
 //case 'w':	flag = 0x1;	break; // mem write
 //case 'i':	flag = 0x3;	break;
+bool hasConditionalBreaks()
+{
+    for (int i = 0; i < 16; i++) {
+        if (conditionals[i])
+            return true;
+    }
+    return false;
+}
+
 struct ConditionalBreak* addConditionalBreak(uint32_t address, uint8_t flag)
 {
     uint8_t condIndex = address >> 24;
     struct ConditionalBreak* cond = NULL;
     BreakSet((&map[condIndex])->breakPoints, address & (&map[condIndex])->mask, ((flag & 0xf) | (flag >> 4)));
+    codeCacheInvalidate(address);
     if (flag & 0xf0) {
         struct ConditionalBreak* base = conditionals[condIndex];
         struct ConditionalBreak* prev = conditionals[condIndex];
@@ -406,6 +417,7 @@ void recountFlagsForAddress(uint32_t address)
             } else {
                 BreakClear((&map[address >> 24])->breakPoints, address & (&map[address >> 24])->mask, 0xff);
                 BreakSet((&map[address >> 24])->breakPoints, address & (&map[address >> 24])->mask, ((flags >> 4) | (flags & 0x8)));
+                codeCacheInvalidate(address);
                 return;
             }
             base = base->next;
@@ -413,6 +425,7 @@ void recountFlagsForAddress(uint32_t address)
     }
     BreakClear((&map[address >> 24])->breakPoints, address & (&map[address >> 24])->mask, 0xff);
     BreakSet((&map[address >> 24])->breakPoints, address & (&map[address >> 24])->mask, ((flags >> 4) | (flags & 0x8)));
+    codeCacheInvalidate(address);
 }
 
 //Removers
@@ -37,6 +37,8 @@ extern struct ConditionalBreak* conditionals[16];
 // case 'w':	flag = 0x1;	break; // mem write
 // case 'i':	flag = 0x3;	break;
 struct ConditionalBreak* addConditionalBreak(uint32_t address, uint8_t flag);
+// true while any break is set, lets the CPU skip the per-instruction checks
+bool hasConditionalBreaks();
 
 int removeConditionalBreakNo(uint32_t address, uint8_t number);
 int removeFlagFromConditionalBreakNo(uint32_t address, uint8_t number, uint8_t flag);
@@ -2,6 +2,7 @@
 #include <memory.h>
 #include <stdio.h>
 #include <string.h>
+#include <vector>
 
 #include "../NLS.h"
 #include "../Util.h"
@@ -178,28 +179,28 @@
 #define CHEATS_16_BIT_WRITE 114
 #define CHEATS_32_BIT_WRITE 115
 
-CheatsData cheatsList[MAX_CHEATS];
-int cheatsNumber = 0;
-uint32_t rompatch2addr[4];
-uint16_t rompatch2val[4];
-uint16_t rompatch2oldval[4];
-
-uint8_t cheatsCBASeedBuffer[0x30];
-uint32_t cheatsCBASeed[4];
-uint32_t cheatsCBATemporaryValue = 0;
-uint16_t cheatsCBATable[256];
-bool cheatsCBATableGenerated = false;
-uint16_t super = 0;
-extern uint32_t mastercode;
-
-uint8_t cheatsCBACurrentSeed[12] = {
+GBA_LOCAL CheatsData cheatsList[MAX_CHEATS];
+GBA_LOCAL int cheatsNumber = 0;
+GBA_LOCAL uint32_t rompatch2addr[4];
+GBA_LOCAL uint16_t rompatch2val[4];
+GBA_LOCAL uint16_t rompatch2oldval[4];
+
+GBA_LOCAL uint8_t cheatsCBASeedBuffer[0x30];
+GBA_LOCAL uint32_t cheatsCBASeed[4];
+GBA_LOCAL uint32_t cheatsCBATemporaryValue = 0;
+GBA_LOCAL uint16_t cheatsCBATable[256];
+GBA_LOCAL bool cheatsCBATableGenerated = false;
+GBA_LOCAL uint16_t super = 0;
+extern GBA_LOCAL uint32_t mastercode;
+
+GBA_LOCAL uint8_t cheatsCBACurrentSeed[12] = {
     0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00
 };
 
-uint32_t seeds_v1[4];
-uint32_t seeds_v3[4];
+GBA_LOCAL uint32_t seeds_v1[4];
+GBA_LOCAL uint32_t seeds_v3[4];
 
 uint32_t seed_gen(uint8_t upper, uint8_t seed, uint8_t* deadtable1, uint8_t* deadtable2);
 
@@ -288,22 +289,40 @@ uint8_t v3_deadtable2[256] = {
 #define debuggerReadByte(addr) \
     map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask]
 
-#define debuggerWriteMemory(addr, value) \
-    WRITE32LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value)
-
-#define debuggerWriteHalfWord(addr, value) \
-    WRITE16LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value)
-
-#define debuggerWriteByte(addr, value) \
-    map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value)
+#define debuggerWriteMemory(addr, value)                                             \
+    do {                                                                             \
+        codeCacheInvalidate(addr);                                                   \
+        tileCacheInvalidate(addr);                                                   \
+        WRITE32LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value); \
+    } while (0)
+
+#define debuggerWriteHalfWord(addr, value)                                           \
+    do {                                                                             \
+        codeCacheInvalidate(addr);                                                   \
+        tileCacheInvalidate(addr);                                                   \
+        WRITE16LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value); \
+    } while (0)
+
+#define debuggerWriteByte(addr, value)                                      \
+    do {                                                                    \
+        codeCacheInvalidate(addr);                                          \
+        tileCacheInvalidate(addr);                                          \
+        map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value); \
+    } while (0)
 
 #define CHEAT_IS_HEX(a) (((a) >= 'A' && (a) <= 'F') || ((a) >= '0' && (a) <= '9'))
 
-#define CHEAT_PATCH_ROM_16BIT(a, v) \
-    WRITE16LE(((uint16_t*)&rom[(a)&0x1ffffff]), v);
+#define CHEAT_PATCH_ROM_16BIT(a, v)                        \
+    do {                                                   \
+        WRITE16LE(((uint16_t*)&rom[(a)&0x1ffffff]), v);    \
+        codeCacheInvalidate(0x08000000 | ((a)&0x1ffffff)); \
+    } while (0)
 
-#define CHEAT_PATCH_ROM_32BIT(a, v) \
-    WRITE32LE(((uint32_t*)&rom[(a)&0x1ffffff]), v);
+#define CHEAT_PATCH_ROM_32BIT(a, v)                        \
+    do {                                                   \
+        WRITE32LE(((uint32_t*)&rom[(a)&0x1ffffff]), v);    \
+        codeCacheInvalidate(0x08000000 | ((a)&0x1ffffff)); \
+    } while (0)
 
 static bool isMultilineWithData(int i)
 {
@@ -563,6 +582,465 @@ static int getCodeLength(int num)
     return 1;
 }
 
+// Compiled cheat list
+//
+// cheatsCheckKeys() runs once a frame, or at every master code hit, so the
+// list is compiled into one CheatOp per entry whenever it changes.  The
+// opcodes are reduced to a few operations, the data lines multi-line codes
+// read are folded into their first line, and values are masked ahead of
+// time.  Entries keep their position, so skips still count list entries
+// and a list behaves exactly as it did when it was interpreted.  A data
+// line missing at the end of the list makes its code do nothing.
+
+enum {
+    // run whether or not a conditional code turned the others off
+    CHEAT_OP_NONE,
+    CHEAT_OP_CODES_ON,
+    CHEAT_OP_SLOWDOWN,
+    CHEAT_OP_SLIDE,
+    CHEAT_OP_GS_WRITE2,
+    CHEAT_OP_ROM_PATCH,
+    CHEAT_OP_ROM_PATCH2,
+    CHEAT_OP_MASTER,
+    // only run while the codes are on
+    CHEAT_OP_WRITE,
+    CHEAT_OP_GS_WRITE,
+    CHEAT_OP_ROM_WRITE,
+    CHEAT_OP_IF,
+    CHEAT_OP_IF_CODES,
+    CHEAT_OP_IF_KEYS,
+    CHEAT_OP_SKIP,
+    CHEAT_OP_CBA_SLIDE,
+    CHEAT_OP_AND,
+    CHEAT_OP_OR,
+    CHEAT_OP_ADD,
+    CHEAT_OP_GSA_ADD,
+    CHEAT_OP_FILL,
+    CHEAT_OP_BYTES,
+    CHEAT_OP_POINTER,
+    CHEAT_OP_IO,
+    CHEAT_OP_GROUP
+};
+
+// comparisons of CHEAT_OP_IF and CHEAT_OP_IF_CODES, the following codes
+// run when they hold
+enum {
+    CHEAT_IF_EQ,
+    CHEAT_IF_NE,
+    CHEAT_IF_LT,
+    CHEAT_IF_GT,
+    CHEAT_IF_LE,
+    CHEAT_IF_GE,
+    CHEAT_IF_AND,
+    CHEAT_IF_LT_S,
+    CHEAT_IF_GT_S
+};
+
+// what a failed condition skips
+#define CHEAT_SKIP_CODES 0 // every code up to the next GSA_CODES_ON
+#define CHEAT_SKIP_LINES 3 // a count of lines given by the code
+
+#define CHEAT_NO_IO 0xFFFFFFFF
+
+struct CheatOp {
+    uint8_t op;
+    uint8_t width;
+    // CHEAT_IF_*, or the key test of CHEAT_OP_IF_KEYS
+    uint8_t cond;
+    bool enabled;
+    // list entries a disabled code covers
+    uint32_t length;
+    // entries skipped once the code ran, or when its condition failed
+    uint32_t skip;
+    uint32_t address;
+    uint32_t value;
+    // value added between the writes of slides, second byte of CHEAT_OP_IO
+    uint32_t inc;
+    // address added between the writes of slides and fills
+    uint32_t step;
+    // writes of slides and fills, CHEAT_OP_BYTES and CHEAT_OP_GROUP data
+    // count, ROM patch register, second offset of CHEAT_OP_IO
+    uint32_t count;
+    // first entry of the data of CHEAT_OP_BYTES and CHEAT_OP_GROUP
+    uint32_t data;
+};
+
+struct CheatIfCode {
+    int size;
+    uint8_t width;
+    uint8_t cond;
+    uint8_t skip;
+    // the value is masked to the width
+    bool masked;
+};
+
+static const CheatIfCode cheatsIfCodes[] = {
+    { CBA_IF_TRUE, 2, CHEAT_IF_EQ, 1, false },
+    { CBA_IF_FALSE, 2, CHEAT_IF_NE, 1, false },
+    { CBA_GT, 2, CHEAT_IF_GT, 1, false },
+    { CBA_LT, 2, CHEAT_IF_LT, 1, false },
+    { GSA_8_BIT_IF_TRUE, 1, CHEAT_IF_EQ, 1, false },
+    { GSA_32_BIT_IF_TRUE, 4, CHEAT_IF_EQ, 1, false },
+    { GSA_8_BIT_IF_FALSE, 1, CHEAT_IF_NE, 1, false },
+    { GSA_32_BIT_IF_FALSE, 4, CHEAT_IF_NE, 1, false },
+    { GSA_8_BIT_IF_TRUE2, 1, CHEAT_IF_EQ, 2, false },
+    { GSA_16_BIT_IF_TRUE2, 2, CHEAT_IF_EQ, 2, false },
+    { GSA_32_BIT_IF_TRUE2, 4, CHEAT_IF_EQ, 2, false },
+    { GSA_8_BIT_IF_FALSE2, 1, CHEAT_IF_NE, 2, false },
+    { GSA_16_BIT_IF_FALSE2, 2, CHEAT_IF_NE, 2, false },
+    { GSA_32_BIT_IF_FALSE2, 4, CHEAT_IF_NE, 2, false },
+    { GSA_8_BIT_IF_TRUE3, 1, CHEAT_IF_EQ, CHEAT_SKIP_CODES, false },
+    { GSA_16_BIT_IF_TRUE3, 2, CHEAT_IF_EQ, CHEAT_SKIP_CODES, false },
+    { GSA_32_BIT_IF_TRUE3, 4, CHEAT_IF_EQ, CHEAT_SKIP_CODES, false },
+    { GSA_8_BIT_IF_FALSE3, 1, CHEAT_IF_NE, CHEAT_SKIP_CODES, false },
+    { GSA_16_BIT_IF_FALSE3, 2, CHEAT_IF_NE, CHEAT_SKIP_CODES, false },
+    { GSA_32_BIT_IF_FALSE3, 4, CHEAT_IF_NE, CHEAT_SKIP_CODES, false },
+    { GSA_8_BIT_IF_LOWER_U, 1, CHEAT_IF_LT, 1, true },
+    { GSA_16_BIT_IF_LOWER_U, 2, CHEAT_IF_LT, 1, true },
+    { GSA_32_BIT_IF_LOWER_U, 4, CHEAT_IF_LT, 1, true },
+    { GSA_8_BIT_IF_HIGHER_U, 1, CHEAT_IF_GT, 1, true },
+    { GSA_16_BIT_IF_HIGHER_U, 2, CHEAT_IF_GT, 1, true },
+    { GSA_32_BIT_IF_HIGHER_U, 4, CHEAT_IF_GT, 1, true },
+    { GSA_8_BIT_IF_AND, 1, CHEAT_IF_AND, 1, true },
+    { GSA_16_BIT_IF_AND, 2, CHEAT_IF_AND, 1, true },
+    { GSA_32_BIT_IF_AND, 4, CHEAT_IF_AND, 1, true },
+    { GSA_8_BIT_IF_LOWER_U2, 1, CHEAT_IF_LT, 2, true },
+    { GSA_16_BIT_IF_LOWER_U2, 2, CHEAT_IF_LT, 2, true },
+    { GSA_32_BIT_IF_LOWER_U2, 4, CHEAT_IF_LT, 2, true },
+    { GSA_8_BIT_IF_HIGHER_U2, 1, CHEAT_IF_GT, 2, true },
+    { GSA_16_BIT_IF_HIGHER_U2, 2, CHEAT_IF_GT, 2, true },
+    { GSA_32_BIT_IF_HIGHER_U2, 4, CHEAT_IF_GT, 2, true },
+    { GSA_8_BIT_IF_AND2, 1, CHEAT_IF_AND, 2, true },
+    { GSA_16_BIT_IF_AND2, 2, CHEAT_IF_AND, 2, true },
+    { GSA_32_BIT_IF_AND2, 4, CHEAT_IF_AND, 2, true },
+    { GSA_8_BIT_IF_LOWER_U3, 1, CHEAT_IF_LT, CHEAT_SKIP_CODES, true },
+    { GSA_16_BIT_IF_LOWER_U3, 2, CHEAT_IF_LT, CHEAT_SKIP_CODES, true },
+    { GSA_32_BIT_IF_LOWER_U3, 4, CHEAT_IF_LT, CHEAT_SKIP_CODES, true },
+    { GSA_8_BIT_IF_HIGHER_U3, 1, CHEAT_IF_GT, CHEAT_SKIP_CODES, true },
+    { GSA_16_BIT_IF_HIGHER_U3, 2, CHEAT_IF_GT, CHEAT_SKIP_CODES, true },
+    { GSA_32_BIT_IF_HIGHER_U3, 4, CHEAT_IF_GT, CHEAT_SKIP_CODES, true },
+    { GSA_8_BIT_IF_AND3, 1, CHEAT_IF_AND, CHEAT_SKIP_CODES, true },
+    { GSA_16_BIT_IF_AND3, 2, CHEAT_IF_AND, CHEAT_SKIP_CODES, true },
+    { GSA_32_BIT_IF_AND3, 4, CHEAT_IF_AND, CHEAT_SKIP_CODES, true },
+    { GSA_ALWAYS3, 4, CHEAT_IF_AND, CHEAT_SKIP_CODES, false },
+    { GSA_8_BIT_IF_LOWER_S, 1, CHEAT_IF_LT_S, 1, true },
+    { GSA_16_BIT_IF_LOWER_S, 2, CHEAT_IF_LT_S, 1, true },
+    { GSA_32_BIT_IF_LOWER_S, 4, CHEAT_IF_LT_S, 1, true },
+    { GSA_8_BIT_IF_HIGHER_S, 1, CHEAT_IF_GT_S, 1, true },
+    { GSA_16_BIT_IF_HIGHER_S, 2, CHEAT_IF_GT_S, 1, true },
+    { GSA_32_BIT_IF_HIGHER_S, 4, CHEAT_IF_GT_S, 1, true },
+    { GSA_8_BIT_IF_LOWER_S2, 1, CHEAT_IF_LT_S, 2, true },
+    { GSA_16_BIT_IF_LOWER_S2, 2, CHEAT_IF_LT_S, 2, true },
+    { GSA_32_BIT_IF_LOWER_S2, 4, CHEAT_IF_LT_S, 2, true },
+    { GSA_8_BIT_IF_HIGHER_S2, 1, CHEAT_IF_GT_S, 2, true },
+    { GSA_16_BIT_IF_HIGHER_S2, 2, CHEAT_IF_GT_S, 2, true },
+    { GSA_32_BIT_IF_HIGHER_S2, 4, CHEAT_IF_GT_S, 2, true },
+    { GSA_8_BIT_IF_LOWER_S3, 1, CHEAT_IF_LT_S, CHEAT_SKIP_CODES, true },
+    { GSA_16_BIT_IF_LOWER_S3, 2, CHEAT_IF_LT_S, CHEAT_SKIP_CODES, true },
+    { GSA_32_BIT_IF_LOWER_S3, 4, CHEAT_IF_LT_S, CHEAT_SKIP_CODES, true },
+    { GSA_8_BIT_IF_HIGHER_S3, 1, CHEAT_IF_GT_S, CHEAT_SKIP_CODES, true },
+    { GSA_16_BIT_IF_HIGHER_S3, 2, CHEAT_IF_GT_S, CHEAT_SKIP_CODES, true },
+    { GSA_32_BIT_IF_HIGHER_S3, 4, CHEAT_IF_GT_S, CHEAT_SKIP_CODES, true },
+    { GSA_16_BIT_IF_LOWER_OR_EQ_U, 2, CHEAT_IF_LE, 1, false },
+    { GSA_16_BIT_IF_HIGHER_OR_EQ_U, 2, CHEAT_IF_GE, 1, false },
+    { GSA_16_BIT_MIF_TRUE, 2, CHEAT_IF_EQ, CHEAT_SKIP_LINES, false },
+    { GSA_16_BIT_MIF_FALSE, 2, CHEAT_IF_NE, CHEAT_SKIP_LINES, false },
+    { GSA_16_BIT_MIF_LOWER_OR_EQ_U, 2, CHEAT_IF_LE, CHEAT_SKIP_LINES, false },
+    { GSA_16_BIT_MIF_HIGHER_OR_EQ_U, 2, CHEAT_IF_GE, CHEAT_SKIP_LINES, false }
+};
+
+// one op more than there are entries, which codes running past the end
+// of the list land on
+static GBA_LOCAL std::vector<CheatOp> cheatsProgram;
+static GBA_LOCAL std::vector<uint32_t> cheatsProgramData;
+static GBA_LOCAL bool cheatsProgramDirty = true;
+
+static inline uint32_t cheatsRead(int width, uint32_t address)
+{
+    if (width == 1)
+        return CPUReadByte(address);
+    if (width == 2)
+        return CPUReadHalfWord(address);
+    return CPUReadMemory(address);
+}
+
+static inline void cheatsWrite(int width, uint32_t address, uint32_t value)
+{
+    if (width == 1)
+        CPUWriteByte(address, value);
+    else if (width == 2)
+        CPUWriteHalfWord(address, value);
+    else
+        CPUWriteMemory(address, value);
+}
+
+static inline uint32_t cheatsWidthMask(int width)
+{
+    return width == 4 ? 0xFFFFFFFF : (1u << (8 * width)) - 1;
+}
+
+// entries past the list are still read like the interpreter did
+static const CheatsData& cheatsEntry(int i)
+{
+    static const CheatsData none = CheatsData();
+    return i < MAX_CHEATS ? cheatsList[i] : none;
+}
+
+static void cheatsCompileEntry(int i, CheatOp& op)
+{
+    const CheatsData& code = cheatsList[i];
+    // the data line of two line codes, if there is one
+    bool data = i + 1 < cheatsNumber;
+    const CheatsData& next = cheatsEntry(i + 1);
+
+    memset(&op, 0, sizeof(op));
+    op.enabled = code.enabled;
+    op.length = getCodeLength(i);
+    op.address = code.address;
+    op.value = code.value;
+
+    switch (code.size) {
+    case GSA_CODES_ON:
+        op.op = CHEAT_OP_CODES_ON;
+        return;
+    case GSA_SLOWDOWN:
+        op.op = CHEAT_OP_SLOWDOWN;
+        op.value = (code.value & 0xFFFF) * 7;
+        return;
+    case GSA_8_BIT_SLIDE:
+    case GSA_16_BIT_SLIDE:
+    case GSA_32_BIT_SLIDE:
+        op.op = CHEAT_OP_SLIDE;
+        op.width = code.size == GSA_8_BIT_SLIDE ? 1 : code.size == GSA_16_BIT_SLIDE ? 2 : 4;
+        op.address = code.value;
+        if (data) {
+            op.value = next.rawaddress;
+            op.inc = (next.value >> 24) & 255;
+            op.count = (next.value >> 16) & 255;
+            op.step = (next.value & 0xffff) * op.width;
+        }
+        return;
+    case GSA_8_BIT_GS_WRITE2:
+    case GSA_16_BIT_GS_WRITE2:
+    case GSA_32_BIT_GS_WRITE2:
+        op.op = CHEAT_OP_GS_WRITE2;
+        op.width = code.size == GSA_8_BIT_GS_WRITE2 ? 1 : code.size == GSA_16_BIT_GS_WRITE2 ? 2 : 4;
+        op.address = code.value;
+        op.value = next.address;
+        op.count = data;
+        return;
+    case GSA_16_BIT_ROM_PATCH:
+        op.op = CHEAT_OP_ROM_PATCH;
+        return;
+    case GSA_16_BIT_ROM_PATCH2C:
+    case GSA_16_BIT_ROM_PATCH2D:
+    case GSA_16_BIT_ROM_PATCH2E:
+    case GSA_16_BIT_ROM_PATCH2F:
+        op.op = data ? CHEAT_OP_ROM_PATCH2 : CHEAT_OP_SLIDE;
+        op.count = code.size == GSA_16_BIT_ROM_PATCH2C ? 0 : code.size == GSA_16_BIT_ROM_PATCH2D ? 1 : code.size == GSA_16_BIT_ROM_PATCH2E ? 2 : 3;
+        op.address = ((code.value & 0x00FFFFFF) << 1) + 0x8000000;
+        op.value = next.rawaddress & 0xFFFF;
+        return;
+    case MASTER_CODE:
+        op.op = CHEAT_OP_MASTER;
+        return;
+
+    case INT_8_BIT_WRITE:
+    case INT_16_BIT_WRITE:
+    case INT_32_BIT_WRITE:
+        op.op = CHEAT_OP_WRITE;
+        op.width = 1 << (code.size - INT_8_BIT_WRITE);
+        return;
+    case GSA_8_BIT_GS_WRITE:
+    case GSA_16_BIT_GS_WRITE:
+    case GSA_32_BIT_GS_WRITE:
+        op.op = CHEAT_OP_GS_WRITE;
+        op.width = 1 << (code.size - GSA_8_BIT_GS_WRITE);
+        return;
+    case CHEATS_16_BIT_WRITE:
+    case CHEATS_32_BIT_WRITE:
+        op.op = (code.address >> 24) >= 0x08 ? CHEAT_OP_ROM_WRITE : CHEAT_OP_WRITE;
+        op.width = code.size == CHEATS_16_BIT_WRITE ? 2 : 4;
+        return;
+    case CBA_IF_KEYS_PRESSED:
+        op.op = CHEAT_OP_IF_KEYS;
+        op.cond = (code.address & 0xF0) >> 4;
+        op.value = code.value & 0xFFFF;
+        return;
+    case GSA_ALWAYS:
+    case GSA_ALWAYS2:
+        op.op = CHEAT_OP_SKIP;
+        op.skip = code.size == GSA_ALWAYS ? 1 : 2;
+        return;
+    case CBA_SLIDE_CODE:
+        op.op = CHEAT_OP_CBA_SLIDE;
+        op.width = 2;
+        op.value = code.value & 0xFFFF;
+        op.skip = 1;
+        if (data) {
+            op.count = ((next.address - 1) & 0xFFFF) + 1;
+            op.inc = (next.address >> 16) & 0xFFFF;
+            op.step = next.value;
+        }
+        return;
+    case CBA_AND:
+    case CBA_OR:
+        op.op = code.size == CBA_AND ? CHEAT_OP_AND : CHEAT_OP_OR;
+        op.width = 2;
+        return;
+    case CBA_ADD:
+        op.op = CHEAT_OP_ADD;
+        op.width = (code.address & 1) ? 4 : 2;
+        if (code.address & 1)
+            op.address = code.address & 0x0FFFFFFE;
+        return;
+    case GSA_32_BIT_ADD2:
+    case GSA_32_BIT_SUB2:
+        op.op = CHEAT_OP_ADD;
+        op.width = 4;
+        op.address = code.value;
+        op.value = code.size == GSA_32_BIT_ADD2 ? next.rawaddress : 0 - next.rawaddress;
+        op.skip = 1;
+        return;
+    case GSA_8_BIT_ADD:
+    case GSA_16_BIT_ADD:
+    case GSA_32_BIT_ADD:
+        op.op = CHEAT_OP_GSA_ADD;
+        op.width = 1 << (code.size - GSA_8_BIT_ADD);
+        op.value = code.value & cheatsWidthMask(op.width);
+        return;
+    case GSA_8_BIT_FILL:
+    case GSA_16_BIT_FILL: {
+        op.op = CHEAT_OP_FILL;
+        op.width = code.size == GSA_8_BIT_FILL ? 1 : 2;
+        op.value = code.value & cheatsWidthMask(op.width);
+        op.step = op.width;
+        uint32_t end = code.address + (op.width == 1 ? code.value >> 8 : (code.value >> 16) << 1);
+        op.count = end >= code.address ? (end - code.address) / op.step + 1 : 1;
+    }
+        return;
+    case CBA_SUPER: {
+        // the bytes come from the following lines, six of them a line
+        op.op = CHEAT_OP_BYTES;
+        op.count = 2 * ((code.value - 1) & 0xFFFF) + 2;
+        op.skip = (op.count - 1) / 6 + 1;
+        op.data = (uint32_t)cheatsProgramData.size();
+        for (uint32_t x = 0; x < op.count; x++) {
+            const CheatsData& line = cheatsEntry(i + 1 + x / 6);
+            int res = x % 6;
+            if (res < 4)
+                cheatsProgramData.push_back((line.address >> (24 - 8 * res)) & 0xFF);
+            else
+                cheatsProgramData.push_back((line.value >> (8 - 8 * (res - 4))) & 0xFF);
+        }
+    }
+        return;
+    case GSA_8_BIT_POINTER:
+        op.op = CHEAT_OP_POINTER;
+        op.width = 1;
+        op.step = (code.value & 0xFFFFFF00) >> 8;
+        op.value = code.value & 0xFF;
+        return;
+    case GSA_16_BIT_POINTER:
+        op.op = CHEAT_OP_POINTER;
+        op.width = 2;
+        op.step = (code.value & 0xFFFF0000) >> 15;
+        op.value = code.value & 0xFFFF;
+        return;
+    case GSA_32_BIT_POINTER:
+        op.op = CHEAT_OP_POINTER;
+        op.width = 4;
+        return;
+    case GSA_16_BIT_WRITE_IOREGS:
+        op.op = CHEAT_OP_IO;
+        op.address = CHEAT_NO_IO;
+        op.count = CHEAT_NO_IO;
+        if ((code.address <= 0x3FF) && (code.address != 0x6) && (code.address != 0x130))
+            op.address = code.address & 0x3FE;
+        op.value = code.value & 0xFF;
+        return;
+    case GSA_32_BIT_WRITE_IOREGS: {
+        uint32_t base = code.address & 0x3FC;
+        op.op = CHEAT_OP_IO;
+        op.address = CHEAT_NO_IO;
+        op.count = CHEAT_NO_IO;
+        if (code.address <= 0x3FF) {
+            if (base != 0x6 && base != 0x130)
+                op.address = base;
+            if (base + 2 != 0x6 && base + 2 != 0x130)
+                op.count = base + 2;
+        }
+        op.value = code.value & 0xFF;
+        op.inc = (code.value >> 16) & 0xFF;
+    }
+        return;
+    case GSA_GROUP_WRITE: {
+        // the value goes to every address of the following lines
+        op.op = CHEAT_OP_GROUP;
+        op.count = (code.address & 0xFFFE) + 1;
+        op.skip = (op.count - 1) / 2;
+        op.data = (uint32_t)cheatsProgramData.size();
+        for (uint32_t x = 1; x <= op.count; x++) {
+            const CheatsData& line = cheatsEntry(i + x / 2);
+            cheatsProgramData.push_back((x % 2) ? line.value : line.rawaddress);
+        }
+    }
+        return;
+    }
+
+    for (size_t k = 0; k < sizeof(cheatsIfCodes) / sizeof(cheatsIfCodes[0]); k++) {
+        const CheatIfCode& test = cheatsIfCodes[k];
+        if (test.size != code.size)
+            continue;
+
+        op.op = test.skip == CHEAT_SKIP_CODES ? CHEAT_OP_IF_CODES : CHEAT_OP_IF;
+        op.width = test.width;
+        op.cond = test.cond;
+        op.skip = test.skip == CHEAT_SKIP_LINES ? (code.rawaddress >> 0x10) & 0xFF : test.skip;
+        if (test.masked)
+            op.value &= cheatsWidthMask(test.width);
+        return;
+    }
+}
+
+static void cheatsCompile()
+{
+    cheatsProgram.resize(cheatsNumber + 1);
+    cheatsProgramData.clear();
+    for (int i = 0; i < cheatsNumber; i++)
+        cheatsCompileEntry(i, cheatsProgram[i]);
+    memset(&cheatsProgram[cheatsNumber], 0, sizeof(CheatOp));
+    cheatsProgramDirty = false;
+}
+
+static bool cheatsTest(const CheatOp& op)
+{
+    uint32_t v = cheatsRead(op.width, op.address);
+    int32_t s = op.width == 1 ? (int8_t)v : op.width == 2 ? (int16_t)v : (int32_t)v;
+
+    switch (op.cond) {
+    case CHEAT_IF_EQ:
+        return v == op.value;
+    case CHEAT_IF_NE:
+        return v != op.value;
+    case CHEAT_IF_LT:
+        return v < op.value;
+    case CHEAT_IF_GT:
+        return v > op.value;
+    case CHEAT_IF_LE:
+        return v <= op.value;
+    case CHEAT_IF_GE:
+        return v >= op.value;
+    case CHEAT_IF_AND:
+        return (v & op.value) != 0;
+    case CHEAT_IF_LT_S:
+        return s < (int32_t)op.value;
+    case CHEAT_IF_GT_S:
+        return s > (int32_t)op.value;
+    }
+    return true;
+}
+
 int cheatsCheckKeys(uint32_t keys, uint32_t extended)
 {
     bool onoff = true;
@@ -576,702 +1054,158 @@ int cheatsCheckKeys(uint32_t keys, uint32_t extended)
             rompatch2addr[i] = 0;
         }
 
+    if (cheatsProgramDirty)
+        cheatsCompile();
+
     for (i = 0; i < cheatsNumber; i++) {
-        if (!cheatsList[i].enabled) {
+        const CheatOp* op = &cheatsProgram[i];
+
+        if (!op->enabled) {
             // make sure we skip other lines in this code
-            i += getCodeLength(i) - 1;
+            i += op->length - 1;
             continue;
         }
-        switch (cheatsList[i].size) {
-        case GSA_CODES_ON:
+
+        switch (op->op) {
+        case CHEAT_OP_CODES_ON:
             onoff = true;
             break;
-        case GSA_SLOWDOWN:
+        case CHEAT_OP_SLOWDOWN: {
             // check if button was pressed and released, if so toggle our state
-            if ((cheatsList[i].status & 4) && !(extended & 4))
-                cheatsList[i].status ^= 1;
+            int& status = cheatsList[i].status;
+            if ((status & 4) && !(extended & 4))
+                status ^= 1;
             if (extended & 4)
-                cheatsList[i].status |= 4;
+                status |= 4;
             else
-                cheatsList[i].status &= ~4;
+                status &= ~4;
 
-            if (cheatsList[i].status & 1)
-                ticks += ((cheatsList[i].value & 0xFFFF) * 7);
-            break;
-        case GSA_8_BIT_SLIDE:
-            i++;
-            if (i < cheatsNumber) {
-                uint32_t addr = cheatsList[i - 1].value;
-                uint8_t value = cheatsList[i].rawaddress;
-                int vinc = (cheatsList[i].value >> 24) & 255;
-                int count = (cheatsList[i].value >> 16) & 255;
-                int ainc = (cheatsList[i].value & 0xffff);
-                while (count > 0) {
-                    CPUWriteByte(addr, value);
-                    value += vinc;
-                    addr += ainc;
-                    count--;
-                }
+            if (status & 1)
+                ticks += op->value;
+        } break;
+        case CHEAT_OP_SLIDE: {
+            uint32_t addr = op->address;
+            uint32_t value = op->value;
+            for (uint32_t n = op->count; n > 0; n--) {
+                cheatsWrite(op->width, addr, value);
+                value += op->inc;
+                addr += op->step;
             }
+            op = &cheatsProgram[++i];
+        } break;
+        case CHEAT_OP_GS_WRITE2:
+            if (op->count && (extended & 4))
+                cheatsWrite(op->width, op->address, op->value);
+            op = &cheatsProgram[++i];
             break;
-        case GSA_16_BIT_SLIDE:
-            i++;
-            if (i < cheatsNumber) {
-                uint32_t addr = cheatsList[i - 1].value;
-                uint16_t value = cheatsList[i].rawaddress;
-                int vinc = (cheatsList[i].value >> 24) & 255;
-                int count = (cheatsList[i].value >> 16) & 255;
-                int ainc = (cheatsList[i].value & 0xffff) * 2;
-                while (count > 0) {
-                    CPUWriteHalfWord(addr, value);
-                    value += vinc;
-                    addr += ainc;
-                    count--;
+        case CHEAT_OP_ROM_PATCH: {
+            CheatsData& code = cheatsList[i];
+            if ((code.status & 1) == 0) {
+                if (CPUReadHalfWord(code.address) != code.value) {
+                    code.oldValue = CPUReadHalfWord(code.address);
+                    code.status |= 1;
+                    CHEAT_PATCH_ROM_16BIT(code.address, code.value);
                 }
             }
+        } break;
+        case CHEAT_OP_ROM_PATCH2:
+            rompatch2addr[op->count] = op->address;
+            rompatch2oldval[op->count] = CPUReadHalfWord(op->address);
+            rompatch2val[op->count] = op->value;
+            op = &cheatsProgram[++i];
             break;
-        case GSA_32_BIT_SLIDE:
-            i++;
-            if (i < cheatsNumber) {
-                uint32_t addr = cheatsList[i - 1].value;
-                uint32_t value = cheatsList[i].rawaddress;
-                int vinc = (cheatsList[i].value >> 24) & 255;
-                int count = (cheatsList[i].value >> 16) & 255;
-                int ainc = (cheatsList[i].value & 0xffff) * 4;
-                while (count > 0) {
-                    CPUWriteMemory(addr, value);
-                    value += vinc;
-                    addr += ainc;
-                    count--;
-                }
-            }
+        case CHEAT_OP_MASTER:
+            mastercode = op->address;
             break;
-        case GSA_8_BIT_GS_WRITE2:
-            i++;
-            if (i < cheatsNumber) {
-                if (extended & 4) {
-                    CPUWriteByte(cheatsList[i - 1].value, cheatsList[i].address);
-                }
-            }
+        }
+
+        if (!onoff)
+            continue;
+
+        switch (op->op) {
+        case CHEAT_OP_WRITE:
+            cheatsWrite(op->width, op->address, op->value);
             break;
-        case GSA_16_BIT_GS_WRITE2:
-            i++;
-            if (i < cheatsNumber) {
-                if (extended & 4) {
-                    CPUWriteHalfWord(cheatsList[i - 1].value, cheatsList[i].address);
-                }
-            }
+        case CHEAT_OP_GS_WRITE:
+            if (extended & 4)
+                cheatsWrite(op->width, op->address, op->value);
             break;
-        case GSA_32_BIT_GS_WRITE2:
-            i++;
-            if (i < cheatsNumber) {
-                if (extended & 4) {
-                    CPUWriteMemory(cheatsList[i - 1].value, cheatsList[i].address);
-                }
-            }
+        case CHEAT_OP_ROM_WRITE:
+            if (op->width == 2)
+                CHEAT_PATCH_ROM_16BIT(op->address, op->value);
+            else
+                CHEAT_PATCH_ROM_32BIT(op->address, op->value);
             break;
-        case GSA_16_BIT_ROM_PATCH:
-            if ((cheatsList[i].status & 1) == 0) {
-                if (CPUReadHalfWord(cheatsList[i].address) != cheatsList[i].value) {
-                    cheatsList[i].oldValue = CPUReadHalfWord(cheatsList[i].address);
-                    cheatsList[i].status |= 1;
-                    CHEAT_PATCH_ROM_16BIT(cheatsList[i].address, cheatsList[i].value);
-                }
-            }
+        case CHEAT_OP_IF:
+            if (!cheatsTest(*op))
+                i += op->skip;
             break;
-        case GSA_16_BIT_ROM_PATCH2C:
-            i++;
-            if (i < cheatsNumber) {
-                rompatch2addr[0] = ((cheatsList[i - 1].value & 0x00FFFFFF) << 1) + 0x8000000;
-                rompatch2oldval[0] = CPUReadHalfWord(rompatch2addr[0]);
-                rompatch2val[0] = cheatsList[i].rawaddress & 0xFFFF;
-            }
+        case CHEAT_OP_IF_CODES:
+            if (!cheatsTest(*op))
+                onoff = false;
             break;
-        case GSA_16_BIT_ROM_PATCH2D:
-            i++;
-            if (i < cheatsNumber) {
-                rompatch2addr[1] = ((cheatsList[i - 1].value & 0x00FFFFFF) << 1) + 0x8000000;
-                rompatch2oldval[1] = CPUReadHalfWord(rompatch2addr[1]);
-                rompatch2val[1] = cheatsList[i].rawaddress & 0xFFFF;
-            }
+        case CHEAT_OP_IF_KEYS:
+            if ((op->cond == 2 && (keys & op->value) == 0)
+                || (op->cond == 1 && (keys & op->value) == op->value)
+                || (op->cond == 0 && ((~keys) & 0x3FF) == op->value))
+                i++;
             break;
-        case GSA_16_BIT_ROM_PATCH2E:
-            i++;
-            if (i < cheatsNumber) {
-                rompatch2addr[2] = ((cheatsList[i - 1].value & 0x00FFFFFF) << 1) + 0x8000000;
-                rompatch2oldval[2] = CPUReadHalfWord(rompatch2addr[2]);
-                rompatch2val[2] = cheatsList[i].rawaddress & 0xFFFF;
-            }
+        case CHEAT_OP_SKIP:
+            i += op->skip;
             break;
-        case GSA_16_BIT_ROM_PATCH2F:
-            i++;
-            if (i < cheatsNumber) {
-                rompatch2addr[3] = ((cheatsList[i - 1].value & 0x00FFFFFF) << 1) + 0x8000000;
-                rompatch2oldval[3] = CPUReadHalfWord(rompatch2addr[3]);
-                rompatch2val[3] = cheatsList[i].rawaddress & 0xFFFF;
+        case CHEAT_OP_CBA_SLIDE: {
+            uint32_t addr = op->address;
+            uint32_t value = op->value;
+            for (uint32_t n = op->count; n > 0; n--) {
+                CPUWriteHalfWord(addr, value);
+                addr += op->step;
+                value += op->inc;
             }
+            i += op->skip;
+        } break;
+        case CHEAT_OP_AND:
+            CPUWriteHalfWord(op->address, CPUReadHalfWord(op->address) & op->value);
             break;
-        case MASTER_CODE:
-            mastercode = cheatsList[i].address;
+        case CHEAT_OP_OR:
+            CPUWriteHalfWord(op->address, CPUReadHalfWord(op->address) | op->value);
             break;
-        }
-        if (onoff) {
-            switch (cheatsList[i].size) {
-            case INT_8_BIT_WRITE:
-                CPUWriteByte(cheatsList[i].address, cheatsList[i].value);
-                break;
-            case INT_16_BIT_WRITE:
-                CPUWriteHalfWord(cheatsList[i].address, cheatsList[i].value);
-                break;
-            case INT_32_BIT_WRITE:
-                CPUWriteMemory(cheatsList[i].address, cheatsList[i].value);
-                break;
-            case GSA_8_BIT_GS_WRITE:
-                if (extended & 4) {
-                    CPUWriteByte(cheatsList[i].address, cheatsList[i].value);
-                }
-                break;
-            case GSA_16_BIT_GS_WRITE:
-                if (extended & 4) {
-                    CPUWriteHalfWord(cheatsList[i].address, cheatsList[i].value);
-                }
-                break;
-            case GSA_32_BIT_GS_WRITE:
-                if (extended & 4) {
-                    CPUWriteMemory(cheatsList[i].address, cheatsList[i].value);
-                }
-                break;
-            case CBA_IF_KEYS_PRESSED: {
-                uint16_t value = cheatsList[i].value;
-                uint32_t addr = cheatsList[i].address;
-                if ((addr & 0xF0) == 0x20) {
-                    if ((keys & value) == 0) {
-                        i++;
-                    }
-                } else if ((addr & 0xF0) == 0x10) {
-                    if ((keys & value) == value) {
-                        i++;
-                    }
-                } else if ((addr & 0xF0) == 0x00) {
-                    if (((~keys) & 0x3FF) == value) {
-                        i++;
-                    }
-                }
-            } break;
-            case CBA_IF_TRUE:
-                if (CPUReadHalfWord(cheatsList[i].address) != cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case CBA_SLIDE_CODE: {
-                uint32_t address = cheatsList[i].address;
-                uint16_t value = cheatsList[i].value;
-                i++;
-                if (i < cheatsNumber) {
-                    int count = ((cheatsList[i].address - 1) & 0xFFFF);
-                    uint16_t vinc = (cheatsList[i].address >> 16) & 0xFFFF;
-                    int inc = cheatsList[i].value;
-                    for (int x = 0; x <= count; x++) {
-                        CPUWriteHalfWord(address, value);
-                        address += inc;
-                        value += vinc;
-                    }
-                }
-            } break;
-            case CBA_IF_FALSE:
-                if (CPUReadHalfWord(cheatsList[i].address) == cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case CBA_AND:
-                CPUWriteHalfWord(cheatsList[i].address,
-                    CPUReadHalfWord(cheatsList[i].address) & cheatsList[i].value);
-                break;
-            case GSA_8_BIT_IF_TRUE:
-                if (CPUReadByte(cheatsList[i].address) != cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_TRUE:
-                if (CPUReadMemory(cheatsList[i].address) != cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_IF_FALSE:
-                if (CPUReadByte(cheatsList[i].address) == cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_FALSE:
-                if (CPUReadMemory(cheatsList[i].address) == cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_FILL: {
-                uint32_t addr = cheatsList[i].address;
-                uint8_t v = cheatsList[i].value & 0xff;
-                uint32_t end = addr + (cheatsList[i].value >> 8);
-                do {
-                    CPUWriteByte(addr, v);
-                    addr++;
-                } while (addr <= end);
-            } break;
-            case GSA_16_BIT_FILL: {
-                uint32_t addr = cheatsList[i].address;
-                uint16_t v = cheatsList[i].value & 0xffff;
-                uint32_t end = addr + ((cheatsList[i].value >> 16) << 1);
-                do {
-                    CPUWriteHalfWord(addr, v);
-                    addr += 2;
-                } while (addr <= end);
-            } break;
-            case GSA_8_BIT_IF_TRUE2:
-                if (CPUReadByte(cheatsList[i].address) != cheatsList[i].value) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_TRUE2:
-                if (CPUReadHalfWord(cheatsList[i].address) != cheatsList[i].value) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_TRUE2:
-                if (CPUReadMemory(cheatsList[i].address) != cheatsList[i].value) {
-                    i += 2;
-                }
-                break;
-            case GSA_8_BIT_IF_FALSE2:
-                if (CPUReadByte(cheatsList[i].address) == cheatsList[i].value) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_FALSE2:
-                if (CPUReadHalfWord(cheatsList[i].address) == cheatsList[i].value) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_FALSE2:
-                if (CPUReadMemory(cheatsList[i].address) == cheatsList[i].value) {
-                    i += 2;
-                }
-                break;
-            case CBA_ADD:
-                if ((cheatsList[i].address & 1) == 0) {
-                    CPUWriteHalfWord(cheatsList[i].address,
-                        CPUReadHalfWord(cheatsList[i].address) + cheatsList[i].value);
-                } else {
-                    CPUWriteMemory(cheatsList[i].address & 0x0FFFFFFE,
-                        CPUReadMemory(cheatsList[i].address & 0x0FFFFFFE) + cheatsList[i].value);
-                }
-                break;
-            case CBA_OR:
-                CPUWriteHalfWord(cheatsList[i].address,
-                    CPUReadHalfWord(cheatsList[i].address) | cheatsList[i].value);
-                break;
-            case CBA_GT:
-                if (!(CPUReadHalfWord(cheatsList[i].address) > cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case CBA_LT:
-                if (!(CPUReadHalfWord(cheatsList[i].address) < cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case CBA_SUPER: {
-                int count = 2 * ((cheatsList[i].value - 1) & 0xFFFF) + 1;
-                uint32_t address = cheatsList[i].address;
-                for (int x = 0; x <= count; x++) {
-                    uint8_t b;
-                    int res = x % 6;
-                    if (res == 0)
-                        i++;
-                    if (res < 4)
-                        b = (cheatsList[i].address >> (24 - 8 * res)) & 0xFF;
-                    else
-                        b = (cheatsList[i].value >> (8 - 8 * (res - 4))) & 0xFF;
-                    CPUWriteByte(address, b);
-                    address++;
-                }
-            } break;
-            case GSA_8_BIT_POINTER:
-                if (((CPUReadMemory(cheatsList[i].address) >= 0x02000000) && (CPUReadMemory(cheatsList[i].address) < 0x02040000)) || ((CPUReadMemory(cheatsList[i].address) >= 0x03000000) && (CPUReadMemory(cheatsList[i].address) < 0x03008000))) {
-                    CPUWriteByte(CPUReadMemory(cheatsList[i].address) + ((cheatsList[i].value & 0xFFFFFF00) >> 8),
-                        cheatsList[i].value & 0xFF);
-                }
-                break;
-            case GSA_16_BIT_POINTER:
-                if (((CPUReadMemory(cheatsList[i].address) >= 0x02000000) && (CPUReadMemory(cheatsList[i].address) < 0x02040000)) || ((CPUReadMemory(cheatsList[i].address) >= 0x03000000) && (CPUReadMemory(cheatsList[i].address) < 0x03008000))) {
-                    CPUWriteHalfWord(CPUReadMemory(cheatsList[i].address) + ((cheatsList[i].value & 0xFFFF0000) >> 15),
-                        cheatsList[i].value & 0xFFFF);
-                }
-                break;
-            case GSA_32_BIT_POINTER:
-                if (((CPUReadMemory(cheatsList[i].address) >= 0x02000000) && (CPUReadMemory(cheatsList[i].address) < 0x02040000)) || ((CPUReadMemory(cheatsList[i].address) >= 0x03000000) && (CPUReadMemory(cheatsList[i].address) < 0x03008000))) {
-                    CPUWriteMemory(CPUReadMemory(cheatsList[i].address),
-                        cheatsList[i].value);
-                }
-                break;
-            case GSA_8_BIT_ADD:
-                CPUWriteByte(cheatsList[i].address,
-                    ((cheatsList[i].value & 0xFF) + CPUReadMemory(cheatsList[i].address)) & 0xFF);
-                break;
-            case GSA_16_BIT_ADD:
-                CPUWriteHalfWord(cheatsList[i].address,
-                    ((cheatsList[i].value & 0xFFFF) + CPUReadMemory(cheatsList[i].address)) & 0xFFFF);
-                break;
-            case GSA_32_BIT_ADD:
-                CPUWriteMemory(cheatsList[i].address,
-                    (cheatsList[i].value + CPUReadMemory(cheatsList[i].address)) & 0xFFFFFFFF);
-                break;
-            case GSA_8_BIT_IF_LOWER_U:
-                if (!(CPUReadByte(cheatsList[i].address) < (cheatsList[i].value & 0xFF))) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_IF_LOWER_U:
-                if (!(CPUReadHalfWord(cheatsList[i].address) < (cheatsList[i].value & 0xFFFF))) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_LOWER_U:
-                if (!(CPUReadMemory(cheatsList[i].address) < cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_IF_HIGHER_U:
-                if (!(CPUReadByte(cheatsList[i].address) > (cheatsList[i].value & 0xFF))) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_U:
-                if (!(CPUReadHalfWord(cheatsList[i].address) > (cheatsList[i].value & 0xFFFF))) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_HIGHER_U:
-                if (!(CPUReadMemory(cheatsList[i].address) > cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_IF_AND:
-                if (!(CPUReadByte(cheatsList[i].address) & (cheatsList[i].value & 0xFF))) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_IF_AND:
-                if (!(CPUReadHalfWord(cheatsList[i].address) & (cheatsList[i].value & 0xFFFF))) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_AND:
-                if (!(CPUReadMemory(cheatsList[i].address) & cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_IF_LOWER_U2:
-                if (!(CPUReadByte(cheatsList[i].address) < (cheatsList[i].value & 0xFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_LOWER_U2:
-                if (!(CPUReadHalfWord(cheatsList[i].address) < (cheatsList[i].value & 0xFFFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_LOWER_U2:
-                if (!(CPUReadMemory(cheatsList[i].address) < cheatsList[i].value)) {
-                    i += 2;
-                }
-                break;
-            case GSA_8_BIT_IF_HIGHER_U2:
-                if (!(CPUReadByte(cheatsList[i].address) > (cheatsList[i].value & 0xFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_U2:
-                if (!(CPUReadHalfWord(cheatsList[i].address) > (cheatsList[i].value & 0xFFFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_HIGHER_U2:
-                if (!(CPUReadMemory(cheatsList[i].address) > cheatsList[i].value)) {
-                    i += 2;
-                }
-                break;
-            case GSA_8_BIT_IF_AND2:
-                if (!(CPUReadByte(cheatsList[i].address) & (cheatsList[i].value & 0xFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_AND2:
-                if (!(CPUReadHalfWord(cheatsList[i].address) & (cheatsList[i].value & 0xFFFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_AND2:
-                if (!(CPUReadMemory(cheatsList[i].address) & cheatsList[i].value)) {
-                    i += 2;
-                }
-                break;
-            case GSA_ALWAYS:
-                i++;
-                break;
-            case GSA_ALWAYS2:
-                i += 2;
-                break;
-            case GSA_8_BIT_IF_LOWER_S:
-                if (!((int8_t)CPUReadByte(cheatsList[i].address) < ((int8_t)cheatsList[i].value & 0xFF))) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_IF_LOWER_S:
-                if (!((int16_t)CPUReadHalfWord(cheatsList[i].address) < ((int16_t)cheatsList[i].value & 0xFFFF))) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_LOWER_S:
-                if (!((int32_t)CPUReadMemory(cheatsList[i].address) < (int32_t)cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_IF_HIGHER_S:
-                if (!((int8_t)CPUReadByte(cheatsList[i].address) > ((int8_t)cheatsList[i].value & 0xFF))) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_S:
-                if (!((int16_t)CPUReadHalfWord(cheatsList[i].address) > ((int16_t)cheatsList[i].value & 0xFFFF))) {
-                    i++;
-                }
-                break;
-            case GSA_32_BIT_IF_HIGHER_S:
-                if (!((int32_t)CPUReadMemory(cheatsList[i].address) > (int32_t)cheatsList[i].value)) {
-                    i++;
-                }
-                break;
-            case GSA_8_BIT_IF_LOWER_S2:
-                if (!((int8_t)CPUReadByte(cheatsList[i].address) < ((int8_t)cheatsList[i].value & 0xFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_LOWER_S2:
-                if (!((int16_t)CPUReadHalfWord(cheatsList[i].address) < ((int16_t)cheatsList[i].value & 0xFFFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_LOWER_S2:
-                if (!((int32_t)CPUReadMemory(cheatsList[i].address) < (int32_t)cheatsList[i].value)) {
-                    i += 2;
-                }
-                break;
-            case GSA_8_BIT_IF_HIGHER_S2:
-                if (!((int8_t)CPUReadByte(cheatsList[i].address) > ((int8_t)cheatsList[i].value & 0xFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_S2:
-                if (!((int16_t)CPUReadHalfWord(cheatsList[i].address) > ((int16_t)cheatsList[i].value & 0xFFFF))) {
-                    i += 2;
-                }
-                break;
-            case GSA_32_BIT_IF_HIGHER_S2:
-                if (!((int32_t)CPUReadMemory(cheatsList[i].address) > (int32_t)cheatsList[i].value)) {
-                    i += 2;
-                }
-                break;
-            case GSA_16_BIT_WRITE_IOREGS:
-                if ((cheatsList[i].address <= 0x3FF) && (cheatsList[i].address != 0x6) && (cheatsList[i].address != 0x130))
-                    ioMem[cheatsList[i].address & 0x3FE] = cheatsList[i].value & 0xFFFF;
-                break;
-            case GSA_32_BIT_WRITE_IOREGS:
-                if (cheatsList[i].address <= 0x3FF) {
-                    if (((cheatsList[i].address & 0x3FC) != 0x6) && ((cheatsList[i].address & 0x3FC) != 0x130))
-                        ioMem[cheatsList[i].address & 0x3FC] = (cheatsList[i].value & 0xFFFF);
-                    if ((((cheatsList[i].address & 0x3FC) + 2) != 0x6) && ((cheatsList[i].address & 0x3FC) + 2) != 0x130)
-                        ioMem[(cheatsList[i].address & 0x3FC) + 2] = ((cheatsList[i].value >> 16) & 0xFFFF);
-                }
-                break;
-            case GSA_8_BIT_IF_TRUE3:
-                if (CPUReadByte(cheatsList[i].address) != cheatsList[i].value) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_TRUE3:
-                if (CPUReadHalfWord(cheatsList[i].address) != cheatsList[i].value) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_TRUE3:
-                if (CPUReadMemory(cheatsList[i].address) != cheatsList[i].value) {
-                    onoff = false;
-                }
-                break;
-            case GSA_8_BIT_IF_FALSE3:
-                if (CPUReadByte(cheatsList[i].address) == cheatsList[i].value) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_FALSE3:
-                if (CPUReadHalfWord(cheatsList[i].address) == cheatsList[i].value) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_FALSE3:
-                if (CPUReadMemory(cheatsList[i].address) == cheatsList[i].value) {
-                    onoff = false;
-                }
-                break;
-            case GSA_8_BIT_IF_LOWER_S3:
-                if (!((int8_t)CPUReadByte(cheatsList[i].address) < ((int8_t)cheatsList[i].value & 0xFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_LOWER_S3:
-                if (!((int16_t)CPUReadHalfWord(cheatsList[i].address) < ((int16_t)cheatsList[i].value & 0xFFFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_LOWER_S3:
-                if (!((int32_t)CPUReadMemory(cheatsList[i].address) < (int32_t)cheatsList[i].value)) {
-                    onoff = false;
-                }
-                break;
-            case GSA_8_BIT_IF_HIGHER_S3:
-                if (!((int8_t)CPUReadByte(cheatsList[i].address) > ((int8_t)cheatsList[i].value & 0xFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_S3:
-                if (!((int16_t)CPUReadHalfWord(cheatsList[i].address) > ((int16_t)cheatsList[i].value & 0xFFFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_HIGHER_S3:
-                if (!((int32_t)CPUReadMemory(cheatsList[i].address) > (int32_t)cheatsList[i].value)) {
-                    onoff = false;
-                }
-                break;
-            case GSA_8_BIT_IF_LOWER_U3:
-                if (!(CPUReadByte(cheatsList[i].address) < (cheatsList[i].value & 0xFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_LOWER_U3:
-                if (!(CPUReadHalfWord(cheatsList[i].address) < (cheatsList[i].value & 0xFFFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_LOWER_U3:
-                if (!(CPUReadMemory(cheatsList[i].address) < cheatsList[i].value)) {
-                    onoff = false;
-                }
-                break;
-            case GSA_8_BIT_IF_HIGHER_U3:
-                if (!(CPUReadByte(cheatsList[i].address) > (cheatsList[i].value & 0xFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_U3:
-                if (!(CPUReadHalfWord(cheatsList[i].address) > (cheatsList[i].value & 0xFFFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_HIGHER_U3:
-                if (!(CPUReadMemory(cheatsList[i].address) > cheatsList[i].value)) {
-                    onoff = false;
-                }
-                break;
-            case GSA_8_BIT_IF_AND3:
-                if (!(CPUReadByte(cheatsList[i].address) & (cheatsList[i].value & 0xFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_16_BIT_IF_AND3:
-                if (!(CPUReadHalfWord(cheatsList[i].address) & (cheatsList[i].value & 0xFFFF))) {
-                    onoff = false;
-                }
-                break;
-            case GSA_32_BIT_IF_AND3:
-                if (!(CPUReadMemory(cheatsList[i].address) & cheatsList[i].value)) {
-                    onoff = false;
-                }
-                break;
-            case GSA_ALWAYS3:
-                if (!(CPUReadMemory(cheatsList[i].address) & cheatsList[i].value)) {
-                    onoff = false;
-                }
-                break;
-            case GSA_GROUP_WRITE: {
-                int count = ((cheatsList[i].address) & 0xFFFE) + 1;
-                uint32_t value = cheatsList[i].value;
-                if (count == 0)
-                    i++;
-                else
-                    for (int x = 1; x <= count; x++) {
-                        if ((x % 2) == 0) {
-                            if (x < count)
-                                i++;
-                            CPUWriteMemory(cheatsList[i].rawaddress, value);
-                        } else
-                            CPUWriteMemory(cheatsList[i].value, value);
-                    }
-            } break;
-            case GSA_32_BIT_ADD2:
-                CPUWriteMemory(cheatsList[i].value,
-                    (CPUReadMemory(cheatsList[i].value) + cheatsList[i + 1].rawaddress) & 0xFFFFFFFF);
-                i++;
-                break;
-            case GSA_32_BIT_SUB2:
-                CPUWriteMemory(cheatsList[i].value,
-                    (CPUReadMemory(cheatsList[i].value) - cheatsList[i + 1].rawaddress) & 0xFFFFFFFF);
-                i++;
-                break;
-            case GSA_16_BIT_IF_LOWER_OR_EQ_U:
-                if (CPUReadHalfWord(cheatsList[i].address) > cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_IF_HIGHER_OR_EQ_U:
-                if (CPUReadHalfWord(cheatsList[i].address) < cheatsList[i].value) {
-                    i++;
-                }
-                break;
-            case GSA_16_BIT_MIF_TRUE:
-                if (CPUReadHalfWord(cheatsList[i].address) != cheatsList[i].value) {
-                    i += ((cheatsList[i].rawaddress >> 0x10) & 0xFF);
-                }
-                break;
-            case GSA_16_BIT_MIF_FALSE:
-                if (CPUReadHalfWord(cheatsList[i].address) == cheatsList[i].value) {
-                    i += (cheatsList[i].rawaddress >> 0x10) & 0xFF;
-                }
-                break;
-            case GSA_16_BIT_MIF_LOWER_OR_EQ_U:
-                if (CPUReadHalfWord(cheatsList[i].address) > cheatsList[i].value) {
-                    i += (cheatsList[i].rawaddress >> 0x10) & 0xFF;
-                }
-                break;
-            case GSA_16_BIT_MIF_HIGHER_OR_EQ_U:
-                if (CPUReadHalfWord(cheatsList[i].address) < cheatsList[i].value) {
-                    i += (cheatsList[i].rawaddress >> 0x10) & 0xFF;
-                }
-                break;
-            case CHEATS_16_BIT_WRITE:
-                if ((cheatsList[i].address >> 24) >= 0x08) {
-                    CHEAT_PATCH_ROM_16BIT(cheatsList[i].address, cheatsList[i].value);
-                } else {
-                    CPUWriteHalfWord(cheatsList[i].address, cheatsList[i].value);
-                }
-                break;
-            case CHEATS_32_BIT_WRITE:
-                if ((cheatsList[i].address >> 24) >= 0x08) {
-                    CHEAT_PATCH_ROM_32BIT(cheatsList[i].address, cheatsList[i].value);
-                } else {
-                    CPUWriteMemory(cheatsList[i].address, cheatsList[i].value);
-                }
-                break;
+        case CHEAT_OP_ADD:
+            cheatsWrite(op->width, op->address, cheatsRead(op->width, op->address) + op->value);
+            i += op->skip;
+            break;
+        case CHEAT_OP_GSA_ADD:
+            cheatsWrite(op->width, op->address, op->value + CPUReadMemory(op->address));
+            break;
+        case CHEAT_OP_FILL: {
+            uint32_t addr = op->address;
+            for (uint32_t n = op->count; n > 0; n--) {
+                cheatsWrite(op->width, addr, op->value);
+                addr += op->step;
             }
+        } break;
+        case CHEAT_OP_BYTES: {
+            const uint32_t* bytes = &cheatsProgramData[op->data];
+            for (uint32_t x = 0; x < op->count; x++)
+                CPUWriteByte(op->address + x, bytes[x]);
+            i += op->skip;
+        } break;
+        case CHEAT_OP_POINTER: {
+            uint32_t pointer = CPUReadMemory(op->address);
+            if ((pointer >= 0x02000000 && pointer < 0x02040000) || (pointer >= 0x03000000 && pointer < 0x03008000))
+                cheatsWrite(op->width, pointer + op->step, op->value);
+        } break;
+        case CHEAT_OP_IO:
+            if (op->address != CHEAT_NO_IO)
+                ioMem[op->address] = op->value;
+            if (op->count != CHEAT_NO_IO)
+                ioMem[op->count] = op->inc;
+            break;
+        case CHEAT_OP_GROUP: {
+            const uint32_t* addresses = &cheatsProgramData[op->data];
+            for (uint32_t x = 0; x < op->count; x++)
+                CPUWriteMemory(addresses[x], op->value);
+            i += op->skip;
+        } break;
         }
     }
     for (i = 0; i < 4; i++)
@@ -1320,6 +1254,7 @@ void cheatsAdd(const char* codeStr,
             break;
         }
         cheatsNumber++;
+        cheatsProgramDirty = true;
     }
 }
 
@@ -1376,6 +1311,7 @@ void cheatsDelete(int number, bool restore)
             memcpy(&cheatsList[x], &cheatsList[x + 1], sizeof(CheatsData) * (cheatsNumber - x - 1));
         }
         cheatsNumber--;
+        cheatsProgramDirty = true;
     }
 }
 
@@ -1390,6 +1326,7 @@ void cheatsEnable(int i)
 {
     if (i >= 0 && i < cheatsNumber) {
         cheatsList[i].enabled = true;
+        cheatsProgramDirty = true;
         mastercode = 0;
     }
 }
@@ -1418,6 +1355,7 @@ void cheatsDisable(int i)
             break;
         }
         cheatsList[i].enabled = false;
+        cheatsProgramDirty = true;
     }
 }
 
@@ -2594,6 +2532,8 @@ void cheatsReadGame(gzFile file, int version)
     if (version > 8)
         utilGzRead(file, cheatsList, sizeof(cheatsList));
 
+    cheatsProgramDirty = true;
+
     bool firstCodeBreaker = true;
 
     for (int i = 0; i < cheatsNumber; i++) {
@@ -2792,12 +2732,13 @@ bool cheatsLoadCheatList(const char* file)
         }
     }
     cheatsNumber = count;
+    cheatsProgramDirty = true;
     fclose(f);
     return true;
 }
 #endif
 
-extern int cpuNextEvent;
+extern GBA_LOCAL int cpuNextEvent;
 
 extern void debuggerBreakOnWrite(uint32_t, uint32_t, uint32_t, int, int);
 
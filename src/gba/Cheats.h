@@ -38,7 +38,7 @@ void cheatsWriteHalfWord(uint32_t address, uint16_t value);
 void cheatsWriteByte(uint32_t address, uint8_t value);
 int cheatsCheckKeys(uint32_t keys, uint32_t extended);
 
-extern int cheatsNumber;
-extern CheatsData cheatsList[MAX_CHEATS];
+extern GBA_LOCAL int cheatsNumber;
+extern GBA_LOCAL CheatsData cheatsList[MAX_CHEATS];
 
 #endif // CHEATS_H
@@ -0,0 +1,152 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../System.h"
+#include "Cheats.h"
+#include "GBA.h"
+#include "Globals.h"
+#include "GBAcpu.h"
+
+#define CODE_CACHE_BIOS_PAGES (0x4000 >> CODE_CACHE_PAGE_SHIFT)
+#define CODE_CACHE_WRAM_PAGES (0x40000 >> CODE_CACHE_PAGE_SHIFT)
+#define CODE_CACHE_IRAM_PAGES (0x8000 >> CODE_CACHE_PAGE_SHIFT)
+#define CODE_CACHE_ROM_PAGES (0x2000000 >> CODE_CACHE_PAGE_SHIFT)
+
+#define CODE_CACHE_WRAM_SLOT CODE_CACHE_BIOS_PAGES
+#define CODE_CACHE_IRAM_SLOT (CODE_CACHE_WRAM_SLOT + CODE_CACHE_WRAM_PAGES)
+#define CODE_CACHE_ROM_SLOT (CODE_CACHE_IRAM_SLOT + CODE_CACHE_IRAM_PAGES)
+#define CODE_CACHE_SLOTS (CODE_CACHE_ROM_SLOT + CODE_CACHE_ROM_PAGES)
+
+GBA_LOCAL bool codeCacheDirty = false;
+GBA_LOCAL uint8_t codeCacheWramPages[CODE_CACHE_WRAM_PAGES];
+GBA_LOCAL uint8_t codeCacheIramPages[CODE_CACHE_IRAM_PAGES];
+
+static GBA_LOCAL armCachePage* armPages[CODE_CACHE_SLOTS];
+static GBA_LOCAL thumbCachePage* thumbPages[CODE_CACHE_SLOTS];
+
+// maps a CPU address to its page slot, -1 if the region is not cached
+static int codeCacheSlot(uint32_t address)
+{
+    switch (address >> 24) {
+    case 0x00:
+        if (address < 0x4000)
+            return address >> CODE_CACHE_PAGE_SHIFT;
+        return -1;
+    case 0x02:
+        return CODE_CACHE_WRAM_SLOT + ((address & 0x3FFFF) >> CODE_CACHE_PAGE_SHIFT);
+    case 0x03:
+        return CODE_CACHE_IRAM_SLOT + ((address & 0x7FFF) >> CODE_CACHE_PAGE_SHIFT);
+    case 0x08:
+    case 0x09:
+    case 0x0A:
+    case 0x0B:
+    case 0x0C:
+    case 0x0D:
+        return CODE_CACHE_ROM_SLOT + ((address & 0x1FFFFFF) >> CODE_CACHE_PAGE_SHIFT);
+    default:
+        return -1;
+    }
+}
+
+armCachePage* codeCacheArmPage(uint32_t address)
+{
+    int slot = codeCacheSlot(address);
+    if (slot < 0)
+        return NULL;
+    if (armPages[slot] == NULL)
+        armPages[slot] = (armCachePage*)calloc(1, sizeof(armCachePage));
+    return armPages[slot];
+}
+
+thumbCachePage* codeCacheThumbPage(uint32_t address)
+{
+    int slot = codeCacheSlot(address);
+    if (slot < 0)
+        return NULL;
+    if (thumbPages[slot] == NULL)
+        thumbPages[slot] = (thumbCachePage*)calloc(1, sizeof(thumbCachePage));
+    return thumbPages[slot];
+}
+
+void codeCacheValidate(uint32_t address)
+{
+    switch (address >> 24) {
+    case 0x02:
+        codeCacheWramPages[(address & 0x3FFFF) >> CODE_CACHE_PAGE_SHIFT] = 1;
+        break;
+    case 0x03:
+        codeCacheIramPages[(address & 0x7FFF) >> CODE_CACHE_PAGE_SHIFT] = 1;
+        break;
+    }
+}
+
+bool codeCacheBreakPoints(uint32_t address)
+{
+#ifdef BKPT_SUPPORT
+    int first = address >> 24;
+    int last = first;
+    if (first >= 0x08 && first <= 0x0D) {
+        // ROM pages are shared between the wait state mirrors
+        first = 0x08;
+        last = 0x0D;
+    }
+    for (int r = first; r <= last; r++) {
+        uint8_t* breakPoints = map[r].breakPoints;
+        if (breakPoints == NULL)
+            continue;
+        uint32_t start = (address & map[r].mask & ~(CODE_CACHE_PAGE_SIZE - 1)) >> 1;
+        for (uint32_t i = 0; i < (CODE_CACHE_PAGE_SIZE >> 1); i++)
+            if (breakPoints[start + i] & 0xCC)
+                return true;
+    }
+#else
+    (void)address;
+#endif
+    return false;
+}
+
+void codeCacheInvalidate(uint32_t address)
+{
+    int slot = codeCacheSlot(address);
+    if (slot < 0)
+        return;
+    if (armPages[slot])
+        armPages[slot]->valid = false;
+    if (thumbPages[slot])
+        thumbPages[slot]->valid = false;
+    switch (address >> 24) {
+    case 0x02:
+        codeCacheWramPages[(address & 0x3FFFF) >> CODE_CACHE_PAGE_SHIFT] = 0;
+        break;
+    case 0x03:
+        codeCacheIramPages[(address & 0x7FFF) >> CODE_CACHE_PAGE_SHIFT] = 0;
+        break;
+    }
+    codeCacheDirty = true;
+}
+
+void codeCacheFlush()
+{
+    for (int i = 0; i < CODE_CACHE_SLOTS; i++) {
+        if (armPages[i])
+            armPages[i]->valid = false;
+        if (thumbPages[i])
+            thumbPages[i]->valid = false;
+    }
+    memset(codeCacheWramPages, 0, sizeof(codeCacheWramPages));
+    memset(codeCacheIramPages, 0, sizeof(codeCacheIramPages));
+    codeCacheDirty = true;
+}
+
+void codeCacheCleanUp()
+{
+    for (int i = 0; i < CODE_CACHE_SLOTS; i++) {
+        free(armPages[i]);
+        armPages[i] = NULL;
+        free(thumbPages[i]);
+        thumbPages[i] = NULL;
+    }
+    memset(codeCacheWramPages, 0, sizeof(codeCacheWramPages));
+    memset(codeCacheIramPages, 0, sizeof(codeCacheIramPages));
+    codeCacheDirty = true;
+}
@@ -0,0 +1,39 @@
+#ifndef CODECACHE_H
+#define CODECACHE_H
+
+#include "../common/Types.h"
+
+// Decoded instruction cache for the ARM and THUMB interpreters.
+//
+// Code is decoded one page at a time into (handler, opcode) pairs so that
+// straight-line runs can be dispatched without re-fetching and re-decoding
+// every instruction.  Only BIOS, work RAM, internal RAM and ROM are cached.
+// Pages covering RAM are dropped as soon as a store changes their contents;
+// ROM and BIOS pages live until codeCacheFlush() is called.
+
+#define CODE_CACHE_PAGE_SHIFT 10
+#define CODE_CACHE_PAGE_SIZE (1 << CODE_CACHE_PAGE_SHIFT)
+#define CODE_CACHE_ARM_INSNS (CODE_CACHE_PAGE_SIZE >> 2)
+#define CODE_CACHE_THUMB_INSNS (CODE_CACHE_PAGE_SIZE >> 1)
+
+// set whenever a cached page is invalidated, so that a running block
+// can fall back to the fetching interpreter
+extern GBA_LOCAL bool codeCacheDirty;
+extern GBA_LOCAL uint8_t codeCacheWramPages[0x40000 >> CODE_CACHE_PAGE_SHIFT];
+extern GBA_LOCAL uint8_t codeCacheIramPages[0x8000 >> CODE_CACHE_PAGE_SHIFT];
+
+void codeCacheInvalidate(uint32_t address);
+void codeCacheFlush();
+void codeCacheCleanUp();
+
+static inline bool codeCacheWramCovered(uint32_t address)
+{
+    return codeCacheWramPages[(address & 0x3FFFF) >> CODE_CACHE_PAGE_SHIFT] != 0;
+}
+
+static inline bool codeCacheIramCovered(uint32_t address)
+{
+    return codeCacheIramPages[(address & 0x7FFF) >> CODE_CACHE_PAGE_SHIFT] != 0;
+}
+
+#endif // CODECACHE_H
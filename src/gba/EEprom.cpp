@@ -4,20 +4,20 @@
 #include <memory.h>
 #include <string.h>
 
-extern int cpuDmaCount;
+extern GBA_LOCAL int cpuDmaCount;
 
-int eepromMode = EEPROM_IDLE;
-int eepromByte = 0;
-int eepromBits = 0;
-int eepromAddress = 0;
+GBA_LOCAL int eepromMode = EEPROM_IDLE;
+GBA_LOCAL int eepromByte = 0;
+GBA_LOCAL int eepromBits = 0;
+GBA_LOCAL int eepromAddress = 0;
 
-uint8_t eepromData[SIZE_EEPROM_8K];
+GBA_LOCAL uint8_t eepromData[SIZE_EEPROM_8K];
 
-uint8_t eepromBuffer[16];
-bool eepromInUse = false;
-int eepromSize = SIZE_EEPROM_512;
+GBA_LOCAL uint8_t eepromBuffer[16];
+GBA_LOCAL bool eepromInUse = false;
+GBA_LOCAL int eepromSize = SIZE_EEPROM_512;
 
-variable_desc eepromSaveData[] = {
+static GBA_LOCAL variable_desc eepromSaveData[] = {
     { &eepromMode, sizeof(int) },
     { &eepromByte, sizeof(int) },
     { &eepromBits, sizeof(int) },
@@ -43,7 +43,6 @@ void eepromReset()
     eepromAddress = 0;
 }
 
-#ifdef __LIBRETRO__
 void eepromSaveGame(uint8_t*& data)
 {
     utilWriteDataMem(data, eepromSaveData);
@@ -63,8 +62,7 @@ void eepromReadGame(const uint8_t*& data, int version)
     }
 }
 
-#else // !__LIBRETRO__
-
+#ifndef __LIBRETRO__
 void eepromSaveGame(gzFile gzFile)
 {
     utilWriteData(gzFile, eepromSaveData);
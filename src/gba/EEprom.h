@@ -3,21 +3,20 @@
 
 #include "../common/Types.h"
 
-#ifdef __LIBRETRO__
 extern void eepromSaveGame(uint8_t*& data);
 extern void eepromReadGame(const uint8_t*& data, int version);
-#else // !__LIBRETRO__
+#ifndef __LIBRETRO__
 extern void eepromSaveGame(gzFile _gzFile);
 extern void eepromReadGame(gzFile _gzFile, int version);
 extern void eepromReadGameSkip(gzFile _gzFile, int version);
 #endif
-extern uint8_t eepromData[0x2000];
+extern GBA_LOCAL uint8_t eepromData[0x2000];
 extern int eepromRead(uint32_t address);
 extern void eepromWrite(uint32_t address, uint8_t value);
 extern void eepromInit();
 extern void eepromReset();
-extern bool eepromInUse;
-extern int eepromSize;
+extern GBA_LOCAL bool eepromInUse;
+extern GBA_LOCAL int eepromSize;
 
 #define EEPROM_IDLE 0
 #define EEPROM_READADDRESS 1
@@ -18,14 +18,14 @@
 #define FLASH_PROGRAM 8
 #define FLASH_SETBANK 9
 
-uint8_t flashSaveMemory[SIZE_FLASH1M];
+GBA_LOCAL uint8_t flashSaveMemory[SIZE_FLASH1M];
 
-int flashState = FLASH_READ_ARRAY;
-int flashReadState = FLASH_READ_ARRAY;
-int flashSize = SIZE_FLASH512;
-int flashDeviceID = 0x1b;
-int flashManufacturerID = 0x32;
-int flashBank = 0;
+GBA_LOCAL int flashState = FLASH_READ_ARRAY;
+GBA_LOCAL int flashReadState = FLASH_READ_ARRAY;
+GBA_LOCAL int flashSize = SIZE_FLASH512;
+GBA_LOCAL int flashDeviceID = 0x1b;
+GBA_LOCAL int flashManufacturerID = 0x32;
+GBA_LOCAL int flashBank = 0;
 
 void flashInit()
 {
@@ -213,7 +213,7 @@ void flashWrite(uint32_t address, uint8_t byte)
     }
 }
 
-static variable_desc flashSaveData3[] = {
+static GBA_LOCAL variable_desc flashSaveData3[] = {
     { &flashState, sizeof(int) },
     { &flashReadState, sizeof(int) },
     { &flashSize, sizeof(int) },
@@ -222,7 +222,6 @@ static variable_desc flashSaveData3[] = {
     { NULL, 0 }
 };
 
-#ifdef __LIBRETRO__
 void flashSaveGame(uint8_t*& data)
 {
     utilWriteDataMem(data, flashSaveData3);
@@ -233,15 +232,15 @@ void flashReadGame(const uint8_t*& data, int)
     utilReadDataMem(data, flashSaveData3);
 }
 
-#else // !__LIBRETRO__
-static variable_desc flashSaveData[] = {
+#ifndef __LIBRETRO__
+static GBA_LOCAL variable_desc flashSaveData[] = {
     { &flashState, sizeof(int) },
     { &flashReadState, sizeof(int) },
     { &flashSaveMemory[0], SIZE_FLASH512 },
     { NULL, 0 }
 };
 
-static variable_desc flashSaveData2[] = {
+static GBA_LOCAL variable_desc flashSaveData2[] = {
     { &flashState, sizeof(int) },
     { &flashReadState, sizeof(int) },
     { &flashSize, sizeof(int) },
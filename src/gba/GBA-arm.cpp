@@ -36,7 +36,7 @@
 
 ///////////////////////////////////////////////////////////////////////////
 
-static int clockTicks;
+static GBA_LOCAL int clockTicks;
 
 static INSN_REGPARM void armUnknownInsn(uint32_t opcode)
 {
@@ -2617,7 +2617,6 @@ static INSN_REGPARM void armF00(uint32_t opcode)
 
 // Instruction table //////////////////////////////////////////////////////
 
-typedef INSN_REGPARM void (*insnfunc_t)(uint32_t opcode);
 #define REP16(insn)                                 \
     insn, insn, insn, insn, insn, insn, insn, insn, \
         insn, insn, insn, insn, insn, insn, insn, insn
@@ -2827,10 +2826,200 @@ static void tester(void) {
 }
 #endif
 
-int armExecute()
+static inline bool armConditionPassed(int cond)
+{
+    bool cond_res = true;
+    if (UNLIKELY(cond != 0x0E)) { // most opcodes are AL (always)
+        switch (cond) {
+        case 0x00: // EQ
+            cond_res = Z_FLAG;
+            break;
+        case 0x01: // NE
+            cond_res = !Z_FLAG;
+            break;
+        case 0x02: // CS
+            cond_res = C_FLAG;
+            break;
+        case 0x03: // CC
+            cond_res = !C_FLAG;
+            break;
+        case 0x04: // MI
+            cond_res = N_FLAG;
+            break;
+        case 0x05: // PL
+            cond_res = !N_FLAG;
+            break;
+        case 0x06: // VS
+            cond_res = V_FLAG;
+            break;
+        case 0x07: // VC
+            cond_res = !V_FLAG;
+            break;
+        case 0x08: // HI
+            cond_res = C_FLAG && !Z_FLAG;
+            break;
+        case 0x09: // LS
+            cond_res = !C_FLAG || Z_FLAG;
+            break;
+        case 0x0A: // GE
+            cond_res = N_FLAG == V_FLAG;
+            break;
+        case 0x0B: // LT
+            cond_res = N_FLAG != V_FLAG;
+            break;
+        case 0x0C: // GT
+            cond_res = !Z_FLAG && (N_FLAG == V_FLAG);
+            break;
+        case 0x0D: // LE
+            cond_res = Z_FLAG || (N_FLAG != V_FLAG);
+            break;
+        case 0x0E: // AL (impossible, checked above)
+            cond_res = true;
+            break;
+        case 0x0F:
+        default:
+            // ???
+            cond_res = false;
+            break;
+        }
+    }
+    return cond_res;
+}
+
+static armCachePage* armCacheLookup(uint32_t address)
+{
+    armCachePage* page = codeCacheArmPage(address);
+    if (page && !page->valid) {
+        uint32_t base = address & ~(CODE_CACHE_PAGE_SIZE - 1);
+        for (int i = 0; i < CODE_CACHE_ARM_INSNS; i++) {
+            uint32_t opcode = CPUReadMemoryQuick(base + (i << 2));
+            page->insn[i].opcode = opcode;
+            page->insn[i].func = armInsnTable[((opcode >> 16) & 0xFF0) | ((opcode >> 4) & 0x0F)];
+        }
+        page->valid = true;
+        page->breakPoints = codeCacheBreakPoints(address);
+        codeCacheValidate(address);
+    }
+    return page;
+}
+
+// Runs code out of the decoded instruction cache with the same
+// per-instruction bookkeeping as armExecuteLoop(), following branches for
+// as long as they land in cached pages.  Returns the number of
+// instructions executed, or -1 when the CPU has to stop.
+template <bool Cheats, bool Breakpoints>
+static int armExecuteCached()
+{
+    armCachePage* page = armCacheLookup(armNextPC);
+    if (page == NULL)
+        return 0;
+
+    // the last two words of a page are left to armExecute() so that the
+    // pipeline can always be refilled from the same page
+    int i = (armNextPC & (CODE_CACHE_PAGE_SIZE - 1)) >> 2;
+    if (i + 2 >= CODE_CACHE_ARM_INSNS)
+        return 0;
+
+    // the pipeline may hold words fetched before the page was last written
+    if (page->insn[i].opcode != cpuPrefetch[0] || page->insn[i + 1].opcode != cpuPrefetch[1])
+        return 0;
+
+    // the master code is only compared on the page holding it
+    bool master = Cheats && ((mastercode ^ armNextPC) & ~(CODE_CACHE_PAGE_SIZE - 1)) == 0;
+    int executed = 0;
+    codeCacheDirty = false;
+    for (;;) {
+        if (master && mastercode == armNextPC)
+            break;
+
+#ifndef FINAL_VERSION
+        if (armNextPC == stop)
+            break;
+#endif
+
+        if ((armNextPC & 0x0803FFFF) == 0x08020000)
+            busPrefetchCount = 0x100;
+
+        const codeCacheInsn* insn = &page->insn[i];
+        cpuPrefetch[0] = insn[1].opcode;
+        cpuPrefetch[1] = insn[2].opcode;
+
+        busPrefetch = false;
+        if (busPrefetchCount & 0xFFFFFE00)
+            busPrefetchCount = 0x100 | (busPrefetchCount & 0xFF);
+
+        clockTicks = 0;
+        uint32_t oldArmNextPC = armNextPC;
+
+        armNextPC = reg[15].I;
+        reg[15].I += 4;
+
+#ifdef BKPT_SUPPORT
+        if (Breakpoints && page->breakPoints) {
+            memoryMap* m = &map[armNextPC >> 24];
+            if (BreakARMCheck(m->breakPoints, armNextPC & m->mask)) {
+                if (debuggerBreakOnExecution(armNextPC, armState)) {
+                    debugger = true;
+                    return -1;
+                }
+            }
+        }
+#endif
+
+        bool cond_res = armConditionPassed(insn->opcode >> 28);
+        if (cond_res)
+            (*insn->func)(insn->opcode);
+#ifdef INSN_COUNTER
+        count(insn->opcode, cond_res);
+#endif
+        executed++;
+
+        if (clockTicks < 0)
+            return -1;
+        if (clockTicks == 0)
+            clockTicks = 1 + codeTicksAccessSeq32(oldArmNextPC);
+        cpuTotalTicks += clockTicks;
+
+        if (codeCacheDirty || !(cpuTotalTicks < cpuNextEvent && armState && !holdState && !SWITicks && !debugger))
+            break;
+
+        if (armNextPC != oldArmNextPC + 4) {
+            // the instruction refilled the pipeline itself; keep going if
+            // the target is cached as well
+            if (((armNextPC ^ oldArmNextPC) & ~(CODE_CACHE_PAGE_SIZE - 1)) != 0) {
+                page = armCacheLookup(armNextPC);
+                if (page == NULL)
+                    break;
+                master = Cheats && ((mastercode ^ armNextPC) & ~(CODE_CACHE_PAGE_SIZE - 1)) == 0;
+            }
+            i = (armNextPC & (CODE_CACHE_PAGE_SIZE - 1)) >> 2;
+        } else {
+            i++;
+        }
+        if (i + 2 >= CODE_CACHE_ARM_INSNS)
+            break;
+    }
+
+    return executed;
+}
+
+// The execute loop is specialized on the cheat and debugger features in
+// use, so that the common configuration does not test for any of them.
+template <bool Cheats, bool Breakpoints, bool Debugger>
+static int armExecuteLoop()
 {
     do {
-        if (cheatsEnabled) {
+        // register breakpoints are checked after every instruction, which
+        // the cached runner does not do
+        if (!Debugger) {
+            int cached = armExecuteCached<Cheats, Breakpoints>();
+            if (cached < 0)
+                return 0;
+            if (cached > 0)
+                continue;
+        }
+
+        if (Cheats) {
             cpuMasterCodeCheck();
         }
 
@@ -2858,73 +3047,20 @@ int armExecute()
         ARM_PREFETCH_NEXT;
 
 #ifdef BKPT_SUPPORT
-        uint32_t memAddr = armNextPC;
-        memoryMap* m = &map[memAddr >> 24];
-        if (m->breakPoints && BreakARMCheck(m->breakPoints, memAddr & m->mask)) {
-            if (debuggerBreakOnExecution(memAddr, armState)) {
-                // Revert tickcount?
-                debugger = true;
-                return 0;
+        if (Breakpoints) {
+            uint32_t memAddr = armNextPC;
+            memoryMap* m = &map[memAddr >> 24];
+            if (m->breakPoints && BreakARMCheck(m->breakPoints, memAddr & m->mask)) {
+                if (debuggerBreakOnExecution(memAddr, armState)) {
+                    // Revert tickcount?
+                    debugger = true;
+                    return 0;
+                }
             }
         }
 #endif
 
-        int cond = opcode >> 28;
-        bool cond_res = true;
-        if (UNLIKELY(cond != 0x0E)) { // most opcodes are AL (always)
-            switch (cond) {
-            case 0x00: // EQ
-                cond_res = Z_FLAG;
-                break;
-            case 0x01: // NE
-                cond_res = !Z_FLAG;
-                break;
-            case 0x02: // CS
-                cond_res = C_FLAG;
-                break;
-            case 0x03: // CC
-                cond_res = !C_FLAG;
-                break;
-            case 0x04: // MI
-                cond_res = N_FLAG;
-                break;
-            case 0x05: // PL
-                cond_res = !N_FLAG;
-                break;
-            case 0x06: // VS
-                cond_res = V_FLAG;
-                break;
-            case 0x07: // VC
-                cond_res = !V_FLAG;
-                break;
-            case 0x08: // HI
-                cond_res = C_FLAG && !Z_FLAG;
-                break;
-            case 0x09: // LS
-                cond_res = !C_FLAG || Z_FLAG;
-                break;
-            case 0x0A: // GE
-                cond_res = N_FLAG == V_FLAG;
-                break;
-            case 0x0B: // LT
-                cond_res = N_FLAG != V_FLAG;
-                break;
-            case 0x0C: // GT
-                cond_res = !Z_FLAG && (N_FLAG == V_FLAG);
-                break;
-            case 0x0D: // LE
-                cond_res = Z_FLAG || (N_FLAG != V_FLAG);
-                break;
-            case 0x0E: // AL (impossible, checked above)
-                cond_res = true;
-                break;
-            case 0x0F:
-            default:
-                // ???
-                cond_res = false;
-                break;
-            }
-        }
+        bool cond_res = armConditionPassed(opcode >> 28);
 
         if (cond_res)
             (*armInsnTable[((opcode >> 16) & 0xFF0) | ((opcode >> 4) & 0x0F)])(opcode);
@@ -2933,7 +3069,7 @@ int armExecute()
 #endif
 
 #ifdef BKPT_SUPPORT
-        if (enableRegBreak) {
+        if (Debugger) {
             if (lowRegBreakCounter[0])
                 breakReg_check(0);
             if (lowRegBreakCounter[1])
@@ -2978,3 +3114,19 @@ int armExecute()
 
     return 1;
 }
+
+static int (*const armExecuteLoops[CPU_EXECUTE_VARIANTS])() = {
+    armExecuteLoop<false, false, false>,
+    armExecuteLoop<true, false, false>,
+    armExecuteLoop<false, true, false>,
+    armExecuteLoop<true, true, false>,
+    armExecuteLoop<false, false, true>,
+    armExecuteLoop<true, false, true>,
+    armExecuteLoop<false, true, true>,
+    armExecuteLoop<true, true, true>,
+};
+
+int armExecute()
+{
+    return armExecuteLoops[cpuExecuteVariant()]();
+}
@@ -35,7 +35,7 @@
 
 ///////////////////////////////////////////////////////////////////////////
 
-static int clockTicks;
+static GBA_LOCAL int clockTicks;
 
 static INSN_REGPARM void thumbUnknownInsn(uint32_t opcode)
 {
@@ -1856,7 +1856,6 @@ static INSN_REGPARM void thumbF8(uint32_t opcode)
 
 // Instruction table //////////////////////////////////////////////////////
 
-typedef INSN_REGPARM void (*insnfunc_t)(uint32_t opcode);
 #define thumbUI thumbUnknownInsn
 #ifdef BKPT_SUPPORT
 #define thumbBP thumbBreakpoint
@@ -1997,10 +1996,128 @@ static insnfunc_t thumbInsnTable[1024] = {
 
 // Wrapper routine (execution loop) ///////////////////////////////////////
 
-int thumbExecute()
+static thumbCachePage* thumbCacheLookup(uint32_t address)
+{
+    thumbCachePage* page = codeCacheThumbPage(address);
+    if (page && !page->valid) {
+        uint32_t base = address & ~(CODE_CACHE_PAGE_SIZE - 1);
+        for (int i = 0; i < CODE_CACHE_THUMB_INSNS; i++) {
+            uint32_t opcode = CPUReadHalfWordQuick(base + (i << 1));
+            page->insn[i].opcode = opcode;
+            page->insn[i].func = thumbInsnTable[opcode >> 6];
+        }
+        page->valid = true;
+        page->breakPoints = codeCacheBreakPoints(address);
+        codeCacheValidate(address);
+    }
+    return page;
+}
+
+// Runs code out of the decoded instruction cache with the same
+// per-instruction bookkeeping as thumbExecuteLoop(), following branches
+// for as long as they land in cached pages.  Returns the number of
+// instructions executed, or -1 when the CPU has to stop.
+template <bool Cheats, bool Breakpoints>
+static int thumbExecuteCached()
+{
+    thumbCachePage* page = thumbCacheLookup(armNextPC);
+    if (page == NULL)
+        return 0;
+
+    // the last two halfwords of a page are left to thumbExecute() so that
+    // the pipeline can always be refilled from the same page
+    int i = (armNextPC & (CODE_CACHE_PAGE_SIZE - 1)) >> 1;
+    if (i + 2 >= CODE_CACHE_THUMB_INSNS)
+        return 0;
+
+    // the pipeline may hold halfwords fetched before the page was last written
+    if (page->insn[i].opcode != cpuPrefetch[0] || page->insn[i + 1].opcode != cpuPrefetch[1])
+        return 0;
+
+    // the master code is only compared on the page holding it
+    bool master = Cheats && ((mastercode ^ armNextPC) & ~(CODE_CACHE_PAGE_SIZE - 1)) == 0;
+    int executed = 0;
+    codeCacheDirty = false;
+    for (;;) {
+        if (master && mastercode == armNextPC)
+            break;
+
+#ifndef FINAL_VERSION
+        if (armNextPC == stop)
+            break;
+#endif
+
+        const codeCacheInsn* insn = &page->insn[i];
+        cpuPrefetch[0] = insn[1].opcode;
+        cpuPrefetch[1] = insn[2].opcode;
+
+        busPrefetch = false;
+        if (busPrefetchCount & 0xFFFFFF00)
+            busPrefetchCount = 0x100 | (busPrefetchCount & 0xFF);
+        clockTicks = 0;
+        uint32_t oldArmNextPC = armNextPC;
+
+        armNextPC = reg[15].I;
+        reg[15].I += 2;
+
+#ifdef BKPT_SUPPORT
+        if (Breakpoints && page->breakPoints) {
+            memoryMap* m = &map[armNextPC >> 24];
+            if (BreakThumbCheck(m->breakPoints, armNextPC & m->mask)) {
+                if (debuggerBreakOnExecution(armNextPC, armState)) {
+                    debugger = true;
+                    return -1;
+                }
+            }
+        }
+#endif
+
+        (*insn->func)(insn->opcode);
+        executed++;
+
+        if (clockTicks < 0)
+            return -1;
+        if (clockTicks == 0)
+            clockTicks = codeTicksAccessSeq16(oldArmNextPC) + 1;
+        cpuTotalTicks += clockTicks;
+
+        if (codeCacheDirty || !(cpuTotalTicks < cpuNextEvent && !armState && !holdState && !SWITicks && !debugger))
+            break;
+
+        if (armNextPC != oldArmNextPC + 2) {
+            // the instruction refilled the pipeline itself; keep going if
+            // the target is cached as well
+            if (((armNextPC ^ oldArmNextPC) & ~(CODE_CACHE_PAGE_SIZE - 1)) != 0) {
+                page = thumbCacheLookup(armNextPC);
+                if (page == NULL)
+                    break;
+                master = Cheats && ((mastercode ^ armNextPC) & ~(CODE_CACHE_PAGE_SIZE - 1)) == 0;
+            }
+            i = (armNextPC & (CODE_CACHE_PAGE_SIZE - 1)) >> 1;
+        } else {
+            i++;
+        }
+        if (i + 2 >= CODE_CACHE_THUMB_INSNS)
+            break;
+    }
+
+    return executed;
+}
+
+// Specialized on the cheat and debugger features in use, see armExecute()
+template <bool Cheats, bool Breakpoints, bool Debugger>
+static int thumbExecuteLoop()
 {
     do {
-        if (cheatsEnabled) {
+        if (!Debugger) {
+            int cached = thumbExecuteCached<Cheats, Breakpoints>();
+            if (cached < 0)
+                return 0;
+            if (cached > 0)
+                continue;
+        }
+
+        if (Cheats) {
             cpuMasterCodeCheck();
         }
 
@@ -2027,13 +2144,15 @@ int thumbExecute()
         THUMB_PREFETCH_NEXT;
 
 #ifdef BKPT_SUPPORT
-        uint32_t memAddr = armNextPC;
-        memoryMap* m = &map[memAddr >> 24];
-        if (m->breakPoints && BreakThumbCheck(m->breakPoints, memAddr & m->mask)) {
-            if (debuggerBreakOnExecution(memAddr, armState)) {
-                // Revert tickcount?
-                debugger = true;
-                return 0;
+        if (Breakpoints) {
+            uint32_t memAddr = armNextPC;
+            memoryMap* m = &map[memAddr >> 24];
+            if (m->breakPoints && BreakThumbCheck(m->breakPoints, memAddr & m->mask)) {
+                if (debuggerBreakOnExecution(memAddr, armState)) {
+                    // Revert tickcount?
+                    debugger = true;
+                    return 0;
+                }
             }
         }
 #endif
@@ -2041,7 +2160,7 @@ int thumbExecute()
         (*thumbInsnTable[opcode >> 6])(opcode);
 
 #ifdef BKPT_SUPPORT
-        if (enableRegBreak) {
+        if (Debugger) {
             if (lowRegBreakCounter[0])
                 breakReg_check(0);
             if (lowRegBreakCounter[1])
@@ -2086,3 +2205,19 @@ int thumbExecute()
     } while (cpuTotalTicks < cpuNextEvent && !armState && !holdState && !SWITicks && !debugger);
     return 1;
 }
+
+static int (*const thumbExecuteLoops[CPU_EXECUTE_VARIANTS])() = {
+    thumbExecuteLoop<false, false, false>,
+    thumbExecuteLoop<true, false, false>,
+    thumbExecuteLoop<false, true, false>,
+    thumbExecuteLoop<true, true, false>,
+    thumbExecuteLoop<false, false, true>,
+    thumbExecuteLoop<true, false, true>,
+    thumbExecuteLoop<false, true, true>,
+    thumbExecuteLoop<true, true, true>,
+};
+
+int thumbExecute()
+{
+    return thumbExecuteLoops[cpuExecuteVariant()]();
+}
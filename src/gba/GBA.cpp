@@ -11,8 +11,12 @@
 #include "../NLS.h"
 #include "../System.h"
 #include "../Util.h"
+#ifndef __LIBRETRO__
+#include "../common/BatteryWriter.h"
+#endif
 #include "../common/ConfigManager.h"
 #include "../common/Port.h"
+#include "BreakpointStructures.h"
 #include "Cheats.h"
 #include "EEprom.h"
 #include "Flash.h"
@@ -22,6 +26,8 @@
 #include "GBAcpu.h"
 #include "GBAinline.h"
 #include "Globals.h"
+#include "RomMap.h"
+#include "Scheduler.h"
 #include "Sound.h"
 #include "Sram.h"
 #include "agbprint.h"
@@ -40,95 +46,94 @@
 extern int emulating;
 bool debugger;
 
-int SWITicks = 0;
-int IRQTicks = 0;
-
-uint32_t mastercode = 0;
-int layerEnableDelay = 0;
-bool busPrefetch = false;
-bool busPrefetchEnable = false;
-uint32_t busPrefetchCount = 0;
-int cpuDmaTicksToUpdate = 0;
-int cpuDmaCount = 0;
-bool cpuDmaHack = false;
-uint32_t cpuDmaLast = 0;
-int dummyAddress = 0;
-
-bool cpuBreakLoop = false;
-int cpuNextEvent = 0;
-
-bool intState = false;
-bool stopState = false;
-bool holdState = false;
-int holdType = 0;
-bool cpuSramEnabled = true;
-bool cpuFlashEnabled = true;
-bool cpuEEPROMEnabled = true;
-bool cpuEEPROMSensorEnabled = false;
-
-uint32_t cpuPrefetch[2];
-
-int cpuTotalTicks = 0;
+GBA_LOCAL int SWITicks = 0;
+GBA_LOCAL int IRQTicks = 0;
+
+GBA_LOCAL uint32_t mastercode = 0;
+GBA_LOCAL int layerEnableDelay = 0;
+GBA_LOCAL bool busPrefetch = false;
+GBA_LOCAL bool busPrefetchEnable = false;
+GBA_LOCAL uint32_t busPrefetchCount = 0;
+GBA_LOCAL int cpuDmaTicksToUpdate = 0;
+GBA_LOCAL int cpuDmaCount = 0;
+GBA_LOCAL bool cpuDmaHack = false;
+GBA_LOCAL uint32_t cpuDmaLast = 0;
+GBA_LOCAL int dummyAddress = 0;
+
+GBA_LOCAL bool cpuBreakLoop = false;
+GBA_LOCAL int cpuNextEvent = 0;
+
+GBA_LOCAL bool intState = false;
+GBA_LOCAL bool stopState = false;
+GBA_LOCAL bool holdState = false;
+GBA_LOCAL int holdType = 0;
+GBA_LOCAL bool cpuSramEnabled = true;
+GBA_LOCAL bool cpuFlashEnabled = true;
+GBA_LOCAL bool cpuEEPROMEnabled = true;
+GBA_LOCAL bool cpuEEPROMSensorEnabled = false;
+
+GBA_LOCAL uint32_t cpuPrefetch[2];
+
+GBA_LOCAL int cpuTotalTicks = 0;
 #ifdef PROFILING
-int profilingTicks = 0;
 int profilingTicksReload = 0;
 static profile_segment* profilSegment = NULL;
 #endif
 
 #ifdef BKPT_SUPPORT
-uint8_t freezeWorkRAM[SIZE_WRAM];
-uint8_t freezeInternalRAM[SIZE_IRAM];
-uint8_t freezeVRAM[0x18000];
-uint8_t freezePRAM[SIZE_PRAM];
-uint8_t freezeOAM[SIZE_OAM];
+GBA_LOCAL uint8_t freezeWorkRAM[SIZE_WRAM];
+GBA_LOCAL uint8_t freezeInternalRAM[SIZE_IRAM];
+GBA_LOCAL uint8_t freezeVRAM[0x18000];
+GBA_LOCAL uint8_t freezePRAM[SIZE_PRAM];
+GBA_LOCAL uint8_t freezeOAM[SIZE_OAM];
 bool debugger_last;
 #endif
 
-int lcdTicks = (useBios && !skipBios) ? 1008 : 208;
-uint8_t timerOnOffDelay = 0;
-uint16_t timer0Value = 0;
-bool timer0On = false;
-int timer0Ticks = 0;
-int timer0Reload = 0;
-int timer0ClockReload = 0;
-uint16_t timer1Value = 0;
-bool timer1On = false;
-int timer1Ticks = 0;
-int timer1Reload = 0;
-int timer1ClockReload = 0;
-uint16_t timer2Value = 0;
-bool timer2On = false;
-int timer2Ticks = 0;
-int timer2Reload = 0;
-int timer2ClockReload = 0;
-uint16_t timer3Value = 0;
-bool timer3On = false;
-int timer3Ticks = 0;
-int timer3Reload = 0;
-int timer3ClockReload = 0;
-uint32_t dma0Source = 0;
-uint32_t dma0Dest = 0;
-uint32_t dma1Source = 0;
-uint32_t dma1Dest = 0;
-uint32_t dma2Source = 0;
-uint32_t dma2Dest = 0;
-uint32_t dma3Source = 0;
-uint32_t dma3Dest = 0;
-void (*cpuSaveGameFunc)(uint32_t, uint8_t) = flashSaveDecide;
-void (*renderLine)() = mode0RenderLine;
-bool fxOn = false;
-bool windowOn = false;
-int frameCount = 0;
-char buffer[1024];
-uint32_t lastTime = 0;
-int count = 0;
-
-int capture = 0;
-int capturePrevious = 0;
-int captureNumber = 0;
-
-int armOpcodeCount = 0;
-int thumbOpcodeCount = 0;
+GBA_LOCAL int lcdTicks = 208;
+GBA_LOCAL uint8_t timerOnOffDelay = 0;
+GBA_LOCAL uint16_t timer0Value = 0;
+GBA_LOCAL bool timer0On = false;
+GBA_LOCAL int timer0Ticks = 0;
+GBA_LOCAL int timer0Reload = 0;
+GBA_LOCAL int timer0ClockReload = 0;
+GBA_LOCAL uint16_t timer1Value = 0;
+GBA_LOCAL bool timer1On = false;
+GBA_LOCAL int timer1Ticks = 0;
+GBA_LOCAL int timer1Reload = 0;
+GBA_LOCAL int timer1ClockReload = 0;
+GBA_LOCAL uint16_t timer2Value = 0;
+GBA_LOCAL bool timer2On = false;
+GBA_LOCAL int timer2Ticks = 0;
+GBA_LOCAL int timer2Reload = 0;
+GBA_LOCAL int timer2ClockReload = 0;
+GBA_LOCAL uint16_t timer3Value = 0;
+GBA_LOCAL bool timer3On = false;
+GBA_LOCAL int timer3Ticks = 0;
+GBA_LOCAL int timer3Reload = 0;
+GBA_LOCAL int timer3ClockReload = 0;
+GBA_LOCAL uint32_t dma0Source = 0;
+GBA_LOCAL uint32_t dma0Dest = 0;
+GBA_LOCAL uint32_t dma1Source = 0;
+GBA_LOCAL uint32_t dma1Dest = 0;
+GBA_LOCAL uint32_t dma2Source = 0;
+GBA_LOCAL uint32_t dma2Dest = 0;
+GBA_LOCAL uint32_t dma3Source = 0;
+GBA_LOCAL uint32_t dma3Dest = 0;
+GBA_LOCAL void (*cpuSaveGameFunc)(uint32_t, uint8_t) = flashSaveDecide;
+GBA_LOCAL void (*renderLine)() = mode0RenderLine;
+GBA_LOCAL bool fxOn = false;
+GBA_LOCAL bool windowOn = false;
+GBA_LOCAL int frameCount = 0;
+GBA_LOCAL char buffer[1024];
+GBA_LOCAL uint32_t lastTime = 0;
+GBA_LOCAL int count = 0;
+
+GBA_LOCAL int capture = 0;
+GBA_LOCAL int capturePrevious = 0;
+GBA_LOCAL int captureNumber = 0;
+
+GBA_LOCAL int armOpcodeCount = 0;
+GBA_LOCAL int thumbOpcodeCount = 0;
 
 const int TIMER_TICKS[4] = {
     0,
@@ -144,10 +149,10 @@ const uint8_t gamepakWaitState0[2] = { 2, 1 };
 const uint8_t gamepakWaitState1[2] = { 4, 1 };
 const uint8_t gamepakWaitState2[2] = { 8, 1 };
 
-uint8_t memoryWait[16] = { 0, 0, 2, 0, 0, 0, 0, 0, 4, 4, 4, 4, 4, 4, 4, 0 };
-uint8_t memoryWait32[16] = { 0, 0, 5, 0, 0, 1, 1, 0, 7, 7, 9, 9, 13, 13, 4, 0 };
-uint8_t memoryWaitSeq[16] = { 0, 0, 2, 0, 0, 0, 0, 0, 2, 2, 4, 4, 8, 8, 4, 0 };
-uint8_t memoryWaitSeq32[16] = { 0, 0, 5, 0, 0, 1, 1, 0, 5, 5, 9, 9, 17, 17, 4, 0 };
+GBA_LOCAL uint8_t memoryWait[16] = { 0, 0, 2, 0, 0, 0, 0, 0, 4, 4, 4, 4, 4, 4, 4, 0 };
+GBA_LOCAL uint8_t memoryWait32[16] = { 0, 0, 5, 0, 0, 1, 1, 0, 7, 7, 9, 9, 13, 13, 4, 0 };
+GBA_LOCAL uint8_t memoryWaitSeq[16] = { 0, 0, 2, 0, 0, 0, 0, 0, 2, 2, 4, 4, 8, 8, 4, 0 };
+GBA_LOCAL uint8_t memoryWaitSeq32[16] = { 0, 0, 5, 0, 0, 1, 1, 0, 5, 5, 9, 9, 17, 17, 4, 0 };
 
 // The videoMemoryWait constants are used to add some waitstates
 // if the opcode access video memory data outside of vblank/hblank
@@ -156,7 +161,7 @@ uint8_t memoryWaitSeq32[16] = { 0, 0, 5, 0, 0, 1, 1, 0, 5, 5, 9, 9, 17, 17, 4, 0
 //const uint8_t videoMemoryWait[16] =
 //  {0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
-uint8_t biosProtected[4];
+GBA_LOCAL uint8_t biosProtected[4];
 
 #ifdef WORDS_BIGENDIAN
 bool cpuBiosSwapped = false;
@@ -338,7 +343,7 @@ uint32_t myROM[] = {
     0x03007FE0
 };
 
-variable_desc saveGameStruct[] = {
+static GBA_LOCAL variable_desc saveGameStruct[] = {
     { &DISPCNT, sizeof(uint16_t) },
     { &DISPSTAT, sizeof(uint16_t) },
     { &VCOUNT, sizeof(uint16_t) },
@@ -457,12 +462,13 @@ variable_desc saveGameStruct[] = {
     { NULL, 0 }
 };
 
-static int romSize = SIZE_ROM;
+static GBA_LOCAL int romSize = SIZE_ROM;
 
 void gbaUpdateRomSize(int size)
 {
     // Only change memory block if new size is larger
     if (size > romSize) {
+        gbaDetachRom();
         romSize = size;
 
         uint8_t* tmp = (uint8_t*)realloc(rom, SIZE_ROM);
@@ -473,51 +479,82 @@ void gbaUpdateRomSize(int size)
             WRITE16LE(temp, (i >> 1) & 0xFFFF);
             temp++;
         }
+        codeCacheFlush();
     }
 }
 
+void gbaDetachRom()
+{
+    if (!romMapActive())
+        return;
+
+    uint8_t* copy = (uint8_t*)malloc(SIZE_ROM);
+    if (copy == NULL) {
+        systemMessage(MSG_OUT_OF_MEMORY, N_("Failed to allocate memory for %s"),
+            "ROM");
+        return;
+    }
+
+    memcpy(copy, rom, SIZE_ROM);
+    romMapRelease();
+    rom = copy;
+}
+
 #ifdef PROFILING
 void cpuProfil(profile_segment* seg)
 {
     profilSegment = seg;
 }
 
+static void cpuProfilingSample(int late)
+{
+    if (profilSegment) {
+        profile_segment* seg = profilSegment;
+        do {
+            uint16_t* b = (uint16_t*)seg->sbuf;
+            int pc = ((reg[15].I - seg->s_lowpc) * seg->s_scale) / 0x10000;
+            if (pc >= 0 && pc < seg->ssiz) {
+                b[pc]++;
+                break;
+            }
+
+            seg = seg->next;
+        } while (seg);
+    }
+    schedulerAdd(SCHEDULER_PROFILING, profilingTicksReload - late, cpuProfilingSample);
+}
+
 void cpuEnableProfiling(int hz)
 {
     if (hz == 0)
         hz = 100;
-    profilingTicks = profilingTicksReload = 16777216 / hz;
+    profilingTicksReload = 16777216 / hz;
     profSetHertz(hz);
+    schedulerAdd(SCHEDULER_PROFILING, profilingTicksReload, cpuProfilingSample);
 }
 #endif
 
-inline int CPUUpdateTicks()
+int cpuExecuteVariant()
 {
-    int cpuLoopTicks = lcdTicks;
-
-    //if (soundTicks < cpuLoopTicks)
-        //cpuLoopTicks = soundTicks;
+    int variant = 0;
 
-    if (timer0On && (timer0Ticks < cpuLoopTicks)) {
-        cpuLoopTicks = timer0Ticks;
-    }
-    if (timer1On && !(TM1CNT & 4) && (timer1Ticks < cpuLoopTicks)) {
-        cpuLoopTicks = timer1Ticks;
-    }
-    if (timer2On && !(TM2CNT & 4) && (timer2Ticks < cpuLoopTicks)) {
-        cpuLoopTicks = timer2Ticks;
-    }
-    if (timer3On && !(TM3CNT & 4) && (timer3Ticks < cpuLoopTicks)) {
-        cpuLoopTicks = timer3Ticks;
-    }
-#ifdef PROFILING
-    if (profilingTicksReload != 0) {
-        if (profilingTicks < cpuLoopTicks) {
-            cpuLoopTicks = profilingTicks;
-        }
-    }
+    if (cheatsEnabled && mastercode)
+        variant |= CPU_EXECUTE_CHEATS;
+#ifdef BKPT_SUPPORT
+    if (hasConditionalBreaks())
+        variant |= CPU_EXECUTE_BREAKPOINTS;
+    if (enableRegBreak)
+        variant |= CPU_EXECUTE_DEBUGGER;
 #endif
 
+    return variant;
+}
+
+inline int CPUUpdateTicks()
+{
+    // the LCD and the timers are on the queue
+    int cpuLoopTicks = schedulerTicks;
+
     if (SWITicks) {
         if (SWITicks < cpuLoopTicks)
             cpuLoopTicks = SWITicks;
@@ -531,6 +568,180 @@ inline int CPUUpdateTicks()
     return cpuLoopTicks;
 }
 
+// A timer counts on its own when it is on and not cascaded (timer 0 never
+// is).  Those timers are events on the queue and their counters are worked
+// out from what is left of the countdown when the CPU reads them.  A
+// cascaded timer counts up when the one before it overflows.
+
+static void CPUCountTimer3()
+{
+    TM3D++;
+    if (TM3D == 0) {
+        TM3D += timer3Reload;
+        if (TM3CNT & 0x40) {
+            IF |= 0x40;
+            UPDATE_REG(0x202, IF);
+        }
+    }
+    UPDATE_REG(0x10C, TM3D);
+}
+
+static void CPUTimer2Overflow()
+{
+    if (TM2CNT & 0x40) {
+        IF |= 0x20;
+        UPDATE_REG(0x202, IF);
+    }
+    if (timer3On && (TM3CNT & 4))
+        CPUCountTimer3();
+}
+
+static void CPUCountTimer2()
+{
+    TM2D++;
+    if (TM2D == 0) {
+        TM2D += timer2Reload;
+        CPUTimer2Overflow();
+    }
+    UPDATE_REG(0x108, TM2D);
+}
+
+static void CPUTimer1Overflow()
+{
+    soundTimerOverflow(1);
+    if (TM1CNT & 0x40) {
+        IF |= 0x10;
+        UPDATE_REG(0x202, IF);
+    }
+    if (timer2On && (TM2CNT & 4))
+        CPUCountTimer2();
+}
+
+static void CPUCountTimer1()
+{
+    TM1D++;
+    if (TM1D == 0) {
+        TM1D += timer1Reload;
+        CPUTimer1Overflow();
+    }
+    UPDATE_REG(0x104, TM1D);
+}
+
+static void CPUTimer0Overflow()
+{
+    soundTimerOverflow(0);
+    if (TM0CNT & 0x40) {
+        IF |= 0x08;
+        UPDATE_REG(0x202, IF);
+    }
+    if (timer1On && (TM1CNT & 4))
+        CPUCountTimer1();
+}
+
+static void CPUTimer0Event(int late)
+{
+    schedulerAdd(SCHEDULER_TIMER0, ((0x10000 - timer0Reload) << timer0ClockReload) - late, CPUTimer0Event);
+    CPUTimer0Overflow();
+}
+
+static void CPUTimer1Event(int late)
+{
+    schedulerAdd(SCHEDULER_TIMER1, ((0x10000 - timer1Reload) << timer1ClockReload) - late, CPUTimer1Event);
+    CPUTimer1Overflow();
+}
+
+static void CPUTimer2Event(int late)
+{
+    schedulerAdd(SCHEDULER_TIMER2, ((0x10000 - timer2Reload) << timer2ClockReload) - late, CPUTimer2Event);
+    CPUTimer2Overflow();
+}
+
+static void CPUTimer3Event(int late)
+{
+    schedulerAdd(SCHEDULER_TIMER3, ((0x10000 - timer3Reload) << timer3ClockReload) - late, CPUTimer3Event);
+    if (TM3CNT & 0x40) {
+        IF |= 0x40;
+        UPDATE_REG(0x202, IF);
+    }
+}
+
+// Copies the countdowns of the timers on the queue to timer0Ticks-timer3Ticks
+// and their counters to TM0D-TM3D
+static void CPUSyncTimers()
+{
+    if (schedulerPending(SCHEDULER_TIMER0)) {
+        timer0Ticks = schedulerLeft(SCHEDULER_TIMER0);
+        TM0D = 0xFFFF - (timer0Ticks >> timer0ClockReload);
+        UPDATE_REG(0x100, TM0D);
+    }
+    if (schedulerPending(SCHEDULER_TIMER1)) {
+        timer1Ticks = schedulerLeft(SCHEDULER_TIMER1);
+        TM1D = 0xFFFF - (timer1Ticks >> timer1ClockReload);
+        UPDATE_REG(0x104, TM1D);
+    }
+    if (schedulerPending(SCHEDULER_TIMER2)) {
+        timer2Ticks = schedulerLeft(SCHEDULER_TIMER2);
+        TM2D = 0xFFFF - (timer2Ticks >> timer2ClockReload);
+        UPDATE_REG(0x108, TM2D);
+    }
+    if (schedulerPending(SCHEDULER_TIMER3)) {
+        timer3Ticks = schedulerLeft(SCHEDULER_TIMER3);
+        TM3D = 0xFFFF - (timer3Ticks >> timer3ClockReload);
+        UPDATE_REG(0x10C, TM3D);
+    }
+}
+
+// Queues the timers that count on their own with the countdowns in
+// timer0Ticks-timer3Ticks, and takes the others off the queue
+static void CPUScheduleTimers()
+{
+    if (timer0On)
+        schedulerAdd(SCHEDULER_TIMER0, timer0Ticks, CPUTimer0Event);
+    else
+        schedulerRemove(SCHEDULER_TIMER0);
+    if (timer1On && !(TM1CNT & 4))
+        schedulerAdd(SCHEDULER_TIMER1, timer1Ticks, CPUTimer1Event);
+    else
+        schedulerRemove(SCHEDULER_TIMER1);
+    if (timer2On && !(TM2CNT & 4))
+        schedulerAdd(SCHEDULER_TIMER2, timer2Ticks, CPUTimer2Event);
+    else
+        schedulerRemove(SCHEDULER_TIMER2);
+    if (timer3On && !(TM3CNT & 4))
+        schedulerAdd(SCHEDULER_TIMER3, timer3Ticks, CPUTimer3Event);
+    else
+        schedulerRemove(SCHEDULER_TIMER3);
+}
+
+// The timers stand still in stop state
+static void CPUDelayTimers(int ticks)
+{
+    if (schedulerPending(SCHEDULER_TIMER0))
+        schedulerAdd(SCHEDULER_TIMER0, schedulerLeft(SCHEDULER_TIMER0) + ticks, CPUTimer0Event);
+    if (schedulerPending(SCHEDULER_TIMER1))
+        schedulerAdd(SCHEDULER_TIMER1, schedulerLeft(SCHEDULER_TIMER1) + ticks, CPUTimer1Event);
+    if (schedulerPending(SCHEDULER_TIMER2))
+        schedulerAdd(SCHEDULER_TIMER2, schedulerLeft(SCHEDULER_TIMER2) + ticks, CPUTimer2Event);
+    if (schedulerPending(SCHEDULER_TIMER3))
+        schedulerAdd(SCHEDULER_TIMER3, schedulerLeft(SCHEDULER_TIMER3) + ticks, CPUTimer3Event);
+}
+
+static void CPULcdEvent(int late);
+
+// Savestates keep lcdTicks and timer0Ticks-timer3Ticks, the cycles left
+// until each is due.  These move them between the state and the queue.
+static void CPUSaveEventTicks()
+{
+    lcdTicks = schedulerLeft(SCHEDULER_LCD);
+    CPUSyncTimers();
+}
+
+static void CPULoadEventTicks()
+{
+    schedulerAdd(SCHEDULER_LCD, lcdTicks, CPULcdEvent);
+    CPUScheduleTimers();
+}
+
 void CPUUpdateWindow0()
 {
     int x00 = WIN0H >> 8;
@@ -563,10 +774,10 @@ void CPUUpdateWindow1()
     }
 }
 
-extern uint32_t line0[240];
-extern uint32_t line1[240];
-extern uint32_t line2[240];
-extern uint32_t line3[240];
+extern GBA_LOCAL uint32_t line0[240];
+extern GBA_LOCAL uint32_t line1[240];
+extern GBA_LOCAL uint32_t line2[240];
+extern GBA_LOCAL uint32_t line3[240];
 
 #define CLEAR_ARRAY(a)                  \
     {                                   \
@@ -592,6 +803,319 @@ void CPUUpdateRenderBuffers(bool force)
     }
 }
 
+// Rebuilds everything derived from the state after one was loaded
+static void CPUStateLoaded()
+{
+    // set pointers!
+    layerEnable = layerSettings & DISPCNT;
+
+    CPUUpdateRender();
+    CPUUpdateRenderBuffers(true);
+    CPUUpdateWindow0();
+    CPUUpdateWindow1();
+
+    SetSaveType(saveType);
+    CPULoadEventTicks();
+
+    systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
+    codeCacheFlush();
+    tileCacheFlush();
+    if (armState) {
+        ARM_PREFETCH;
+    } else {
+        THUMB_PREFETCH;
+    }
+
+    CPUUpdateRegister(0x204, CPUReadHalfWordQuick(0x4000204));
+}
+
+static bool CPUCheckStateRom(uint8_t* romname, bool ub)
+{
+    if (memcmp(&rom[0xa0], romname, 16) != 0) {
+        char name[17];
+        for (int i = 0; i < 16; i++)
+            name[i] = romname[i] < 32 ? 32 : romname[i];
+        name[16] = 0;
+        systemMessage(MSG_CANNOT_LOAD_SGM, N_("Cannot load save game for %s"), name);
+        return false;
+    }
+
+    if (ub != useBios) {
+        if (useBios)
+            systemMessage(MSG_SAVE_GAME_NOT_USING_BIOS,
+                N_("Save game is not using the BIOS files"));
+        else
+            systemMessage(MSG_SAVE_GAME_USING_BIOS,
+                N_("Save game is using the BIOS file"));
+        return false;
+    }
+
+    return true;
+}
+
+// Binary save states
+//
+// Uncompressed layout for states that are saved and loaded often, like
+// rewind snapshots or netplay and movie tools.  A header and a table of
+// sections are followed by the sections, each one starting on a 64 byte
+// boundary, so the memory areas are plain copies and a mapped file can be
+// read in place.  Readers skip sections they do not know and refuse known
+// ones with a different size.  Unlike the zlib states the cheats list is
+// not saved.  Written to a file it goes through zlib, compressed or not.
+
+#define BINARY_STATE_MAGIC 0x42414256 // "VBAB"
+#define BINARY_STATE_VERSION 1
+#define BINARY_STATE_ALIGN 64
+#define BINARY_STATE_ID(a, b, c, d) ((uint32_t)(a) | (b) << 8 | (c) << 16 | (uint32_t)(d) << 24)
+
+struct BinaryStateHeader {
+    uint32_t magic;
+    uint32_t version;
+    // of the whole state
+    uint32_t size;
+    uint32_t sections;
+    uint8_t romname[16];
+    uint32_t useBios;
+    // SAVE_GAME_VERSION of the sound and save chip sections
+    uint32_t saveVersion;
+};
+
+struct BinaryStateSection {
+    uint32_t id;
+    uint32_t offset;
+    uint32_t size;
+};
+
+enum {
+    BINARY_STATE_CPU,
+    BINARY_STATE_IWRAM,
+    BINARY_STATE_WRAM,
+    BINARY_STATE_VRAM,
+    BINARY_STATE_OAM,
+    BINARY_STATE_PRAM,
+    BINARY_STATE_IO,
+    BINARY_STATE_PIX,
+    BINARY_STATE_SOUND,
+    BINARY_STATE_SAVE,
+    BINARY_STATE_RTC,
+    BINARY_STATE_SECTIONS
+};
+
+static const uint32_t binaryStateIds[BINARY_STATE_SECTIONS] = {
+    BINARY_STATE_ID('C', 'P', 'U', ' '),
+    BINARY_STATE_ID('I', 'W', 'R', 'M'),
+    BINARY_STATE_ID('W', 'R', 'A', 'M'),
+    BINARY_STATE_ID('V', 'R', 'A', 'M'),
+    BINARY_STATE_ID('O', 'A', 'M', ' '),
+    BINARY_STATE_ID('P', 'R', 'A', 'M'),
+    BINARY_STATE_ID('I', 'O', ' ', ' '),
+    BINARY_STATE_ID('P', 'I', 'X', ' '),
+    BINARY_STATE_ID('S', 'N', 'D', ' '),
+    BINARY_STATE_ID('S', 'A', 'V', 'E'),
+    BINARY_STATE_ID('R', 'T', 'C', ' ')
+};
+
+// Sections as this build writes them, set up by CPUBinaryStateSize()
+static GBA_LOCAL BinaryStateSection binaryStateLayout[BINARY_STATE_SECTIONS];
+static GBA_LOCAL uint32_t binaryStateSize = 0;
+
+static uint32_t CPUWriteBinaryStateData(uint8_t* base)
+{
+    BinaryStateHeader* header = (BinaryStateHeader*)base;
+    BinaryStateSection* sections = (BinaryStateSection*)(header + 1);
+    uint8_t* data = (uint8_t*)(sections + BINARY_STATE_SECTIONS);
+
+    for (int i = 0; i < BINARY_STATE_SECTIONS; i++) {
+        // padding is zeroed so equal states are equal bytes
+        uint8_t* start = base + ((data - base + BINARY_STATE_ALIGN - 1) & ~(BINARY_STATE_ALIGN - 1));
+        memset(data, 0, start - data);
+        data = start;
+
+        sections[i].id = binaryStateIds[i];
+        sections[i].offset = (uint32_t)(data - base);
+
+        switch (i) {
+        case BINARY_STATE_CPU:
+            CPUSaveEventTicks();
+            utilWriteMem(data, &reg[0], sizeof(reg));
+            utilWriteDataMem(data, saveGameStruct);
+            utilWriteIntMem(data, stopState);
+            utilWriteIntMem(data, IRQTicks);
+            break;
+        case BINARY_STATE_IWRAM:
+            utilWriteMem(data, internalRAM, SIZE_IRAM);
+            break;
+        case BINARY_STATE_WRAM:
+            utilWriteMem(data, workRAM, SIZE_WRAM);
+            break;
+        case BINARY_STATE_VRAM:
+            utilWriteMem(data, vram, SIZE_VRAM);
+            break;
+        case BINARY_STATE_OAM:
+            utilWriteMem(data, oam, SIZE_OAM);
+            break;
+        case BINARY_STATE_PRAM:
+            utilWriteMem(data, paletteRAM, SIZE_PRAM);
+            break;
+        case BINARY_STATE_IO:
+            utilWriteMem(data, ioMem, SIZE_IOMEM);
+            break;
+        case BINARY_STATE_PIX:
+            utilWriteMem(data, pix, SIZE_PIX);
+            break;
+        case BINARY_STATE_SOUND:
+            soundSaveGame(data);
+            break;
+        case BINARY_STATE_SAVE:
+            eepromSaveGame(data);
+            flashSaveGame(data);
+            break;
+        case BINARY_STATE_RTC:
+            rtcSaveGame(data);
+            break;
+        }
+
+        sections[i].size = (uint32_t)(data - base) - sections[i].offset;
+    }
+
+    header->magic = BINARY_STATE_MAGIC;
+    header->version = BINARY_STATE_VERSION;
+    header->size = (uint32_t)(data - base);
+    header->sections = BINARY_STATE_SECTIONS;
+    memcpy(header->romname, &rom[0xa0], 16);
+    header->useBios = useBios;
+    header->saveVersion = SAVE_GAME_VERSION;
+
+    return header->size;
+}
+
+size_t CPUBinaryStateSize()
+{
+    if (!binaryStateSize) {
+        // the sound and save chip sections are a few variable tables and
+        // at most a 128K flash image
+        size_t scratchSize = sizeof(BinaryStateHeader) + sizeof(binaryStateLayout)
+            + BINARY_STATE_SECTIONS * BINARY_STATE_ALIGN
+            + SIZE_IRAM + SIZE_WRAM + SIZE_VRAM + SIZE_OAM + SIZE_PRAM
+            + SIZE_IOMEM + SIZE_PIX + SIZE_FLASH1M + SIZE_EEPROM_8K + 0x10000;
+        uint8_t* scratch = (uint8_t*)malloc(scratchSize);
+
+        if (scratch == NULL)
+            return 0;
+
+        binaryStateSize = CPUWriteBinaryStateData(scratch);
+        memcpy(binaryStateLayout, scratch + sizeof(BinaryStateHeader), sizeof(binaryStateLayout));
+        free(scratch);
+    }
+
+    return binaryStateSize;
+}
+
+size_t CPUWriteBinaryState(uint8_t* data, size_t size)
+{
+    size_t needed = CPUBinaryStateSize();
+
+    if (!needed || size < needed)
+        return 0;
+
+    return CPUWriteBinaryStateData(data);
+}
+
+bool CPUIsBinaryState(const uint8_t* data, size_t size)
+{
+    uint32_t magic;
+
+    if (size < sizeof(magic))
+        return false;
+
+    memcpy(&magic, data, sizeof(magic));
+    return magic == BINARY_STATE_MAGIC;
+}
+
+bool CPUReadBinaryState(const uint8_t* data, size_t size)
+{
+    BinaryStateHeader header;
+
+    if (!CPUIsBinaryState(data, size) || size < sizeof(header) || !CPUBinaryStateSize())
+        return false;
+
+    memcpy(&header, data, sizeof(header));
+
+    if (header.version != BINARY_STATE_VERSION || header.saveVersion != SAVE_GAME_VERSION) {
+        systemMessage(MSG_UNSUPPORTED_VBA_SGM,
+            N_("Unsupported VisualBoyAdvance save game version %d"),
+            header.version);
+        return false;
+    }
+
+    if (header.size > size || header.sections > (header.size - sizeof(header)) / sizeof(BinaryStateSection))
+        return false;
+
+    if (!CPUCheckStateRom(header.romname, header.useBios ? true : false))
+        return false;
+
+    // find all sections before touching anything
+    const uint8_t* sections[BINARY_STATE_SECTIONS] = { NULL };
+    for (uint32_t i = 0; i < header.sections; i++) {
+        BinaryStateSection section;
+        memcpy(&section, data + sizeof(header) + i * sizeof(section), sizeof(section));
+
+        if (section.offset > header.size || section.size > header.size - section.offset)
+            return false;
+
+        for (int k = 0; k < BINARY_STATE_SECTIONS; k++) {
+            if (section.id != binaryStateIds[k])
+                continue;
+            if (section.size != binaryStateLayout[k].size)
+                return false;
+            sections[k] = data + section.offset;
+        }
+    }
+    for (int k = 0; k < BINARY_STATE_SECTIONS; k++)
+        if (sections[k] == NULL)
+            return false;
+
+    int version = header.saveVersion;
+    const uint8_t* in = sections[BINARY_STATE_CPU];
+
+    utilReadMem(&reg[0], in, sizeof(reg));
+    utilReadDataMem(in, saveGameStruct);
+
+    stopState = utilReadIntMem(in) ? true : false;
+
+    IRQTicks = utilReadIntMem(in);
+    if (IRQTicks > 0)
+        intState = true;
+    else {
+        intState = false;
+        IRQTicks = 0;
+    }
+
+    memcpy(internalRAM, sections[BINARY_STATE_IWRAM], SIZE_IRAM);
+    memcpy(workRAM, sections[BINARY_STATE_WRAM], SIZE_WRAM);
+    memcpy(vram, sections[BINARY_STATE_VRAM], SIZE_VRAM);
+    memcpy(oam, sections[BINARY_STATE_OAM], SIZE_OAM);
+    memcpy(paletteRAM, sections[BINARY_STATE_PRAM], SIZE_PRAM);
+    memcpy(ioMem, sections[BINARY_STATE_IO], SIZE_IOMEM);
+    memcpy(pix, sections[BINARY_STATE_PIX], SIZE_PIX);
+
+    in = sections[BINARY_STATE_SOUND];
+    soundReadGame(in, version);
+
+    if (!skipSaveGameBattery) {
+        in = sections[BINARY_STATE_SAVE];
+        eepromReadGame(in, version);
+        flashReadGame(in, version);
+    }
+
+    in = sections[BINARY_STATE_RTC];
+    rtcReadGame(in);
+
+    CPUStateLoaded();
+
+    return true;
+}
+
 #ifdef __LIBRETRO__
 #include <stddef.h>
 
@@ -604,6 +1128,7 @@ unsigned int CPUWriteState(uint8_t* data, unsigned size)
     utilWriteIntMem(data, useBios);
     utilWriteMem(data, &reg[0], sizeof(reg));
 
+    CPUSaveEventTicks();
     utilWriteDataMem(data, saveGameStruct);
 
     utilWriteIntMem(data, stopState);
@@ -672,32 +1197,7 @@ bool CPUReadState(const uint8_t* data, unsigned size)
     soundReadGame(data, version);
     rtcReadGame(data);
 
-    //// Copypasta stuff ...
-    // set pointers!
-    layerEnable = layerSettings & DISPCNT;
-
-    CPUUpdateRender();
-
-    // CPU Update Render Buffers set to true
-    CLEAR_ARRAY(line0);
-    CLEAR_ARRAY(line1);
-    CLEAR_ARRAY(line2);
-    CLEAR_ARRAY(line3);
-    // End of CPU Update Render Buffers set to true
-
-    CPUUpdateWindow0();
-    CPUUpdateWindow1();
-
-    SetSaveType(saveType);
-
-    systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
-    if (armState) {
-        ARM_PREFETCH;
-    } else {
-        THUMB_PREFETCH;
-    }
-
-    CPUUpdateRegister(0x204, CPUReadHalfWordQuick(0x4000204));
+    CPUStateLoaded();
 
     return true;
 }
@@ -714,6 +1214,7 @@ static bool CPUWriteState(gzFile gzFile)
 
     utilGzWrite(gzFile, &reg[0], sizeof(reg));
 
+    CPUSaveEventTicks();
     utilWriteData(gzFile, saveGameStruct);
 
     // new to version 0.7.1
@@ -777,10 +1278,76 @@ bool CPUWriteMemState(char* memory, int available, long& reserved)
     return res;
 }
 
+bool CPUWriteMemStateRaw(char* memory, int available, long& reserved)
+{
+    reserved = (long)CPUWriteBinaryState((uint8_t*)memory, available);
+
+    return reserved != 0;
+}
+
+bool CPUWriteBinaryState(const char* file, bool compress)
+{
+    size_t size = CPUBinaryStateSize();
+    uint8_t* data = size ? (uint8_t*)malloc(size) : NULL;
+
+    if (data == NULL)
+        return false;
+
+    CPUWriteBinaryState(data, size);
+
+    gzFile gzFile = utilGzOpen(file, compress ? "wb" : "wbT");
+
+    if (gzFile == NULL) {
+        systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"), file);
+        free(data);
+        return false;
+    }
+
+    bool res = utilGzWrite(gzFile, data, (unsigned)size) == (int)size;
+
+    utilGzClose(gzFile);
+    free(data);
+
+    return res;
+}
+
+// Reads the rest of a binary state after its magic
+static bool CPUReadBinaryState(gzFile gzFile)
+{
+    BinaryStateHeader header;
+    header.magic = BINARY_STATE_MAGIC;
+
+    unsigned rest = sizeof(header) - sizeof(header.magic);
+    if (utilGzRead(gzFile, (uint8_t*)&header + sizeof(header.magic), rest) != (int)rest)
+        return false;
+
+    // larger than anything this build writes is not a state it can load
+    if (header.size < sizeof(header) || header.size > 2 * CPUBinaryStateSize())
+        return false;
+
+    uint8_t* data = (uint8_t*)malloc(header.size);
+
+    if (data == NULL)
+        return false;
+
+    memcpy(data, &header, sizeof(header));
+    rest = header.size - sizeof(header);
+
+    bool res = utilGzRead(gzFile, data + sizeof(header), rest) == (int)rest
+        && CPUReadBinaryState(data, header.size);
+
+    free(data);
+
+    return res;
+}
+
 static bool CPUReadState(gzFile gzFile)
 {
     int version = utilReadInt(gzFile);
 
+    if ((uint32_t)version == BINARY_STATE_MAGIC)
+        return CPUReadBinaryState(gzFile);
+
     if (version > SAVE_GAME_VERSION || version < SAVE_GAME_VERSION_1) {
         systemMessage(MSG_UNSUPPORTED_VBA_SGM,
             N_("Unsupported VisualBoyAdvance save game version %d"),
@@ -788,30 +1355,14 @@ static bool CPUReadState(gzFile gzFile)
         return false;
     }
 
-    uint8_t romname[17];
+    uint8_t romname[16];
 
     utilGzRead(gzFile, romname, 16);
 
-    if (memcmp(&rom[0xa0], romname, 16) != 0) {
-        romname[16] = 0;
-        for (int i = 0; i < 16; i++)
-            if (romname[i] < 32)
-                romname[i] = 32;
-        systemMessage(MSG_CANNOT_LOAD_SGM, N_("Cannot load save game for %s"), romname);
-        return false;
-    }
-
     bool ub = utilReadInt(gzFile) ? true : false;
 
-    if (ub != useBios) {
-        if (useBios)
-            systemMessage(MSG_SAVE_GAME_NOT_USING_BIOS,
-                N_("Save game is not using the BIOS files"));
-        else
-            systemMessage(MSG_SAVE_GAME_USING_BIOS,
-                N_("Save game is using the BIOS file"));
+    if (!CPUCheckStateRom(romname, ub))
         return false;
-    }
 
     utilGzRead(gzFile, &reg[0], sizeof(reg));
 
@@ -900,30 +1451,16 @@ static bool CPUReadState(gzFile gzFile)
         interp_rate();
     }
 
-    // set pointers!
-    layerEnable = layerSettings & DISPCNT;
-
-    CPUUpdateRender();
-    CPUUpdateRenderBuffers(true);
-    CPUUpdateWindow0();
-    CPUUpdateWindow1();
-
-    SetSaveType(saveType);
-
-    systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
-    if (armState) {
-        ARM_PREFETCH;
-    } else {
-        THUMB_PREFETCH;
-    }
-
-    CPUUpdateRegister(0x204, CPUReadHalfWordQuick(0x4000204));
+    CPUStateLoaded();
 
     return true;
 }
 
 bool CPUReadMemState(char* memory, int available)
 {
+    if (CPUIsBinaryState((const uint8_t*)memory, available))
+        return CPUReadBinaryState((const uint8_t*)memory, available);
+
     gzFile gzFile = utilMemGzOpen(memory, available, "r");
 
     bool res = CPUReadState(gzFile);
@@ -973,41 +1510,49 @@ bool CPUExportEepromFile(const char* fileName)
     return true;
 }
 
-bool CPUWriteBatteryFile(const char* fileName)
+#ifndef __LIBRETRO__
+// The battery file as it goes on disk, false if the game has none
+static bool CPUBatteryImage(std::vector<uint8_t>& image)
 {
-    if ((saveType) && (saveType != GBA_SAVE_NONE)) {
-        FILE* file = utilOpenFile(fileName, "wb");
+    image.clear();
 
-        if (!file) {
-            systemMessage(MSG_ERROR_CREATING_FILE, N_("Error creating file %s"),
-                fileName);
-            return false;
-        }
+    if (!saveType || saveType == GBA_SAVE_NONE)
+        return false;
 
-        // only save if Flash/Sram in use or EEprom in use
-        if (!eepromInUse) {
-            if (saveType == GBA_SAVE_FLASH) { // save flash type
-                if (fwrite(flashSaveMemory, 1, flashSize, file) != (size_t)flashSize) {
-                    fclose(file);
-                    return false;
-                }
-            } else if (saveType == GBA_SAVE_SRAM) { // save sram type
-                if (fwrite(flashSaveMemory, 1, 0x8000, file) != 0x8000) {
-                    fclose(file);
-                    return false;
-                }
-            }
-        } else { // save eeprom type
-            if (fwrite(eepromData, 1, eepromSize, file) != (size_t)eepromSize) {
-                fclose(file);
-                return false;
-            }
-        }
-        fclose(file);
+    // only save if Flash/Sram in use or EEprom in use
+    if (!eepromInUse) {
+        if (saveType == GBA_SAVE_FLASH) // save flash type
+            image.assign(flashSaveMemory, flashSaveMemory + flashSize);
+        else if (saveType == GBA_SAVE_SRAM) // save sram type
+            image.assign(flashSaveMemory, flashSaveMemory + 0x8000);
+    } else { // save eeprom type
+        image.assign(eepromData, eepromData + eepromSize);
     }
     return true;
 }
 
+bool CPUWriteBatteryFile(const char* fileName)
+{
+    std::vector<uint8_t> image;
+
+    if (!CPUBatteryImage(image))
+        return true;
+
+    bool ok = batteryWriter.write(fileName, image);
+    return batteryWriter.flush() && ok;
+}
+
+bool CPUWriteBatteryFileAsync(const char* fileName)
+{
+    std::vector<uint8_t> image;
+
+    if (!CPUBatteryImage(image))
+        return true;
+
+    return batteryWriter.write(fileName, image);
+}
+#endif
+
 bool CPUReadGSASnapshot(const char* fileName)
 {
     int i;
@@ -1367,12 +1912,16 @@ void CPUCleanUp()
 {
 #ifdef PROFILING
     if (profilingTicksReload) {
+        schedulerRemove(SCHEDULER_PROFILING);
         profCleanup();
     }
 #endif
 
     if (rom != NULL) {
-        free(rom);
+        if (romMapActive())
+            romMapRelease();
+        else
+            free(rom);
         rom = NULL;
     }
 
@@ -1420,6 +1969,8 @@ void CPUCleanUp()
     elfCleanUp();
 #endif //NO_DEBUGGER
 
+    codeCacheCleanUp();
+
     systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
 
     emulating = 0;
@@ -1466,6 +2017,34 @@ void SetMapMasks()
 #endif
 }
 
+// Whether szFile names an image utilLoad() would read as it is, which is
+// what romMapLoad() may map instead.  The libretro core loads from memory
+// and has neither the mapping nor utilStripDoubleExtension().
+static bool CPUCanMapRom(const char* szFile)
+{
+#ifdef __LIBRETRO__
+    (void)szFile;
+    return false;
+#else
+    char buffer[2048];
+    if (strlen(szFile) >= sizeof(buffer))
+        return false;
+
+#ifndef NO_DEBUGGER
+    if (CPUIsELF(szFile))
+        return false;
+#endif
+
+    // utilIsGBAImage() also tells multiboot images apart, which is left to
+    // utilLoad() as before
+    bool multiBoot = cpuIsMultiBoot;
+    utilStripDoubleExtension(szFile, buffer);
+    bool accepted = utilIsGBAImage(buffer) && !cpuIsMultiBoot;
+    cpuIsMultiBoot = multiBoot;
+    return accepted;
+#endif
+}
+
 int CPULoadRom(const char* szFile)
 {
     romSize = SIZE_ROM;
@@ -1475,7 +2054,14 @@ int CPULoadRom(const char* szFile)
 
     systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
 
-    rom = (uint8_t*)malloc(SIZE_ROM);
+    // plain images utilLoad() would accept are mapped rather than read, see
+    // RomMap.h
+    rom = NULL;
+    if (szFile != NULL && !cpuIsMultiBoot && CPUCanMapRom(szFile))
+        rom = romMapLoad(szFile, romSize);
+
+    if (rom == NULL)
+        rom = (uint8_t*)malloc(SIZE_ROM);
     if (rom == NULL) {
         systemMessage(MSG_OUT_OF_MEMORY, N_("Failed to allocate memory for %s"),
             "ROM");
@@ -1490,8 +2076,11 @@ int CPULoadRom(const char* szFile)
 
     uint8_t* whereToLoad = cpuIsMultiBoot ? workRAM : rom;
 
+    if (romMapActive()) {
+        // the pattern below is part of the mapping
+    }
 #ifndef NO_DEBUGGER
-    if (CPUIsELF(szFile)) {
+    else if (CPUIsELF(szFile)) {
         FILE* f = utilOpenFile(szFile, "rb");
         if (!f) {
             systemMessage(MSG_ERROR_OPENING_IMAGE, N_("Error opening image %s"),
@@ -1511,9 +2100,9 @@ int CPULoadRom(const char* szFile)
             elfCleanUp();
             return 0;
         }
-    } else
+    }
 #endif //NO_DEBUGGER
-        if (szFile != NULL) {
+    else if (szFile != NULL) {
         if (!utilLoad(szFile,
                 utilIsGBAImage,
                 whereToLoad,
@@ -1526,11 +2115,12 @@ int CPULoadRom(const char* szFile)
         }
     }
 
-    uint16_t* temp = (uint16_t*)(rom + ((romSize + 1) & ~1));
-    int i;
-    for (i = (romSize + 1) & ~1; i < SIZE_ROM; i += 2) {
-        WRITE16LE(temp, (i >> 1) & 0xFFFF);
-        temp++;
+    if (!romMapActive()) {
+        uint16_t* temp = (uint16_t*)(rom + ((romSize + 1) & ~1));
+        for (int i = (romSize + 1) & ~1; i < SIZE_ROM; i += 2) {
+            WRITE16LE(temp, (i >> 1) & 0xFFFF);
+            temp++;
+        }
     }
 
     bios = (uint8_t*)calloc(1, SIZE_BIOS);
@@ -1662,7 +2252,7 @@ int CPULoadRomData(const char* data, int size)
         return 0;
     }
 
-    pix = (uint8_t*)calloc(1, 4 * 240 * 160);
+    pix = (uint8_t*)calloc(1, SIZE_PIX);
     if (pix == NULL) {
         systemMessage(MSG_OUT_OF_MEMORY, N_("Failed to allocate memory for %s"),
             "PIX");
@@ -1700,10 +2290,14 @@ void doMirroring(bool b)
     if ((mirroredRomSize <= 0x800000) && (b)) {
         if (mirroredRomSize == 0)
             mirroredRomSize = 0x100000;
+        // a mapped image is unmodified, anything patching it detaches it
+        // first, so mapping the file again mirrors what is in memory
         while (mirroredRomAddress < 0x01000000) {
-            memcpy((uint16_t*)(rom + mirroredRomAddress), (uint16_t*)(rom), mirroredRomSize);
+            if (!romMapActive() || !romMapMirror(mirroredRomAddress, mirroredRomSize))
+                memcpy((uint16_t*)(rom + mirroredRomAddress), (uint16_t*)(rom), mirroredRomSize);
             mirroredRomAddress += mirroredRomSize;
         }
+        codeCacheFlush();
     }
 }
 
@@ -2005,7 +2599,7 @@ void CPUSoftwareInterrupt()
 
 void CPUSoftwareInterrupt(int comment)
 {
-    static bool disableMessage = false;
+    static GBA_LOCAL bool disableMessage = false;
     if (armState)
         comment >>= 16;
 #ifdef BKPT_SUPPORT
@@ -2055,7 +2649,14 @@ void CPUSoftwareInterrupt(int comment)
                 VCOUNT);
         }
 #endif
-        if ((comment & 0xF8) != 0xE0) {
+        if (acceleratedSwi && (comment == 0x0B || comment == 0x0C || (comment >= 0x11 && comment <= 0x15))) {
+            // copies and decompression are done natively below, leaving
+            // behind what the BIOS would after returning from a SWI
+            biosProtected[0] = 0x04;
+            biosProtected[1] = 0x20;
+            biosProtected[2] = 0xa0;
+            biosProtected[3] = 0xe3;
+        } else if ((comment & 0xF8) != 0xE0) {
             CPUSoftwareInterrupt();
             return;
         } else {
@@ -2335,6 +2936,178 @@ void CPUCompareVCOUNT()
     }
 }
 
+#ifdef BKPT_SUPPORT
+// true if a byte of the span is a frozen cheat or a write watchpoint of the
+// debugger or the GDB stub, the span is within one of the memories
+static bool CPUWatched(uint32_t address, uint32_t size)
+{
+    const uint8_t* freeze;
+
+    switch (address >> 24) {
+    case 0x02:
+        freeze = &freezeWorkRAM[address & 0x3FFFF];
+        break;
+    case 0x03:
+        freeze = &freezeInternalRAM[address & 0x7FFF];
+        break;
+    case 0x05:
+        freeze = &freezePRAM[address & 0x3FF];
+        break;
+    case 0x06:
+        freeze = &freezeVRAM[address & 0x1FFFF];
+        break;
+    case 0x07:
+        freeze = &freezeOAM[address & 0x3FF];
+        break;
+    default:
+        return false;
+    }
+
+    uint8_t any = 0;
+    for (uint32_t i = 0; i < size; i++)
+        any |= freeze[i];
+    return any != 0;
+}
+#endif
+
+uint8_t* CPUDirectMemory(uint32_t address, uint32_t size, int width, bool write)
+{
+    uint8_t* base;
+    uint32_t offset;
+    uint32_t limit;
+
+#ifdef BKPT_SUPPORT
+    // breakpoints and frozen cheat addresses need the handlers
+    if (hasConditionalBreaks() || (write && cheatsNumber))
+        return NULL;
+#endif
+
+    switch (address >> 24) {
+    case 0x02:
+        base = workRAM;
+        offset = address & 0x3FFFF;
+        limit = 0x40000;
+        break;
+    case 0x03:
+        base = internalRAM;
+        offset = address & 0x7FFF;
+        limit = 0x8000;
+        break;
+    case 0x05:
+        // byte stores to palette RAM, VRAM and OAM are not plain stores
+        if (write && width == 1)
+            return NULL;
+        base = paletteRAM;
+        offset = address & 0x3FF;
+        limit = 0x400;
+        break;
+    case 0x06:
+        if (write && width == 1)
+            return NULL;
+        // the mirror of the object tiles is left to the handlers
+        base = vram;
+        offset = address & 0x1FFFF;
+        limit = 0x18000;
+        break;
+    case 0x07:
+        if (write && width == 1)
+            return NULL;
+        base = oam;
+        offset = address & 0x3FF;
+        limit = 0x400;
+        break;
+    case 0x08:
+    case 0x09:
+    case 0x0A:
+    case 0x0B:
+    case 0x0C:
+        if (write || size > 0x0D000000 - address)
+            return NULL;
+        // halfword reads of the RTC registers
+        if (width == 2 && address < 0x80000CA && address + size > 0x80000C4)
+            return NULL;
+        base = rom;
+        offset = address & 0x1FFFFFF;
+        limit = 0x2000000;
+        break;
+    default:
+        return NULL;
+    }
+
+    if (offset > limit || size > limit - offset)
+        return NULL;
+
+#ifdef BKPT_SUPPORT
+    // watched stores break into the debugger from the write handlers, and
+    // they do so with no cheats on too
+    if (write && CPUWatched(address, size))
+        return NULL;
+#endif
+
+    return base + offset;
+}
+
+void CPUDirectMemoryWritten(uint32_t address, uint32_t size)
+{
+    uint32_t end = address + size;
+
+    if (size == 0)
+        return;
+
+    switch (address >> 24) {
+    case 0x02:
+        for (uint32_t a = address & ~(CODE_CACHE_PAGE_SIZE - 1); a < end; a += CODE_CACHE_PAGE_SIZE) {
+            if (codeCacheWramCovered(a))
+                codeCacheInvalidate(a);
+        }
+        break;
+    case 0x03:
+        for (uint32_t a = address & ~(CODE_CACHE_PAGE_SIZE - 1); a < end; a += CODE_CACHE_PAGE_SIZE) {
+            if (codeCacheIramCovered(a))
+                codeCacheInvalidate(a);
+        }
+        break;
+    case 0x05:
+        for (uint32_t a = address & ~31; a < end; a += 32)
+            tileCachePaletteWritten(a & 0x3FF);
+        break;
+    case 0x06:
+        for (uint32_t a = address & ~31; a < end; a += 32)
+            tileCacheVramWritten(a & 0x1FFFF);
+        break;
+    }
+}
+
+// Moves c units of plain memory in one go, false if the transfer has to
+// go through the memory handlers
+static bool doDMADirect(uint32_t& s, uint32_t& d, uint32_t c, int width)
+{
+    uint32_t size = c * width;
+
+    if (d & (width - 1))
+        return false;
+
+    const uint8_t* src = CPUDirectMemory(s, size, width, false);
+    uint8_t* dst = CPUDirectMemory(d, size, width, true);
+    // copying forward onto a later part of the source repeats it
+    if (src == NULL || dst == NULL || (dst > src && dst < src + size))
+        return false;
+
+    memmove(dst, src, size);
+    CPUDirectMemoryWritten(d, size);
+
+    if (width == 4)
+        cpuDmaLast = READ32LE((uint32_t*)(src + size - 4));
+    else {
+        cpuDmaLast = READ16LE((uint16_t*)(src + size - 2));
+        cpuDmaLast |= (cpuDmaLast << 16);
+    }
+
+    s += size;
+    d += size;
+    return true;
+}
+
 void doDMA(uint32_t& s, uint32_t& d, uint32_t si, uint32_t di, uint32_t c, int transfer32)
 {
     int sm = s >> 24;
@@ -2362,7 +3135,7 @@ void doDMA(uint32_t& s, uint32_t& d, uint32_t si, uint32_t di, uint32_t c, int t
                 d += di;
                 c--;
             }
-        } else {
+        } else if (si != 4 || di != 4 || !doDMADirect(s, d, c, 4)) {
             while (c != 0) {
                 cpuDmaLast = CPUReadMemory(s);
                 CPUWriteMemory(d, cpuDmaLast);
@@ -2381,7 +3154,7 @@ void doDMA(uint32_t& s, uint32_t& d, uint32_t si, uint32_t di, uint32_t c, int t
                 d += di;
                 c--;
             }
-        } else {
+        } else if (si != 2 || di != 2 || !doDMADirect(s, d, c, 2)) {
             while (c != 0) {
                 cpuDmaLast = CPUReadHalfWord(s);
                 CPUWriteHalfWord(d, cpuDmaLast);
@@ -3230,6 +4003,7 @@ void CPUUpdateRegister(uint32_t address, uint16_t value)
 
 void applyTimer()
 {
+    CPUSyncTimers();
     if (timerOnOffDelay & 1) {
         timer0ClockReload = TIMER_TICKS[timer0Value & 3];
         if (!timer0On && (timer0Value & 0x80)) {
@@ -3281,12 +4055,13 @@ void applyTimer()
         TM3CNT = timer3Value & 0xC7;
         UPDATE_REG(0x10E, TM3CNT);
     }
+    CPUScheduleTimers();
     cpuNextEvent = CPUUpdateTicks();
     timerOnOffDelay = 0;
 }
 
-uint8_t cpuBitsSet[256];
-uint8_t cpuLowestBitSet[256];
+GBA_LOCAL uint8_t cpuBitsSet[256];
+GBA_LOCAL uint8_t cpuLowestBitSet[256];
 
 void CPUInit(const char* biosFileName, bool useBiosFile)
 {
@@ -3600,6 +4375,7 @@ void CPUReset()
     timer3Ticks = 0;
     timer3Reload = 0;
     timer3ClockReload = 0;
+    CPULoadEventTicks();
     dma0Source = 0;
     dma0Dest = 0;
     dma1Source = 0;
@@ -3656,6 +4432,8 @@ void CPUReset()
     eepromReset();
     SetSaveType(saveType);
 
+    codeCacheFlush();
+    tileCacheFlush();
     ARM_PREFETCH;
 
     systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
@@ -3690,8 +4468,8 @@ void CPUInterrupt()
     biosProtected[3] = 0xe5;
 }
 
-static uint32_t joy;
-static bool has_frames;
+static GBA_LOCAL uint32_t joy;
+static GBA_LOCAL bool has_frames;
 
 static void gbaUpdateJoypads(void)
 {
@@ -3724,10 +4502,187 @@ static void gbaUpdateJoypads(void)
     }
 }
 
+// cycles the cheats applied at VBlank took, CPULoop() adds them to the chunk
+static GBA_LOCAL int cpuCheatTicks = 0;
+
+// Moves the LCD on to the next H-Blank or line
+static void CPULcdEvent(int late)
+{
+    if (DISPSTAT & 1) { // V-BLANK
+        // if in V-Blank mode, keep computing...
+        if (DISPSTAT & 2) {
+            schedulerAdd(SCHEDULER_LCD, 1008 - late, CPULcdEvent);
+            VCOUNT++;
+            UPDATE_REG(0x06, VCOUNT);
+            DISPSTAT &= 0xFFFD;
+            UPDATE_REG(0x04, DISPSTAT);
+            CPUCompareVCOUNT();
+        } else {
+            schedulerAdd(SCHEDULER_LCD, 224 - late, CPULcdEvent);
+            DISPSTAT |= 2;
+            UPDATE_REG(0x04, DISPSTAT);
+            if (DISPSTAT & 16) {
+                IF |= 2;
+                UPDATE_REG(0x202, IF);
+            }
+        }
+
+        if (VCOUNT > 227) { //Reaching last line
+            DISPSTAT &= 0xFFFC;
+            UPDATE_REG(0x04, DISPSTAT);
+            VCOUNT = 0;
+            UPDATE_REG(0x06, VCOUNT);
+            CPUCompareVCOUNT();
+        }
+    } else {
+        int framesToSkip = systemFrameSkip;
+
+        static GBA_LOCAL bool speedup_throttle_set = false;
+        bool turbo_button_pressed        = (joy >> 10) & 1;
+#ifndef __LIBRETRO__
+        static GBA_LOCAL uint32_t last_throttle;
+
+        if (turbo_button_pressed) {
+            if (speedup_frame_skip)
+                framesToSkip = speedup_frame_skip;
+            else {
+                if (!speedup_throttle_set && throttle != speedup_throttle) {
+                    last_throttle = throttle;
+                    soundSetThrottle(speedup_throttle);
+                    speedup_throttle_set = true;
+                }
+
+                if (speedup_throttle_frame_skip)
+                    framesToSkip += std::ceil(double(speedup_throttle) / 100.0) - 1;
+            }
+        }
+        else if (speedup_throttle_set) {
+            soundSetThrottle(last_throttle);
+            speedup_throttle_set = false;
+        }
+#else
+        if (turbo_button_pressed)
+            framesToSkip = 9;
+#endif
+
+        if (DISPSTAT & 2) {
+            // if in H-Blank, leave it and move to drawing mode
+            VCOUNT++;
+            UPDATE_REG(0x06, VCOUNT);
+
+            schedulerAdd(SCHEDULER_LCD, 1008 - late, CPULcdEvent);
+            DISPSTAT &= 0xFFFD;
+            if (VCOUNT == 160) {
+                count++;
+                // TM0D-TM3D as the debugger's views show them
+                CPUSyncTimers();
+                systemFrame();
+
+                if ((count % 10) == 0) {
+                    system10Frames(60);
+                }
+                if (count == 60) {
+                    uint32_t time = systemGetClock();
+                    if (time != lastTime) {
+                        uint32_t t = 100000 / (time - lastTime);
+                        systemShowSpeed(t);
+                    } else
+                        systemShowSpeed(0);
+                    lastTime = time;
+                    count = 0;
+                }
+
+                uint32_t ext = (joy >> 10);
+                // If no (m) code is enabled, apply the cheats at each LCDline
+                if ((cheatsEnabled) && (mastercode == 0))
+                    cpuCheatTicks += cheatsCheckKeys(P1 ^ 0x3FF, ext);
+
+                speedup = false;
+
+                if (ext & 1 && !speedup_throttle_set)
+                    speedup = true;
+
+                capture = (ext & 2) ? true : false;
+
+                if (capture && !capturePrevious) {
+                    captureNumber++;
+                    systemScreenCapture(captureNumber);
+                }
+                capturePrevious = capture;
+
+                DISPSTAT |= 1;
+                DISPSTAT &= 0xFFFD;
+                UPDATE_REG(0x04, DISPSTAT);
+                if (DISPSTAT & 0x0008) {
+                    IF |= 1;
+                    UPDATE_REG(0x202, IF);
+                }
+                CPUCheckDMA(1, 0x0f);
+
+                psoundTickfn();
+
+                if (frameCount >= framesToSkip) {
+                    systemDrawScreen();
+                    frameCount = 0;
+                } else {
+                    frameCount++;
+                    systemSendScreen();
+                }
+                if (systemPauseOnFrame())
+                    cpuBreakLoop = true;
+
+                has_frames = true;
+            }
+
+            UPDATE_REG(0x04, DISPSTAT);
+            CPUCompareVCOUNT();
+
+        } else {
+            if (frameCount >= framesToSkip) {
+                (*renderLine)();
+                switch (systemColorDepth) {
+                case 16: {
+#ifdef __LIBRETRO__
+                    uint16_t* dest = (uint16_t*)pix + 240 * VCOUNT;
+#else
+                    uint16_t* dest = (uint16_t*)pix + 242 * (VCOUNT + 1);
+#endif
+                    gfxConvertLine16(dest);
+// for filters that read past the screen
+#ifndef __LIBRETRO__
+                    dest[240] = 0;
+#endif
+                } break;
+                case 24: {
+                    uint8_t* dest = (uint8_t*)pix + 240 * VCOUNT * 3;
+                    gfxConvertLine24(dest);
+                } break;
+                case 32: {
+#ifdef __LIBRETRO__
+                    uint32_t* dest = (uint32_t*)pix + 240 * VCOUNT;
+#else
+                    uint32_t* dest = (uint32_t*)pix + 241 * (VCOUNT + 1);
+#endif
+                    gfxConvertLine32(dest);
+                } break;
+                }
+            }
+            // entering H-Blank
+            DISPSTAT |= 2;
+            UPDATE_REG(0x04, DISPSTAT);
+            schedulerAdd(SCHEDULER_LCD, 224 - late, CPULcdEvent);
+            CPUCheckDMA(2, 0x0f);
+            if (DISPSTAT & 16) {
+                IF |= 2;
+                UPDATE_REG(0x202, IF);
+            }
+        }
+    }
+}
+
 void CPULoop(int ticks)
 {
     int clockTicks;
-    int timerOverflow = 0;
     // variable used by the CPU core
     cpuTotalTicks = 0;
 
@@ -3763,9 +4718,6 @@ void CPULoop(int ticks)
 
         cpuTotalTicks += clockTicks;
 
-        if (rtcIsEnabled())
-            rtcUpdateTime(cpuTotalTicks);
-
         if (cpuTotalTicks >= cpuNextEvent) {
             int remainingTicks = cpuTotalTicks - cpuNextEvent;
 
@@ -3786,257 +4738,8 @@ void CPULoop(int ticks)
                     IRQTicks = 0;
             }
 
-            lcdTicks -= clockTicks;
-
             soundTicks += clockTicks;
 
-            if (lcdTicks <= 0) {
-                if (DISPSTAT & 1) { // V-BLANK
-                    // if in V-Blank mode, keep computing...
-                    if (DISPSTAT & 2) {
-                        lcdTicks += 1008;
-                        VCOUNT++;
-                        UPDATE_REG(0x06, VCOUNT);
-                        DISPSTAT &= 0xFFFD;
-                        UPDATE_REG(0x04, DISPSTAT);
-                        CPUCompareVCOUNT();
-                    } else {
-                        lcdTicks += 224;
-                        DISPSTAT |= 2;
-                        UPDATE_REG(0x04, DISPSTAT);
-                        if (DISPSTAT & 16) {
-                            IF |= 2;
-                            UPDATE_REG(0x202, IF);
-                        }
-                    }
-
-                    if (VCOUNT > 227) { //Reaching last line
-                        DISPSTAT &= 0xFFFC;
-                        UPDATE_REG(0x04, DISPSTAT);
-                        VCOUNT = 0;
-                        UPDATE_REG(0x06, VCOUNT);
-                        CPUCompareVCOUNT();
-                    }
-                } else {
-                    int framesToSkip = systemFrameSkip;
-
-                    static bool speedup_throttle_set = false;
-                    bool turbo_button_pressed        = (joy >> 10) & 1;
-#ifndef __LIBRETRO__
-                    static uint32_t last_throttle;
-
-                    if (turbo_button_pressed) {
-                        if (speedup_frame_skip)
-                            framesToSkip = speedup_frame_skip;
-                        else {
-                            if (!speedup_throttle_set && throttle != speedup_throttle) {
-                                last_throttle = throttle;
-                                soundSetThrottle(speedup_throttle);
-                                speedup_throttle_set = true;
-                            }
-
-                            if (speedup_throttle_frame_skip)
-                                framesToSkip += std::ceil(double(speedup_throttle) / 100.0) - 1;
-                        }
-                    }
-                    else if (speedup_throttle_set) {
-                        soundSetThrottle(last_throttle);
-                        speedup_throttle_set = false;
-                    }
-#else
-                    if (turbo_button_pressed)
-                        framesToSkip = 9;
-#endif
-
-                    if (DISPSTAT & 2) {
-                        // if in H-Blank, leave it and move to drawing mode
-                        VCOUNT++;
-                        UPDATE_REG(0x06, VCOUNT);
-
-                        lcdTicks += 1008;
-                        DISPSTAT &= 0xFFFD;
-                        if (VCOUNT == 160) {
-                            count++;
-                            systemFrame();
-
-                            if ((count % 10) == 0) {
-                                system10Frames(60);
-                            }
-                            if (count == 60) {
-                                uint32_t time = systemGetClock();
-                                if (time != lastTime) {
-                                    uint32_t t = 100000 / (time - lastTime);
-                                    systemShowSpeed(t);
-                                } else
-                                    systemShowSpeed(0);
-                                lastTime = time;
-                                count = 0;
-                            }
-
-                            uint32_t ext = (joy >> 10);
-                            // If no (m) code is enabled, apply the cheats at each LCDline
-                            if ((cheatsEnabled) && (mastercode == 0))
-                                remainingTicks += cheatsCheckKeys(P1 ^ 0x3FF, ext);
-
-                            speedup = false;
-
-                            if (ext & 1 && !speedup_throttle_set)
-                                speedup = true;
-
-                            capture = (ext & 2) ? true : false;
-
-                            if (capture && !capturePrevious) {
-                                captureNumber++;
-                                systemScreenCapture(captureNumber);
-                            }
-                            capturePrevious = capture;
-
-                            DISPSTAT |= 1;
-                            DISPSTAT &= 0xFFFD;
-                            UPDATE_REG(0x04, DISPSTAT);
-                            if (DISPSTAT & 0x0008) {
-                                IF |= 1;
-                                UPDATE_REG(0x202, IF);
-                            }
-                            CPUCheckDMA(1, 0x0f);
-
-                            psoundTickfn();
-
-                            if (frameCount >= framesToSkip) {
-                                systemDrawScreen();
-                                frameCount = 0;
-                            } else {
-                                frameCount++;
-                                systemSendScreen();
-                            }
-                            if (systemPauseOnFrame())
-                                ticks = 0;
-
-                            has_frames = true;
-                        }
-
-                        UPDATE_REG(0x04, DISPSTAT);
-                        CPUCompareVCOUNT();
-
-                    } else {
-                        if (frameCount >= framesToSkip) {
-                            (*renderLine)();
-                            switch (systemColorDepth) {
-                            case 16: {
-#ifdef __LIBRETRO__
-                                uint16_t* dest = (uint16_t*)pix + 240 * VCOUNT;
-#else
-                                uint16_t* dest = (uint16_t*)pix + 242 * (VCOUNT + 1);
-#endif
-                                for (int x = 0; x < 240;) {
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
-                                }
-// for filters that read past the screen
-#ifndef __LIBRETRO__
-                                *dest++ = 0;
-#endif
-                            } break;
-                            case 24: {
-                                uint8_t* dest = (uint8_t*)pix + 240 * VCOUNT * 3;
-                                for (int x = 0; x < 240;) {
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                    *((uint32_t*)dest) = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    dest += 3;
-                                }
-                            } break;
-                            case 32: {
-#ifdef __LIBRETRO__
-                                uint32_t* dest = (uint32_t*)pix + 240 * VCOUNT;
-#else
-                                uint32_t* dest = (uint32_t*)pix + 241 * (VCOUNT + 1);
-#endif
-                                for (int x = 0; x < 240;) {
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                    *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
-                                }
-                            } break;
-                            }
-                        }
-                        // entering H-Blank
-                        DISPSTAT |= 2;
-                        UPDATE_REG(0x04, DISPSTAT);
-                        lcdTicks += 224;
-                        CPUCheckDMA(2, 0x0f);
-                        if (DISPSTAT & 16) {
-                            IF |= 2;
-                            UPDATE_REG(0x202, IF);
-                        }
-                    }
-                }
-            }
-
             // we shouldn't be doing sound in stop state, but we loose synchronization
             // if sound is disabled, so in stop state, soundTick will just produce
             // mute sound
@@ -4047,131 +4750,15 @@ void CPULoop(int ticks)
                 //soundTicks += SOUND_CLOCK_TICKS;
             //}
 
-            if (!stopState) {
-                if (timer0On) {
-                    timer0Ticks -= clockTicks;
-                    if (timer0Ticks <= 0) {
-                        timer0Ticks += (0x10000 - timer0Reload) << timer0ClockReload;
-                        timerOverflow |= 1;
-                        soundTimerOverflow(0);
-                        if (TM0CNT & 0x40) {
-                            IF |= 0x08;
-                            UPDATE_REG(0x202, IF);
-                        }
-                    }
-                    TM0D = 0xFFFF - (timer0Ticks >> timer0ClockReload);
-                    UPDATE_REG(0x100, TM0D);
-                }
-
-                if (timer1On) {
-                    if (TM1CNT & 4) {
-                        if (timerOverflow & 1) {
-                            TM1D++;
-                            if (TM1D == 0) {
-                                TM1D += timer1Reload;
-                                timerOverflow |= 2;
-                                soundTimerOverflow(1);
-                                if (TM1CNT & 0x40) {
-                                    IF |= 0x10;
-                                    UPDATE_REG(0x202, IF);
-                                }
-                            }
-                            UPDATE_REG(0x104, TM1D);
-                        }
-                    } else {
-                        timer1Ticks -= clockTicks;
-                        if (timer1Ticks <= 0) {
-                            timer1Ticks += (0x10000 - timer1Reload) << timer1ClockReload;
-                            timerOverflow |= 2;
-                            soundTimerOverflow(1);
-                            if (TM1CNT & 0x40) {
-                                IF |= 0x10;
-                                UPDATE_REG(0x202, IF);
-                            }
-                        }
-                        TM1D = 0xFFFF - (timer1Ticks >> timer1ClockReload);
-                        UPDATE_REG(0x104, TM1D);
-                    }
-                }
-
-                if (timer2On) {
-                    if (TM2CNT & 4) {
-                        if (timerOverflow & 2) {
-                            TM2D++;
-                            if (TM2D == 0) {
-                                TM2D += timer2Reload;
-                                timerOverflow |= 4;
-                                if (TM2CNT & 0x40) {
-                                    IF |= 0x20;
-                                    UPDATE_REG(0x202, IF);
-                                }
-                            }
-                            UPDATE_REG(0x108, TM2D);
-                        }
-                    } else {
-                        timer2Ticks -= clockTicks;
-                        if (timer2Ticks <= 0) {
-                            timer2Ticks += (0x10000 - timer2Reload) << timer2ClockReload;
-                            timerOverflow |= 4;
-                            if (TM2CNT & 0x40) {
-                                IF |= 0x20;
-                                UPDATE_REG(0x202, IF);
-                            }
-                        }
-                        TM2D = 0xFFFF - (timer2Ticks >> timer2ClockReload);
-                        UPDATE_REG(0x108, TM2D);
-                    }
-                }
-
-                if (timer3On) {
-                    if (TM3CNT & 4) {
-                        if (timerOverflow & 4) {
-                            TM3D++;
-                            if (TM3D == 0) {
-                                TM3D += timer3Reload;
-                                if (TM3CNT & 0x40) {
-                                    IF |= 0x40;
-                                    UPDATE_REG(0x202, IF);
-                                }
-                            }
-                            UPDATE_REG(0x10C, TM3D);
-                        }
-                    } else {
-                        timer3Ticks -= clockTicks;
-                        if (timer3Ticks <= 0) {
-                            timer3Ticks += (0x10000 - timer3Reload) << timer3ClockReload;
-                            if (TM3CNT & 0x40) {
-                                IF |= 0x40;
-                                UPDATE_REG(0x202, IF);
-                            }
-                        }
-                        TM3D = 0xFFFF - (timer3Ticks >> timer3ClockReload);
-                        UPDATE_REG(0x10C, TM3D);
-                    }
-                }
-            }
-
-            timerOverflow = 0;
-
-#ifdef PROFILING
-            profilingTicks -= clockTicks;
-            if (profilingTicks <= 0) {
-                profilingTicks += profilingTicksReload;
-                if (profilSegment) {
-                    profile_segment* seg = profilSegment;
-                    do {
-                        uint16_t* b = (uint16_t*)seg->sbuf;
-                        int pc = ((reg[15].I - seg->s_lowpc) * seg->s_scale) / 0x10000;
-                        if (pc >= 0 && pc < seg->ssiz) {
-                            b[pc]++;
-                            break;
-                        }
+            if (stopState)
+                CPUDelayTimers(clockTicks);
 
-                        seg = seg->next;
-                    } while (seg);
-                }
+            // the LCD, the timers and the DMA they start, the cart's clock
+            schedulerAdvance(clockTicks);
+            if (cpuCheatTicks) {
+                remainingTicks += cpuCheatTicks;
+                cpuCheatTicks = 0;
             }
-#endif
 
             ticks -= clockTicks;
 
@@ -4286,8 +4873,18 @@ struct EmulatedSystem GBASystem = {
     CPUCleanUp,
     // emuReadBattery
     CPUReadBatteryFile,
-    // emuWriteBattery
+// emuWriteBattery
+#ifdef __LIBRETRO__
+    NULL,
+#else
     CPUWriteBatteryFile,
+#endif
+// emuWriteBatteryAsync
+#ifdef __LIBRETRO__
+    NULL,
+#else
+    CPUWriteBatteryFileAsync,
+#endif
     // emuReadState
     CPUReadState,
     // emuWriteState
@@ -4300,6 +4897,12 @@ struct EmulatedSystem GBASystem = {
 #endif
     // emuWriteMemState
     CPUWriteMemState,
+// emuWriteMemStateRaw
+#ifdef __LIBRETRO__
+    NULL,
+#else
+    CPUWriteMemStateRaw,
+#endif
     // emuWritePNG
     CPUWritePNGFile,
     // emuWriteBMP
@@ -97,24 +97,24 @@ typedef union {
 } reg_pair;
 
 #ifndef NO_GBA_MAP
-extern memoryMap map[256];
+extern GBA_LOCAL memoryMap map[256];
 #endif
 
-extern uint8_t biosProtected[4];
+extern GBA_LOCAL uint8_t biosProtected[4];
 
-extern void (*cpuSaveGameFunc)(uint32_t, uint8_t);
+extern GBA_LOCAL void (*cpuSaveGameFunc)(uint32_t, uint8_t);
 
-extern bool cpuSramEnabled;
-extern bool cpuFlashEnabled;
-extern bool cpuEEPROMEnabled;
-extern bool cpuEEPROMSensorEnabled;
+extern GBA_LOCAL bool cpuSramEnabled;
+extern GBA_LOCAL bool cpuFlashEnabled;
+extern GBA_LOCAL bool cpuEEPROMEnabled;
+extern GBA_LOCAL bool cpuEEPROMSensorEnabled;
 
 #ifdef BKPT_SUPPORT
-extern uint8_t freezeWorkRAM[0x40000];
-extern uint8_t freezeInternalRAM[0x8000];
-extern uint8_t freezeVRAM[0x18000];
-extern uint8_t freezeOAM[0x400];
-extern uint8_t freezePRAM[0x400];
+extern GBA_LOCAL uint8_t freezeWorkRAM[0x40000];
+extern GBA_LOCAL uint8_t freezeInternalRAM[0x8000];
+extern GBA_LOCAL uint8_t freezeVRAM[0x18000];
+extern GBA_LOCAL uint8_t freezeOAM[0x400];
+extern GBA_LOCAL uint8_t freezePRAM[0x400];
 extern bool debugger_last;
 extern int oldreg[18];
 extern char oldbuffer[10];
@@ -125,6 +125,7 @@ extern bool CPUReadGSASnapshot(const char*);
 extern bool CPUReadGSASPSnapshot(const char*);
 extern bool CPUWriteGSASnapshot(const char*, const char*, const char*, const char*);
 extern bool CPUWriteBatteryFile(const char*);
+extern bool CPUWriteBatteryFileAsync(const char*);
 extern bool CPUReadBatteryFile(const char*);
 extern bool CPUExportEepromFile(const char*);
 extern bool CPUImportEepromFile(const char*);
@@ -133,14 +134,28 @@ extern bool CPUWriteBMPFile(const char*);
 extern void CPUCleanUp();
 extern void CPUUpdateRender();
 extern void CPUUpdateRenderBuffers(bool);
+// Converts lineMix into a pix line at the given color depth, see GBAGfxPix.cpp
+extern void gfxConvertLine16(uint16_t*);
+extern void gfxConvertLine24(uint8_t*);
+extern void gfxConvertLine32(uint32_t*);
+// Called after systemColorMap16/32 are rebuilt, lcd tells whether the LCD
+// color filter was applied to them
+extern void gfxColorMapsChanged(bool lcd);
 extern bool CPUReadMemState(char*, int);
 extern bool CPUWriteMemState(char*, int);
+extern bool CPUWriteMemStateRaw(char*, int, long&);
+// Uncompressed states with a section table, see GBA.cpp
+extern size_t CPUBinaryStateSize();
+extern size_t CPUWriteBinaryState(uint8_t*, size_t);
+extern bool CPUReadBinaryState(const uint8_t*, size_t);
+extern bool CPUIsBinaryState(const uint8_t*, size_t);
 #ifdef __LIBRETRO__
 extern bool CPUReadState(const uint8_t*, unsigned);
 extern unsigned int CPUWriteState(uint8_t* data, unsigned int size);
 #else
 extern bool CPUReadState(const char*);
 extern bool CPUWriteState(const char*);
+extern bool CPUWriteBinaryState(const char*, bool compress);
 #endif
 extern int CPULoadRom(const char*);
 extern int CPULoadRomData(const char* data, int size);
@@ -152,6 +167,13 @@ void SetSaveType(int st);
 extern void CPUReset();
 extern void CPULoop(int);
 extern void CPUCheckDMA(int, int);
+// Pointer to [address, address + size) if the span lies in one stretch of
+// memory where accesses of the given width are plain loads and stores, NULL
+// if they have to go through CPURead*() and CPUWrite*(), as stores to frozen
+// or watched addresses do
+extern uint8_t* CPUDirectMemory(uint32_t address, uint32_t size, int width, bool write);
+// Tells the caches about stores made through CPUDirectMemory()
+extern void CPUDirectMemoryWritten(uint32_t address, uint32_t size);
 extern bool CPUIsGBAImage(const char*);
 extern bool CPUIsZipFile(const char*);
 #ifdef PROFILING
@@ -169,6 +191,9 @@ void SetSaveDotCodeFile(const char* szFile);
 
 // Updates romSize and realloc rom pointer if needed after soft-patching
 void gbaUpdateRomSize(int size);
+// Turns a mapped ROM into a copy in memory, needed before soft-patching
+// can reallocate it
+void gbaDetachRom();
 
 extern struct EmulatedSystem GBASystem;
 
@@ -7,25 +7,25 @@ int coeff[32] = {
     16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16
 };
 
-uint32_t line0[240];
-uint32_t line1[240];
-uint32_t line2[240];
-uint32_t line3[240];
-uint32_t lineOBJ[240];
-uint32_t lineOBJWin[240];
-uint32_t lineMix[240];
-bool gfxInWin0[240];
-bool gfxInWin1[240];
-int lineOBJpixleft[128];
-
-int gfxBG2Changed = 0;
-int gfxBG3Changed = 0;
-
-int gfxBG2X = 0;
-int gfxBG2Y = 0;
-int gfxBG3X = 0;
-int gfxBG3Y = 0;
-int gfxLastVCOUNT = 0;
+GBA_LOCAL uint32_t line0[240];
+GBA_LOCAL uint32_t line1[240];
+GBA_LOCAL uint32_t line2[240];
+GBA_LOCAL uint32_t line3[240];
+GBA_LOCAL uint32_t lineOBJ[240];
+GBA_LOCAL uint32_t lineOBJWin[240];
+GBA_LOCAL uint32_t lineMix[240];
+GBA_LOCAL bool gfxInWin0[240];
+GBA_LOCAL bool gfxInWin1[240];
+GBA_LOCAL int lineOBJpixleft[128];
+
+GBA_LOCAL int gfxBG2Changed = 0;
+GBA_LOCAL int gfxBG3Changed = 0;
+
+GBA_LOCAL int gfxBG2X = 0;
+GBA_LOCAL int gfxBG2Y = 0;
+GBA_LOCAL int gfxBG3X = 0;
+GBA_LOCAL int gfxBG3Y = 0;
+GBA_LOCAL int gfxLastVCOUNT = 0;
 
 #ifdef TILED_RENDERING
 #ifdef _MSC_VER
@@ -1,8 +1,11 @@
 #ifndef GFX_H
 #define GFX_H
 
+#include <string.h>
+
 #include "GBA.h"
 #include "Globals.h"
+#include "TileCache.h"
 
 #include "../common/Port.h"
 
@@ -49,26 +52,32 @@ void mode5RenderLine();
 void mode5RenderLineNoWindow();
 void mode5RenderLineAll();
 
+// Composites lineOBJ and the BG lines selected by layers (bit 0 = line0 ..
+// bit 3 = line3) into lineMix.  gfxMixLineEffects() also applies the
+// BLDMOD color special effect, see GBAGfxMix.cpp.
+void gfxMixLine(int layers, uint32_t backdrop);
+void gfxMixLineEffects(int layers, uint32_t backdrop);
+
 extern int coeff[32];
-extern uint32_t line0[240];
-extern uint32_t line1[240];
-extern uint32_t line2[240];
-extern uint32_t line3[240];
-extern uint32_t lineOBJ[240];
-extern uint32_t lineOBJWin[240];
-extern uint32_t lineMix[240];
-extern bool gfxInWin0[240];
-extern bool gfxInWin1[240];
-extern int lineOBJpixleft[128];
-
-extern int gfxBG2Changed;
-extern int gfxBG3Changed;
-
-extern int gfxBG2X;
-extern int gfxBG2Y;
-extern int gfxBG3X;
-extern int gfxBG3Y;
-extern int gfxLastVCOUNT;
+extern GBA_LOCAL uint32_t line0[240];
+extern GBA_LOCAL uint32_t line1[240];
+extern GBA_LOCAL uint32_t line2[240];
+extern GBA_LOCAL uint32_t line3[240];
+extern GBA_LOCAL uint32_t lineOBJ[240];
+extern GBA_LOCAL uint32_t lineOBJWin[240];
+extern GBA_LOCAL uint32_t lineMix[240];
+extern GBA_LOCAL bool gfxInWin0[240];
+extern GBA_LOCAL bool gfxInWin1[240];
+extern GBA_LOCAL int lineOBJpixleft[128];
+
+extern GBA_LOCAL int gfxBG2Changed;
+extern GBA_LOCAL int gfxBG3Changed;
+
+extern GBA_LOCAL int gfxBG2X;
+extern GBA_LOCAL int gfxBG2Y;
+extern GBA_LOCAL int gfxBG3X;
+extern GBA_LOCAL int gfxBG3Y;
+extern GBA_LOCAL int gfxLastVCOUNT;
 
 static inline void gfxClearArray(uint32_t* array)
 {
@@ -80,10 +89,8 @@ static inline void gfxClearArray(uint32_t* array)
 #ifndef TILED_RENDERING
 static inline void gfxDrawTextScreen(uint16_t control, uint16_t hofs, uint16_t vofs, uint32_t* line)
 {
-    uint16_t* palette = (uint16_t*)paletteRAM;
-    uint8_t* charBase = &vram[((control >> 2) & 0x03) * 0x4000];
+    uint32_t charBase = ((control >> 2) & 0x03) * 0x4000;
     uint16_t* screenBase = (uint16_t*)&vram[((control >> 8) & 0x1f) * 0x800];
-    uint32_t prio = ((control & 3) << 25) + 0x1000000;
     int sizeX = 256;
     int sizeY = 256;
     switch ((control >> 14) & 3) {
@@ -126,80 +133,50 @@ static inline void gfxDrawTextScreen(uint16_t control, uint16_t hofs, uint16_t v
     }
 
     int yshift = ((yyy >> 3) << 5);
-    if ((control)&0x80) {
-        uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
-        for (int x = 0; x < 240; x++) {
-            uint16_t data = READ16LE(screenSource);
-
-            int tile = data & 0x3FF;
-            int tileX = (xxx & 7);
-            int tileY = yyy & 7;
-
-            if (tileX == 7)
-                screenSource++;
-
-            if (data & 0x0400)
-                tileX = 7 - tileX;
-            if (data & 0x0800)
-                tileY = 7 - tileY;
-
-            uint8_t color = charBase[tile * 64 + tileY * 8 + tileX];
-
-            line[x] = color ? (READ16LE(&palette[color]) | prio) : 0x80000000;
-
-            xxx++;
-            if (xxx == 256) {
-                if (sizeX > 256)
-                    screenSource = screenBase + 0x400 + yshift;
-                else {
-                    screenSource = screenBase + yshift;
-                    xxx = 0;
-                }
-            } else if (xxx >= sizeX) {
-                xxx = 0;
-                screenSource = screenBase + yshift;
-            }
+    uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
+    int tileX = xxx & 7;
+    int x = 0;
+
+    // one tile row at a time, the first and last ones may be clipped
+    while (x < 240) {
+        uint16_t data = READ16LE(screenSource);
+
+        int tile = data & 0x3FF;
+        int tileY = yyy & 7;
+        if (data & 0x0800)
+            tileY = 7 - tileY;
+
+        const uint32_t* pixels;
+        if (control & 0x80)
+            pixels = tileCacheLookup(charBase + tile * 64 + tileY * 8, TILE_CACHE_PALETTE_ALL, (data & 0x0400) != 0, control & 3);
+        else
+            pixels = tileCacheLookup(charBase + (tile << 5) + (tileY << 2), data >> 12, (data & 0x0400) != 0, control & 3);
+
+        int count = 8;
+        if (tileX == 0 && x <= 232) {
+            memcpy(&line[x], pixels, 8 * sizeof(uint32_t));
+        } else {
+            count -= tileX;
+            if (count > 240 - x)
+                count = 240 - x;
+            memcpy(&line[x], &pixels[tileX], count * sizeof(uint32_t));
         }
-    } else {
-        uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
-        for (int x = 0; x < 240; x++) {
-            uint16_t data = READ16LE(screenSource);
-
-            int tile = data & 0x3FF;
-            int tileX = (xxx & 7);
-            int tileY = yyy & 7;
-
-            if (tileX == 7)
-                screenSource++;
 
-            if (data & 0x0400)
-                tileX = 7 - tileX;
-            if (data & 0x0800)
-                tileY = 7 - tileY;
+        x += count;
+        xxx += count;
+        tileX = 0;
+        screenSource++;
 
-            uint8_t color = charBase[(tile << 5) + (tileY << 2) + (tileX >> 1)];
-
-            if (tileX & 1) {
-                color = (color >> 4);
-            } else {
-                color &= 0x0F;
-            }
-
-            int pal = (data >> 8) & 0xF0;
-            line[x] = color ? (READ16LE(&palette[pal + color]) | prio) : 0x80000000;
-
-            xxx++;
-            if (xxx == 256) {
-                if (sizeX > 256)
-                    screenSource = screenBase + 0x400 + yshift;
-                else {
-                    screenSource = screenBase + yshift;
-                    xxx = 0;
-                }
-            } else if (xxx >= sizeX) {
-                xxx = 0;
+        if (xxx == 256) {
+            if (sizeX > 256)
+                screenSource = screenBase + 0x400 + yshift;
+            else {
                 screenSource = screenBase + yshift;
+                xxx = 0;
             }
+        } else if (xxx >= sizeX) {
+            xxx = 0;
+            screenSource = screenBase + yshift;
         }
     }
     if (mosaicOn) {
@@ -0,0 +1,329 @@
+#include <string.h>
+
+#include "GBA.h"
+#include "GBAGfx.h"
+#include "Globals.h"
+
+// Scanline compositor shared by the mode 0-5 renderers that do not use
+// windows.  For every pixel it picks the top layer by priority, then
+// applies semi-transparent OBJ blending and, for the NoWindow renderers,
+// the BLDMOD alpha/brightness effect.
+//
+// On x86 the loop is also built with GCC vector extensions for SSE2 (4
+// pixels per step) and AVX2 (8 pixels per step), and the widest version
+// the CPU supports is picked on first use.  Every version produces the
+// same lineMix values as gfxAlphaBlend(), gfxIncreaseBrightness() and
+// gfxDecreaseBrightness().
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define GFX_MIX_SIMD
+#include <immintrin.h>
+#endif
+
+#define GFX_MIX_OBJ 0x10
+#define GFX_MIX_BACKDROP 0x20
+
+// layer sets used by the modes: 0 all four BGs, 1 BG0-2, 2 BG2-3, 3 BG2
+#define GFX_MIX_LAYER_SETS 4
+
+struct gfxMixState {
+    uint32_t backdrop;
+    uint32_t targets;
+    uint32_t targets2;
+    int effect;
+    int ca;
+    int cb;
+    int cy;
+};
+
+static void gfxMixInit(gfxMixState* s, uint32_t backdrop)
+{
+    s->backdrop = backdrop;
+    s->targets = BLDMOD & 0x3F;
+    s->targets2 = (BLDMOD >> 8) & 0x3F;
+    s->effect = (BLDMOD >> 6) & 3;
+    s->ca = coeff[COLEV & 0x1F];
+    s->cb = coeff[(COLEV >> 8) & 0x1F];
+    s->cy = coeff[COLY & 0x1F];
+}
+
+// Picks the top layer, optionally skipping one, exactly like the scalar
+// loops in the mode renderers used to
+#define GFX_MIX_SCALAR_PICK(line, bit, color, top, skip)                    \
+    if ((uint8_t)(line[x] >> 24) < (uint8_t)(color >> 24) && (skip) != bit) { \
+        color = line[x];                                                    \
+        top = bit;                                                          \
+    }
+
+template <int Layers, bool Effects>
+static void gfxMixScalar(const gfxMixState* s)
+{
+    const uint32_t backdrop = s->backdrop;
+    const uint32_t targets = s->targets;
+    const uint32_t targets2 = s->targets2;
+    const int effect = s->effect;
+
+    for (int x = 0; x < 240; x++) {
+        uint32_t color = backdrop;
+        uint32_t top = GFX_MIX_BACKDROP;
+
+        if (Layers & 0x01)
+            GFX_MIX_SCALAR_PICK(line0, 0x01, color, top, 0);
+        if (Layers & 0x02)
+            GFX_MIX_SCALAR_PICK(line1, 0x02, color, top, 0);
+        if (Layers & 0x04)
+            GFX_MIX_SCALAR_PICK(line2, 0x04, color, top, 0);
+        if (Layers & 0x08)
+            GFX_MIX_SCALAR_PICK(line3, 0x08, color, top, 0);
+        GFX_MIX_SCALAR_PICK(lineOBJ, GFX_MIX_OBJ, color, top, 0);
+
+        bool semi = (top == GFX_MIX_OBJ) && (color & 0x00010000);
+
+        if (semi || (Effects && effect == 1 && (top & targets))) {
+            // topmost layer under the top one
+            uint32_t back = backdrop;
+            uint32_t top2 = GFX_MIX_BACKDROP;
+
+            if (Layers & 0x01)
+                GFX_MIX_SCALAR_PICK(line0, 0x01, back, top2, top);
+            if (Layers & 0x02)
+                GFX_MIX_SCALAR_PICK(line1, 0x02, back, top2, top);
+            if (Layers & 0x04)
+                GFX_MIX_SCALAR_PICK(line2, 0x04, back, top2, top);
+            if (Layers & 0x08)
+                GFX_MIX_SCALAR_PICK(line3, 0x08, back, top2, top);
+            GFX_MIX_SCALAR_PICK(lineOBJ, GFX_MIX_OBJ, back, top2, top);
+
+            if (top2 & targets2) {
+                lineMix[x] = gfxAlphaBlend(color, back, s->ca, s->cb);
+                continue;
+            }
+        }
+
+        if ((semi || Effects) && (top & targets)) {
+            if (effect == 2)
+                color = gfxIncreaseBrightness(color, s->cy);
+            else if (effect == 3)
+                color = gfxDecreaseBrightness(color, s->cy);
+        }
+
+        lineMix[x] = color;
+    }
+}
+
+#ifdef GFX_MIX_SIMD
+typedef uint32_t gfxMixV4 __attribute__((vector_size(16)));
+typedef int32_t gfxMixV4s __attribute__((vector_size(16)));
+typedef uint16_t gfxMixV4x16 __attribute__((vector_size(16)));
+typedef uint32_t gfxMixV8 __attribute__((vector_size(32)));
+typedef int32_t gfxMixV8s __attribute__((vector_size(32)));
+typedef uint16_t gfxMixV8x16 __attribute__((vector_size(32)));
+
+// true if any lane of the mask m is set
+__attribute__((target("sse2"))) static inline bool gfxMixAny(gfxMixV4 m)
+{
+    return _mm_movemask_epi8((__m128i)m) != 0;
+}
+
+__attribute__((target("avx2"))) static inline bool gfxMixAny(gfxMixV8 m)
+{
+    return !_mm256_testz_si256((__m256i)m, (__m256i)m);
+}
+
+#define GFX_MIX_VECTOR_LOAD(v, line) \
+    V v;                             \
+    memcpy(&v, &line[x], sizeof(V));
+
+#define GFX_MIX_VECTOR_PICK(v, bit)                      \
+    {                                                    \
+        VS m = (VS)(v >> 24) < (VS)(color >> 24);        \
+        color = m ? v : color;                           \
+        top = m ? zero + bit : top;                      \
+    }
+
+#define GFX_MIX_VECTOR_PICK_BACK(v, bit)                           \
+    {                                                              \
+        VS m = ((VS)(v >> 24) < (VS)(back >> 24)) & (VS)(top != bit); \
+        back = m ? v : back;                                       \
+        top2 = m ? zero + bit : top2;                              \
+    }
+
+// V holds N pixels as uint32_t lanes.  Every value compared fits in 16
+// bits, so comparisons are done on VS (int32_t lanes), which SSE2 supports
+// directly, and channel products on V16 (uint16_t lanes).
+template <typename V, typename VS, typename V16, int N, int Layers, bool Effects>
+static inline void gfxMixVector(const gfxMixState* s)
+{
+    const V zero = V{};
+    const V c31 = zero + 31;
+    const V ca = zero + s->ca;
+    const V cb = zero + s->cb;
+    const V cy = zero + s->cy;
+    const V backdrop = zero + s->backdrop;
+    const V targets = zero + s->targets;
+    const V targets2 = zero + s->targets2;
+    const int effect = s->effect;
+    const bool canBlend = s->targets2 != 0;
+
+    for (int x = 0; x < 240; x += N) {
+        V color = backdrop;
+        V top = zero + GFX_MIX_BACKDROP;
+
+        GFX_MIX_VECTOR_LOAD(p0, line0);
+        GFX_MIX_VECTOR_LOAD(p1, line1);
+        GFX_MIX_VECTOR_LOAD(p2, line2);
+        GFX_MIX_VECTOR_LOAD(p3, line3);
+        GFX_MIX_VECTOR_LOAD(pObj, lineOBJ);
+
+        if (Layers & 0x01)
+            GFX_MIX_VECTOR_PICK(p0, 0x01);
+        if (Layers & 0x02)
+            GFX_MIX_VECTOR_PICK(p1, 0x02);
+        if (Layers & 0x04)
+            GFX_MIX_VECTOR_PICK(p2, 0x04);
+        if (Layers & 0x08)
+            GFX_MIX_VECTOR_PICK(p3, 0x08);
+        GFX_MIX_VECTOR_PICK(pObj, GFX_MIX_OBJ);
+
+        V semi = (V)(top == GFX_MIX_OBJ) & (V)((color & 0x00010000) != 0);
+        V res = color;
+
+        // most steps have no semi-transparent OBJ and no effect to apply
+        if (Effects || gfxMixAny(semi)) {
+            V isTarget = (V)((top & targets) != 0);
+            V r = color & 0x1F;
+            V g = (color >> 5) & 0x1F;
+            V b = (color >> 10) & 0x1F;
+            V blend = zero;
+
+            V needBack = semi;
+            if (Effects && effect == 1)
+                needBack |= isTarget;
+
+            if (canBlend && gfxMixAny(needBack)) {
+                V back = backdrop;
+                V top2 = zero + GFX_MIX_BACKDROP;
+
+                if (Layers & 0x01)
+                    GFX_MIX_VECTOR_PICK_BACK(p0, 0x01);
+                if (Layers & 0x02)
+                    GFX_MIX_VECTOR_PICK_BACK(p1, 0x02);
+                if (Layers & 0x04)
+                    GFX_MIX_VECTOR_PICK_BACK(p2, 0x04);
+                if (Layers & 0x08)
+                    GFX_MIX_VECTOR_PICK_BACK(p3, 0x08);
+                GFX_MIX_VECTOR_PICK_BACK(pObj, GFX_MIX_OBJ);
+
+                blend = needBack & (V)((top2 & targets2) != 0);
+
+                V br = ((V)((V16)r * (V16)ca) + (V)((V16)(back & 0x1F) * (V16)cb)) >> 4;
+                V bg = ((V)((V16)g * (V16)ca) + (V)((V16)((back >> 5) & 0x1F) * (V16)cb)) >> 4;
+                V bb = ((V)((V16)b * (V16)ca) + (V)((V16)((back >> 10) & 0x1F) * (V16)cb)) >> 4;
+                br = (VS)br > (VS)c31 ? c31 : br;
+                bg = (VS)bg > (VS)c31 ? c31 : bg;
+                bb = (VS)bb > (VS)c31 ? c31 : bb;
+                res = (VS)blend ? br | (bg << 5) | (bb << 10) | (bg << 21) : res;
+            }
+
+            if (effect >= 2) {
+                V bright = (Effects ? isTarget : semi & isTarget) & ~blend;
+                V dr, dg, db;
+                if (effect == 2) {
+                    dr = r + ((V)((V16)(c31 - r) * (V16)cy) >> 4);
+                    dg = g + ((V)((V16)(c31 - g) * (V16)cy) >> 4);
+                    db = b + ((V)((V16)(c31 - b) * (V16)cy) >> 4);
+                } else {
+                    dr = r - ((V)((V16)r * (V16)cy) >> 4);
+                    dg = g - ((V)((V16)g * (V16)cy) >> 4);
+                    db = b - ((V)((V16)b * (V16)cy) >> 4);
+                }
+                res = (VS)bright ? dr | (dg << 5) | (db << 10) | (dg << 21) : res;
+            }
+        }
+
+        memcpy(&lineMix[x], &res, sizeof(V));
+    }
+}
+
+template <int Layers, bool Effects>
+__attribute__((target("sse2"), flatten)) static void gfxMixSSE2(const gfxMixState* s)
+{
+    gfxMixVector<gfxMixV4, gfxMixV4s, gfxMixV4x16, 4, Layers, Effects>(s);
+}
+
+template <int Layers, bool Effects>
+__attribute__((target("avx2"), flatten)) static void gfxMixAVX2(const gfxMixState* s)
+{
+    gfxMixVector<gfxMixV8, gfxMixV8s, gfxMixV8x16, 8, Layers, Effects>(s);
+}
+#endif
+
+typedef void (*gfxMixFunc)(const gfxMixState* s);
+
+#define GFX_MIX_TABLE(func, effects)                                          \
+    {                                                                         \
+        func<0x0F, effects>, func<0x07, effects>, func<0x0C, effects>, func<0x04, effects> \
+    }
+
+static const gfxMixFunc gfxMixScalarTable[2][GFX_MIX_LAYER_SETS] = {
+    GFX_MIX_TABLE(gfxMixScalar, false),
+    GFX_MIX_TABLE(gfxMixScalar, true),
+};
+
+#ifdef GFX_MIX_SIMD
+static const gfxMixFunc gfxMixSSE2Table[2][GFX_MIX_LAYER_SETS] = {
+    GFX_MIX_TABLE(gfxMixSSE2, false),
+    GFX_MIX_TABLE(gfxMixSSE2, true),
+};
+
+static const gfxMixFunc gfxMixAVX2Table[2][GFX_MIX_LAYER_SETS] = {
+    GFX_MIX_TABLE(gfxMixAVX2, false),
+    GFX_MIX_TABLE(gfxMixAVX2, true),
+};
+#endif
+
+static GBA_LOCAL const gfxMixFunc (*gfxMixTable)[GFX_MIX_LAYER_SETS] = NULL;
+
+static void gfxMix(int layers, uint32_t backdrop, bool effects)
+{
+    if (gfxMixTable == NULL) {
+        gfxMixTable = gfxMixScalarTable;
+#ifdef GFX_MIX_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            gfxMixTable = gfxMixAVX2Table;
+        else if (__builtin_cpu_supports("sse2"))
+            gfxMixTable = gfxMixSSE2Table;
+#endif
+    }
+
+    int set;
+    switch (layers) {
+    case 0x0F:
+        set = 0;
+        break;
+    case 0x07:
+        set = 1;
+        break;
+    case 0x0C:
+        set = 2;
+        break;
+    default:
+        set = 3;
+        break;
+    }
+
+    gfxMixState s;
+    gfxMixInit(&s, backdrop);
+    gfxMixTable[effects][set](&s);
+}
+
+void gfxMixLine(int layers, uint32_t backdrop)
+{
+    gfxMix(layers, backdrop, false);
+}
+
+void gfxMixLineEffects(int layers, uint32_t backdrop)
+{
+    gfxMix(layers, backdrop, true);
+}
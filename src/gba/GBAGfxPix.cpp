@@ -0,0 +1,179 @@
+#include <string.h>
+
+#include "../System.h"
+#include "GBA.h"
+#include "Globals.h"
+
+// Conversion of a finished lineMix scanline into the frontend framebuffer.
+//
+// systemColorMap16/32 are plain bit shuffles of the GBA BGR555 color unless
+// the LCD color filter was applied to them, so without the filter the AVX2
+// versions of the 16 and 32 bit conversions compute the color instead of
+// looking it up.  Table lookups use AVX2 gathers for 24 and 32 bit; 24 bit
+// always looks up since packing the pixels already costs more than that.
+// Without AVX2 everything goes through the scalar lookups.
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define GFX_PIX_AVX2
+#include <immintrin.h>
+#endif
+
+extern GBA_LOCAL uint32_t lineMix[240];
+
+// set by gfxColorMapsChanged() when the maps hold no color correction
+static bool gfxPixDirect = false;
+
+void gfxColorMapsChanged(bool lcd)
+{
+    gfxPixDirect = !lcd;
+}
+
+static void gfxPixLine16C(uint16_t* dest)
+{
+    for (int x = 0; x < 240;) {
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap16[lineMix[x++] & 0xFFFF];
+    }
+}
+
+// each store also writes the first byte of the next pixel, pix always has
+// room for the one past the end of the line
+static void gfxPixLine24C(uint8_t* dest)
+{
+    for (int x = 0; x < 240;) {
+        memcpy(dest, &systemColorMap32[lineMix[x++] & 0xFFFF], 4);
+        memcpy(dest + 3, &systemColorMap32[lineMix[x++] & 0xFFFF], 4);
+        memcpy(dest + 6, &systemColorMap32[lineMix[x++] & 0xFFFF], 4);
+        memcpy(dest + 9, &systemColorMap32[lineMix[x++] & 0xFFFF], 4);
+        dest += 12;
+    }
+}
+
+static void gfxPixLine32C(uint32_t* dest)
+{
+    for (int x = 0; x < 240;) {
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+        *dest++ = systemColorMap32[lineMix[x++] & 0xFFFF];
+    }
+}
+
+#ifdef GFX_PIX_AVX2
+// what systemColorMap16/32 would hold for the colors in c, with the shift
+// counts in the low quadword of rs, gs and bs
+__attribute__((target("avx2"))) static inline __m256i gfxPixShuffle(__m256i c, __m128i rs, __m128i gs, __m128i bs)
+{
+    const __m256i mask = _mm256_set1_epi32(0x1F);
+    __m256i r = _mm256_sll_epi32(_mm256_and_si256(c, mask), rs);
+    __m256i g = _mm256_sll_epi32(_mm256_and_si256(_mm256_srli_epi32(c, 5), mask), gs);
+    __m256i b = _mm256_sll_epi32(_mm256_and_si256(_mm256_srli_epi32(c, 10), mask), bs);
+    return _mm256_or_si256(_mm256_or_si256(r, g), b);
+}
+
+template <bool Direct>
+__attribute__((target("avx2"))) static inline __m256i gfxPixColors32(int x, __m128i rs, __m128i gs, __m128i bs)
+{
+    __m256i c = _mm256_loadu_si256((const __m256i*)&lineMix[x]);
+    if (Direct)
+        return gfxPixShuffle(c, rs, gs, bs);
+    c = _mm256_and_si256(c, _mm256_set1_epi32(0xFFFF));
+    return _mm256_i32gather_epi32((const int*)systemColorMap32, c, 4);
+}
+
+__attribute__((target("avx2"))) static void gfxPixLine16AVX2(uint16_t* dest)
+{
+    const __m128i rs = _mm_cvtsi32_si128(systemRedShift);
+    const __m128i gs = _mm_cvtsi32_si128(systemGreenShift);
+    const __m128i bs = _mm_cvtsi32_si128(systemBlueShift);
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+
+    for (int x = 0; x < 240; x += 16) {
+        __m256i lo = _mm256_and_si256(gfxPixColors32<true>(x, rs, gs, bs), mask);
+        __m256i hi = _mm256_and_si256(gfxPixColors32<true>(x + 8, rs, gs, bs), mask);
+        // packus works on 128 bit lanes, put the quadwords back in order
+        __m256i c = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256((__m256i*)&dest[x], c);
+    }
+}
+
+__attribute__((target("avx2"))) static void gfxPixLine24AVX2(uint8_t* dest)
+{
+    const __m128i none = _mm_setzero_si128();
+    // low three bytes of each pixel packed at the bottom of the register
+    const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+    for (int x = 0; x < 240; x += 16) {
+        __m256i lo = gfxPixColors32<false>(x, none, none, none);
+        __m256i hi = gfxPixColors32<false>(x + 8, none, none, none);
+        __m128i a = _mm_shuffle_epi8(_mm256_castsi256_si128(lo), pack);
+        __m128i b = _mm_shuffle_epi8(_mm256_extracti128_si256(lo, 1), pack);
+        __m128i c = _mm_shuffle_epi8(_mm256_castsi256_si128(hi), pack);
+        __m128i d = _mm_shuffle_epi8(_mm256_extracti128_si256(hi, 1), pack);
+        // 16 pixels of 12 bytes per group of four make 48 bytes
+        _mm_storeu_si128((__m128i*)dest, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128((__m128i*)(dest + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128((__m128i*)(dest + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+        dest += 48;
+    }
+}
+
+template <bool Direct>
+__attribute__((target("avx2"))) static void gfxPixLine32AVX2(uint32_t* dest)
+{
+    const __m128i rs = _mm_cvtsi32_si128(systemRedShift);
+    const __m128i gs = _mm_cvtsi32_si128(systemGreenShift);
+    const __m128i bs = _mm_cvtsi32_si128(systemBlueShift);
+
+    for (int x = 0; x < 240; x += 8)
+        _mm256_storeu_si256((__m256i*)&dest[x], gfxPixColors32<Direct>(x, rs, gs, bs));
+}
+
+static bool gfxPixHasAVX2()
+{
+    static GBA_LOCAL int avx2 = -1;
+    if (avx2 < 0) {
+        __builtin_cpu_init();
+        avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return avx2 != 0;
+}
+#endif
+
+void gfxConvertLine16(uint16_t* dest)
+{
+#ifdef GFX_PIX_AVX2
+    if (gfxPixDirect && gfxPixHasAVX2()) {
+        gfxPixLine16AVX2(dest);
+        return;
+    }
+#endif
+    gfxPixLine16C(dest);
+}
+
+void gfxConvertLine24(uint8_t* dest)
+{
+#ifdef GFX_PIX_AVX2
+    if (gfxPixHasAVX2()) {
+        gfxPixLine24AVX2(dest);
+        return;
+    }
+#endif
+    gfxPixLine24C(dest);
+}
+
+void gfxConvertLine32(uint32_t* dest)
+{
+#ifdef GFX_PIX_AVX2
+    if (gfxPixHasAVX2()) {
+        if (gfxPixDirect)
+            gfxPixLine32AVX2<true>(dest);
+        else
+            gfxPixLine32AVX2<false>(dest);
+        return;
+    }
+#endif
+    gfxPixLine32C(dest);
+}
@@ -1,8 +1,11 @@
 // This file was written by denopqrihg
 // with major changes by tjm
+#include <assert.h>
 #include <stdio.h>
+#include <atomic>
 #include <cstring>
 #include <string>
+#include <thread>
 
 // malloc.h does not seem to exist on Mac OS 10.7 and is an error on FreeBSD
 #if defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__)
@@ -71,6 +74,7 @@ std::string IP_LINK_BIND_ADDRESS = "*";
 #include "GBA.h"
 #include "GBALink.h"
 #include "GBASockClient.h"
+#include "Instance.h"
 
 #include <SFML/Network.hpp>
 
@@ -206,6 +210,10 @@ static void StartCableSocket(uint16_t siocnt);
 static ConnectionState ConnectUpdateSocket(char* const message, size_t size);
 static void UpdateCableSocket(int ticks);
 static void CloseSocket();
+static ConnectionState InitCableLocal();
+static void StartCableLocal(uint16_t siocnt);
+static void UpdateCableLocal(int ticks);
+static void CloseCableLocal();
 
 const uint64_t TICKS_PER_FRAME = TICKS_PER_SECOND / 60;
 const uint64_t BITS_PER_SECOND = 115200;
@@ -365,7 +373,7 @@ struct LinkDriver {
 static const LinkDriver* linkDriver = NULL;
 static ConnectionState gba_connection_state = LINK_OK;
 
-static int linktime = 0;
+static GBA_LOCAL int linktime = 0;
 
 static GBASockClient* dol = NULL;
 static sf::IpAddress joybusHostAddr = sf::IpAddress::LocalHost;
@@ -380,6 +388,7 @@ static const LinkDriver linkDrivers[] = {
     { LINK_RFU_SOCKET, InitSocket, ConnectUpdateRFUSocket, StartRFUSocket, UpdateRFUSocket, CloseSocket, true },
     { LINK_GAMECUBE_DOLPHIN, JoyBusConnect, NULL, NULL, JoyBusUpdate, JoyBusShutdown, false },
     { LINK_GAMEBOY_SOCKET, InitSocket, ConnectUpdateSocket, NULL, NULL, CloseSocket, true },
+    { LINK_CABLE_LOCAL, InitCableLocal, NULL, StartCableLocal, UpdateCableLocal, CloseCableLocal, false },
 };
 
 enum {
@@ -482,6 +491,8 @@ static HANDLE linksync[4];
 static sem_t* linksync[4];
 #endif
 static int transfer_start_time_from_master = 0;
+// player of this thread's core on the in-process cable, -1 if unplugged
+static GBA_LOCAL int localPlayer = -1;
 #if (defined __WIN32__ || defined _WIN32)
 static HANDLE mmf = NULL;
 #else
@@ -555,6 +566,8 @@ int GetLinkPlayerId()
 {
     if (GetLinkMode() == LINK_DISCONNECTED) {
         return -1;
+    } else if (GetLinkMode() == LINK_CABLE_LOCAL) {
+        return localPlayer;
     } else if (linkid > 0) {
         return linkid;
     } else {
@@ -699,13 +712,17 @@ void StartGPLink(uint16_t value)
         return;
 
     switch (GetSIOMode(READ16LE(&ioMem[COMM_SIOCNT]), value)) {
-    case MULTIPLAYER:
+    case MULTIPLAYER: {
+        int id = linkid;
+        if (GetLinkMode() == LINK_CABLE_LOCAL)
+            id = localPlayer > 0 ? localPlayer : 0;
         value &= 0xc0f0;
         value |= 3;
-        if (linkid)
+        if (id)
             value |= 4;
-        UPDATE_REG(COMM_SIOCNT, ((READ16LE(&ioMem[COMM_SIOCNT]) & 0xff8b) | (linkid ? 0xc : 8) | (linkid << 4)));
+        UPDATE_REG(COMM_SIOCNT, ((READ16LE(&ioMem[COMM_SIOCNT]) & 0xff8b) | (id ? 0xc : 8) | (id << 4)));
         break;
+    }
 
     case GP:
 #if (defined __WIN32__ || defined _WIN32)
@@ -1274,6 +1291,309 @@ void CleanLocalLink()
 #endif
 }
 
+// The in-process cable
+//
+// Every player is the core of a GBAInstance thread (see Instance.h).  The
+// cores meet at a barrier every LOCAL_LINK_QUANTUM ticks and what one of
+// them sends is tagged with a boundary the receiver has not reached yet, so
+// a transfer starts and ends at the same emulated time on every core however
+// the threads get scheduled.  Nothing blocks but the barrier.
+
+#define LOCAL_LINK_QUANTUM 1024
+// A sender puts at most one message per boundary in each queue, its 'M' or
+// its 'D', and cannot get a boundary ahead of a receiver that has not read
+// them, so a queue never holds more than two.  Waiting for room could only
+// deadlock at the barrier, a full queue is a bug.
+#define LOCAL_LINK_QUEUE 16
+
+struct LocalLinkMessage {
+    uint32_t boundary; // read once the receiver has passed it
+    uint16_t data;
+    uint8_t type; // 'M' transfer started by the master, 'D' data of a slave
+    uint8_t arg; // speed | players << 2, for 'M'
+};
+
+// One writer thread, one reader thread
+class LocalLinkQueue {
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    LocalLinkMessage ring[LOCAL_LINK_QUEUE];
+
+public:
+    LocalLinkQueue(void);
+    void Push(const LocalLinkMessage& m);
+    bool Pop(LocalLinkMessage& m, uint32_t boundary);
+    void Drop(void);
+};
+
+static struct {
+    // generation << 16 | players plugged << 8 | players at the barrier
+    std::atomic<uint64_t> barrier;
+    std::atomic<int> plugged;
+    // [receiver][sender]
+    LocalLinkQueue queue[4][4];
+} localLink;
+
+static GBA_LOCAL int localTicks = 0;
+// barriers passed, all the plugged cores agree on it between two barriers
+static GBA_LOCAL uint32_t localBoundary = 0;
+static GBA_LOCAL uint32_t localEnd = 0;
+static GBA_LOCAL bool localTransfer = false;
+
+LocalLinkQueue::LocalLinkQueue(void)
+    : head(0)
+    , tail(0)
+{
+}
+
+void LocalLinkQueue::Push(const LocalLinkMessage& m)
+{
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    assert(t - head.load(std::memory_order_acquire) < LOCAL_LINK_QUEUE);
+    ring[t % LOCAL_LINK_QUEUE] = m;
+    tail.store(t + 1, std::memory_order_release);
+}
+
+bool LocalLinkQueue::Pop(LocalLinkMessage& m, uint32_t boundary)
+{
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+        return false;
+    if ((int32_t)(boundary - ring[h % LOCAL_LINK_QUEUE].boundary) < 0)
+        return false;
+    m = ring[h % LOCAL_LINK_QUEUE];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+// on the reader's side
+void LocalLinkQueue::Drop(void)
+{
+    head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+static void LocalLinkReset()
+{
+    localLink.barrier.store(0);
+    localLink.plugged.store(0);
+    for (int i = 0; i < 4; i++)
+        for (int k = 0; k < 4; k++)
+            localLink.queue[i][k].Drop();
+}
+
+// players in the chain, up to the first empty seat
+static int LocalLinkPlayers()
+{
+    int plugged = localLink.plugged.load();
+    int n = 0;
+    while (n < 4 && (plugged & (1 << n)))
+        n++;
+    return n;
+}
+
+static uint32_t LocalLinkQuanta(int players, int speed)
+{
+    return (trtimeend[players - 2][speed] + LOCAL_LINK_QUANTUM - 1) / LOCAL_LINK_QUANTUM;
+}
+
+static void LocalLinkSync()
+{
+    uint64_t s = localLink.barrier.load();
+    uint64_t next;
+    do {
+        if ((s & 0xff) + 1 >= ((s >> 8) & 0xff))
+            next = ((s >> 16) + 1) << 16 | (s & 0xff00); // the last one
+        else
+            next = s + 1;
+    } while (!localLink.barrier.compare_exchange_weak(s, next));
+
+    uint32_t generation = (uint32_t)(s >> 16);
+    for (int spin = 0; (uint32_t)(localLink.barrier.load() >> 16) == generation; spin++) {
+        if (spin >= 64)
+            std::this_thread::yield();
+    }
+    localBoundary = generation + 1;
+}
+
+static void LocalLinkBegin(const LocalLinkMessage& m)
+{
+    int players = m.arg >> 2;
+    if (localTransfer || localPlayer >= players)
+        return;
+
+    LocalLinkMessage reply = { localBoundary + 1, READ16LE(&ioMem[COMM_SIODATA8]), 'D', 0 };
+    for (int i = 0; i < players; i++)
+        if (i != localPlayer)
+            localLink.queue[i][localPlayer].Push(reply);
+
+    localTransfer = true;
+    localEnd = localBoundary + LocalLinkQuanta(players, m.arg & 3);
+    UPDATE_REG(COMM_SIOMULTI0, m.data);
+    UPDATE_REG(COMM_SIOMULTI1, 0xffff);
+    WRITE32LE(&ioMem[COMM_SIOMULTI2], 0xffffffff);
+    UPDATE_REG(COMM_SIOMULTI0 + (localPlayer << 1), reply.data);
+    // SI low during the transfer
+    UPDATE_REG(COMM_SIOCNT, (READ16LE(&ioMem[COMM_SIOCNT]) & ~0x44) | 0x80);
+    UPDATE_REG(COMM_RCNT, 6);
+}
+
+static void LocalLinkFinish()
+{
+    localTransfer = false;
+    uint16_t value = READ16LE(&ioMem[COMM_SIOCNT]);
+    if (localPlayer)
+        value |= 4;
+    UPDATE_REG(COMM_SIOCNT, (value & 0xff0f) | (localPlayer << 4));
+    // SC/SI high after transfer
+    UPDATE_REG(COMM_RCNT, localPlayer ? 15 : 11);
+    if (value & 0x4000) {
+        IF |= 0x80;
+        UPDATE_REG(0x202, IF);
+    }
+}
+
+static ConnectionState InitCableLocal()
+{
+    if (!GBAInstance::separate()) {
+        systemMessage(0, N_("The local cable needs a build where each instance has a core of its own"));
+        return LINK_ERROR;
+    }
+
+    LocalLinkReset();
+    return LINK_OK;
+}
+
+static void StartCableLocal(uint16_t value)
+{
+    int id = localPlayer > 0 ? localPlayer : 0;
+
+    switch (GetSIOMode(value, READ16LE(&ioMem[COMM_RCNT]))) {
+    case MULTIPLAYER: {
+        bool start = (value & 0x80) && localPlayer == 0 && !localTransfer;
+        // clear start, seqno, si (RO on slave, start = pulse on master)
+        value &= 0xff4b;
+        // get current si.  This way, on slaves, it is low during xfer
+        if (id) {
+            if (!localTransfer)
+                value |= 4;
+            else
+                value |= READ16LE(&ioMem[COMM_SIOCNT]) & 4;
+        }
+        if (start) {
+            int players = LocalLinkPlayers();
+            if (players > 1) {
+                // the slaves start on the next boundary, so does the master
+                LocalLinkMessage m = { localBoundary + 1, READ16LE(&ioMem[COMM_SIODATA8]), 'M',
+                    (uint8_t)((value & 3) | (players << 2)) };
+                for (int i = 1; i < players; i++)
+                    localLink.queue[i][0].Push(m);
+
+                localTransfer = true;
+                localEnd = m.boundary + LocalLinkQuanta(players, value & 3);
+                UPDATE_REG(COMM_SIOMULTI0, m.data);
+                UPDATE_REG(COMM_SIOMULTI1, 0xffff);
+                WRITE32LE(&ioMem[COMM_SIOMULTI2], 0xffffffff);
+                value &= ~0x40;
+            } else {
+                value |= 0x40; // comm error
+            }
+        }
+        value |= localTransfer << 7;
+        value |= (id && !localTransfer ? 0xc : 8); // set SD (high), SI (low on master)
+        value |= id << 4; // set seq
+        UPDATE_REG(COMM_SIOCNT, value);
+        if (id)
+            // SC low -> transfer in progress
+            UPDATE_REG(COMM_RCNT, localTransfer ? 6 : 7);
+        else
+            // SI is always low on master
+            UPDATE_REG(COMM_RCNT, localTransfer ? 2 : 3);
+        break;
+    }
+    case NORMAL8:
+    case NORMAL32:
+    case UART:
+    default:
+        UPDATE_REG(COMM_SIOCNT, value);
+        break;
+    }
+}
+
+static void UpdateCableLocal(int ticks)
+{
+    if (localPlayer < 0)
+        return;
+
+    localTicks += ticks;
+    while (localTicks >= LOCAL_LINK_QUANTUM) {
+        localTicks -= LOCAL_LINK_QUANTUM;
+        LocalLinkSync();
+
+        LocalLinkMessage m;
+        for (int from = 0; from < 4; from++) {
+            while (localLink.queue[localPlayer][from].Pop(m, localBoundary)) {
+                if (m.type == 'M')
+                    LocalLinkBegin(m);
+                else if (localTransfer)
+                    UPDATE_REG(COMM_SIOMULTI0 + (from << 1), m.data);
+            }
+        }
+
+        if (localTransfer && (int32_t)(localBoundary - localEnd) >= 0)
+            LocalLinkFinish();
+    }
+}
+
+static void CloseCableLocal()
+{
+    LocalLinkReset();
+}
+
+bool AttachLocalLink(int player)
+{
+    if (GetLinkMode() != LINK_CABLE_LOCAL || player < 0 || player > 3 || localPlayer >= 0)
+        return false;
+
+    if (localLink.plugged.fetch_or(1 << player) & (1 << player))
+        return false;
+
+    // whatever the previous player in this seat had not read
+    for (int from = 0; from < 4; from++)
+        localLink.queue[player][from].Drop();
+
+    // join the barrier everyone else is heading for
+    uint64_t s = localLink.barrier.load();
+    while (!localLink.barrier.compare_exchange_weak(s, s + 0x100))
+        ;
+
+    localPlayer = player;
+    localBoundary = (uint32_t)(s >> 16);
+    localTicks = 0;
+    localTransfer = false;
+    return true;
+}
+
+void DetachLocalLink()
+{
+    if (localPlayer < 0)
+        return;
+
+    // leave the barrier, finishing it if the others are all waiting there
+    uint64_t s = localLink.barrier.load();
+    uint64_t next;
+    do {
+        uint64_t players = ((s >> 8) & 0xff) - 1;
+        if (players && (s & 0xff) >= players)
+            next = ((s >> 16) + 1) << 16 | players << 8;
+        else
+            next = (s & ~(uint64_t)0xff00) | players << 8;
+    } while (!localLink.barrier.compare_exchange_weak(s, next));
+
+    localLink.plugged.fetch_and(~(1 << localPlayer));
+    localPlayer = -1;
+    localTransfer = false;
+}
+
 static ConnectionState JoyBusConnect()
 {
     delete dol;
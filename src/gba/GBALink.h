@@ -18,7 +18,8 @@ enum LinkMode {
     LINK_RFU_SOCKET,
     LINK_GAMECUBE_DOLPHIN,
     LINK_GAMEBOY_IPC,
-    LINK_GAMEBOY_SOCKET
+    LINK_GAMEBOY_SOCKET,
+    LINK_CABLE_LOCAL
 };
 
 /**
@@ -102,6 +103,24 @@ extern void CheckLinkConnection();
  */
 extern void CloseLink();
 
+/**
+ * Plug the core of the calling thread into the in-process cable
+ *
+ * Only in LINK_CABLE_LOCAL mode, where the cores of up to four GBAInstance
+ * threads play together.  Attach every player before any of them runs and
+ * detach each one before its thread stops running it, the others wait for
+ * it at every sync point.
+ *
+ * @param player 0 for the master, 1 to 3 for the slaves
+ * @return false if the seat is taken or the link is in another mode
+ */
+extern bool AttachLocalLink(int player);
+
+/**
+ * Unplug the core of the calling thread from the in-process cable
+ */
+extern void DetachLocalLink();
+
 /**
  * Get the id of the player of this VBA instance
  *
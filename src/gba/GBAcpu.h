@@ -1,9 +1,20 @@
 #ifndef GBACPU_H
 #define GBACPU_H
 
+#include "CodeCache.h"
+
 extern int armExecute();
 extern int thumbExecute();
 
+// armExecute() and thumbExecute() dispatch to a loop specialized on the
+// features below, picked by cpuExecuteVariant() on every call
+#define CPU_EXECUTE_CHEATS 1
+#define CPU_EXECUTE_BREAKPOINTS 2
+#define CPU_EXECUTE_DEBUGGER 4
+#define CPU_EXECUTE_VARIANTS 8
+
+extern int cpuExecuteVariant();
+
 #if defined(__i386__) || defined(__x86_64__)
 #define INSN_REGPARM __attribute__((regparm(1)))
 #else
@@ -18,6 +29,36 @@ extern int thumbExecute();
 #define UNLIKELY(x) (x)
 #endif
 
+typedef INSN_REGPARM void (*insnfunc_t)(uint32_t opcode);
+
+// Decoded instruction cache pages, see CodeCache.h
+
+struct codeCacheInsn {
+    insnfunc_t func;
+    uint32_t opcode;
+};
+
+struct armCachePage {
+    bool valid;
+    bool breakPoints;
+    codeCacheInsn insn[CODE_CACHE_ARM_INSNS];
+};
+
+struct thumbCachePage {
+    bool valid;
+    bool breakPoints;
+    codeCacheInsn insn[CODE_CACHE_THUMB_INSNS];
+};
+
+// Returns the page holding address, allocating it if needed, or NULL if
+// the address is not in a cacheable region.  The caller decodes the page
+// when it is not valid and then calls codeCacheValidate().
+armCachePage* codeCacheArmPage(uint32_t address);
+thumbCachePage* codeCacheThumbPage(uint32_t address);
+void codeCacheValidate(uint32_t address);
+// true if an execution breakpoint is set anywhere in the page
+bool codeCacheBreakPoints(uint32_t address);
+
 #define UPDATE_REG(address, value)                 \
     {                                              \
         WRITE16LE(((uint16_t*)&ioMem[address]), value); \
@@ -39,21 +80,21 @@ extern int thumbExecute();
 
 #define THUMB_PREFETCH_NEXT cpuPrefetch[1] = CPUReadHalfWordQuick(armNextPC + 2);
 
-extern int SWITicks;
-extern uint32_t mastercode;
-extern bool busPrefetch;
-extern bool busPrefetchEnable;
-extern uint32_t busPrefetchCount;
-extern int cpuNextEvent;
-extern bool holdState;
-extern uint32_t cpuPrefetch[2];
-extern int cpuTotalTicks;
-extern uint8_t memoryWait[16];
-extern uint8_t memoryWait32[16];
-extern uint8_t memoryWaitSeq[16];
-extern uint8_t memoryWaitSeq32[16];
-extern uint8_t cpuBitsSet[256];
-extern uint8_t cpuLowestBitSet[256];
+extern GBA_LOCAL int SWITicks;
+extern GBA_LOCAL uint32_t mastercode;
+extern GBA_LOCAL bool busPrefetch;
+extern GBA_LOCAL bool busPrefetchEnable;
+extern GBA_LOCAL uint32_t busPrefetchCount;
+extern GBA_LOCAL int cpuNextEvent;
+extern GBA_LOCAL bool holdState;
+extern GBA_LOCAL uint32_t cpuPrefetch[2];
+extern GBA_LOCAL int cpuTotalTicks;
+extern GBA_LOCAL uint8_t memoryWait[16];
+extern GBA_LOCAL uint8_t memoryWait32[16];
+extern GBA_LOCAL uint8_t memoryWaitSeq[16];
+extern GBA_LOCAL uint8_t memoryWaitSeq32[16];
+extern GBA_LOCAL uint8_t cpuBitsSet[256];
+extern GBA_LOCAL uint8_t cpuLowestBitSet[256];
 extern void CPUSwitchMode(int mode, bool saveState, bool breakLoop);
 extern void CPUSwitchMode(int mode, bool saveState);
 extern void CPUUpdateCPSR();
@@ -6,35 +6,33 @@
 #include "GBALink.h"
 #include "GBAcpu.h"
 #include "RTC.h"
+#include "Scheduler.h"
 #include "Sound.h"
+#include "TileCache.h"
 #include "agbprint.h"
 #include "remote.h"
 
 extern const uint32_t objTilesAddress[3];
 
-extern bool stopState;
-extern bool holdState;
-extern int holdType;
-extern int cpuNextEvent;
-extern bool cpuSramEnabled;
-extern bool cpuFlashEnabled;
-extern bool cpuEEPROMEnabled;
-extern bool cpuEEPROMSensorEnabled;
-extern bool cpuDmaHack;
-extern uint32_t cpuDmaLast;
-extern bool timer0On;
-extern int timer0Ticks;
-extern int timer0ClockReload;
-extern bool timer1On;
-extern int timer1Ticks;
-extern int timer1ClockReload;
-extern bool timer2On;
-extern int timer2Ticks;
-extern int timer2ClockReload;
-extern bool timer3On;
-extern int timer3Ticks;
-extern int timer3ClockReload;
-extern int cpuTotalTicks;
+extern GBA_LOCAL bool stopState;
+extern GBA_LOCAL bool holdState;
+extern GBA_LOCAL int holdType;
+extern GBA_LOCAL int cpuNextEvent;
+extern GBA_LOCAL bool cpuSramEnabled;
+extern GBA_LOCAL bool cpuFlashEnabled;
+extern GBA_LOCAL bool cpuEEPROMEnabled;
+extern GBA_LOCAL bool cpuEEPROMSensorEnabled;
+extern GBA_LOCAL bool cpuDmaHack;
+extern GBA_LOCAL uint32_t cpuDmaLast;
+extern GBA_LOCAL bool timer0On;
+extern GBA_LOCAL int timer0ClockReload;
+extern GBA_LOCAL bool timer1On;
+extern GBA_LOCAL int timer1ClockReload;
+extern GBA_LOCAL bool timer2On;
+extern GBA_LOCAL int timer2ClockReload;
+extern GBA_LOCAL bool timer3On;
+extern GBA_LOCAL int timer3ClockReload;
+extern GBA_LOCAL int cpuTotalTicks;
 
 #define CPUReadByteQuick(addr) map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask]
 
@@ -46,6 +44,21 @@ extern int cpuTotalTicks;
 
 extern uint32_t myROM[];
 
+// TM0D-TM3D of a timer that counts on its own is worked out from what is
+// left of its countdown, value is the register as it was last written
+static inline uint32_t CPUReadTimer(uint32_t address, uint32_t value)
+{
+    if ((address == 0x100) && timer0On)
+        value = 0xFFFF - ((schedulerLeft(SCHEDULER_TIMER0) - cpuTotalTicks) >> timer0ClockReload);
+    else if ((address == 0x104) && timer1On && !(TM1CNT & 4))
+        value = 0xFFFF - ((schedulerLeft(SCHEDULER_TIMER1) - cpuTotalTicks) >> timer1ClockReload);
+    else if ((address == 0x108) && timer2On && !(TM2CNT & 4))
+        value = 0xFFFF - ((schedulerLeft(SCHEDULER_TIMER2) - cpuTotalTicks) >> timer2ClockReload);
+    else if ((address == 0x10C) && timer3On && !(TM3CNT & 4))
+        value = 0xFFFF - ((schedulerLeft(SCHEDULER_TIMER3) - cpuTotalTicks) >> timer3ClockReload);
+    return value;
+}
+
 static inline uint32_t CPUReadMemory(uint32_t address)
 {
 #ifdef BKPT_SUPPORT
@@ -86,6 +99,8 @@ static inline uint32_t CPUReadMemory(uint32_t address)
         if ((address < 0x4000400) && ioReadable[address & 0x3fc]) {
             if (ioReadable[(address & 0x3fc) + 2]) {
                 value = READ32LE(((uint32_t*)&ioMem[address & 0x3fC]));
+                if (((address & 0x3fc) > 0xFF) && ((address & 0x3fc) < 0x10E))
+                    value = (value & 0xFFFF0000) | (CPUReadTimer(address & 0x3fc, value & 0xFFFF) & 0xFFFF);
                 if ((address & 0x3fc) == COMM_JOY_RECV_L)
                     UPDATE_REG(COMM_JOYSTAT,
                         READ16LE(&ioMem[COMM_JOYSTAT]) & ~JOYSTAT_RECV);
@@ -226,16 +241,8 @@ static inline uint32_t CPUReadHalfWord(uint32_t address)
     case 4:
         if ((address < 0x4000400) && ioReadable[address & 0x3fe]) {
             value = READ16LE(((uint16_t*)&ioMem[address & 0x3fe]));
-            if (((address & 0x3fe) > 0xFF) && ((address & 0x3fe) < 0x10E)) {
-                if (((address & 0x3fe) == 0x100) && timer0On)
-                    value = 0xFFFF - ((timer0Ticks - cpuTotalTicks) >> timer0ClockReload);
-                else if (((address & 0x3fe) == 0x104) && timer1On && !(TM1CNT & 4))
-                    value = 0xFFFF - ((timer1Ticks - cpuTotalTicks) >> timer1ClockReload);
-                else if (((address & 0x3fe) == 0x108) && timer2On && !(TM2CNT & 4))
-                    value = 0xFFFF - ((timer2Ticks - cpuTotalTicks) >> timer2ClockReload);
-                else if (((address & 0x3fe) == 0x10C) && timer3On && !(TM3CNT & 4))
-                    value = 0xFFFF - ((timer3Ticks - cpuTotalTicks) >> timer3ClockReload);
-            }
+            if (((address & 0x3fe) > 0xFF) && ((address & 0x3fe) < 0x10E))
+                value = CPUReadTimer(address & 0x3fe, value);
         } else if ((address < 0x4000400) && ioReadable[address & 0x3fc]) {
             value = 0;
         } else
@@ -367,8 +374,11 @@ static inline uint8_t CPUReadByte(uint32_t address)
     case 3:
         return internalRAM[address & 0x7fff];
     case 4:
-        if ((address < 0x4000400) && ioReadable[address & 0x3ff])
+        if ((address < 0x4000400) && ioReadable[address & 0x3ff]) {
+            if (((address & 0x3fe) > 0xFF) && ((address & 0x3fe) < 0x10E))
+                return CPUReadTimer(address & 0x3fe, READ16LE(((uint16_t*)&ioMem[address & 0x3fe]))) >> ((address & 1) << 3);
             return ioMem[address & 0x3ff];
+        }
         else
             goto unreadable;
     case 5:
@@ -453,6 +463,8 @@ static inline void CPUWriteMemory(uint32_t address, uint32_t value)
 
     switch (address >> 24) {
     case 0x02:
+        if (UNLIKELY(codeCacheWramCovered(address)) && READ32LE(((uint32_t*)&workRAM[address & 0x3FFFC])) != value)
+            codeCacheInvalidate(address);
 #ifdef BKPT_SUPPORT
         if (*((uint32_t*)&freezeWorkRAM[address & 0x3FFFC]))
             cheatsWriteMemory(address & 0x203FFFC, value);
@@ -461,6 +473,8 @@ static inline void CPUWriteMemory(uint32_t address, uint32_t value)
             WRITE32LE(((uint32_t*)&workRAM[address & 0x3FFFC]), value);
         break;
     case 0x03:
+        if (UNLIKELY(codeCacheIramCovered(address)) && READ32LE(((uint32_t*)&internalRAM[address & 0x7ffc])) != value)
+            codeCacheInvalidate(address);
 #ifdef BKPT_SUPPORT
         if (*((uint32_t*)&freezeInternalRAM[address & 0x7ffc]))
             cheatsWriteMemory(address & 0x3007FFC, value);
@@ -482,6 +496,7 @@ static inline void CPUWriteMemory(uint32_t address, uint32_t value)
         else
 #endif
             WRITE32LE(((uint32_t*)&paletteRAM[address & 0x3FC]), value);
+        tileCachePaletteWritten(address & 0x3FC);
         break;
     case 0x06:
         address = (address & 0x1fffc);
@@ -497,6 +512,7 @@ static inline void CPUWriteMemory(uint32_t address, uint32_t value)
 #endif
 
             WRITE32LE(((uint32_t*)&vram[address]), value);
+        tileCacheVramWritten(address);
         break;
     case 0x07:
 #ifdef BKPT_SUPPORT
@@ -557,6 +573,8 @@ static inline void CPUWriteHalfWord(uint32_t address, uint16_t value)
 
     switch (address >> 24) {
     case 2:
+        if (UNLIKELY(codeCacheWramCovered(address)) && READ16LE(((uint16_t*)&workRAM[address & 0x3FFFE])) != value)
+            codeCacheInvalidate(address);
 #ifdef BKPT_SUPPORT
         if (*((uint16_t*)&freezeWorkRAM[address & 0x3FFFE]))
             cheatsWriteHalfWord(address & 0x203FFFE, value);
@@ -565,6 +583,8 @@ static inline void CPUWriteHalfWord(uint32_t address, uint16_t value)
             WRITE16LE(((uint16_t*)&workRAM[address & 0x3FFFE]), value);
         break;
     case 3:
+        if (UNLIKELY(codeCacheIramCovered(address)) && READ16LE(((uint16_t*)&internalRAM[address & 0x7ffe])) != value)
+            codeCacheInvalidate(address);
 #ifdef BKPT_SUPPORT
         if (*((uint16_t*)&freezeInternalRAM[address & 0x7ffe]))
             cheatsWriteHalfWord(address & 0x3007ffe, value);
@@ -585,6 +605,7 @@ static inline void CPUWriteHalfWord(uint32_t address, uint16_t value)
         else
 #endif
             WRITE16LE(((uint16_t*)&paletteRAM[address & 0x3fe]), value);
+        tileCachePaletteWritten(address & 0x3fe);
         break;
     case 6:
         address = (address & 0x1fffe);
@@ -598,6 +619,7 @@ static inline void CPUWriteHalfWord(uint32_t address, uint16_t value)
         else
 #endif
             WRITE16LE(((uint16_t*)&vram[address]), value);
+        tileCacheVramWritten(address);
         break;
     case 7:
 #ifdef BKPT_SUPPORT
@@ -655,6 +677,8 @@ static inline void CPUWriteByte(uint32_t address, uint8_t b)
 
     switch (address >> 24) {
     case 2:
+        if (UNLIKELY(codeCacheWramCovered(address)) && workRAM[address & 0x3FFFF] != b)
+            codeCacheInvalidate(address);
 #ifdef BKPT_SUPPORT
         if (freezeWorkRAM[address & 0x3FFFF])
             cheatsWriteByte(address & 0x203FFFF, b);
@@ -663,6 +687,8 @@ static inline void CPUWriteByte(uint32_t address, uint8_t b)
             workRAM[address & 0x3FFFF] = b;
         break;
     case 3:
+        if (UNLIKELY(codeCacheIramCovered(address)) && internalRAM[address & 0x7fff] != b)
+            codeCacheInvalidate(address);
 #ifdef BKPT_SUPPORT
         if (freezeInternalRAM[address & 0x7fff])
             cheatsWriteByte(address & 0x3007fff, b);
@@ -739,6 +765,7 @@ static inline void CPUWriteByte(uint32_t address, uint8_t b)
     case 5:
         // no need to switch
         *((uint16_t*)&paletteRAM[address & 0x3FE]) = (b << 8) | b;
+        tileCachePaletteWritten(address & 0x3FE);
         break;
     case 6:
         address = (address & 0x1fffe);
@@ -756,6 +783,7 @@ static inline void CPUWriteByte(uint32_t address, uint8_t b)
             else
 #endif
                 *((uint16_t*)&vram[address]) = (b << 8) | b;
+            tileCacheVramWritten(address);
         }
         break;
     case 7:
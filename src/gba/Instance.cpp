@@ -0,0 +1,86 @@
+#include "Instance.h"
+
+static thread_local GBAInstance* currentInstance = NULL;
+
+GBAInstance::GBAInstance()
+    : m_running(0)
+    , m_stop(false)
+{
+    m_thread = std::thread(&GBAInstance::worker, this);
+}
+
+GBAInstance::~GBAInstance()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void GBAInstance::call(const std::function<void()>& f)
+{
+    if (currentInstance == this) {
+        f();
+        return;
+    }
+
+    post(f);
+    wait();
+}
+
+void GBAInstance::post(const std::function<void()>& f)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_queue.push_back(f);
+    }
+    m_wake.notify_one();
+}
+
+void GBAInstance::wait()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_done.wait(lock, [this] { return m_queue.empty() && !m_running; });
+}
+
+GBAInstance* GBAInstance::current()
+{
+    return currentInstance;
+}
+
+bool GBAInstance::separate()
+{
+#ifdef MULTI_INSTANCE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GBAInstance::worker()
+{
+    currentInstance = this;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        // whatever was posted still runs before the thread exits
+        if (m_queue.empty())
+            break;
+
+        std::function<void()> f;
+        f.swap(m_queue.front());
+        m_queue.pop_front();
+        m_running++;
+
+        lock.unlock();
+        f();
+        lock.lock();
+
+        m_running--;
+        if (m_queue.empty())
+            m_done.notify_all();
+    }
+}
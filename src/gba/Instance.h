@@ -0,0 +1,57 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "../common/Types.h"
+
+// A GBA core with a thread of its own.
+//
+// The state of the core is marked GBA_LOCAL.  In a MULTI_INSTANCE build
+// every thread has its own copy of it, so each instance is a separate
+// machine: the functions passed to call() and post() run on its thread and
+// everything they do with the core (CPULoadRom(), CPUInit(), CPULoop(),
+// states, cheats...) touches only its game.  The system* callbacks are
+// still shared, frontends tell the instances apart with current().
+//
+// What is not GBA_LOCAL is shared by the whole process: the sound settings
+// and output of Sound.cpp, layerSettings, GBASystem, the debugger, the
+// e-Reader and the link cable, which in LINK_CABLE_LOCAL mode plugs the
+// instances into each other (see AttachLocalLink()).  useBios and
+// layerEnable are per core like the rest of its state.
+// Without MULTI_INSTANCE there is only one machine, whichever thread runs
+// it, so only one instance may have a game loaded at a time.
+class GBAInstance {
+public:
+    GBAInstance();
+    virtual ~GBAInstance();
+
+    // Runs f on the instance's thread and returns once it has
+    void call(const std::function<void()>& f);
+    // Queues f to run on the instance's thread and returns at once
+    void post(const std::function<void()>& f);
+    // Waits until everything posted so far has run
+    void wait();
+
+    // The instance whose thread is calling, NULL on any other thread
+    static GBAInstance* current();
+    // true if every instance has a core of its own
+    static bool separate();
+
+private:
+    void worker();
+
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::deque<std::function<void()> > m_queue;
+    int m_running;
+    bool m_stop;
+};
+
+#endif // INSTANCE_H
@@ -35,50 +35,7 @@ void mode4RenderLine()
         backdrop = ((customBackdropColor & 0x7FFF) | 0x30000000);
     }
 
-    for (int x = 0; x < 240; x++) {
-        uint32_t color = backdrop;
-        uint8_t top = 0x20;
-
-        if (line2[x] < color) {
-            color = line2[x];
-            top = 0x04;
-        }
-
-        if ((uint8_t)(lineOBJ[x] >> 24) < (uint8_t)(color >> 24)) {
-            color = lineOBJ[x];
-            top = 0x10;
-        }
-
-        if ((top & 0x10) && (color & 0x00010000)) {
-            // semi-transparent OBJ
-            uint32_t back = backdrop;
-            uint8_t top2 = 0x20;
-
-            if (line2[x] < back) {
-                back = line2[x];
-                top2 = 0x04;
-            }
-
-            if (top2 & (BLDMOD >> 8))
-                color = gfxAlphaBlend(color, back,
-                    coeff[COLEV & 0x1F],
-                    coeff[(COLEV >> 8) & 0x1F]);
-            else {
-                switch ((BLDMOD >> 6) & 3) {
-                case 2:
-                    if (BLDMOD & top)
-                        color = gfxIncreaseBrightness(color, coeff[COLY & 0x1F]);
-                    break;
-                case 3:
-                    if (BLDMOD & top)
-                        color = gfxDecreaseBrightness(color, coeff[COLY & 0x1F]);
-                    break;
-                }
-            }
-        }
-
-        lineMix[x] = color;
-    }
+    gfxMixLine(0x04, backdrop);
     gfxBG2Changed = 0;
     gfxLastVCOUNT = VCOUNT;
 }
@@ -116,88 +73,7 @@ void mode4RenderLineNoWindow()
         backdrop = ((customBackdropColor & 0x7FFF) | 0x30000000);
     }
 
-    for (int x = 0; x < 240; x++) {
-        uint32_t color = backdrop;
-        uint8_t top = 0x20;
-
-        if (line2[x] < color) {
-            color = line2[x];
-            top = 0x04;
-        }
-
-        if ((uint8_t)(lineOBJ[x] >> 24) < (uint8_t)(color >> 24)) {
-            color = lineOBJ[x];
-            top = 0x10;
-        }
-
-        if (!(color & 0x00010000)) {
-            switch ((BLDMOD >> 6) & 3) {
-            case 0:
-                break;
-            case 1: {
-                if (top & BLDMOD) {
-                    uint32_t back = backdrop;
-                    uint8_t top2 = 0x20;
-
-                    if (line2[x] < back) {
-                        if (top != 0x04) {
-                            back = line2[x];
-                            top2 = 0x04;
-                        }
-                    }
-
-                    if ((uint8_t)(lineOBJ[x] >> 24) < (uint8_t)(back >> 24)) {
-                        if (top != 0x10) {
-                            back = lineOBJ[x];
-                            top2 = 0x10;
-                        }
-                    }
-
-                    if (top2 & (BLDMOD >> 8))
-                        color = gfxAlphaBlend(color, back,
-                            coeff[COLEV & 0x1F],
-                            coeff[(COLEV >> 8) & 0x1F]);
-                }
-            } break;
-            case 2:
-                if (BLDMOD & top)
-                    color = gfxIncreaseBrightness(color, coeff[COLY & 0x1F]);
-                break;
-            case 3:
-                if (BLDMOD & top)
-                    color = gfxDecreaseBrightness(color, coeff[COLY & 0x1F]);
-                break;
-            }
-        } else {
-            // semi-transparent OBJ
-            uint32_t back = backdrop;
-            uint8_t top2 = 0x20;
-
-            if (line2[x] < back) {
-                back = line2[x];
-                top2 = 0x04;
-            }
-
-            if (top2 & (BLDMOD >> 8))
-                color = gfxAlphaBlend(color, back,
-                    coeff[COLEV & 0x1F],
-                    coeff[(COLEV >> 8) & 0x1F]);
-            else {
-                switch ((BLDMOD >> 6) & 3) {
-                case 2:
-                    if (BLDMOD & top)
-                        color = gfxIncreaseBrightness(color, coeff[COLY & 0x1F]);
-                    break;
-                case 3:
-                    if (BLDMOD & top)
-                        color = gfxDecreaseBrightness(color, coeff[COLY & 0x1F]);
-                    break;
-                }
-            }
-        }
-
-        lineMix[x] = color;
-    }
+    gfxMixLineEffects(0x04, backdrop);
     gfxBG2Changed = 0;
     gfxLastVCOUNT = VCOUNT;
 }
@@ -4,6 +4,7 @@
 #include "../common/Port.h"
 #include "GBA.h"
 #include "Globals.h"
+#include "Scheduler.h"
 
 #include <memory.h>
 #include <string.h>
@@ -32,16 +33,27 @@ typedef struct
     uint32_t reserved3;
 } RTCCLOCKDATA;
 
-struct tm gba_time;
-static RTCCLOCKDATA rtcClockData;
-static bool rtcClockEnabled = true;
-static bool rtcRumbleEnabled = false;
+GBA_LOCAL struct tm gba_time;
+static GBA_LOCAL RTCCLOCKDATA rtcClockData;
+// set by the frontends, or by utilGBAFindSave() for carts with an RTC
+static GBA_LOCAL bool rtcClockEnabled = false;
+static GBA_LOCAL bool rtcRumbleEnabled = false;
 
-uint32_t countTicks = 0;
+static void rtcUpdateTime(int late)
+{
+    gba_time.tm_sec++;
+    mktime(&gba_time);
+    schedulerAdd(SCHEDULER_RTC, (int)TICKS_PER_SECOND - late, rtcUpdateTime);
+}
 
 void rtcEnable(bool e)
 {
     rtcClockEnabled = e;
+
+    if (!e)
+        schedulerRemove(SCHEDULER_RTC);
+    else if (!schedulerPending(SCHEDULER_RTC))
+        schedulerAdd(SCHEDULER_RTC, (int)TICKS_PER_SECOND, rtcUpdateTime);
 }
 
 bool rtcIsEnabled()
@@ -113,17 +125,6 @@ void SetGBATime()
     gba_time = *localtime(&long_time); /* Convert to local time. */
 }
 
-void rtcUpdateTime(int ticks)
-{
-    countTicks += ticks;
-
-    if (countTicks > TICKS_PER_SECOND) {
-        countTicks -= TICKS_PER_SECOND;
-        gba_time.tm_sec++;
-        mktime(&gba_time);
-    }
-}
-
 bool rtcWrite(uint32_t address, uint16_t value)
 {
     if (address == 0x80000c8) {
@@ -304,9 +305,11 @@ void rtcReset()
     rtcClockData.state = IDLE;
     rtcClockData.reserved[11] = 0;
     SetGBATime();
+
+    if (rtcClockEnabled)
+        schedulerAdd(SCHEDULER_RTC, (int)TICKS_PER_SECOND, rtcUpdateTime);
 }
 
-#ifdef __LIBRETRO__
 void rtcSaveGame(uint8_t*& data)
 {
     utilWriteMem(data, &rtcClockData, sizeof(rtcClockData));
@@ -316,7 +319,8 @@ void rtcReadGame(const uint8_t*& data)
 {
     utilReadMem(&rtcClockData, data, sizeof(rtcClockData));
 }
-#else
+
+#ifndef __LIBRETRO__
 void rtcSaveGame(gzFile gzFile)
 {
     utilGzWrite(gzFile, &rtcClockData, sizeof(rtcClockData));
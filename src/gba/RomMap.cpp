@@ -0,0 +1,168 @@
+#include <stddef.h>
+
+#include "RomMap.h"
+
+#if !defined(_WIN32) && !defined(__LIBRETRO__)
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common/Port.h"
+#include "GBA.h"
+#include "fex/fex.h"
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+// Past the image each halfword reads as its address / 2, which repeats
+// every 128K
+#define ROM_PATTERN_SIZE 0x20000
+
+static GBA_LOCAL uint8_t* romMapArea = NULL;
+static GBA_LOCAL int romMapFile = -1;
+static GBA_LOCAL uint32_t romMapFileSize = 0;
+// file holding one period of the pattern, -1 if there is none
+static GBA_LOCAL int romMapPattern = -1;
+
+static int romMapCreatePattern()
+{
+    FILE* f = tmpfile();
+    if (f == NULL)
+        return -1;
+
+    uint16_t chunk[0x1000];
+    for (uint32_t i = 0; i < ROM_PATTERN_SIZE; i += sizeof(chunk)) {
+        for (uint32_t k = 0; k < sizeof(chunk) / 2; k++)
+            WRITE16LE(&chunk[k], ((i >> 1) + k) & 0xFFFF);
+        if (fwrite(chunk, sizeof(chunk), 1, f) != 1) {
+            fclose(f);
+            return -1;
+        }
+    }
+
+    // the file is already unlinked, the descriptor keeps it around
+    int fd = fflush(f) == 0 ? dup(fileno(f)) : -1;
+    fclose(f);
+    return fd;
+}
+
+static bool romMapAt(uint32_t offset, uint32_t length)
+{
+    uint8_t* at = romMapArea + offset;
+    uint32_t image = romMapFileSize < length ? romMapFileSize : length;
+
+    if (mmap(at, image, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE,
+            romMapFile, 0) == MAP_FAILED)
+        return false;
+
+    // up to the next period the pattern is written, which also covers
+    // the end of the image's last page
+    uint32_t i = offset + ((image + 1) & ~1);
+    uint32_t end = offset + length;
+    for (; i < end && ((i & (ROM_PATTERN_SIZE - 1)) || romMapPattern < 0); i += 2)
+        WRITE16LE((uint16_t*)(romMapArea + i), (i >> 1) & 0xFFFF);
+
+    for (; i < end; i += ROM_PATTERN_SIZE) {
+        if (mmap(romMapArea + i, ROM_PATTERN_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE, romMapPattern, 0) == MAP_FAILED)
+            return false;
+    }
+
+    return true;
+}
+
+uint8_t* romMapLoad(const char* file, int& size)
+{
+    romMapRelease();
+
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    char header[fex_identify_header_size];
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < (off_t)sizeof(header)
+        || st.st_size > SIZE_ROM || pread(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header)
+        || *fex_identify_header(header)) {
+        close(fd);
+        return NULL;
+    }
+
+    void* area = mmap(NULL, SIZE_ROM, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (area == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    romMapArea = (uint8_t*)area;
+    romMapFile = fd;
+    romMapFileSize = (uint32_t)st.st_size;
+    romMapPattern = romMapCreatePattern();
+
+    if (!romMapAt(0, SIZE_ROM)) {
+        romMapRelease();
+        return NULL;
+    }
+
+    size = (int)romMapFileSize;
+    return romMapArea;
+}
+
+bool romMapMirror(uint32_t offset, uint32_t length)
+{
+    if (romMapArea == NULL || offset > SIZE_ROM || length > SIZE_ROM - offset)
+        return false;
+
+    return romMapAt(offset, length);
+}
+
+bool romMapActive()
+{
+    return romMapArea != NULL;
+}
+
+void romMapRelease()
+{
+    if (romMapArea != NULL)
+        munmap(romMapArea, SIZE_ROM);
+    if (romMapFile >= 0)
+        close(romMapFile);
+    if (romMapPattern >= 0)
+        close(romMapPattern);
+
+    romMapArea = NULL;
+    romMapFile = -1;
+    romMapFileSize = 0;
+    romMapPattern = -1;
+}
+
+#else
+
+uint8_t* romMapLoad(const char*, int&)
+{
+    return NULL;
+}
+
+bool romMapMirror(uint32_t, uint32_t)
+{
+    return false;
+}
+
+bool romMapActive()
+{
+    return false;
+}
+
+void romMapRelease()
+{
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef ROMMAP_H
+#define ROMMAP_H
+
+#include "../common/Types.h"
+
+// Cartridge images mapped from their file instead of read into memory.
+//
+// An uncompressed image is mapped private and writable over a SIZE_ROM
+// area, so loading does not copy anything, only the pages the game reads
+// are brought in, and processes running the same game share them through
+// the page cache.  Cheats and patches writing to the ROM get a private copy
+// of the page they touch.  The rest of the area reads as CPULoadRom() fills
+// it, from a small pattern file mapped over and over, and mirrors are more
+// mappings of the same file.  Only available on POSIX systems, elsewhere
+// romMapLoad() fails and the ROM is read as before.
+
+// Maps file over a new SIZE_ROM area and sets size to its size.  Returns
+// NULL if it is an archive, too big or cannot be mapped.
+uint8_t* romMapLoad(const char* file, int& size);
+// Maps the image again over [offset, offset + length) of the area, which
+// mirrors what is in memory only while the image is unmodified: patches
+// call gbaDetachRom() first, which copies the ROM and releases the mapping
+bool romMapMirror(uint32_t offset, uint32_t length);
+// true while the ROM comes from romMapLoad()
+bool romMapActive();
+void romMapRelease();
+
+#endif // ROMMAP_H
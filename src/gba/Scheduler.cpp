@@ -0,0 +1,116 @@
+#include <stddef.h>
+
+#include "Scheduler.h"
+
+// how far ahead the queue looks when nothing is scheduled
+#define SCHEDULER_IDLE_TICKS 0x10000000
+
+struct schedulerEntry {
+    uint32_t when;
+    schedulerHandler handler;
+    int next;
+    bool pending;
+    // taken off the queue by schedulerRun(), not run yet
+    bool due;
+};
+
+GBA_LOCAL int schedulerTicks = SCHEDULER_IDLE_TICKS;
+
+static GBA_LOCAL schedulerEntry schedulerEvents[SCHEDULER_EVENTS];
+static GBA_LOCAL int schedulerHead = -1;
+// timestamp schedulerTicks counts down to; the current time is always
+// schedulerDue - schedulerTicks
+static GBA_LOCAL uint32_t schedulerDue = SCHEDULER_IDLE_TICKS;
+
+static void schedulerUpdateTicks(uint32_t now)
+{
+    if (schedulerHead < 0)
+        schedulerDue = now + SCHEDULER_IDLE_TICKS;
+    else
+        schedulerDue = schedulerEvents[schedulerHead].when;
+    schedulerTicks = (int32_t)(schedulerDue - now);
+}
+
+static void schedulerUnlink(int event)
+{
+    int* link = &schedulerHead;
+    while (*link != event)
+        link = &schedulerEvents[*link].next;
+    *link = schedulerEvents[event].next;
+    schedulerEvents[event].pending = false;
+}
+
+void schedulerAdd(schedulerEvent event, int ticks, schedulerHandler handler)
+{
+    uint32_t now = schedulerDue - schedulerTicks;
+    schedulerEntry* e = &schedulerEvents[event];
+
+    if (e->pending)
+        schedulerUnlink(event);
+
+    e->when = now + ticks;
+    e->handler = handler;
+    e->pending = true;
+    e->due = false;
+
+    // events due at the same cycle stay in schedulerEvent order
+    int* link = &schedulerHead;
+    while (*link >= 0) {
+        int32_t after = (int32_t)(e->when - schedulerEvents[*link].when);
+        if (after < 0 || (after == 0 && *link > event))
+            break;
+        link = &schedulerEvents[*link].next;
+    }
+    e->next = *link;
+    *link = event;
+
+    schedulerUpdateTicks(now);
+}
+
+void schedulerRemove(schedulerEvent event)
+{
+    schedulerEvents[event].due = false;
+    if (!schedulerEvents[event].pending)
+        return;
+
+    uint32_t now = schedulerDue - schedulerTicks;
+    schedulerUnlink(event);
+    schedulerUpdateTicks(now);
+}
+
+bool schedulerPending(schedulerEvent event)
+{
+    return schedulerEvents[event].pending;
+}
+
+int schedulerLeft(schedulerEvent event)
+{
+    return (int32_t)(schedulerEvents[event].when - (schedulerDue - schedulerTicks));
+}
+
+void schedulerRun()
+{
+    uint32_t now = schedulerDue - schedulerTicks;
+    int due[SCHEDULER_EVENTS];
+    int count = 0;
+
+    // everything due is taken off first, so an event that is still due
+    // after rescheduling itself waits for the next run
+    while (schedulerHead >= 0 && (int32_t)(now - schedulerEvents[schedulerHead].when) >= 0) {
+        schedulerEntry* e = &schedulerEvents[schedulerHead];
+        schedulerHead = e->next;
+        e->pending = false;
+        e->due = true;
+        due[count++] = (int)(e - schedulerEvents);
+    }
+    schedulerUpdateTicks(now);
+
+    for (int i = 0; i < count; i++) {
+        schedulerEntry* e = &schedulerEvents[due[i]];
+        // an earlier handler moved or removed it
+        if (!e->due)
+            continue;
+        e->due = false;
+        e->handler((int32_t)(now - e->when));
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "../common/Types.h"
+
+// Timestamp-ordered event queue for the GBA core.
+//
+// Peripherals that need to run at a given point in emulated time register
+// an event here instead of being polled from CPULoop().  Events are kept
+// sorted by the cycle they are due at, so the loop only has to look at
+// schedulerTicks, the number of cycles left until the earliest one.  New
+// peripherals add an entry to schedulerEvent and schedule themselves.
+//
+// Time only moves on when CPULoop() calls schedulerAdvance() at the end of
+// a chunk, an event added while the CPU runs is due counting from there.
+// Savestates keep the countdowns of the LCD and the timers, GBA.cpp puts
+// them back on the queue when a state is loaded.
+
+// Events due at the same cycle run in this order, which is the order the
+// hardware is updated in within a chunk
+enum schedulerEvent {
+    SCHEDULER_LCD,
+    SCHEDULER_TIMER0,
+    SCHEDULER_TIMER1,
+    SCHEDULER_TIMER2,
+    SCHEDULER_TIMER3,
+    SCHEDULER_RTC,
+    SCHEDULER_PROFILING,
+    SCHEDULER_EVENTS
+};
+
+// called once the event is due, with the number of cycles it ran late
+typedef void (*schedulerHandler)(int late);
+
+// cycles until the earliest pending event
+extern GBA_LOCAL int schedulerTicks;
+
+// (re)schedules event to run ticks cycles from now
+void schedulerAdd(schedulerEvent event, int ticks, schedulerHandler handler);
+void schedulerRemove(schedulerEvent event);
+bool schedulerPending(schedulerEvent event);
+// cycles until a pending event is due
+int schedulerLeft(schedulerEvent event);
+// runs every event that is due once, called when schedulerTicks reaches 0
+void schedulerRun();
+
+static inline void schedulerAdvance(int ticks)
+{
+    schedulerTicks -= ticks;
+    if (schedulerTicks <= 0)
+        schedulerRun();
+}
+
+#endif // SCHEDULER_H
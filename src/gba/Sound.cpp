@@ -3,6 +3,10 @@
 #include "Sound.h"
 
 #include "../Util.h"
+#ifndef __LIBRETRO__
+#include "../common/AudioRateControl.h"
+#include "../common/ConfigManager.h"
+#endif
 #include "../common/Port.h"
 #include "GBA.h"
 #include "Globals.h"
@@ -34,24 +38,31 @@
 #define NR51 0x81
 #define NR52 0x84
 
-SoundDriver* soundDriver = 0;
+GBA_LOCAL SoundDriver* soundDriver = 0;
 
-extern bool stopState; // TODO: silence sound when true
+extern GBA_LOCAL bool stopState; // TODO: silence sound when true
 
 int const SOUND_CLOCK_TICKS_ = 167772; // 1/100 second
 
-static uint16_t soundFinalWave[1600];
+static GBA_LOCAL uint16_t soundFinalWave[1600];
 long soundSampleRate = 44100;
 bool soundInterpolation = true;
-bool soundPaused = true;
+GBA_LOCAL bool soundPaused = true;
 float soundFiltering = 0.5f;
 int SOUND_CLOCK_TICKS = SOUND_CLOCK_TICKS_;
-int soundTicks = SOUND_CLOCK_TICKS_;
+GBA_LOCAL int soundTicks = SOUND_CLOCK_TICKS_;
 
 static float soundVolume = 1.0f;
 static int soundEnableFlag = 0x3ff; // emulator channels enabled
-static float soundFiltering_ = -1.0f;
-static float soundVolume_ = -1.0f;
+static bool soundOutput = true;
+static GBA_LOCAL float soundFiltering_ = -1.0f;
+static GBA_LOCAL float soundVolume_ = -1.0f;
+static GBA_LOCAL bool soundSynthesizing_ = true; // channels are connected
+#ifndef __LIBRETRO__
+static AudioRateControl rateControl;
+static bool rateControlPaced = false; // soundSetExternalPacing()
+static bool rateControlOn = false; // stretched the last samples
+#endif
 
 void interp_rate() { /* empty for now */}
 
@@ -90,11 +101,11 @@ private:
     bool enabled;
 };
 
-static Gba_Pcm_Fifo pcm[2];
-static Gb_Apu* gb_apu;
-static Stereo_Buffer* stereo_buffer;
+static GBA_LOCAL Gba_Pcm_Fifo pcm[2];
+static GBA_LOCAL Gb_Apu* gb_apu;
+static GBA_LOCAL Stereo_Buffer* stereo_buffer;
 
-static Blip_Synth<blip_best_quality, 1> pcm_synth[3]; // 32 kHz, 16 kHz, 8 kHz
+static GBA_LOCAL Blip_Synth<blip_best_quality, 1> pcm_synth[3]; // 32 kHz, 16 kHz, 8 kHz
 
 void Gba_Pcm::init()
 {
@@ -109,7 +120,7 @@ void Gba_Pcm::apply_control(int idx)
     shift = ~ioMem[SGCNT0_H] >> (2 + idx) & 1;
 
     int ch = 0;
-    if ((soundEnableFlag >> idx & 0x100) && (ioMem[NR52] & 0x80))
+    if (soundSynthesizing_ && (soundEnableFlag >> idx & 0x100) && (ioMem[NR52] & 0x80))
         ch = ioMem[SGCNT0_H + 1] >> (idx * 4) & 3;
 
     Blip_Buffer* out = 0;
@@ -334,7 +345,10 @@ static void end_frame(blip_time_t time)
     pcm[1].pcm.end_frame(time);
 
     gb_apu->end_frame(time);
-    stereo_buffer->end_frame(time);
+
+    // nothing was added to it with the channels disconnected
+    if (soundSynthesizing_)
+        stereo_buffer->end_frame(time);
 }
 
 void flush_samples(Multi_Buffer* buffer)
@@ -362,7 +376,24 @@ void flush_samples(Multi_Buffer* buffer)
         if (soundPaused)
             soundResume();
 
-        soundDriver->write(soundFinalWave, soundBufferLen);
+        // drivers that report their buffer take any length, recordings
+        // keep the emulated rate
+        SoundDriverStats stats;
+        bool control = audio_rate_control && rateControlPaced && !speedup
+            && soundDriver->getStats(stats);
+        // the skew learned before speedup or another pause in control is
+        // stale
+        if (control && !rateControlOn)
+            rateControl.reset();
+        rateControlOn = control;
+        if (control) {
+            int pairs;
+            rateControl.update(stats);
+            uint16_t* wave = rateControl.resample(soundFinalWave, out_buf_size / 2, pairs);
+            soundDriver->write(wave, pairs * 4);
+        } else {
+            soundDriver->write(soundFinalWave, soundBufferLen);
+        }
         systemOnWriteDataToSoundBuffer(soundFinalWave, soundBufferLen);
     }
 #endif
@@ -383,19 +414,25 @@ static void apply_filtering()
     }
 }
 
+static void apply_output();
+
 void psoundTickfn()
 {
     if (gb_apu && stereo_buffer) {
         // Run sound hardware to present
         end_frame(soundTicks);
 
-        flush_samples(stereo_buffer);
+        if (soundSynthesizing_)
+            flush_samples(stereo_buffer);
 
         if (soundFiltering_ != soundFiltering)
             apply_filtering();
 
         if (soundVolume_ != soundVolume)
             apply_volume();
+
+        if (soundSynthesizing_ != soundSynthesizing())
+            apply_output();
     }
 
     soundTicks = 0;
@@ -412,7 +449,7 @@ static void apply_muting()
     if (gb_apu) {
         // APU
         for (int i = 0; i < 4; i++) {
-            if (soundEnableFlag >> i & 1)
+            if (soundSynthesizing_ && (soundEnableFlag >> i & 1))
                 gb_apu->set_output(stereo_buffer->center(),
                     stereo_buffer->left(), stereo_buffer->right(), i);
             else
@@ -421,6 +458,14 @@ static void apply_muting()
     }
 }
 
+// Connects or disconnects the channels, what was in the buffer is dropped
+static void apply_output()
+{
+    soundSynthesizing_ = soundSynthesizing();
+    apply_muting();
+    stereo_buffer->clear();
+}
+
 static void reset_apu()
 {
     gb_apu->reset(gb_apu->mode_agb, true);
@@ -460,6 +505,7 @@ static void remake_stereo_buffer()
     apply_filtering();
 
     // Volume Level
+    soundSynthesizing_ = soundSynthesizing();
     apply_muting();
     apply_volume();
 }
@@ -515,12 +561,34 @@ int soundGetEnable()
     return (soundEnableFlag & 0x30f);
 }
 
+void soundSetOutput(bool output)
+{
+    soundOutput = output;
+}
+
+bool soundGetOutput()
+{
+    return soundOutput;
+}
+
+bool soundSynthesizing()
+{
+#ifndef __LIBRETRO__
+    if (speedup && speedup_mute)
+        return false;
+#endif
+    return soundOutput;
+}
+
 void soundReset()
 {
     if (!soundDriver)
         return;
 
     soundDriver->reset();
+#ifndef __LIBRETRO__
+    rateControl.reset();
+#endif
 
     remake_stereo_buffer();
     reset_apu();
@@ -539,6 +607,9 @@ bool soundInit()
 
     if (!soundDriver->init(soundSampleRate))
         return false;
+#ifndef __LIBRETRO__
+    rateControl.reset();
+#endif
 
     if (!stereo_buffer) {
         remake_stereo_buffer();
@@ -553,6 +624,9 @@ void soundSetThrottle(unsigned short _throttle)
     if (!soundDriver)
         return;
     soundDriver->setThrottle(_throttle);
+#ifndef __LIBRETRO__
+    rateControl.reset();
+#endif
 }
 
 long soundGetSampleRate()
@@ -560,6 +634,20 @@ long soundGetSampleRate()
     return soundSampleRate;
 }
 
+bool soundGetStats(SoundDriverStats& stats)
+{
+    if (!soundDriver)
+        return false;
+    return soundDriver->getStats(stats);
+}
+
+void soundSetExternalPacing(bool paced)
+{
+#ifndef __LIBRETRO__
+    rateControlPaced = paced;
+#endif
+}
+
 void soundSetSampleRate(long sampleRate)
 {
     if (soundSampleRate != sampleRate) {
@@ -575,7 +663,7 @@ void soundSetSampleRate(long sampleRate)
     }
 }
 
-static int dummy_state[16];
+static GBA_LOCAL int dummy_state[16];
 
 #define SKIP(type, name)          \
     {                             \
@@ -587,7 +675,7 @@ static int dummy_state[16];
         &name, sizeof(type) \
     }
 
-static struct {
+static GBA_LOCAL struct {
     gb_apu_state_t apu;
 
     // old state
@@ -597,7 +685,7 @@ static struct {
 
 #ifndef __LIBRETRO__
 // Old GBA sound state format
-static variable_desc old_gba_state[] = {
+static GBA_LOCAL variable_desc old_gba_state[] = {
     SKIP(int, soundPaused),
     SKIP(int, soundPlay),
     SKIP(int, soundTicks),
@@ -674,7 +762,7 @@ static variable_desc old_gba_state[] = {
     { NULL, 0 }
 };
 
-variable_desc old_gba_state2[] = {
+static GBA_LOCAL variable_desc old_gba_state2[] = {
     LOAD(uint8_t[0x20], state.apu.regs[0x20]),
     SKIP(int, sound3Bank),
     SKIP(int, sound3DataSize),
@@ -684,7 +772,7 @@ variable_desc old_gba_state2[] = {
 #endif
 
 // New state format
-static variable_desc gba_state[] = {
+static GBA_LOCAL variable_desc gba_state[] = {
     // PCM
     LOAD(int, pcm[0].readIndex),
     LOAD(int, pcm[0].count),
@@ -733,25 +821,27 @@ static variable_desc gba_state[] = {
     { NULL, 0 }
 };
 
-#ifdef __LIBRETRO__
-void soundSaveGame(uint8_t*& out)
-#else
-void soundSaveGame(gzFile out)
-#endif
+static void soundSaveState()
 {
     gb_apu->save_state(&state.apu);
 
     // Be sure areas for expansion get written as zero
     memset(dummy_state, 0, sizeof dummy_state);
+}
 
-#ifdef __LIBRETRO__
+void soundSaveGame(uint8_t*& out)
+{
+    soundSaveState();
     utilWriteDataMem(out, gba_state);
-#else
-    utilWriteData(out, gba_state);
-#endif
 }
 
 #ifndef __LIBRETRO__
+void soundSaveGame(gzFile out)
+{
+    soundSaveState();
+    utilWriteData(out, gba_state);
+}
+
 // Reads and discards count bytes from in
 static void skip_read(gzFile in, int count)
 {
@@ -805,27 +895,38 @@ static void soundReadGameOld(gzFile in, int version)
 
 #include <stdio.h>
 
-#ifdef __LIBRETRO__
-void soundReadGame(const uint8_t*& in, int version)
-#else
-void soundReadGame(gzFile in, int version)
-#endif
+// Prepares APU and default state
+static void soundReadStateBegin()
 {
-    // Prepare APU and default state
     reset_apu();
     gb_apu->save_state(&state.apu);
+}
 
-#ifdef __LIBRETRO__
+static void soundReadStateEnd()
+{
+    gb_apu->load_state(state.apu);
+    write_SGCNT0_H(READ16LE(&ioMem[SGCNT0_H]) & 0x770F);
+
+    apply_muting();
+}
+
+// Memory states are only read at SAVE_GAME_VERSION, which has no older
+// formats to tell apart
+void soundReadGame(const uint8_t*& in, int /*version*/)
+{
+    soundReadStateBegin();
     utilReadDataMem(in, gba_state);
-#else
+    soundReadStateEnd();
+}
+
+#ifndef __LIBRETRO__
+void soundReadGame(gzFile in, int version)
+{
+    soundReadStateBegin();
     if (version > SAVE_GAME_VERSION_9)
         utilReadData(in, gba_state);
     else
         soundReadGameOld(in, version);
-#endif
-
-    gb_apu->load_state(state.apu);
-    write_SGCNT0_H(READ16LE(&ioMem[SGCNT0_H]) & 0x770F);
-
-    apply_muting();
+    soundReadStateEnd();
 }
+#endif
@@ -28,10 +28,20 @@ float soundGetVolume();
 void soundSetEnable(int mask);
 int soundGetEnable();
 
+// Turns sound output on and off. While it is off the sound hardware keeps
+// only what games can see, the registers, length counters, envelopes and
+// PCM FIFOs with their timers and DMA, nothing is synthesized or resampled
+// and the sound driver gets no samples. Runs without sound go faster.
+void soundSetOutput(bool output);
+bool soundGetOutput();
+// false while output is off, or the speedup key is held and speedup_mute is
+// set
+bool soundSynthesizing();
+
 // Pauses/resumes system sound output
 void soundPause();
 void soundResume();
-extern bool soundPaused; // current paused state
+extern GBA_LOCAL bool soundPaused; // current paused state
 
 // Cleans up sound. Afterwards, soundInit() can be called again.
 void soundShutdown();
@@ -41,6 +51,15 @@ void soundShutdown();
 long soundGetSampleRate();
 void soundSetSampleRate(long sampleRate);
 
+// Output buffer state of the sound driver, false if it does not keep one
+bool soundGetStats(struct SoundDriverStats& stats);
+
+// Whether something other than the sound driver, like waiting for vsync,
+// paces the emulator. audio_rate_control only stretches the sound while it
+// does and speedup is off: a driver that blocks the emulator keeps its
+// buffer full on its own.
+void soundSetExternalPacing(bool paced);
+
 // Sound settings
 extern bool soundInterpolation; // 1 if PCM should have low-pass filtering
 extern float soundFiltering; // 0.0 = none, 1.0 = max
@@ -73,13 +92,12 @@ void psoundTickfn();
 extern int SOUND_CLOCK_TICKS; // Number of 16.8 MHz clocks between calls to soundTick()
 
 // 2018-12-10 - counts up from 0 since last psoundTickfn() was called
-extern int soundTicks;
+extern GBA_LOCAL int soundTicks;
 
 // Saves/loads emulator state
-#ifdef __LIBRETRO__
 void soundSaveGame(uint8_t*&);
 void soundReadGame(const uint8_t*& in, int version);
-#else
+#ifndef __LIBRETRO__
 void soundSaveGame(gzFile);
 void soundReadGame(gzFile, int version);
 #endif
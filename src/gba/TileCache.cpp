@@ -0,0 +1,59 @@
+#include "../common/Port.h"
+#include "Globals.h"
+#include "TileCache.h"
+
+GBA_LOCAL tileCacheRow tileCacheRows[TILE_CACHE_ROWS];
+GBA_LOCAL uint32_t tileCacheVramGen[0x20000 >> 5];
+GBA_LOCAL uint32_t tileCachePaletteGen[TILE_CACHE_PALETTE_ALL + 1];
+
+static inline uint32_t tileCacheColor(int color, const uint16_t* palette, uint32_t prio)
+{
+    return color ? (READ16LE(&palette[color]) | prio) : 0x80000000;
+}
+
+void tileCacheDecode(tileCacheRow* row, uint32_t key)
+{
+    uint32_t address = key & 0x1FFFF;
+    int bank = (key >> 17) & 0x1F;
+    bool hFlip = (key >> 22) & 1;
+    uint32_t prio = (((key >> 23) & 3) << 25) + 0x1000000;
+    const uint8_t* data = &vram[address];
+    const uint16_t* palette = (uint16_t*)paletteRAM;
+
+    if (bank == TILE_CACHE_PALETTE_ALL) {
+        for (int i = 0; i < 8; i++)
+            row->pixels[hFlip ? 7 - i : i] = tileCacheColor(data[i], palette, prio);
+    } else {
+        palette += bank << 4;
+        for (int i = 0; i < 8; i++) {
+            int color = (i & 1) ? (data[i >> 1] >> 4) : (data[i >> 1] & 0x0F);
+            row->pixels[hFlip ? 7 - i : i] = tileCacheColor(color, palette, prio);
+        }
+    }
+
+    row->key = key;
+    row->vramGen = tileCacheVramGen[address >> 5];
+    row->paletteGen = tileCachePaletteGen[bank];
+}
+
+void tileCacheInvalidate(uint32_t address)
+{
+    switch (address >> 24) {
+    case 0x05:
+        tileCachePaletteWritten(address & 0x3FF);
+        break;
+    case 0x06:
+        address &= 0x1FFFF;
+        if ((address & 0x18000) == 0x18000)
+            address &= 0x17FFF;
+        tileCacheVramWritten(address);
+        break;
+    }
+}
+
+void tileCacheFlush()
+{
+    // every row checks the generation of its palette bank
+    for (int i = 0; i <= TILE_CACHE_PALETTE_ALL; i++)
+        tileCachePaletteGen[i]++;
+}
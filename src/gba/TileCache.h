@@ -0,0 +1,68 @@
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include "../common/Types.h"
+
+// Cache of decoded text background tile rows.
+//
+// gfxDrawTextScreen() looks up every 8 pixel tile row it draws by its VRAM
+// address, palette bank, horizontal flip and layer priority, and only
+// decodes the row on a miss, so a hit is a plain copy into the line.  Each entry remembers the generation of the 32 byte VRAM block and
+// of the palette bank it was decoded from.  Stores to VRAM and palette RAM
+// bump those generations, so stale rows simply stop matching.  Code that
+// changes either without going through CPUWriteMemory() and friends has to
+// call tileCacheInvalidate() or tileCacheFlush().
+
+#define TILE_CACHE_ROWS 4096
+// palette generation used by 256 color rows, bumped by any BG palette write
+#define TILE_CACHE_PALETTE_ALL 16
+
+struct tileCacheRow {
+    // palette color and priority as gfxDrawTextScreen() writes it, or
+    // 0x80000000 for a transparent pixel
+    uint32_t pixels[8];
+    uint32_t key;
+    uint32_t vramGen;
+    uint32_t paletteGen;
+};
+
+extern GBA_LOCAL tileCacheRow tileCacheRows[TILE_CACHE_ROWS];
+extern GBA_LOCAL uint32_t tileCacheVramGen[0x20000 >> 5];
+extern GBA_LOCAL uint32_t tileCachePaletteGen[TILE_CACHE_PALETTE_ALL + 1];
+
+void tileCacheDecode(tileCacheRow* row, uint32_t key);
+void tileCacheInvalidate(uint32_t address);
+void tileCacheFlush();
+
+// address is the offset into vram
+static inline void tileCacheVramWritten(uint32_t address)
+{
+    tileCacheVramGen[address >> 5]++;
+}
+
+// address is the offset into paletteRAM
+static inline void tileCachePaletteWritten(uint32_t address)
+{
+    if (address < 0x200) {
+        tileCachePaletteGen[address >> 5]++;
+        tileCachePaletteGen[TILE_CACHE_PALETTE_ALL]++;
+    }
+}
+
+// Returns the decoded pixels of the row at the given vram offset, for 16
+// color rows drawn with palette bank, and 256 color rows if bank is
+// TILE_CACHE_PALETTE_ALL.  prio is the BG priority from the control register.
+static inline const uint32_t* tileCacheLookup(uint32_t address, int bank, bool hFlip, int prio)
+{
+    uint32_t key = address | (bank << 17) | (hFlip << 22) | (prio << 23) | 0x80000000;
+    // 256 color rows are 8 bytes apart, 16 color ones 4
+    uint32_t index = bank == TILE_CACHE_PALETTE_ALL ? address >> 3 : address >> 2;
+    tileCacheRow* row = &tileCacheRows[(index ^ (bank << 6) ^ (hFlip << 11) ^ (prio << 9)) & (TILE_CACHE_ROWS - 1)];
+
+    if (row->key != key || row->vramGen != tileCacheVramGen[address >> 5] || row->paletteGen != tileCachePaletteGen[bank])
+        tileCacheDecode(row, key);
+
+    return row->pixels;
+}
+
+#endif // TILECACHE_H
@@ -3,17 +3,21 @@
 
 #include "../System.h"
 #include "../common/Port.h"
+#include "CodeCache.h"
 #include "GBA.h"
 #include "Globals.h"
 
-#define debuggerWriteHalfWord(addr, value) \
-    WRITE16LE((uint16_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], (value))
+#define debuggerWriteHalfWord(addr, value)                                                        \
+    do {                                                                                          \
+        codeCacheInvalidate(addr);                                                                \
+        WRITE16LE((uint16_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], (value)); \
+    } while (0)
 
 #define debuggerReadHalfWord(addr) \
     READ16LE(((uint16_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask]))
 
-static bool agbPrintEnabled = false;
-static bool agbPrintProtect = false;
+static GBA_LOCAL bool agbPrintEnabled = false;
+static GBA_LOCAL bool agbPrintProtect = false;
 
 bool agbPrintWrite(uint32_t address, uint16_t value)
 {
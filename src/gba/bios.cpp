@@ -1,6 +1,7 @@
 #include <math.h>
 #include <memory.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "GBA.h"
 #include "GBAinline.h"
@@ -250,6 +251,258 @@ void BIOS_BgAffineSet()
     }
 }
 
+// Fast paths for the SWIs that move and unpack blocks of data.  When both
+// ends are plain memory they work on it directly instead of going through
+// CPURead*() and CPUWrite*() for every unit, with the same result as the
+// loops below them, which still handle everything else.
+
+// CpuSet and CpuFastSet of count units of width bytes
+static bool biosCopyDirect(uint32_t source, uint32_t dest, uint32_t count, int width, bool fill)
+{
+    uint32_t size = count * width;
+
+    if ((source | dest) & (width - 1))
+        return false;
+
+    const uint8_t* src = CPUDirectMemory(source, fill ? width : size, width, false);
+    uint8_t* dst = CPUDirectMemory(dest, size, width, true);
+    if (src == NULL || dst == NULL)
+        return false;
+
+    if (fill) {
+        if (width == 4) {
+            uint32_t value = READ32LE((uint32_t*)src);
+            for (uint32_t i = 0; i < size; i += 4)
+                WRITE32LE((uint32_t*)(dst + i), value);
+        } else {
+            uint16_t value = READ16LE((uint16_t*)src);
+            for (uint32_t i = 0; i < size; i += 2)
+                WRITE16LE((uint16_t*)(dst + i), value);
+        }
+    } else {
+        // copying forward onto a later part of the source repeats it
+        if (dst > src && dst < src + size)
+            return false;
+        memmove(dst, src, size);
+    }
+
+    CPUDirectMemoryWritten(dest, size);
+    return true;
+}
+
+// LZ77UnCompWram stores bytes, LZ77UnCompVram halfwords.  The latter keeps
+// a byte back until its pair is complete, so the window can see what was
+// in memory before, and drops an odd last byte.
+static bool biosLZ77Direct(uint32_t source, uint32_t dest, int len, bool halfwords)
+{
+    // a unit reads one byte per byte it writes, except a match cut short at
+    // the end, plus a flag byte for every eight
+    uint32_t bound = len + (len + 7) / 8 + 1;
+
+    if (halfwords && (dest & 1))
+        return false;
+
+    const uint8_t* src = CPUDirectMemory(source, bound, 1, false);
+    uint8_t* dst = CPUDirectMemory(dest, len, halfwords ? 2 : 1, true);
+    if (src == NULL || dst == NULL || (src < dst + len && dst < src + bound))
+        return false;
+
+    uint32_t in = 0;
+    int pos = 0;
+    uint8_t low = 0;
+
+    while (pos < len) {
+        uint8_t d = src[in++];
+
+        for (int i = 0; i < 8 && pos < len; i++, d <<= 1) {
+            if (!(d & 0x80)) {
+                if (!halfwords)
+                    dst[pos] = src[in];
+                else if (pos & 1) {
+                    dst[pos - 1] = low;
+                    dst[pos] = src[in];
+                } else
+                    low = src[in];
+                in++;
+                pos++;
+                continue;
+            }
+
+            int length = (src[in] >> 4) + 3;
+            int window = pos - (((src[in] & 0x0F) << 8) | src[in + 1]) - 1;
+            in += 2;
+            if (length > len - pos)
+                length = len - pos;
+
+            if (!halfwords && window >= 0 && window + length <= pos) {
+                memcpy(dst + pos, dst + window, length);
+                pos += length;
+                continue;
+            }
+
+            for (int end = pos + length; pos < end; pos++, window++) {
+                uint8_t b = window >= 0 ? dst[window] : CPUReadByte(dest + window);
+                if (!halfwords)
+                    dst[pos] = b;
+                else if (pos & 1) {
+                    dst[pos - 1] = low;
+                    dst[pos] = b;
+                } else
+                    low = b;
+            }
+        }
+    }
+
+    CPUDirectMemoryWritten(dest, len);
+    return true;
+}
+
+// RLUnCompWram stores bytes, RLUnCompVram halfwords and drops an odd last
+// byte
+static bool biosRLDirect(uint32_t source, uint32_t dest, int len, bool halfwords)
+{
+    // a run reads at most two bytes per byte it writes
+    uint32_t bound = 2 * len;
+    int size = halfwords ? len & ~1 : len;
+
+    if (halfwords && (dest & 1))
+        return false;
+
+    const uint8_t* src = CPUDirectMemory(source, bound, 1, false);
+    uint8_t* dst = CPUDirectMemory(dest, size, halfwords ? 2 : 1, true);
+    if (src == NULL || dst == NULL || (src < dst + size && dst < src + bound))
+        return false;
+
+    uint32_t in = 0;
+    int pos = 0;
+
+    while (pos < len) {
+        uint8_t d = src[in++];
+        int l = d & 0x7F;
+
+        l += (d & 0x80) ? 3 : 1;
+        if (l > len - pos)
+            l = len - pos;
+        int n = l < size - pos ? l : size - pos;
+
+        if (d & 0x80)
+            memset(dst + pos, src[in++], n);
+        else {
+            memcpy(dst + pos, src + in, n);
+            in += l;
+        }
+        pos += l;
+    }
+
+    CPUDirectMemoryWritten(dest, size);
+    return true;
+}
+
+// HuffUnComp from source, just past the header.  The tree is walked in a
+// copy of it, so it may not share a region with the output.
+static bool biosHuffDirect(uint32_t source, uint32_t dest, uint32_t header)
+{
+    int len = header >> 8;
+    uint32_t size = (len + 3) & ~3;
+
+    uint32_t treeStart = source + 1;
+    int treeBytes = ((CPUReadByte(source) + 1) << 1) - 1;
+
+    if ((dest & 3) || (source >> 24) == (dest >> 24) || ((treeStart + treeBytes) >> 24) == (dest >> 24))
+        return false;
+
+    uint8_t* dst = CPUDirectMemory(dest, size, 4, true);
+    if (dst == NULL)
+        return false;
+
+    uint8_t tree[511];
+    for (int i = 0; i < treeBytes; i++)
+        tree[i] = CPUReadByte(treeStart + i);
+
+    // well formed data takes a few bits per symbol, past that and for
+    // rotated unaligned words CPUReadMemory() is used
+    uint32_t next = treeStart + treeBytes;
+    uint32_t dataStart = next;
+    uint32_t dataSize = size * 2 + 8;
+    const uint8_t* data = (next & 3) ? NULL : CPUDirectMemory(dataStart, dataSize, 4, false);
+    if (data == NULL)
+        dataSize = 0;
+
+#define HUFF_NODE(p) ((p) < treeBytes ? tree[p] : CPUReadByte(treeStart + (p)))
+#define HUFF_WORD(a) ((a) - dataStart < dataSize ? READ32LE((uint32_t*)(data + ((a) - dataStart))) : CPUReadMemory(a))
+
+    uint32_t mask = 0x80000000;
+    uint32_t bits = HUFF_WORD(next);
+    next += 4;
+
+    int pos = 0;
+    uint8_t rootNode = tree[0];
+    uint8_t currentNode = rootNode;
+    bool nibbles = (header & 0x0F) != 8;
+    int halfLen = 0;
+    int value = 0;
+    int byteShift = 0;
+    uint32_t writeValue = 0;
+    uint32_t out = 0;
+
+    while (len > 0) {
+        bool leaf;
+
+        if (pos == 0)
+            pos++;
+        else
+            pos += (((currentNode & 0x3F) + 1) << 1);
+
+        if (bits & mask) {
+            leaf = (currentNode & 0x40) != 0;
+            currentNode = HUFF_NODE(pos + 1);
+        } else {
+            leaf = (currentNode & 0x80) != 0;
+            currentNode = HUFF_NODE(pos);
+        }
+
+        if (leaf) {
+            bool full = true;
+            if (nibbles) {
+                value |= currentNode << halfLen;
+                halfLen += 4;
+                full = halfLen == 8;
+            } else
+                value = currentNode;
+
+            if (full) {
+                writeValue |= value << byteShift;
+                byteShift += 8;
+                halfLen = 0;
+                value = 0;
+
+                if (byteShift == 32) {
+                    WRITE32LE((uint32_t*)(dst + out), writeValue);
+                    out += 4;
+                    byteShift = 0;
+                    writeValue = 0;
+                    len -= 4;
+                }
+            }
+            pos = 0;
+            currentNode = rootNode;
+        }
+
+        mask >>= 1;
+        if (mask == 0) {
+            mask = 0x80000000;
+            bits = HUFF_WORD(next);
+            next += 4;
+        }
+    }
+
+#undef HUFF_NODE
+#undef HUFF_WORD
+
+    CPUDirectMemoryWritten(dest, size);
+    return true;
+}
+
 void BIOS_CpuSet()
 {
 #ifdef GBA_LOGGING
@@ -273,6 +526,8 @@ void BIOS_CpuSet()
         // needed for 32-bit mode!
         source &= 0xFFFFFFFC;
         dest &= 0xFFFFFFFC;
+        if (biosCopyDirect(source, dest, count, 4, (cnt >> 24) & 1))
+            return;
         // fill ?
         if ((cnt >> 24) & 1) {
             uint32_t value = (source > 0x0EFFFFFF ? 0x1CAD1CAD : CPUReadMemory(source));
@@ -291,6 +546,8 @@ void BIOS_CpuSet()
             }
         }
     } else {
+        if (biosCopyDirect(source, dest, count, 2, (cnt >> 24) & 1))
+            return;
         // 16-bit fill?
         if ((cnt >> 24) & 1) {
             uint16_t value = (source > 0x0EFFFFFF ? 0x1CAD : CPUReadHalfWord(source));
@@ -333,6 +590,10 @@ void BIOS_CpuFastSet()
 
     int count = cnt & 0x1FFFFF;
 
+    // BIOS always transfers 32 bytes at a time
+    if (biosCopyDirect(source, dest, (count + 7) & ~7, 4, (cnt >> 24) & 1))
+        return;
+
     // fill?
     if ((cnt >> 24) & 1) {
         while (count > 0) {
@@ -534,6 +795,9 @@ void BIOS_HuffUnComp()
     if (((source & 0xe000000) == 0) || ((source + ((header >> 8) & 0x1fffff)) & 0xe000000) == 0)
         return;
 
+    if (biosHuffDirect(source, dest, header))
+        return;
+
     uint8_t treeSize = CPUReadByte(source++);
 
     uint32_t treeStart = source;
@@ -685,6 +949,9 @@ void BIOS_LZ77UnCompVram()
 
     int len = header >> 8;
 
+    if (biosLZ77Direct(source, dest, len, true))
+        return;
+
     while (len > 0) {
         uint8_t d = CPUReadByte(source++);
 
@@ -769,6 +1036,9 @@ void BIOS_LZ77UnCompWram()
 
     int len = header >> 8;
 
+    if (biosLZ77Direct(source, dest, len, false))
+        return;
+
     while (len > 0) {
         uint8_t d = CPUReadByte(source++);
 
@@ -866,6 +1136,8 @@ void BIOS_RegisterRamReset(uint32_t flags)
             // clear internal RAM
             memset(internalRAM, 0, 0x7e00); // don't clear 0x7e00-0x7fff
         }
+        if (flags & 0x03)
+            codeCacheFlush();
         if (flags & 0x04) {
             // clear palette RAM
             memset(paletteRAM, 0, 0x400);
@@ -874,6 +1146,8 @@ void BIOS_RegisterRamReset(uint32_t flags)
             // clear VRAM
             memset(vram, 0, 0x18000);
         }
+        if (flags & 0x0C)
+            tileCacheFlush();
         if (flags & 0x10) {
             // clean OAM
             memset(oam, 0, 0x400);
@@ -964,6 +1238,9 @@ void BIOS_RLUnCompVram()
     int byteShift = 0;
     uint32_t writeValue = 0;
 
+    if (biosRLDirect(source, dest, len, true))
+        return;
+
     while (len > 0) {
         uint8_t d = CPUReadByte(source++);
         int l = d & 0x7F;
@@ -1029,6 +1306,9 @@ void BIOS_RLUnCompWram()
 
     int len = header >> 8;
 
+    if (biosRLDirect(source, dest, len, false))
+        return;
+
     while (len > 0) {
         uint8_t d = CPUReadByte(source++);
         int l = d & 0x7F;
@@ -1077,6 +1357,7 @@ void BIOS_SoftReset()
     uint8_t b = internalRAM[0x7ffa];
 
     memset(&internalRAM[0x7e00], 0, 0x200);
+    codeCacheInvalidate(0x03007e00);
 
     if (b) {
         armNextPC = 0x02000000;
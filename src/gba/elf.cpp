@@ -217,24 +217,24 @@ struct ELFFrameState {
 
 extern bool cpuIsMultiBoot;
 
-Symbol* elfSymbols = NULL;
-char* elfSymbolsStrTab = NULL;
-int elfSymbolsCount = 0;
+GBA_LOCAL Symbol* elfSymbols = NULL;
+GBA_LOCAL char* elfSymbolsStrTab = NULL;
+GBA_LOCAL int elfSymbolsCount = 0;
 
-ELFSectionHeader** elfSectionHeaders = NULL;
-char* elfSectionHeadersStringTable = NULL;
-int elfSectionHeadersCount = 0;
-uint8_t* elfFileData = NULL;
+GBA_LOCAL ELFSectionHeader** elfSectionHeaders = NULL;
+GBA_LOCAL char* elfSectionHeadersStringTable = NULL;
+GBA_LOCAL int elfSectionHeadersCount = 0;
+GBA_LOCAL uint8_t* elfFileData = NULL;
 
-CompileUnit* elfCompileUnits = NULL;
-DebugInfo* elfDebugInfo = NULL;
-char* elfDebugStrings = NULL;
+GBA_LOCAL CompileUnit* elfCompileUnits = NULL;
+GBA_LOCAL DebugInfo* elfDebugInfo = NULL;
+GBA_LOCAL char* elfDebugStrings = NULL;
 
-ELFcie* elfCies = NULL;
-ELFfde** elfFdes = NULL;
-int elfFdeCount = 0;
+GBA_LOCAL ELFcie* elfCies = NULL;
+GBA_LOCAL ELFfde** elfFdes = NULL;
+GBA_LOCAL int elfFdeCount = 0;
 
-CompileUnit* elfCurrentUnit = NULL;
+GBA_LOCAL CompileUnit* elfCurrentUnit = NULL;
 
 uint32_t elfRead4Bytes(uint8_t*);
 uint16_t elfRead2Bytes(uint8_t*);
@@ -11,7 +11,7 @@
 char US_Ereader[19] = "CARDE READERPSAE01";
 char JAP_Ereader[19] = "CARDE READERPEAJ01";
 char JAP_Ereader_plus[19] = "CARDEREADER+PSAJ01";
-char rom_info[19];
+GBA_LOCAL char rom_info[19];
 
 char Signature[0x29] = "E-Reader Dotcode -Created- by CaitSith2";
 
@@ -198,6 +198,7 @@ int LoadDotCodeData(int size, uint32_t* DCdata, unsigned long MEM1, unsigned lon
 
 void EReaderWriteMemory(uint32_t address, uint32_t value)
 {
+    codeCacheInvalidate(address);
     switch (address >> 24) {
     case 2:
         WRITE32LE(((uint32_t*)&workRAM[address & 0x3FFFF]), value);
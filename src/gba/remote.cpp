@@ -31,8 +31,10 @@
 #endif // _WIN32
 
 #include "BreakpointStructures.h"
+#include "CodeCache.h"
 #include "GBA.h"
 #include "elf.h"
+#include "TileCache.h"
 #include "remote.h"
 #include <iomanip>
 #include <iostream>
@@ -70,14 +72,26 @@ void remoteSetSockets(SOCKET l, SOCKET r)
 #define debuggerReadByte(addr) \
     map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask]
 
-#define debuggerWriteMemory(addr, value) \
-    *(uint32_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value)
-
-#define debuggerWriteHalfWord(addr, value) \
-    *(uint16_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value)
-
-#define debuggerWriteByte(addr, value) \
-    map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value)
+#define debuggerWriteMemory(addr, value)                                                 \
+    do {                                                                                 \
+        codeCacheInvalidate(addr);                                                       \
+        tileCacheInvalidate(addr);                                                       \
+        *(uint32_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value); \
+    } while (0)
+
+#define debuggerWriteHalfWord(addr, value)                                               \
+    do {                                                                                 \
+        codeCacheInvalidate(addr);                                                       \
+        tileCacheInvalidate(addr);                                                       \
+        *(uint16_t*)&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value); \
+    } while (0)
+
+#define debuggerWriteByte(addr, value)                                      \
+    do {                                                                    \
+        codeCacheInvalidate(addr);                                          \
+        tileCacheInvalidate(addr);                                          \
+        map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value); \
+    } while (0)
 
 bool dontBreakNow = false;
 int debuggerNumOfDontBreak = 0;
@@ -0,0 +1,490 @@
+// vbam-headless: runs a ROM for a number of frames without any video or
+// audio output and prints a JSON summary, for regression and throughput
+// jobs on hosts without a display or sound card.
+//
+// Nothing is read from the configuration or the battery files, so the same
+// command gives the same hashes on any machine.
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifndef __GNUC__
+#define HAVE_DECL_GETOPT 0
+#define __STDC__ 1
+#include "getopt.h"
+#else // ! __GNUC__
+#define HAVE_DECL_GETOPT 1
+#include <getopt.h>
+#endif // ! __GNUC__
+
+#include "../System.h"
+#include "../Util.h"
+#include "../common/ConfigManager.h"
+#include "../common/SoundDriver.h"
+#include "../gb/gb.h"
+#include "../gb/gbGlobals.h"
+#include "../gba/Flash.h"
+#include "../gba/GBA.h"
+#include "../gba/Globals.h"
+#include "../gba/Sound.h"
+
+// GBA frames per second
+#define FRAME_RATE 59.7275
+
+int emulating = 0;
+int systemSpeed = 0;
+int systemRedShift = 19;
+int systemGreenShift = 11;
+int systemBlueShift = 3;
+int systemColorDepth = 32;
+int systemVerbose = 0;
+int systemFrameSkip = 0;
+int systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
+uint32_t systemColorMap32[0x10000];
+uint16_t systemColorMap16[0x10000];
+uint16_t systemGbPalette[24];
+
+static int frames = 0;
+static int framesToRun = 600;
+static uint32_t heldKeys = 0;
+static bool hashing = false;
+static int hashEvery = 0;
+static int saveEvery = 0;
+static const char* saveStateFile = NULL;
+static const char* loadStateFile = NULL;
+static const char* outputFile = NULL;
+static const char* biosFile = NULL;
+
+static const uint64_t FNV_OFFSET = 1469598103934665603ULL;
+static uint64_t videoHash = FNV_OFFSET;
+static uint64_t audioHash = FNV_OFFSET;
+static uint64_t audioBytes = 0;
+
+struct FrameHash {
+    int frame;
+    uint64_t video;
+};
+static std::vector<FrameHash> frameHashes;
+static std::vector<std::string> statesWritten;
+static EmulatedSystem emulator;
+static int screenWidth = 240;
+static int screenHeight = 160;
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t length)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Takes the samples and throws them away, hashing them if asked to
+class HeadlessSound : public SoundDriver {
+public:
+    bool init(long) { return true; }
+    void pause() {}
+    void reset() {}
+    void resume() {}
+    void write(uint16_t* finalWave, int length)
+    {
+        if (hashing)
+            audioHash = fnv1a(audioHash, finalWave, length);
+        audioBytes += length;
+    }
+    void setThrottle(unsigned short) {}
+};
+
+static std::string stateFileName(int frame)
+{
+    std::string name = saveStateFile;
+    if (!saveEvery)
+        return name;
+
+    // the frame goes before the extension, game.sgm -> game-600.sgm
+    char number[16];
+    snprintf(number, sizeof(number), "-%d", frame);
+    size_t dot = name.rfind('.');
+    size_t slash = name.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        dot = name.size();
+    return name.insert(dot, number);
+}
+
+static bool saveState(int frame)
+{
+    std::string name = stateFileName(frame);
+    if (!emulator.emuWriteState(name.c_str())) {
+        systemMessage(0, "Cannot write state %s", name.c_str());
+        return false;
+    }
+    statesWritten.push_back(name);
+    return true;
+}
+
+static void writeJsonString(FILE* f, const char* s)
+{
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void writeSummary(FILE* f, const char* rom, IMAGE_TYPE type, double seconds)
+{
+    double fps = seconds > 0 ? frames / seconds : 0;
+
+    fprintf(f, "{\n  \"rom\": ");
+    writeJsonString(f, rom);
+    fprintf(f, ",\n  \"system\": \"%s\",\n", type == IMAGE_GB ? "gb" : "gba");
+    fprintf(f, "  \"frames\": %d,\n", frames);
+    fprintf(f, "  \"seconds\": %.3f,\n", seconds);
+    fprintf(f, "  \"fps\": %.1f,\n", fps);
+    fprintf(f, "  \"speed\": %.1f", fps * 100 / FRAME_RATE);
+    if (hashing) {
+        fprintf(f, ",\n  \"video_hash\": \"%016llx\"", (unsigned long long)videoHash);
+        fprintf(f, ",\n  \"audio_hash\": \"%016llx\"", (unsigned long long)audioHash);
+        fprintf(f, ",\n  \"audio_bytes\": %llu", (unsigned long long)audioBytes);
+    }
+    if (hashEvery) {
+        fprintf(f, ",\n  \"frame_hashes\": [");
+        for (size_t i = 0; i < frameHashes.size(); i++)
+            fprintf(f, "%s\n    { \"frame\": %d, \"video\": \"%016llx\" }", i ? "," : "",
+                frameHashes[i].frame, (unsigned long long)frameHashes[i].video);
+        fprintf(f, "\n  ]");
+    }
+    if (!statesWritten.empty()) {
+        fprintf(f, ",\n  \"states\": [");
+        for (size_t i = 0; i < statesWritten.size(); i++) {
+            fprintf(f, "%s\n    ", i ? "," : "");
+            writeJsonString(f, statesWritten[i].c_str());
+        }
+        fprintf(f, "\n  ]");
+    }
+    fprintf(f, "\n}\n");
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "Usage: vbam-headless [options] rom\n"
+        "\n"
+        "  -f, --frames=N        frames to run (default 600)\n"
+        "  -b, --bios=FILE       BIOS to boot from\n"
+        "  -k, --keys=MASK       buttons held down, a GBA key mask\n"
+        "  -s, --frameskip=N     frames not drawn out of every N + 1\n"
+        "  -H, --hash            hash the video and audio output\n"
+        "  -e, --hash-every=N    also list the video hash every N frames\n"
+        "  -l, --load-state=FILE start from a saved state\n"
+        "  -S, --save-state=FILE save the state after the last frame\n"
+        "  -E, --save-every=N    save every N frames instead, with the frame\n"
+        "                        number added to the file name\n"
+        "  -o, --output=FILE     write the JSON summary to FILE, not stdout\n");
+}
+
+static bool parseOptions(int argc, char** argv)
+{
+    static const struct option options[] = {
+        { "frames", required_argument, NULL, 'f' },
+        { "bios", required_argument, NULL, 'b' },
+        { "keys", required_argument, NULL, 'k' },
+        { "frameskip", required_argument, NULL, 's' },
+        { "hash", no_argument, NULL, 'H' },
+        { "hash-every", required_argument, NULL, 'e' },
+        { "load-state", required_argument, NULL, 'l' },
+        { "save-state", required_argument, NULL, 'S' },
+        { "save-every", required_argument, NULL, 'E' },
+        { "output", required_argument, NULL, 'o' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, no_argument, NULL, 0 }
+    };
+
+    int op;
+    while ((op = getopt_long(argc, argv, "f:b:k:s:He:l:S:E:o:h", options, NULL)) != -1) {
+        switch (op) {
+        case 'f':
+            framesToRun = atoi(optarg);
+            break;
+        case 'b':
+            biosFile = optarg;
+            break;
+        case 'k':
+            heldKeys = strtoul(optarg, NULL, 0) & 0x3ff;
+            break;
+        case 's':
+            systemFrameSkip = atoi(optarg);
+            break;
+        case 'H':
+            hashing = true;
+            break;
+        case 'e':
+            hashing = true;
+            hashEvery = atoi(optarg);
+            break;
+        case 'l':
+            loadStateFile = optarg;
+            break;
+        case 'S':
+            saveStateFile = optarg;
+            break;
+        case 'E':
+            saveEvery = atoi(optarg);
+            break;
+        case 'o':
+            outputFile = optarg;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    if (optind != argc - 1 || framesToRun <= 0 || hashEvery < 0 || saveEvery < 0
+        || systemFrameSkip < 0 || systemFrameSkip > 9)
+        return false;
+    if (saveEvery && !saveStateFile) {
+        fprintf(stderr, "--save-every needs --save-state\n");
+        return false;
+    }
+    return true;
+}
+
+static bool loadRom(const char* file, IMAGE_TYPE type)
+{
+    if (type == IMAGE_GB) {
+        if (!gbLoadRom(file))
+            return false;
+        gbGetHardwareType();
+        if (gbHardware & 7)
+            gbCPUInit(biosFile, biosFile != NULL);
+        emulator = GBSystem;
+        screenWidth = gbBorderLineSkip;
+        screenHeight = gbBorderOn ? 224 : 144;
+        gbReset();
+        return true;
+    }
+
+    int size = CPULoadRom(file);
+    if (!size)
+        return false;
+    if (cpuSaveType == 0)
+        utilGBAFindSave(size);
+    else
+        saveType = cpuSaveType;
+    doMirroring(mirroringEnable);
+    emulator = GBASystem;
+    CPUInit(biosFile, biosFile != NULL);
+    CPUReset();
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (!parseOptions(argc, argv)) {
+        usage();
+        return 1;
+    }
+
+    const char* rom = argv[optind];
+    IMAGE_TYPE type = utilFindType(rom);
+    if (type == IMAGE_UNKNOWN) {
+        systemMessage(0, "Unknown file type %s", rom);
+        return 2;
+    }
+
+    // the defaults LoadConfig() would give
+    for (int i = 0; i < 24;) {
+        systemGbPalette[i++] = (0x1f) | (0x1f << 5) | (0x1f << 10);
+        systemGbPalette[i++] = (0x15) | (0x15 << 5) | (0x15 << 10);
+        systemGbPalette[i++] = (0x0c) | (0x0c << 5) | (0x0c << 10);
+        systemGbPalette[i++] = 0;
+    }
+    flashSetSize(0x10000);
+    utilUpdateSystemColorMaps();
+    // the samples are only kept for the hash
+    soundSetOutput(hashing);
+    soundInit();
+
+    if (!loadRom(rom, type)) {
+        systemMessage(0, "Failed to load file %s", rom);
+        return 2;
+    }
+    if (loadStateFile && !emulator.emuReadState(loadStateFile)) {
+        systemMessage(0, "Cannot read state %s", loadStateFile);
+        return 3;
+    }
+
+    FILE* out = stdout;
+    if (outputFile && !(out = fopen(outputFile, "w"))) {
+        systemMessage(0, "Cannot write %s", outputFile);
+        return 1;
+    }
+
+    emulating = 1;
+    bool failed = false;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (frames < framesToRun) {
+        int before = frames;
+        emulator.emuMain(emulator.emuCount);
+        // systemPauseOnFrame() has the loop return after every frame
+        if (frames == before)
+            continue;
+        if (hashEvery && frames % hashEvery == 0) {
+            FrameHash h = { frames, videoHash };
+            frameHashes.push_back(h);
+        }
+        if (saveEvery && frames % saveEvery == 0 && frames < framesToRun)
+            failed |= !saveState(frames);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    emulating = 0;
+
+    if (saveStateFile)
+        failed |= !saveState(frames);
+
+    writeSummary(out, rom, type, seconds);
+    if (out != stdout)
+        fclose(out);
+
+    emulator.emuCleanUp();
+    soundShutdown();
+    return failed ? 3 : 0;
+}
+
+void systemMessage(int, const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vfprintf(stderr, msg, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+void log(const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vfprintf(stderr, msg, args);
+    va_end(args);
+}
+
+void systemFrame()
+{
+    frames++;
+}
+
+bool systemPauseOnFrame()
+{
+    return true;
+}
+
+void systemDrawScreen()
+{
+    if (!hashing)
+        return;
+
+    // 32 bit lines are one pixel wider than the screen, after a blank one
+    int pitch = (screenWidth + 1) * 4;
+    for (int y = 0; y < screenHeight; y++)
+        videoHash = fnv1a(videoHash, pix + (y + 1) * pitch, screenWidth * 4);
+}
+
+void systemSendScreen()
+{
+}
+
+SoundDriver* systemSoundInit()
+{
+    soundShutdown();
+    return new HeadlessSound();
+}
+
+uint32_t systemReadJoypad(int)
+{
+    return heldKeys;
+}
+
+bool systemReadJoypads()
+{
+    return true;
+}
+
+uint32_t systemGetClock()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void systemOnWriteDataToSoundBuffer(const uint16_t*, int)
+{
+}
+
+void systemOnSoundShutdown()
+{
+}
+
+bool systemCanChangeSoundQuality()
+{
+    return false;
+}
+
+void systemShowSpeed(int)
+{
+}
+
+void system10Frames(int)
+{
+}
+
+void systemScreenCapture(int)
+{
+}
+
+void systemGbPrint(uint8_t*, int, int, int, int, int)
+{
+}
+
+void systemGbBorderOn()
+{
+}
+
+void systemUpdateMotionSensor()
+{
+}
+
+int systemGetSensorX()
+{
+    return 0;
+}
+
+int systemGetSensorY()
+{
+    return 0;
+}
+
+int systemGetSensorZ()
+{
+    return 0;
+}
+
+uint8_t systemGetSensorDarkness()
+{
+    return 0xE8;
+}
+
+void systemCartridgeRumble(bool)
+{
+}
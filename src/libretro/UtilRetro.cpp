@@ -26,6 +26,7 @@
 int  rtcEnabled          = 0;
 int  cpuDisableSfx       = 0;
 int  skipBios            = 0;
+int  acceleratedSwi      = 0;
 int  saveType            = 0;
 int  cpuSaveType         = 0;
 int  skipSaveGameBattery = 0;
@@ -245,6 +246,8 @@ void utilUpdateSystemColorMaps(bool lcd)
                     gbafilter_pal32(systemColorMap32, 0x10000);
             break;
     }
+
+    gfxColorMapsChanged(lcd);
 }
 
 // Not endian safe, but VBA itself doesn't seem to care, so hey <_<
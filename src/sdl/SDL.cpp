@@ -47,6 +47,7 @@
 
 #include "../Util.h"
 #include "../common/ConfigManager.h"
+#include "../common/FrameTimes.h"
 #include "../common/Patch.h"
 #include "../gb/gb.h"
 #include "../gb/gbCheats.h"
@@ -122,6 +123,8 @@ struct EmulatedSystem emulator = {
     NULL,
     NULL,
     NULL,
+    NULL,
+    NULL,
     false,
     0
 };
@@ -185,6 +188,9 @@ static int sdlSoundToggledOff = 0;
 
 extern int autoFireMaxCount;
 
+// Rewind slots, a state every rewindTimer seconds that the rewind keys
+// browse back and forth.  Unlike the wx frontend's per-frame history
+// (common/Rewind.h) a slot can be gone back to and left again.
 #define REWIND_NUM 8
 #define REWIND_SIZE 400000
 
@@ -222,6 +228,46 @@ char homeDataDir[1024];
 char screenMessageBuffer[21];
 uint32_t screenMessageTime = 0;
 
+// Frames handed from the emulator to the filter thread and back.  The
+// emulator copies pix into a free buffer, the filter thread filters it into
+// the buffer's screen, and the emulator shows the newest filtered frame the
+// next time it draws.  The SDL renderer and the GL context stay on the main
+// thread, which is the emulator's.  The emulator never waits: with no free
+// buffer it writes over the oldest frame still waiting.
+enum {
+    FRAME_FREE,
+    FRAME_WRITING,
+    FRAME_READY,
+    FRAME_FILTERING,
+    FRAME_FILTERED
+};
+
+struct PresentFrame {
+    uint8_t* pix;
+    uint8_t* screen;
+    int state;
+    uint32_t serial;
+};
+
+#define PRESENT_MAX_BUFFERS 4
+
+static PresentFrame presentFrames[PRESENT_MAX_BUFFERS];
+static int presentCount = 0;
+static size_t presentSize = 0;
+static uint32_t presentSerial = 0;
+static bool presentStop = false;
+static SDL_Thread* filterThread = NULL;
+// guards the frames and the on-screen message
+static SDL_mutex* presentLock = NULL;
+static SDL_cond* presentWake = NULL;
+
+#define FRAME_STATS_INTERVAL 10000
+
+static FrameTimes frameTimes;
+// when the emulator started on the next frame, 0 while it is not running
+static uint64_t frameStart = 0;
+static uint32_t frameStatsTime = 0;
+
 #define SOUND_MAX_VOLUME 2.0
 #define SOUND_ECHO 0.2
 #define SOUND_STEREO 0.15
@@ -723,7 +769,8 @@ void sdlWriteBackupStateExchange(int from, int to, int backup)
     free(stateNameBack);
 }
 
-void sdlWriteBattery()
+// In the background the battery is copied and written later, see BatteryWriter
+void sdlWriteBattery(bool background)
 {
     char buffer[2048];
     char *gameDir = sdlGetFilePath(filename);
@@ -736,10 +783,11 @@ void sdlWriteBattery()
     else
         sprintf(buffer, "%s%c%s.sav", homeDataDir, FILE_SEP, gameFile);
 
-    bool result = emulator.emuWriteBattery(buffer);
-
-    if (result)
+    if (background) {
+        emulator.emuWriteBatteryAsync(buffer);
+    } else if (emulator.emuWriteBattery(buffer)) {
         systemMessage(0, "Wrote battery '%s'", buffer);
+    }
 
     freeSafe(gameFile);
     freeSafe(gameDir);
@@ -838,7 +886,7 @@ void sdlInitVideo()
     window = SDL_CreateWindow("VBA-M", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
         screenWidth, screenHeight, flags);
     if (!openGL) {
-        renderer = SDL_CreateRenderer(window, -1, 0);
+        renderer = SDL_CreateRenderer(window, -1, vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
     }
 
     if (window == NULL) {
@@ -879,12 +927,126 @@ void sdlInitVideo()
 
     if (openGL) {
         glcontext = SDL_GL_CreateContext(window);
+        SDL_GL_SetSwapInterval(vsync ? 1 : 0);
         sdlOpenGLInit(screenWidth, screenHeight);
     }
 
     sdlResizeVideo();
 }
 
+static void sdlFilterFrame(uint8_t* frame, uint8_t* screen);
+
+// The oldest frame in the state, or the newest, NULL if there is none
+static PresentFrame* sdlFindFrame(int state, bool newest)
+{
+    PresentFrame* found = NULL;
+
+    for (int i = 0; i < presentCount; i++) {
+        if (presentFrames[i].state != state)
+            continue;
+        if (!found || ((int32_t)(presentFrames[i].serial - found->serial) < 0) != newest)
+            found = &presentFrames[i];
+    }
+    return found;
+}
+
+static int sdlFilterMain(void*)
+{
+    SDL_LockMutex(presentLock);
+    for (;;) {
+        PresentFrame* next = NULL;
+        while (!presentStop && !(next = sdlFindFrame(FRAME_READY, false)))
+            SDL_CondWait(presentWake, presentLock);
+        if (presentStop)
+            break;
+
+        next->state = FRAME_FILTERING;
+        SDL_UnlockMutex(presentLock);
+        sdlFilterFrame(next->pix, next->screen);
+        SDL_LockMutex(presentLock);
+        next->state = FRAME_FILTERED;
+    }
+    SDL_UnlockMutex(presentLock);
+    return 0;
+}
+
+// Starts the filter thread if presentBuffers asks for one
+static void sdlFilterThreadStart()
+{
+    if (filterThread || presentBuffers < 2)
+        return;
+
+    presentCount = presentBuffers > PRESENT_MAX_BUFFERS ? PRESENT_MAX_BUFFERS : presentBuffers;
+    presentSize = srcPitch * (sizeY + 2);
+    for (int i = 0; i < presentCount; i++) {
+        presentFrames[i].pix = (uint8_t*)calloc(1, presentSize);
+        presentFrames[i].screen = (uint8_t*)calloc(1, (systemColorDepth >> 3) * destWidth * destHeight);
+        presentFrames[i].state = FRAME_FREE;
+    }
+    presentLock = SDL_CreateMutex();
+    presentWake = SDL_CreateCond();
+    presentStop = false;
+
+    filterThread = SDL_CreateThread(sdlFilterMain, "filter", NULL);
+    if (filterThread == NULL) {
+        systemMessage(0, "Failed to start the filter thread: %s", SDL_GetError());
+        presentBuffers = 0;
+    }
+}
+
+// Stops the filter thread, dropping the frames not shown yet.  Returns
+// true if it was running.
+static bool sdlFilterThreadStop()
+{
+    if (filterThread) {
+        SDL_LockMutex(presentLock);
+        presentStop = true;
+        SDL_CondSignal(presentWake);
+        SDL_UnlockMutex(presentLock);
+        SDL_WaitThread(filterThread, NULL);
+        filterThread = NULL;
+    }
+
+    if (presentLock == NULL)
+        return false;
+
+    for (int i = 0; i < presentCount; i++) {
+        freeSafe(presentFrames[i].pix);
+        freeSafe(presentFrames[i].screen);
+    }
+    presentCount = 0;
+    SDL_DestroyCond(presentWake);
+    SDL_DestroyMutex(presentLock);
+    presentWake = NULL;
+    presentLock = NULL;
+    return true;
+}
+
+// Hands the emulator's frame to the filter thread
+static void sdlQueueFrame()
+{
+    SDL_LockMutex(presentLock);
+    PresentFrame* frame = sdlFindFrame(FRAME_FREE, false);
+    if (!frame) {
+        // the filter thread or the display is behind, replace the oldest
+        // frame waiting for either
+        frame = sdlFindFrame(FRAME_READY, false);
+        if (!frame)
+            frame = sdlFindFrame(FRAME_FILTERED, false);
+        frameTimes.drop();
+    }
+    frame->state = FRAME_WRITING;
+    SDL_UnlockMutex(presentLock);
+
+    memcpy(frame->pix, pix, presentSize);
+
+    SDL_LockMutex(presentLock);
+    frame->state = FRAME_READY;
+    frame->serial = ++presentSerial;
+    SDL_CondSignal(presentWake);
+    SDL_UnlockMutex(presentLock);
+}
+
 #ifndef KMOD_META
 #define KMOD_META KMOD_GUI
 #endif
@@ -1187,6 +1349,7 @@ void sdlPollEvents()
                 break;
             case SDLK_g:
                 if (!(event.key.keysym.mod & MOD_NOCTRL) && (event.key.keysym.mod & KMOD_CTRL)) {
+                    bool filtering = sdlFilterThreadStop();
                     filterFunction = 0;
                     while (!filterFunction) {
                         filter = (Filter)((filter + 1) % kInvalidFilter);
@@ -1197,6 +1360,8 @@ void sdlPollEvents()
                         if (!fullScreen)
                             SDL_SetWindowSize(window, destWidth, destHeight);
                     }
+                    if (filtering)
+                        sdlFilterThreadStart();
                     systemScreenMessage(getFilterName(filter));
                 }
                 break;
@@ -1457,9 +1622,13 @@ Options:\n\
                                 512 - AGBPrint messages\n\
 \n\
 Long options only:\n\
+      --accelerated-swi        Do BIOS copies and decompression natively\n\
       --agb-print              Enable AGBPrint support\n\
       --auto-frameskip         Enable auto frameskipping\n\
+      --frame-stats            Show and log how long frames take\n\
       --no-agb-print           Disable AGBPrint support\n\
+      --no-audio-rate-control  Don't stretch the sound to keep the sound\n\
+                               buffer half full while vsync is on\n\
       --no-auto-frameskip      Disable auto frameskipping\n\
       --no-patch               Do not automatically apply patch\n\
       --no-pause-when-inactive Don't pause when inactive\n\
@@ -1467,9 +1636,13 @@ Long options only:\n\
       --no-show-speed          Don't show emulation speed\n\
       --no-throttle            Disable throttle\n\
       --pause-when-inactive    Pause when inactive\n\
+      --present-buffers=N      Filter frames on a thread of their own with N\n\
+                               buffers, a frame later (2...4, 0 = off)\n\
       --rtc                    Enable RTC support\n\
       --show-speed-normal      Show emulation speed\n\
       --show-speed-detailed    Show detailed speed data\n\
+      --speedup-mute           Emulate no sound output while speedup runs\n\
+                               unthrottled\n\
       --cheat 'CHEAT'          Add a cheat\n\
 ");
 }
@@ -1716,17 +1889,19 @@ int main(int argc, char** argv)
 
                 sdlApplyPerImagePreferences();
 
-                doMirroring(mirroringEnable);
-
                 cartridgeType = 0;
                 emulator = GBASystem;
 
                 CPUInit(biosFileNameGBA, useBios);
+                if (patchNum > 0)
+                    gbaDetachRom();
                 int patchnum;
                 for (patchnum = 0; patchnum < patchNum; patchnum++) {
                     fprintf(stdout, "Trying patch %s%s\n", patchNames[patchnum],
                         applyPatch(patchNames[patchnum], &rom, &size) ? " [success]" : "");
                 }
+                // mirror the patched image
+                doMirroring(mirroringEnable);
                 CPUReset();
             }
         }
@@ -1833,6 +2008,7 @@ int main(int argc, char** argv)
     renderedFrames = 0;
 
     autoFrameSkipLastTime = throttleLastTime = systemGetClock();
+    frameStatsTime = systemGetClock();
 
     // now we can enable cheats?
     {
@@ -1857,6 +2033,10 @@ int main(int argc, char** argv)
         }
     }
 
+    // frames are shown on this thread, waiting for vsync paces it
+    soundSetExternalPacing(vsync != 0);
+    sdlFilterThreadStart();
+
     while (emulating) {
         if (!paused && active) {
             if (debugger && emulator.emuHasDebugger)
@@ -1870,6 +2050,7 @@ int main(int argc, char** argv)
                 rewindSaveNeeded = false;
             }
         } else {
+            frameStart = 0;
             SDL_Delay(500);
         }
         sdlPollEvents();
@@ -1885,6 +2066,9 @@ int main(int argc, char** argv)
 
     emulating = 0;
     fprintf(stdout, "Shutting down\n");
+    sdlFilterThreadStop();
+    if (frameStats)
+        frameTimes.print(stdout);
     remoteCleanUp();
     soundShutdown();
 
@@ -1893,7 +2077,7 @@ int main(int argc, char** argv)
     }
 
     if (gbRom != NULL || rom != NULL) {
-        sdlWriteBattery();
+        sdlWriteBattery(false);
         emulator.emuCleanUp();
     }
 
@@ -1935,7 +2119,8 @@ void systemMessage(int num, const char* msg, ...)
 void drawScreenMessage(uint8_t* screen, int pitch, int x, int y, unsigned int duration)
 {
     if (screenMessage) {
-        if (cartridgeType == 1 && gbBorderOn) {
+        // the filter thread works on a copy, the border is already in it
+        if (cartridgeType == 1 && gbBorderOn && !filterThread) {
             gbSgbRenderBorder();
         }
         if (((systemGetClock() - screenMessageTime) < duration) && !disableStatusMessages) {
@@ -1960,24 +2145,24 @@ void drawSpeed(uint8_t* screen, int pitch, int x, int y)
     drawText(screen, pitch, x, y, buffer, showSpeedTransparent);
 }
 
-void systemDrawScreen()
+static void drawFrameStats(uint8_t* screen, int pitch, int x, int y)
 {
-    unsigned int destPitch = destWidth * (systemColorDepth >> 3);
-    uint8_t* screen;
-
-    renderedFrames++;
+    char buffer[50];
+    frameTimes.summary(buffer, sizeof(buffer));
+    drawText(screen, pitch, x, y, buffer, showSpeedTransparent);
+}
 
-    if (openGL)
-        screen = filterPix;
-    else {
-        screen = (uint8_t*)surface->pixels;
-        SDL_LockSurface(surface);
-    }
+// Filters frame, laid out like pix, into screen and draws the on-screen
+// text over it
+static void sdlFilterFrame(uint8_t* frame, uint8_t* screen)
+{
+    unsigned int destPitch = destWidth * (systemColorDepth >> 3);
+    uint64_t start = FrameTimes::now();
 
     if (ifbFunction)
-        ifbFunction(pix + srcPitch, srcPitch, sizeX, sizeY);
+        ifbFunction(frame + srcPitch, srcPitch, sizeX, sizeY);
 
-    filterFunction(pix + srcPitch, srcPitch, delta, screen,
+    filterFunction(frame + srcPitch, srcPitch, delta, screen,
         destPitch, sizeX, sizeY);
 
     if (openGL) {
@@ -1985,17 +2170,34 @@ void systemDrawScreen()
         for (int i = 0; i < destWidth; i++)
             for (int j = 0; j < destHeight; j++) {
                 uint8_t k;
-                k = filterPix[i * bytes + j * destPitch + 3];
-                filterPix[i * bytes + j * destPitch + 3] = filterPix[i * bytes + j * destPitch + 1];
-                filterPix[i * bytes + j * destPitch + 1] = k;
+                k = screen[i * bytes + j * destPitch + 3];
+                screen[i * bytes + j * destPitch + 3] = screen[i * bytes + j * destPitch + 1];
+                screen[i * bytes + j * destPitch + 1] = k;
             }
     }
 
+    if (presentLock)
+        SDL_LockMutex(presentLock);
     drawScreenMessage(screen, destPitch, 10, destHeight - 20, 3000);
+    if (presentLock)
+        SDL_UnlockMutex(presentLock);
 
     if (showSpeed && fullScreen)
         drawSpeed(screen, destPitch, 10, 20);
 
+    if (frameStats)
+        drawFrameStats(screen, destPitch, 10, showSpeed && fullScreen ? 30 : 20);
+
+    frameTimes.add(FrameTimes::FILTER, (uint32_t)(FrameTimes::now() - start));
+}
+
+// Shows a filtered screen in the window, on the thread owning the renderer
+// or the GL context
+static void sdlPresent(uint8_t* screen)
+{
+    unsigned int destPitch = destWidth * (systemColorDepth >> 3);
+    uint64_t start = FrameTimes::now();
+
     if (openGL) {
         glClear(GL_COLOR_BUFFER_BIT);
         glPixelStorei(GL_UNPACK_ROW_LENGTH, destWidth);
@@ -2020,11 +2222,62 @@ void systemDrawScreen()
         glEnd();
         SDL_GL_SwapWindow(window);
     } else {
-        SDL_UnlockSurface(surface);
-        SDL_UpdateTexture(texture, NULL, surface->pixels, surface->pitch);
+        SDL_UpdateTexture(texture, NULL, screen, destPitch);
         SDL_RenderCopy(renderer, texture, NULL, NULL);
         SDL_RenderPresent(renderer);
     }
+
+    frameTimes.add(FrameTimes::PRESENT, (uint32_t)(FrameTimes::now() - start));
+}
+
+// Shows the newest frame the filter thread is done with, if there is one
+// not shown yet, and gives the older ones back
+static void sdlPresentFiltered()
+{
+    SDL_LockMutex(presentLock);
+    PresentFrame* frame = sdlFindFrame(FRAME_FILTERED, true);
+    if (frame) {
+        for (int i = 0; i < presentCount; i++)
+            if (presentFrames[i].state == FRAME_FILTERED && &presentFrames[i] != frame) {
+                presentFrames[i].state = FRAME_FREE;
+                frameTimes.drop();
+            }
+        // keeps the filter thread and sdlQueueFrame off it
+        frame->state = FRAME_WRITING;
+    }
+    SDL_UnlockMutex(presentLock);
+
+    if (!frame)
+        return;
+
+    sdlPresent(frame->screen);
+
+    SDL_LockMutex(presentLock);
+    frame->state = FRAME_FREE;
+    SDL_UnlockMutex(presentLock);
+}
+
+void systemDrawScreen()
+{
+    if (frameStart)
+        frameTimes.add(FrameTimes::EMULATE, (uint32_t)(FrameTimes::now() - frameStart));
+
+    renderedFrames++;
+
+    if (filterThread) {
+        sdlQueueFrame();
+        sdlPresentFiltered();
+    } else if (openGL) {
+        sdlFilterFrame(pix, filterPix);
+        sdlPresent(filterPix);
+    } else {
+        SDL_LockSurface(surface);
+        sdlFilterFrame(pix, (uint8_t*)surface->pixels);
+        SDL_UnlockSurface(surface);
+        sdlPresent((uint8_t*)surface->pixels);
+    }
+
+    frameStart = FrameTimes::now();
 }
 
 void systemSendScreen()
@@ -2040,13 +2293,26 @@ void systemShowSpeed(int speed)
 {
     systemSpeed = speed;
 
+    if (frameStats && systemGetClock() - frameStatsTime >= FRAME_STATS_INTERVAL) {
+        frameTimes.print(stdout);
+        frameTimes.clear();
+        frameStatsTime = systemGetClock();
+    }
+
     showRenderedFrames = renderedFrames;
     renderedFrames = 0;
 
     if (!fullScreen && showSpeed) {
-        char buffer[80];
+        char buffer[120];
+        SoundDriverStats stats;
         if (showSpeed == 1)
             sprintf(buffer, "VBA-M - %d%%", systemSpeed);
+        else if (soundGetStats(stats))
+            sprintf(buffer, "VBA-M - %d%%(%d, %d fps) audio %d ms, %u underruns", systemSpeed,
+                systemFrameSkip,
+                showRenderedFrames,
+                (int)(stats.buffered * 500LL / soundGetSampleRate()),
+                stats.underruns);
         else
             sprintf(buffer, "VBA-M - %d%%(%d, %d fps)", systemSpeed,
                 systemFrameSkip,
@@ -2100,7 +2366,7 @@ void system10Frames(int rate)
 
     if (systemSaveUpdateCounter) {
         if (--systemSaveUpdateCounter <= SYSTEM_SAVE_NOT_UPDATED) {
-            sdlWriteBattery();
+            sdlWriteBattery(true);
             systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
         }
     }
@@ -2190,6 +2456,8 @@ void systemConsoleMessage(const char* msg)
 
 void systemScreenMessage(const char* msg)
 {
+    if (presentLock)
+        SDL_LockMutex(presentLock);
 
     screenMessage = true;
     screenMessageTime = systemGetClock();
@@ -2199,6 +2467,9 @@ void systemScreenMessage(const char* msg)
     } else
         strcpy(screenMessageBuffer, msg);
 
+    if (presentLock)
+        SDL_UnlockMutex(presentLock);
+
     systemConsoleMessage(msg);
 }
 
@@ -2225,9 +2496,14 @@ void systemGbBorderOn()
     gbBorderColumnSkip = 48;
     gbBorderRowSkip = 40;
 
+    bool filtering = sdlFilterThreadStop();
+
     sdlInitVideo();
 
     filterFunction = initFilter(filter, systemColorDepth, sizeX);
+
+    if (filtering)
+        sdlFilterThreadStart();
 }
 
 bool systemReadJoypads()
@@ -24,8 +24,10 @@
 #include <string.h>
 
 #include "../common/Port.h"
+#include "../gba/CodeCache.h"
 #include "../gba/GBA.h"
 #include "../gba/Sound.h"
+#include "../gba/TileCache.h"
 #include "../gba/armdis.h"
 #include "../gba/elf.h"
 #include "exprNode.h"
@@ -46,14 +48,26 @@ extern struct EmulatedSystem emulator;
 #define debuggerReadByte(addr) \
     map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask]
 
-#define debuggerWriteMemory(addr, value) \
-    WRITE32LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value)
-
-#define debuggerWriteHalfWord(addr, value) \
-    WRITE16LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value)
-
-#define debuggerWriteByte(addr, value) \
-    map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value)
+#define debuggerWriteMemory(addr, value)                                             \
+    do {                                                                             \
+        codeCacheInvalidate(addr);                                                   \
+        tileCacheInvalidate(addr);                                                   \
+        WRITE32LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value); \
+    } while (0)
+
+#define debuggerWriteHalfWord(addr, value)                                           \
+    do {                                                                             \
+        codeCacheInvalidate(addr);                                                   \
+        tileCacheInvalidate(addr);                                                   \
+        WRITE16LE(&map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask], value); \
+    } while (0)
+
+#define debuggerWriteByte(addr, value)                                      \
+    do {                                                                    \
+        codeCacheInvalidate(addr);                                          \
+        tileCacheInvalidate(addr);                                          \
+        map[(addr) >> 24].address[(addr)&map[(addr) >> 24].mask] = (value); \
+    } while (0)
 
 struct breakpointInfo {
     uint32_t address;
@@ -199,7 +213,7 @@ bool debuggerAtBreakpoint = false;
 int debuggerBreakpointNumber = 0;
 int debuggerRadix = 0;
 
-extern uint32_t cpuPrefetch[2];
+extern GBA_LOCAL uint32_t cpuPrefetch[2];
 
 #define ARM_PREFETCH                                        \
     {                                                       \
@@ -0,0 +1,85 @@
+#include <string.h>
+#include <vector>
+
+#include "../gba/GBA.h"
+#include "../gba/GBAinline.h"
+#include "../gba/Globals.h"
+#include "../gba/Sound.h"
+
+#include "tests.hpp"
+
+// a cartridge of zeros, booted past the BIOS
+static void bootBlankRom()
+{
+    static std::vector<char> data(0x1000);
+    soundInit();
+    REQUIRE(CPULoadRomData(&data[0], (int)data.size()));
+    CPUInit(NULL, false);
+    CPUReset();
+}
+
+// count words from source to dest on DMA3, started at once
+static void dma3(uint32_t source, uint32_t dest, uint16_t count)
+{
+    CPUUpdateRegister(0xD4, source & 0xFFFF);
+    CPUUpdateRegister(0xD6, source >> 16);
+    CPUUpdateRegister(0xD8, dest & 0xFFFF);
+    CPUUpdateRegister(0xDA, dest >> 16);
+    CPUUpdateRegister(0xDC, count);
+    CPUUpdateRegister(0xDE, 0x8400);
+}
+
+static void fillWorkRAM(int size)
+{
+    for (int i = 0; i < size; i++)
+        workRAM[i] = (uint8_t)(i * 7 + 1);
+}
+
+TEST_CASE("DMA from work RAM to IWRAM copies the words") {
+    bootBlankRom();
+    fillWorkRAM(64);
+    cpuNextEvent = 1000;
+
+    dma3(0x02000000, 0x03000100, 16);
+
+    REQUIRE(memcmp(&internalRAM[0x100], workRAM, 64) == 0);
+    // nothing asked the CPU loop to stop
+    REQUIRE(cpuNextEvent == 1000);
+
+    CPUCleanUp();
+}
+
+#ifdef BKPT_SUPPORT
+TEST_CASE("DMA into a watched IWRAM word still breaks") {
+    bootBlankRom();
+    fillWorkRAM(64);
+    cpuNextEvent = 1000;
+
+    // a break on write for one word in the middle, as the SDL debugger and
+    // the GDB stub set it
+    memset(&freezeInternalRAM[0x120], 1, 4);
+    REQUIRE(CPUDirectMemory(0x03000100, 64, 4, true) == nullptr);
+
+    dma3(0x02000000, 0x03000100, 16);
+
+    REQUIRE(memcmp(&internalRAM[0x100], workRAM, 64) == 0);
+    // cheatsWriteMemory() ends the CPU loop so the debugger can stop
+    REQUIRE(cpuNextEvent == 0);
+
+    memset(&freezeInternalRAM[0x120], 0, 4);
+    CPUCleanUp();
+}
+
+TEST_CASE("Only watched spans are kept from the direct path") {
+    bootBlankRom();
+
+    memset(&freezeVRAM[0x40], 2, 2);
+    REQUIRE(CPUDirectMemory(0x06000000, 0x40, 2, true) != nullptr);
+    REQUIRE(CPUDirectMemory(0x06000000, 0x42, 2, true) == nullptr);
+    // loads are not watched
+    REQUIRE(CPUDirectMemory(0x06000000, 0x42, 2, false) != nullptr);
+
+    memset(&freezeVRAM[0x40], 0, 2);
+    CPUCleanUp();
+}
+#endif
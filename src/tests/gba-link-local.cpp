@@ -0,0 +1,147 @@
+#include <chrono>
+#include <random>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "../common/Port.h"
+#include "../gba/GBALink.h"
+#include "../gba/Globals.h"
+#include "../gba/Instance.h"
+
+#include "tests.hpp"
+
+// what one player saw at the end of a transfer
+struct Transfer {
+    long tick;
+    uint16_t multi[4];
+    bool irq;
+
+    bool operator==(const Transfer& other) const
+    {
+        return tick == other.tick && irq == other.irq
+            && memcmp(multi, other.multi, sizeof(multi)) == 0;
+    }
+};
+
+static uint16_t readReg(uint32_t address)
+{
+    return READ16LE(&ioMem[address]);
+}
+
+static void writeReg(uint32_t address, uint16_t value)
+{
+    WRITE16LE(&ioMem[address], value);
+}
+
+// Runs one player's side of the cable on its instance: the master starts
+// transfers a few thousand ticks apart, every player sends 0x1000 * player
+// plus the transfers it has seen.  Both step time the same way, jitter only
+// stalls the thread now and then.
+static void runPlayer(int player, int count, bool jitter, std::vector<Transfer>* log)
+{
+    ioMem = (uint8_t*)calloc(1, 0x400);
+    IF = 0;
+
+    std::mt19937 ticks(1);
+    std::mt19937 stalls(player + 1);
+
+    writeReg(COMM_RCNT, 0);
+    StartGPLink(0);
+    // multiplayer, IRQ on completion, 115200 bps
+    StartLink(0x2000 | 0x4000 | 3);
+    writeReg(COMM_SIODATA8, 0x1000 * player);
+
+    long tick = 0;
+    long nextStart = 5000;
+    bool busy = false;
+    while ((int)log->size() < count) {
+        if (jitter && stalls() % 2000 == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(stalls() % 200));
+
+        int step = 1 + ticks() % 200;
+        tick += step;
+        LinkUpdate(step);
+
+        uint16_t siocnt = readReg(COMM_SIOCNT);
+        if (player == 0 && !busy && tick >= nextStart) {
+            StartLink(siocnt | 0x80);
+            siocnt = readReg(COMM_SIOCNT);
+        }
+
+        if (siocnt & 0x80) {
+            busy = true;
+        } else if (busy) {
+            busy = false;
+            Transfer t = { tick, { readReg(COMM_SIOMULTI0), readReg(COMM_SIOMULTI1),
+                                     readReg(COMM_SIOMULTI2), readReg(COMM_SIOMULTI3) },
+                (IF & 0x80) != 0 };
+            log->push_back(t);
+            IF = 0;
+            writeReg(COMM_SIODATA8, 0x1000 * player + (uint16_t)log->size());
+            nextStart = tick + 1000 + ticks() % 10000;
+        }
+    }
+
+    // off the barrier, so the others do not wait for this player
+    DetachLocalLink();
+    free(ioMem);
+    ioMem = NULL;
+}
+
+static std::vector<std::vector<Transfer> > runCable(int players, int count, bool jitter)
+{
+    REQUIRE(InitLink(LINK_CABLE_LOCAL) == LINK_OK);
+
+    std::vector<GBAInstance*> instances;
+    std::vector<std::vector<Transfer> > logs(players);
+    for (int p = 0; p < players; p++) {
+        instances.push_back(new GBAInstance());
+        bool attached = false;
+        instances[p]->call([&] { attached = AttachLocalLink(p); });
+        REQUIRE(attached);
+    }
+
+    for (int p = 0; p < players; p++) {
+        std::vector<Transfer>* log = &logs[p];
+        instances[p]->post([=] { runPlayer(p, count, jitter, log); });
+    }
+
+    for (int p = 0; p < players; p++) {
+        instances[p]->wait();
+        delete instances[p];
+    }
+
+    CloseLink();
+    return logs;
+}
+
+TEST_CASE("Two instances swap their data over the local cable") {
+    std::vector<std::vector<Transfer> > logs = runCable(2, 20, false);
+
+    REQUIRE(logs[0].size() == 20);
+    REQUIRE(logs[1].size() == 20);
+    for (int k = 0; k < 20; k++) {
+        CHECK(logs[0][k] == logs[1][k]);
+        CHECK(logs[0][k].multi[0] == k);
+        CHECK(logs[0][k].multi[1] == 0x1000 + k);
+        // nobody in the other seats
+        CHECK(logs[0][k].multi[2] == 0xffff);
+        CHECK(logs[0][k].multi[3] == 0xffff);
+        CHECK(logs[0][k].irq);
+    }
+}
+
+TEST_CASE("Transfers end at the same time however the threads run") {
+    std::vector<std::vector<Transfer> > steady = runCable(4, 20, false);
+    std::vector<std::vector<Transfer> > stalled = runCable(4, 20, true);
+
+    for (int p = 0; p < 4; p++) {
+        CHECK(steady[p] == steady[0]);
+        CHECK(stalled[p] == steady[0]);
+    }
+    for (int k = 0; k < 20; k++)
+        for (int p = 0; p < 4; p++)
+            CHECK(steady[0][k].multi[p] == 0x1000 * p + k);
+}
@@ -0,0 +1,23 @@
+# Runs vbam-headless on ROM for FRAMES frames and checks the video and audio
+# hashes it prints against VIDEO_HASH and AUDIO_HASH, run with
+# cmake -DHEADLESS=... -DROM=... -DFRAMES=... -DVIDEO_HASH=... -DAUDIO_HASH=... -P
+
+execute_process(
+    COMMAND "${HEADLESS}" --hash -f "${FRAMES}" "${ROM}"
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE errors
+    RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "vbam-headless failed (${result}):\n${output}${errors}")
+endif()
+
+foreach(kind video audio)
+    string(TOUPPER "${kind}_HASH" expected)
+    string(REGEX MATCH "\"${kind}_hash\": \"([0-9a-f]+)\"" match "${output}")
+
+    if(NOT CMAKE_MATCH_1 STREQUAL "${${expected}}")
+        message(FATAL_ERROR "${kind} hash is '${CMAKE_MATCH_1}', expected '${${expected}}':\n${output}")
+    endif()
+endforeach()
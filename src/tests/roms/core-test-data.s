@@ -0,0 +1,371 @@
+@ Data for core-test.s: 2K of raw bytes, the same bytes as the BIOS LZ77,
+@ RLE and (the first 1K, 5 bits each) Huffman decompressors take them, and
+@ a BG2PA value per line for HBlank DMA.
+
+  .align 2
+raw_data:
+  .byte 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f
+  .byte 0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f
+  .byte 0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f
+  .byte 0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0a,0x04,0x0c,0x01,0x02,0x03,0x0b,0x01,0x06,0x01,0x02,0x0d,0x0d,0x02,0x07,0x02
+  .byte 0x0d,0x01,0x03,0x07,0x01,0x0c,0x01,0x07,0x01,0x04,0x09,0x0d,0x04,0x03,0x09,0x05
+  .byte 0x03,0x06,0x0b,0x03,0x02,0x01,0x06,0x0f,0x0d,0x0a,0x0e,0x0e,0x0b,0x09,0x07,0x05
+  .byte 0x07,0x02,0x09,0x0f,0x0a,0x0e,0x09,0x02,0x03,0x0d,0x05,0x0a,0x04,0x0f,0x0d,0x01
+  .byte 0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf
+  .byte 0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf
+  .byte 0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef
+  .byte 0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x02,0x0a,0x0a,0x0b,0x0f,0x0e,0x02,0x02,0x08,0x0f,0x02,0x01,0x09,0x0e,0x09,0x0c
+  .byte 0x0b,0x00,0x0e,0x0b,0x05,0x03,0x0f,0x01,0x06,0x09,0x04,0x07,0x0c,0x0c,0x0f,0x02
+  .byte 0x05,0x0e,0x0c,0x08,0x04,0x0d,0x08,0x0d,0x0b,0x0c,0x07,0x04,0x02,0x05,0x04,0x07
+  .byte 0x07,0x00,0x0f,0x05,0x08,0x09,0x00,0x04,0x0d,0x0b,0x0a,0x04,0x01,0x0e,0x0c,0x0c
+  .byte 0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f
+  .byte 0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f
+  .byte 0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf
+  .byte 0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0c,0x0c,0x03,0x0f,0x0c,0x01,0x06,0x02,0x06,0x0e,0x05,0x03,0x0a,0x01,0x03,0x00
+  .byte 0x04,0x03,0x0b,0x00,0x02,0x06,0x0c,0x04,0x08,0x0b,0x0b,0x0f,0x03,0x03,0x0f,0x0e
+  .byte 0x0f,0x0f,0x09,0x02,0x04,0x03,0x0a,0x08,0x0f,0x05,0x00,0x06,0x0b,0x04,0x00,0x09
+  .byte 0x02,0x08,0x0b,0x05,0x0b,0x07,0x0a,0x07,0x06,0x07,0x0c,0x07,0x06,0x0f,0x0b,0x00
+  .byte 0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f
+  .byte 0x50,0x51,0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f
+  .byte 0x60,0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f
+  .byte 0x70,0x71,0x72,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x7d,0x7e,0x7f
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x00,0x08,0x0f,0x08,0x06,0x0b,0x0e,0x0b,0x0b,0x02,0x07,0x03,0x07,0x0f,0x06,0x0a
+  .byte 0x06,0x0f,0x00,0x0f,0x0b,0x02,0x03,0x0c,0x06,0x0f,0x05,0x0d,0x0a,0x02,0x0c,0x0e
+  .byte 0x0c,0x02,0x05,0x05,0x04,0x00,0x04,0x0e,0x04,0x0f,0x0b,0x04,0x04,0x00,0x00,0x03
+  .byte 0x04,0x0d,0x06,0x06,0x00,0x08,0x06,0x09,0x07,0x0a,0x08,0x0d,0x04,0x01,0x0b,0x0e
+  .byte 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f
+  .byte 0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f
+  .byte 0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f
+  .byte 0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0d,0x04,0x04,0x00,0x0e,0x05,0x00,0x04,0x05,0x04,0x0f,0x03,0x01,0x0a,0x0f,0x03
+  .byte 0x01,0x07,0x06,0x08,0x01,0x03,0x0e,0x00,0x02,0x0e,0x0a,0x06,0x08,0x0e,0x0f,0x07
+  .byte 0x08,0x06,0x0e,0x04,0x0d,0x03,0x0c,0x0e,0x0a,0x02,0x07,0x0d,0x02,0x06,0x09,0x03
+  .byte 0x04,0x0b,0x04,0x08,0x04,0x0e,0x07,0x03,0x0c,0x0f,0x05,0x07,0x05,0x0d,0x0c,0x0a
+  .byte 0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf
+  .byte 0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf
+  .byte 0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef
+  .byte 0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0d,0x06,0x0b,0x0a,0x02,0x0b,0x00,0x0a,0x0e,0x0e,0x00,0x0c,0x0a,0x09,0x02,0x03
+  .byte 0x07,0x03,0x02,0x08,0x08,0x01,0x05,0x08,0x04,0x0d,0x08,0x0c,0x04,0x0f,0x0a,0x02
+  .byte 0x08,0x01,0x05,0x0d,0x02,0x08,0x00,0x02,0x08,0x02,0x07,0x02,0x08,0x03,0x0e,0x00
+  .byte 0x0a,0x0d,0x08,0x04,0x01,0x07,0x03,0x05,0x08,0x01,0x05,0x06,0x09,0x09,0x06,0x09
+  .byte 0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f
+  .byte 0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f
+  .byte 0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf
+  .byte 0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0e,0x05,0x08,0x0b,0x00,0x08,0x01,0x00,0x00,0x06,0x0f,0x07,0x0e,0x03,0x0d,0x0f
+  .byte 0x0c,0x09,0x06,0x07,0x0a,0x06,0x04,0x0c,0x0b,0x01,0x04,0x00,0x02,0x08,0x0d,0x05
+  .byte 0x01,0x02,0x0c,0x09,0x07,0x09,0x01,0x0e,0x05,0x05,0x08,0x0e,0x00,0x08,0x0b,0x0a
+  .byte 0x0a,0x07,0x01,0x09,0x06,0x0b,0x05,0x00,0x0a,0x0c,0x02,0x0f,0x08,0x06,0x07,0x00
+  .byte 0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f
+  .byte 0x50,0x51,0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f
+  .byte 0x60,0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f
+  .byte 0x70,0x71,0x72,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x7d,0x7e,0x7f
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x02,0x08,0x02,0x04,0x0c,0x01,0x0c,0x00,0x09,0x09,0x07,0x02,0x04,0x0c,0x0a,0x0f
+  .byte 0x04,0x09,0x04,0x01,0x0d,0x04,0x00,0x07,0x02,0x00,0x01,0x04,0x0b,0x03,0x0c,0x0e
+  .byte 0x01,0x00,0x07,0x0f,0x08,0x00,0x0e,0x02,0x02,0x02,0x0f,0x08,0x02,0x08,0x07,0x06
+  .byte 0x07,0x0e,0x0f,0x0c,0x02,0x0f,0x09,0x01,0x06,0x02,0x04,0x0a,0x08,0x09,0x04,0x00
+  .byte 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f
+  .byte 0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f
+  .byte 0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f
+  .byte 0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0f,0x01,0x0f,0x08,0x03,0x06,0x0f,0x09,0x09,0x0e,0x0e,0x0e,0x03,0x06,0x09,0x02
+  .byte 0x0f,0x00,0x09,0x0e,0x02,0x0e,0x08,0x0c,0x06,0x06,0x02,0x02,0x04,0x08,0x0b,0x04
+  .byte 0x08,0x03,0x0b,0x07,0x0f,0x0f,0x0c,0x00,0x05,0x00,0x0f,0x0e,0x0c,0x09,0x04,0x0d
+  .byte 0x0b,0x0c,0x0a,0x03,0x0a,0x00,0x0a,0x0a,0x0c,0x03,0x06,0x00,0x09,0x08,0x0b,0x02
+  .byte 0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf
+  .byte 0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf
+  .byte 0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef
+  .byte 0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x0c,0x0c,0x02,0x0b,0x0d,0x08,0x01,0x08,0x03,0x01,0x09,0x04,0x07,0x08,0x0d,0x0a
+  .byte 0x06,0x0b,0x0d,0x00,0x0c,0x06,0x02,0x01,0x0d,0x0e,0x04,0x09,0x0f,0x01,0x04,0x05
+  .byte 0x0f,0x0d,0x0a,0x09,0x09,0x08,0x08,0x0c,0x07,0x09,0x0f,0x0c,0x03,0x05,0x05,0x02
+  .byte 0x06,0x0f,0x07,0x0e,0x0a,0x0e,0x0d,0x04,0x06,0x07,0x02,0x05,0x0a,0x02,0x0a,0x07
+  .byte 0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f
+  .byte 0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f
+  .byte 0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf
+  .byte 0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .byte 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55
+  .align 2
+lz_data:
+  .byte 0x10,0x00,0x08,0x00,0x00,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x00,0x08,0x09
+  .byte 0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x00,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x00
+  .byte 0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x00,0x20,0x21,0x22,0x23,0x24,0x25,0x26
+  .byte 0x27,0x00,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,0x00,0x30,0x31,0x32,0x33,0x34
+  .byte 0x35,0x36,0x37,0x00,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f,0x78,0x55,0xf0,0x00
+  .byte 0xf0,0x00,0xf0,0x00,0x60,0x00,0x0a,0x04,0x0c,0x80,0x00,0x81,0x0b,0x01,0x06,0x01
+  .byte 0x02,0x0d,0x0d,0x00,0x02,0x07,0x02,0x0d,0x01,0x03,0x07,0x01,0x00,0x0c,0x01,0x07
+  .byte 0x01,0x04,0x09,0x0d,0x04,0x00,0x03,0x09,0x05,0x03,0x06,0x0b,0x03,0x02,0x00,0x01
+  .byte 0x06,0x0f,0x0d,0x0a,0x0e,0x0e,0x0b,0x00,0x09,0x07,0x05,0x07,0x02,0x09,0x0f,0x0a
+  .byte 0x00,0x0e,0x09,0x02,0x03,0x0d,0x05,0x0a,0x04,0x00,0x0f,0x0d,0x01,0xc0,0xc1,0xc2
+  .byte 0xc3,0xc4,0x00,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0x00,0xcd,0xce,0xcf,0xd0
+  .byte 0xd1,0xd2,0xd3,0xd4,0x00,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0x00,0xdd,0xde
+  .byte 0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0x00,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0x00
+  .byte 0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0x00,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb
+  .byte 0xfc,0x1e,0xfd,0xfe,0xff,0xf0,0x91,0xf0,0x00,0xf0,0x00,0x70,0x00,0x02,0x00,0x0a
+  .byte 0x0a,0x0b,0x0f,0x0e,0x02,0x02,0x08,0x00,0x0f,0x02,0x01,0x09,0x0e,0x09,0x0c,0x0b
+  .byte 0x00,0x00,0x0e,0x0b,0x05,0x03,0x0f,0x01,0x06,0x00,0x09,0x04,0x07,0x0c,0x0c,0x0f
+  .byte 0x02,0x05,0x00,0x0e,0x0c,0x08,0x04,0x0d,0x08,0x0d,0x0b,0x00,0x0c,0x07,0x04,0x02
+  .byte 0x05,0x04,0x07,0x07,0x00,0x00,0x0f,0x05,0x08,0x09,0x00,0x04,0x0d,0x00,0x0b,0x0a
+  .byte 0x04,0x01,0x0e,0x0c,0x0c,0x80,0x00,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x00
+  .byte 0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f,0x90,0x00,0x91,0x92,0x93,0x94,0x95,0x96,0x97
+  .byte 0x98,0x00,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f,0xa0,0x00,0xa1,0xa2,0xa3,0xa4,0xa5
+  .byte 0xa6,0xa7,0xa8,0x00,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf,0xb0,0x00,0xb1,0xb2,0xb3
+  .byte 0xb4,0xb5,0xb6,0xb7,0xb8,0x01,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0xf0,0x91,0xe0
+  .byte 0xf0,0x00,0xf0,0x00,0x70,0x00,0x0c,0x0c,0x03,0x0f,0x0c,0x00,0x01,0x06,0x02,0x06
+  .byte 0x0e,0x05,0x03,0x0a,0x00,0x01,0x03,0x00,0x04,0x03,0x0b,0x00,0x02,0x00,0x06,0x0c
+  .byte 0x04,0x08,0x0b,0x0b,0x0f,0x03,0x00,0x03,0x0f,0x0e,0x0f,0x0f,0x09,0x02,0x04,0x00
+  .byte 0x03,0x0a,0x08,0x0f,0x05,0x00,0x06,0x0b,0x00,0x04,0x00,0x09,0x02,0x08,0x0b,0x05
+  .byte 0x0b,0x00,0x07,0x0a,0x07,0x06,0x07,0x0c,0x07,0x06,0x00,0x0f,0x0b,0x00,0x40,0x41
+  .byte 0x42,0x43,0x44,0x00,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x00,0x4d,0x4e,0x4f
+  .byte 0x50,0x51,0x52,0x53,0x54,0x00,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x00,0x5d
+  .byte 0x5e,0x5f,0x60,0x61,0x62,0x63,0x64,0x00,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c
+  .byte 0x00,0x6d,0x6e,0x6f,0x70,0x71,0x72,0x73,0x74,0x00,0x75,0x76,0x77,0x78,0x79,0x7a
+  .byte 0x7b,0x7c,0x1e,0x7d,0x7e,0x7f,0xf0,0x91,0xf0,0x00,0xf0,0x00,0x70,0x00,0x00,0x00
+  .byte 0x08,0x0f,0x08,0x06,0x0b,0x0e,0x0b,0x0b,0x00,0x02,0x07,0x03,0x07,0x0f,0x06,0x0a
+  .byte 0x06,0x00,0x0f,0x00,0x0f,0x0b,0x02,0x03,0x0c,0x06,0x00,0x0f,0x05,0x0d,0x0a,0x02
+  .byte 0x0c,0x0e,0x0c,0x00,0x02,0x05,0x05,0x04,0x00,0x04,0x0e,0x04,0x00,0x0f,0x0b,0x04
+  .byte 0x04,0x00,0x00,0x03,0x04,0x00,0x0d,0x06,0x06,0x00,0x08,0x06,0x09,0x07,0x01,0x0a
+  .byte 0x08,0x0d,0x04,0x01,0x0b,0x0e,0xf2,0xff,0xfc,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf0
+  .byte 0x00,0xf0,0x00,0xf0,0x00,0x55,0x55,0x40,0x0d,0x00,0x95,0x0e,0x05,0x00,0x04,0x05
+  .byte 0x04,0x08,0x0f,0x03,0x01,0x0a,0x00,0x03,0x07,0x06,0x08,0x00,0x01,0x03,0x0e,0x00
+  .byte 0x02,0x0e,0x0a,0x06,0x00,0x08,0x0e,0x0f,0x07,0x08,0x06,0x0e,0x04,0x00,0x0d,0x03
+  .byte 0x0c,0x0e,0x0a,0x02,0x07,0x0d,0x00,0x02,0x06,0x09,0x03,0x04,0x0b,0x04,0x08,0x00
+  .byte 0x04,0x0e,0x07,0x03,0x0c,0x0f,0x05,0x07,0x0f,0x05,0x0d,0x0c,0x0a,0xf2,0xff,0xf2
+  .byte 0xff,0xf2,0xff,0xf2,0xff,0xf0,0xf0,0x00,0xf0,0x00,0xf0,0x00,0x00,0xbf,0x06,0x0b
+  .byte 0x0a,0x02,0x22,0x0b,0x00,0x03,0x9d,0x00,0x0c,0x0a,0x03,0x96,0x07,0x02,0x03,0x02
+  .byte 0x08,0x08,0x01,0x05,0x12,0xf3,0x0c,0x08,0x04,0x0f,0x0a,0x02,0x00,0x0b,0x0d,0x02
+  .byte 0x08,0x14,0x00,0x02,0x08,0x03,0xdb,0x08,0x00,0xd7,0x0a,0x0d,0x02,0x08,0x04,0x01
+  .byte 0x07,0x03,0x05,0x00,0x17,0x06,0x0f,0x09,0x09,0x06,0x09,0xf2,0xff,0xf2,0xff,0xf2
+  .byte 0xff,0xf2,0xff,0xe0,0xf0,0x00,0xf0,0x00,0xf0,0x00,0x55,0x55,0x0e,0x05,0x08,0x00
+  .byte 0x0b,0x00,0x08,0x01,0x00,0x00,0x06,0x0f,0x00,0x07,0x0e,0x03,0x0d,0x0f,0x0c,0x09
+  .byte 0x06,0x00,0x07,0x0a,0x06,0x04,0x0c,0x0b,0x01,0x04,0x80,0x00,0xb4,0x0d,0x05,0x01
+  .byte 0x02,0x0c,0x09,0x07,0x00,0x09,0x01,0x0e,0x05,0x05,0x08,0x0e,0x00,0x00,0x08,0x0b
+  .byte 0x0a,0x0a,0x07,0x01,0x09,0x06,0x02,0x0b,0x05,0x00,0x0a,0x0c,0x02,0x02,0x78,0x07
+  .byte 0xff,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf0,0x00,0xf0,0x00,0xf0,0x00,0x14
+  .byte 0x7f,0x20,0x08,0x02,0x05,0x41,0x0c,0x00,0x09,0x09,0x07,0x80,0x00,0x08,0x0a,0x0f
+  .byte 0x04,0x09,0x04,0x01,0x0d,0x00,0x04,0x00,0x07,0x02,0x00,0x01,0x04,0x0b,0x81,0x02
+  .byte 0x37,0x01,0x00,0x07,0x0f,0x08,0x00,0x04,0xa0,0x92,0x00,0xae,0x02,0x08,0x03,0xb6
+  .byte 0x0e,0x0f,0x00,0xb9,0x09,0x87,0x03,0xf1,0x04,0x0a,0x08,0x09,0x03,0x11,0xf2,0xff
+  .byte 0xf2,0xff,0xf8,0xf2,0xff,0xf2,0xff,0xf0,0x00,0xf0,0x00,0xf0,0x00,0x55,0x0f,0x01
+  .byte 0x00,0x0f,0x08,0x03,0x06,0x0f,0x09,0x09,0x0e,0x00,0x0e,0x0e,0x03,0x06,0x09,0x02
+  .byte 0x0f,0x00,0x00,0x09,0x0e,0x02,0x0e,0x08,0x0c,0x06,0x06,0x20,0x02,0x02,0x04,0x84
+  .byte 0x04,0x08,0x03,0x0b,0x07,0x00,0x0f,0x0f,0x0c,0x00,0x05,0x00,0x0f,0x0e,0x20,0x0c
+  .byte 0x09,0x05,0x36,0x0c,0x0a,0x03,0x0a,0x00,0x00,0x0a,0x0a,0x0c,0x03,0x06,0x00,0x09
+  .byte 0x08,0x3f,0x0b,0x02,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf0,0x00,0xf0,0x00
+  .byte 0xc0,0xf0,0x00,0x15,0x3f,0x02,0x0b,0x0d,0x08,0x01,0x08,0x20,0x03,0x01,0x05,0xf0
+  .byte 0x08,0x0d,0x0a,0x06,0x0b,0x00,0x0d,0x00,0x0c,0x06,0x02,0x01,0x0d,0x0e,0x02,0x04
+  .byte 0x09,0x0f,0x01,0x04,0x05,0x06,0xb8,0x09,0x00,0x09,0x08,0x08,0x0c,0x07,0x09,0x0f
+  .byte 0x0c,0x08,0x03,0x05,0x05,0x02,0x12,0x66,0x0a,0x0e,0x0d,0x00,0x04,0x06,0x07,0x02
+  .byte 0x05,0x0a,0x02,0x0a,0x7f,0x07,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf2,0xff,0xf0,0x00
+  .byte 0xf0,0x00,0xf0,0x00,0x00,0x55,0x55,0x00
+  .align 2
+rl_data:
+  .byte 0x30,0x00,0x08,0x00,0x3f,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a
+  .byte 0x0b,0x0c,0x0d,0x0e,0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a
+  .byte 0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a
+  .byte 0x2b,0x2c,0x2d,0x2e,0x2f,0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a
+  .byte 0x3b,0x3c,0x3d,0x3e,0x3f,0xbd,0x55,0x7f,0x0a,0x04,0x0c,0x01,0x02,0x03,0x0b,0x01
+  .byte 0x06,0x01,0x02,0x0d,0x0d,0x02,0x07,0x02,0x0d,0x01,0x03,0x07,0x01,0x0c,0x01,0x07
+  .byte 0x01,0x04,0x09,0x0d,0x04,0x03,0x09,0x05,0x03,0x06,0x0b,0x03,0x02,0x01,0x06,0x0f
+  .byte 0x0d,0x0a,0x0e,0x0e,0x0b,0x09,0x07,0x05,0x07,0x02,0x09,0x0f,0x0a,0x0e,0x09,0x02
+  .byte 0x03,0x0d,0x05,0x0a,0x04,0x0f,0x0d,0x01,0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7
+  .byte 0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf,0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7
+  .byte 0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7
+  .byte 0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7
+  .byte 0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff,0xbd,0x55,0x7f,0x02,0x0a,0x0a,0x0b,0x0f
+  .byte 0x0e,0x02,0x02,0x08,0x0f,0x02,0x01,0x09,0x0e,0x09,0x0c,0x0b,0x00,0x0e,0x0b,0x05
+  .byte 0x03,0x0f,0x01,0x06,0x09,0x04,0x07,0x0c,0x0c,0x0f,0x02,0x05,0x0e,0x0c,0x08,0x04
+  .byte 0x0d,0x08,0x0d,0x0b,0x0c,0x07,0x04,0x02,0x05,0x04,0x07,0x07,0x00,0x0f,0x05,0x08
+  .byte 0x09,0x00,0x04,0x0d,0x0b,0x0a,0x04,0x01,0x0e,0x0c,0x0c,0x80,0x81,0x82,0x83,0x84
+  .byte 0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f,0x90,0x91,0x92,0x93,0x94
+  .byte 0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4
+  .byte 0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf,0xb0,0xb1,0xb2,0xb3,0xb4
+  .byte 0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0xbd,0x55,0x7f,0x0c,0x0c
+  .byte 0x03,0x0f,0x0c,0x01,0x06,0x02,0x06,0x0e,0x05,0x03,0x0a,0x01,0x03,0x00,0x04,0x03
+  .byte 0x0b,0x00,0x02,0x06,0x0c,0x04,0x08,0x0b,0x0b,0x0f,0x03,0x03,0x0f,0x0e,0x0f,0x0f
+  .byte 0x09,0x02,0x04,0x03,0x0a,0x08,0x0f,0x05,0x00,0x06,0x0b,0x04,0x00,0x09,0x02,0x08
+  .byte 0x0b,0x05,0x0b,0x07,0x0a,0x07,0x06,0x07,0x0c,0x07,0x06,0x0f,0x0b,0x00,0x40,0x41
+  .byte 0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f,0x50,0x51
+  .byte 0x52,0x53,0x54,0x55,0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x60,0x61
+  .byte 0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70,0x71
+  .byte 0x72,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x7d,0x7e,0x7f,0xbd,0x55
+  .byte 0x7f,0x00,0x08,0x0f,0x08,0x06,0x0b,0x0e,0x0b,0x0b,0x02,0x07,0x03,0x07,0x0f,0x06
+  .byte 0x0a,0x06,0x0f,0x00,0x0f,0x0b,0x02,0x03,0x0c,0x06,0x0f,0x05,0x0d,0x0a,0x02,0x0c
+  .byte 0x0e,0x0c,0x02,0x05,0x05,0x04,0x00,0x04,0x0e,0x04,0x0f,0x0b,0x04,0x04,0x00,0x00
+  .byte 0x03,0x04,0x0d,0x06,0x06,0x00,0x08,0x06,0x09,0x07,0x0a,0x08,0x0d,0x04,0x01,0x0b
+  .byte 0x0e,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e
+  .byte 0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e
+  .byte 0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e
+  .byte 0x2f,0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e
+  .byte 0x3f,0xbd,0x55,0x7f,0x0d,0x04,0x04,0x00,0x0e,0x05,0x00,0x04,0x05,0x04,0x0f,0x03
+  .byte 0x01,0x0a,0x0f,0x03,0x01,0x07,0x06,0x08,0x01,0x03,0x0e,0x00,0x02,0x0e,0x0a,0x06
+  .byte 0x08,0x0e,0x0f,0x07,0x08,0x06,0x0e,0x04,0x0d,0x03,0x0c,0x0e,0x0a,0x02,0x07,0x0d
+  .byte 0x02,0x06,0x09,0x03,0x04,0x0b,0x04,0x08,0x04,0x0e,0x07,0x03,0x0c,0x0f,0x05,0x07
+  .byte 0x05,0x0d,0x0c,0x0a,0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb
+  .byte 0xcc,0xcd,0xce,0xcf,0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb
+  .byte 0xdc,0xdd,0xde,0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb
+  .byte 0xec,0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb
+  .byte 0xfc,0xfd,0xfe,0xff,0xbd,0x55,0x7f,0x0d,0x06,0x0b,0x0a,0x02,0x0b,0x00,0x0a,0x0e
+  .byte 0x0e,0x00,0x0c,0x0a,0x09,0x02,0x03,0x07,0x03,0x02,0x08,0x08,0x01,0x05,0x08,0x04
+  .byte 0x0d,0x08,0x0c,0x04,0x0f,0x0a,0x02,0x08,0x01,0x05,0x0d,0x02,0x08,0x00,0x02,0x08
+  .byte 0x02,0x07,0x02,0x08,0x03,0x0e,0x00,0x0a,0x0d,0x08,0x04,0x01,0x07,0x03,0x05,0x08
+  .byte 0x01,0x05,0x06,0x09,0x09,0x06,0x09,0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88
+  .byte 0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f,0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98
+  .byte 0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8
+  .byte 0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf,0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8
+  .byte 0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0xbd,0x55,0x7f,0x0e,0x05,0x08,0x0b,0x00,0x08
+  .byte 0x01,0x00,0x00,0x06,0x0f,0x07,0x0e,0x03,0x0d,0x0f,0x0c,0x09,0x06,0x07,0x0a,0x06
+  .byte 0x04,0x0c,0x0b,0x01,0x04,0x00,0x02,0x08,0x0d,0x05,0x01,0x02,0x0c,0x09,0x07,0x09
+  .byte 0x01,0x0e,0x05,0x05,0x08,0x0e,0x00,0x08,0x0b,0x0a,0x0a,0x07,0x01,0x09,0x06,0x0b
+  .byte 0x05,0x00,0x0a,0x0c,0x02,0x0f,0x08,0x06,0x07,0x00,0x40,0x41,0x42,0x43,0x44,0x45
+  .byte 0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f,0x50,0x51,0x52,0x53,0x54,0x55
+  .byte 0x56,0x57,0x58,0x59,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x60,0x61,0x62,0x63,0x64,0x65
+  .byte 0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70,0x71,0x72,0x73,0x74,0x75
+  .byte 0x76,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x7d,0x7e,0x7f,0xbd,0x55,0x26,0x02,0x08,0x02
+  .byte 0x04,0x0c,0x01,0x0c,0x00,0x09,0x09,0x07,0x02,0x04,0x0c,0x0a,0x0f,0x04,0x09,0x04
+  .byte 0x01,0x0d,0x04,0x00,0x07,0x02,0x00,0x01,0x04,0x0b,0x03,0x0c,0x0e,0x01,0x00,0x07
+  .byte 0x0f,0x08,0x00,0x0e,0x80,0x02,0x55,0x0f,0x08,0x02,0x08,0x07,0x06,0x07,0x0e,0x0f
+  .byte 0x0c,0x02,0x0f,0x09,0x01,0x06,0x02,0x04,0x0a,0x08,0x09,0x04,0x00,0x00,0x01,0x02
+  .byte 0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10,0x11,0x12
+  .byte 0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22
+  .byte 0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,0x30,0x31,0x32
+  .byte 0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f,0xbd,0x55,0x08
+  .byte 0x0f,0x01,0x0f,0x08,0x03,0x06,0x0f,0x09,0x09,0x80,0x0e,0x73,0x03,0x06,0x09,0x02
+  .byte 0x0f,0x00,0x09,0x0e,0x02,0x0e,0x08,0x0c,0x06,0x06,0x02,0x02,0x04,0x08,0x0b,0x04
+  .byte 0x08,0x03,0x0b,0x07,0x0f,0x0f,0x0c,0x00,0x05,0x00,0x0f,0x0e,0x0c,0x09,0x04,0x0d
+  .byte 0x0b,0x0c,0x0a,0x03,0x0a,0x00,0x0a,0x0a,0x0c,0x03,0x06,0x00,0x09,0x08,0x0b,0x02
+  .byte 0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf
+  .byte 0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf
+  .byte 0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef
+  .byte 0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff
+  .byte 0xbd,0x55,0x7f,0x0c,0x0c,0x02,0x0b,0x0d,0x08,0x01,0x08,0x03,0x01,0x09,0x04,0x07
+  .byte 0x08,0x0d,0x0a,0x06,0x0b,0x0d,0x00,0x0c,0x06,0x02,0x01,0x0d,0x0e,0x04,0x09,0x0f
+  .byte 0x01,0x04,0x05,0x0f,0x0d,0x0a,0x09,0x09,0x08,0x08,0x0c,0x07,0x09,0x0f,0x0c,0x03
+  .byte 0x05,0x05,0x02,0x06,0x0f,0x07,0x0e,0x0a,0x0e,0x0d,0x04,0x06,0x07,0x02,0x05,0x0a
+  .byte 0x02,0x0a,0x07,0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c
+  .byte 0x8d,0x8e,0x8f,0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c
+  .byte 0x9d,0x9e,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac
+  .byte 0xad,0xae,0xaf,0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc
+  .byte 0xbd,0xbe,0xbf,0xbd,0x55,0x00,0x00,0x00
+  .align 2
+hf_data:
+  .byte 0x28,0x00,0x04,0x00,0x1f,0x00,0x00,0x41,0x01,0x02,0x02,0x15,0x82,0x03,0x03,0x04
+  .byte 0x04,0x05,0x04,0x05,0x05,0x06,0xc6,0xc7,0xc7,0xc8,0xc8,0xc9,0xc9,0x4a,0xca,0xcb
+  .byte 0xcb,0xcc,0xcc,0xcd,0x09,0x08,0x00,0x05,0x0a,0x0d,0x01,0x0c,0x06,0x07,0x0e,0x0b
+  .byte 0x03,0x02,0x86,0x0f,0x12,0x13,0x14,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e
+  .byte 0x1f,0xc0,0x10,0x11,0x5c,0x40,0xab,0x53,0x6f,0x32,0x94,0x22,0xd8,0x6a,0xaf,0x6c
+  .byte 0x41,0x8e,0x8d,0x82,0xa7,0x61,0x16,0x25,0x5a,0x9d,0x62,0x1f,0xa1,0x14,0xe1,0x02
+  .byte 0x7b,0x65,0x7b,0x93,0x6c,0x14,0xc4,0x56,0xb3,0x28,0x09,0x72,0x3f,0xfb,0x38,0x0d
+  .byte 0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xd8,0xff,0xff,0xff
+  .byte 0x37,0x69,0x75,0x0f,0x6b,0x6b,0xd5,0x41,0x8b,0xd4,0xb5,0x1a,0x10,0xb8,0xe8,0x9e
+  .byte 0x48,0x17,0xa2,0xd0,0x2e,0x74,0x95,0x4e,0x44,0x53,0x4a,0xd6,0xec,0xa2,0x1a,0x57
+  .byte 0xad,0x46,0x2b,0x92,0x4e,0xb9,0x76,0x81,0x8a,0x70,0x01,0xad,0xb2,0xbd,0xc9,0x50
+  .byte 0x0a,0x62,0xab,0xbd,0x94,0x04,0x39,0x36,0x7d,0x9c,0x86,0x59,0x0b,0x68,0x75,0x8a
+  .byte 0x4d,0x86,0x52,0x84,0x5b,0xed,0x95,0xed,0xc8,0xb1,0x51,0x10,0x34,0xcc,0xa2,0x24
+  .byte 0xff,0xff,0xec,0xe3,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff
+  .byte 0x19,0xab,0xff,0xff,0x4d,0xb5,0xca,0x3b,0x0f,0x49,0xe4,0xea,0xd2,0x35,0xa5,0x9a
+  .byte 0x2f,0x02,0x82,0xee,0x3d,0xb9,0xea,0x7d,0x6f,0xb6,0xd4,0x20,0x18,0x61,0x55,0x88
+  .byte 0x14,0x4a,0xeb,0xaa,0xd2,0x01,0x9b,0x0d,0xd0,0xea,0xd4,0x7b,0x0c,0xa5,0x08,0x17
+  .byte 0xda,0x2b,0xdb,0x9b,0x63,0xa3,0x20,0xb6,0x98,0x45,0x49,0x90,0xa7,0xd8,0xc7,0x69
+  .byte 0x45,0xb8,0x80,0x56,0xd9,0xde,0x64,0x28,0x05,0xb1,0xd5,0x5e,0x4a,0x82,0x1c,0x1b
+  .byte 0x3e,0x4e,0xc3,0x2c,0xff,0xff,0xff,0xcf,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff
+  .byte 0xff,0xff,0xff,0xff,0x7b,0x97,0xbe,0xf7,0x74,0x49,0x58,0xa1,0xa4,0xa0,0xa8,0x63
+  .byte 0x13,0x3c,0x58,0xd5,0xbc,0x94,0xde,0x39,0x28,0x54,0x74,0xaf,0x84,0x6a,0xdd,0xc4
+  .byte 0x66,0xaa,0x48,0xc1,0x84,0x91,0xc5,0xb9,0x6a,0x5e,0x18,0x5f,0x5c,0x40,0xab,0x53
+  .byte 0x6f,0x32,0x94,0x22,0xd8,0x6a,0xaf,0x6c,0x41,0x8e,0x8d,0x82,0xa7,0x61,0x16,0x25
+  .byte 0x5a,0x9d,0x62,0x1f,0xa1,0x14,0xe1,0x02,0x7b,0x65,0x7b,0x93,0x6c,0x14,0xc4,0x56
+  .byte 0xb3,0x28,0x09,0x72,0x3f,0xfb,0x38,0x0d,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff
+  .byte 0xff,0xff,0xff,0xff,0xd4,0xff,0xff,0xff,0x94,0x13,0xa6,0x9b,0x37,0xd2,0x58,0xe7
+  .byte 0x5e,0x75,0x21,0x83,0x75,0xe1,0xa3,0x75,0x9f,0x7c,0x95,0xb5,0x12,0x14,0xac,0x55
+  .byte 0x4a,0x01,0xcc,0x0b,0x52,0x10,0x36,0xa0,0x2d,0xb1,0x88,0x60,0x75,0x4a,0x4e,0x07
+  .byte 0x52,0x84,0x0b,0x68,0x95,0xed,0x4d,0x86,0x51,0x10,0x5b,0xed,0xa2,0x24,0xc8,0xb1
+  .byte 0xec,0xe3,0x34,0xcc,0x5c,0x40,0xab,0x53,0x6f,0x32,0x94,0x22,0xd8,0x6a,0xaf,0x6c
+  .byte 0x41,0x8e,0x8d,0x82,0xa7,0x61,0x16,0x25,0xff,0xff,0x67,0x1f,0xff,0xff,0xff,0xff
+  .byte 0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x15,0x40,0xfb,0xff,0x17,0x16,0xa8,0x25
+  .byte 0x3a,0x7a,0x99,0xa3,0x25,0xa9,0x4b,0x30,0x65,0x82,0x4c,0x56,0x06,0x12,0xa6,0x78
+  .byte 0x62,0x65,0xf2,0xd1,0x09,0x14,0xc1,0xda,0xa3,0x51,0x42,0x82,0xaf,0xad,0xb8,0xee
+  .byte 0x02,0x5a,0x9d,0x62,0x93,0xa1,0x14,0xe1,0x56,0x7b,0x65,0x7b,0x72,0x6c,0x14,0xc4
+  .byte 0x0d,0xb3,0x28,0x09,0xea,0x14,0xfb,0x38,0xa5,0x08,0x17,0xd0,0x2b,0xdb,0x9b,0x0c
+  .byte 0xa3,0x20,0xb6,0xda,0x45,0x49,0x90,0x63,0xd8,0xc7,0x69,0x98
+  .align 2
+pa_table:
+  .byte 0x00,0x01,0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01
+  .byte 0x44,0x01,0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01
+  .byte 0x2c,0x01,0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01
+  .byte 0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01
+  .byte 0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01
+  .byte 0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01
+  .byte 0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01,0x58,0x01
+  .byte 0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01,0x40,0x01
+  .byte 0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01,0x28,0x01
+  .byte 0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01,0x58,0x01,0x10,0x01
+  .byte 0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01,0x40,0x01,0x54,0x01
+  .byte 0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01,0x28,0x01,0x3c,0x01
+  .byte 0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01,0x58,0x01,0x10,0x01,0x24,0x01
+  .byte 0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01,0x40,0x01,0x54,0x01,0x0c,0x01
+  .byte 0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01
+  .byte 0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01,0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01
+  .byte 0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01,0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01
+  .byte 0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01
+  .byte 0x1c,0x01,0x30,0x01,0x44,0x01,0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01
+  .byte 0x04,0x01,0x18,0x01,0x2c,0x01,0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01
+  .byte 0x48,0x01,0x00,0x01,0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01
+  .byte 0x30,0x01,0x44,0x01,0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01
+  .byte 0x18,0x01,0x2c,0x01,0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01
+  .byte 0x00,0x01,0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01
+  .byte 0x44,0x01,0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01
+  .byte 0x2c,0x01,0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01
+  .byte 0x14,0x01,0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01
+  .byte 0x58,0x01,0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01
+  .byte 0x40,0x01,0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01
+  .byte 0x28,0x01,0x3c,0x01,0x50,0x01,0x08,0x01,0x1c,0x01,0x30,0x01,0x44,0x01,0x58,0x01
+  .byte 0x10,0x01,0x24,0x01,0x38,0x01,0x4c,0x01,0x04,0x01,0x18,0x01,0x2c,0x01,0x40,0x01
+  .byte 0x54,0x01,0x0c,0x01,0x20,0x01,0x34,0x01,0x48,0x01,0x00,0x01,0x14,0x01,0x28,0x01
+  .align 2
@@ -0,0 +1,492 @@
+@ core-test.gba: a homebrew ROM the headless test runs for a fixed number of
+@ frames, checking the hashes of what it draws and plays.  Every frame it
+@ runs ARM and THUMB code from ROM and from IWRAM (some of it rewritten as
+@ it goes), the BIOS calls the core does natively, DMA in its odd corners,
+@ timers with cascade and IRQs, HBlank DMA into BG2PA and DMA sound, and
+@ writes what it computed into the mode 3 bitmap.
+@
+@ Built with GNU or LLVM binutils for ARM:
+@   as -o core-test.o core-test.s
+@   ld -Ttext=0x08000000 -e _start -o core-test.elf core-test.o
+@   objcopy -O binary core-test.elf core-test.gba
+
+    .syntax unified
+    .arch armv4t
+    .text
+    .arm
+    .global _start
+_start:
+    b main
+    .fill 0xBC, 1, 0
+main:
+    mov r0, #0x12
+    msr cpsr_c, r0
+    ldr sp, =0x03007FA0
+    mov r0, #0x1F
+    msr cpsr_c, r0
+    ldr sp, =0x03007F00
+    ldr r0, =0x03007FFC
+    ldr r1, =irq_handler
+    str r1, [r0]
+    @ copy IWRAM code via CpuSet (32-bit)
+    ldr r0, =iw_code_start
+    ldr r1, =0x03000000
+    ldr r2, =((iw_code_end - iw_code_start) / 4) | 0x04000000
+    swi 0x0B0000
+    mov r0, #0x04000000
+    ldr r1, =0x0403
+    strh r1, [r0]
+    mov r1, #0x08
+    strh r1, [r0, #4]
+    @ timers: t0 reload FC00 irq, t1 cascade, t2 prescaler 64
+    ldr r2, =0x04000100
+    ldr r1, =0x00C0FC00
+    str r1, [r2]
+    ldr r1, =0x00840000
+    str r1, [r2, #4]
+    ldr r1, =0x00810000
+    str r1, [r2, #8]
+    @ sound
+    ldr r2, =0x04000080
+    mov r1, #0x80
+    strh r1, [r2, #4]
+    ldr r1, =0xFF77
+    strh r1, [r2]
+    ldr r1, =0x0B06
+    strh r1, [r2, #2]
+    ldr r2, =0x04000060
+    mov r1, #0
+    strh r1, [r2]
+    ldr r1, =0xF780
+    strh r1, [r2, #2]
+    ldr r1, =0x8000 | 1750
+    strh r1, [r2, #4]
+    ldr r1, =0xA340
+    strh r1, [r2, #8]
+    ldr r1, =0x8000 | 1900
+    strh r1, [r2, #12]
+    @ DMA1 -> FIFO A
+    ldr r2, =0x040000BC
+    ldr r1, =raw_data
+    str r1, [r2]
+    ldr r1, =0x040000A0
+    str r1, [r2, #4]
+    ldr r1, =0xB6400004
+    str r1, [r2, #8]
+    @ IE vblank|timer0, IME
+    ldr r2, =0x04000200
+    ldr r1, =0x0009
+    strh r1, [r2]
+    mov r1, #1
+    strh r1, [r2, #8]
+    mov r10, #0
+    ldr r11, =0x12345678
+    mov r9, #0
+loop:
+    ldr r0, =0x04000130
+    ldrh r1, [r0]
+    eor r9, r9, r1
+    tst r1, #1
+    addeq r9, r9, r10, lsl #4
+    bl arm_tests
+    ldr r12, =0x03000000 + (iw_arm - iw_code_start)
+    mov lr, pc
+    bx r12
+    ldr r12, =thumb_tests
+    mov lr, pc
+    bx r12
+    ldr r12, =0x03000000 + (iw_thumb - iw_code_start)
+    mov lr, pc
+    bx r12
+    ldr r0, =0x03000000 + (iw_patch - iw_code_start)
+    ldr r1, [r0]
+    bic r1, r1, #0xFF
+    and r2, r10, #0xFF
+    orr r1, r1, r2
+    str r1, [r0]
+    bl swi_tests
+    bl dma_tests
+    ldr r0, =0x04000108
+    ldrh r1, [r0]
+    add r9, r9, r1
+    ldr r0, =0x03006000
+    ldr r1, [r0]
+    add r9, r9, r1
+    ldr r0, =0x06000000
+    ldr r1, =0x7FFF
+    and r2, r10, r1
+    add r0, r0, r2, lsl #1
+    strh r9, [r0]
+    mov r1, r9, lsr #16
+    strh r1, [r0, #2]
+    swi 0x050000
+    @ re-arm hblank DMA2 -> BG2PA
+    ldr r0, =0x040000B0
+    mov r1, #0
+    strh r1, [r0, #10]
+    ldr r1, =pa_table
+    str r1, [r0]
+    ldr r1, =0x04000020
+    str r1, [r0, #4]
+    ldr r1, =0xA2400001
+    str r1, [r0, #8]
+    add r10, r10, #1
+    b loop
+    .ltorg
+
+irq_handler:
+    mov r0, #0x04000000
+    add r0, r0, #0x200
+    ldrh r1, [r0, #2]
+    strh r1, [r0, #2]
+    ldr r2, =0x03007FF8
+    ldrh r3, [r2]
+    orr r3, r3, r1
+    strh r3, [r2]
+    tst r1, #8
+    ldrne r2, =0x03006000
+    ldrne r3, [r2]
+    addne r3, r3, #1
+    strne r3, [r2]
+    bx lr
+    .ltorg
+
+arm_tests:
+    stmfd sp!, {r4-r8, lr}
+    mov r4, #200
+1:
+    movs r0, r11, lsr #1
+    eorcs r0, r0, #0xB4000000
+    mov r11, r0
+    adds r1, r11, r9
+    adcs r2, r1, r11, ror #7
+    subs r3, r2, r1, asr #3
+    sbcs r5, r3, r9, lsl r4
+    rsbs r6, r5, #0x1000
+    rscs r7, r6, r11
+    andgt r9, r9, r7
+    orrle r9, r9, r6
+    eorvs r9, r9, #0x80000000
+    bicvc r9, r9, #3
+    teq r1, r2
+    addeq r9, r9, #1
+    tst r3, #0x10
+    subne r9, r9, #1
+    cmn r5, r6
+    addmi r9, r9, r5
+    cmp r6, r7
+    addhi r9, r9, #7
+    addls r9, r9, #11
+    addcc r9, r9, #13
+    mvnge r8, r9
+    addlt r9, r9, r8, lsr #5
+    movs r8, r7, ror r4
+    addcs r9, r9, #1
+    mul r0, r11, r9
+    mla r1, r0, r4, r9
+    umull r2, r3, r1, r11
+    smlal r2, r3, r0, r9
+    smull r5, r6, r1, r0
+    umlal r5, r6, r2, r3
+    eor r9, r9, r3
+    add r9, r9, r6
+    ldr r0, =0x03004000
+    and r1, r4, #63
+    str r9, [r0, r1, lsl #2]
+    strh r11, [r0, #2]!
+    ldrsh r2, [r0, #-2]
+    ldrsb r3, [r0, #1]
+    ldrb r5, [r0], #3
+    ldr r6, [r0, #-1]
+    add r9, r9, r2
+    eor r9, r9, r3
+    add r9, r9, r5
+    eor r9, r9, r6
+    swp r7, r9, [r0]
+    swpb r8, r11, [r0]
+    add r9, r9, r7
+    add r9, r9, r8
+    ldr r0, =0x02007000
+    stmia r0!, {r1-r3, r5-r9}
+    ldmdb r0, {r1-r3, r5-r8}
+    add r9, r9, r8
+    mrs r0, cpsr
+    eor r9, r9, r0
+    msr cpsr_f, #0x60000000
+    addeq r9, r9, #3
+    subs r4, r4, #1
+    bne 1b
+    ldmfd sp!, {r4-r8, lr}
+    bx lr
+    .ltorg
+
+swi_tests:
+    stmfd sp!, {r4, lr}
+    mov r0, r9
+    mov r1, #37
+    swi 0x060000
+    add r9, r9, r0
+    eor r9, r9, r1
+    mov r0, r11, lsr #1
+    swi 0x080000
+    add r9, r9, r0
+    ldr r0, =lz_data
+    ldr r1, =0x02000000
+    swi 0x110000
+    ldr r0, =rl_data
+    ldr r1, =0x02001000
+    swi 0x140000
+    ldr r0, =hf_data
+    ldr r1, =0x02002000
+    swi 0x130000
+    ldr r0, =lz_data
+    ldr r1, =0x06014000
+    swi 0x120000
+    ldr r0, =rl_data
+    ldr r1, =0x06015000
+    swi 0x150000
+    ldr r0, =0x02000000
+    mov r1, #512
+    bl sum_words
+    ldr r0, =0x02001000
+    mov r1, #512
+    bl sum_words
+    ldr r0, =0x02002000
+    mov r1, #256
+    bl sum_words
+    ldr r0, =0x06014000
+    mov r1, #1024
+    bl sum_words
+    ldr r0, =0x03004300
+    str r9, [r0]
+    ldr r1, =0x02003000
+    ldr r2, =0x05000100
+    swi 0x0B0000
+    ldr r0, =0x02000000
+    ldr r1, =0x02004000
+    mov r2, #512
+    swi 0x0C0000
+    ldr r0, =0x02004000
+    mov r1, #512
+    bl sum_words
+    ldr r0, =0x02003000
+    mov r1, #256
+    bl sum_words
+    ldmfd sp!, {r4, lr}
+    bx lr
+sum_words:
+    ldr r2, [r0], #4
+    add r9, r9, r2
+    eor r9, r9, r9, lsl #3
+    subs r1, r1, #1
+    bne sum_words
+    bx lr
+    .ltorg
+
+dma_tests:
+    stmfd sp!, {r4, lr}
+    ldr r0, =0x040000D4
+    ldr r1, =raw_data
+    str r1, [r0]
+    ldr r1, =0x06008000
+    str r1, [r0, #4]
+    ldr r1, =0x84000100
+    str r1, [r0, #8]
+    ldr r1, =raw_data + 512
+    str r1, [r0]
+    ldr r1, =0x02005000
+    str r1, [r0, #4]
+    ldr r1, =0x80800080
+    str r1, [r0, #8]
+    ldr r1, =0x02000000
+    str r1, [r0]
+    ldr r1, =0x02006000
+    str r1, [r0, #4]
+    and r2, r10, #0xFF
+    add r2, r2, #1
+    orr r2, r2, #0x84000000
+    str r2, [r0, #8]
+    @ to palette, 16-bit
+    ldr r1, =raw_data + 100
+    str r1, [r0]
+    ldr r1, =0x05000000
+    str r1, [r0, #4]
+    ldr r1, =0x80000200
+    str r1, [r0, #8]
+    @ across the bitmap-mode OBJ VRAM hole
+    ldr r1, =raw_data
+    str r1, [r0]
+    ldr r1, =0x06017F00
+    str r1, [r0, #4]
+    ldr r1, =0x84000080
+    str r1, [r0, #8]
+    @ from BIOS (reads as zero / open bus)
+    ldr r1, =0x00000100
+    str r1, [r0]
+    ldr r1, =0x02005400
+    str r1, [r0, #4]
+    ldr r1, =0x84000010
+    str r1, [r0, #8]
+    @ fixed destination into IWRAM
+    ldr r1, =raw_data + 40
+    str r1, [r0]
+    ldr r1, =0x03004800
+    str r1, [r0, #4]
+    ldr r1, =0x84400020
+    str r1, [r0, #8]
+    @ dest decrement EWRAM -> EWRAM, overlapping
+    ldr r1, =0x02005000
+    str r1, [r0]
+    ldr r1, =0x02005040
+    str r1, [r0, #4]
+    ldr r1, =0x84200040
+    str r1, [r0, #8]
+    @ to IO (sound regs) 16-bit
+    ldr r1, =pa_table
+    str r1, [r0]
+    ldr r1, =0x04000090
+    str r1, [r0, #4]
+    ldr r1, =0x80000008
+    str r1, [r0, #8]
+    ldr r0, =0x02005000
+    mov r1, #512
+    bl sum_words
+    ldr r0, =0x02006000
+    mov r1, #256
+    bl sum_words
+    ldr r0, =0x06017F00
+    mov r1, #256
+    bl sum_words
+    ldr r0, =0x03004800
+    mov r1, #4
+    bl sum_words
+    ldmfd sp!, {r4, lr}
+    bx lr
+    .ltorg
+
+    .thumb
+    .align 2
+    .thumb_func
+thumb_tests:
+    push {r4-r7, lr}
+    movs r4, #150
+3:
+    mov r0, r11
+    lsrs r1, r0, #3
+    lsls r2, r0, #5
+    asrs r3, r0, #2
+    adds r5, r1, r2
+    subs r6, r5, r3
+    mov r7, r9
+    eors r7, r6
+    ands r5, r7
+    orrs r6, r5
+    bics r7, r1
+    mvns r5, r7
+    muls r5, r6, r5
+    rors r6, r4
+    adcs r7, r5
+    sbcs r7, r6
+    rsbs r5, r7, #0
+    cmp r5, r7
+    bge 4f
+    adds r7, #3
+4:
+    tst r7, r6
+    beq 5f
+    subs r7, #1
+5:
+    mov r0, r9
+    adds r0, r0, r7
+    mov r9, r0
+    add r9, r11
+    ldr r1, =0x03004200
+    lsls r2, r4, #2
+    str r7, [r1, r2]
+    strh r6, [r1, #2]
+    strb r5, [r1, #5]
+    ldrsh r3, [r1, r2]
+    ldrsb r2, [r1, r2]
+    adds r3, r3, r2
+    ldr r2, [r1, #4]
+    adds r3, r3, r2
+    ldrh r2, [r1, #2]
+    push {r2, r3}
+    pop {r2, r3}
+    stmia r1!, {r2, r3, r5}
+    ldmia r1!, {r2, r3}
+    adds r2, r2, r3
+    mov r0, r9
+    eors r0, r2
+    mov r9, r0
+    bl thumb_sub
+    subs r4, #1
+    bne 3b
+    pop {r4-r7}
+    pop {r0}
+    bx r0
+thumb_sub:
+    mov r0, r9
+    adds r0, #17
+    mov r9, r0
+    bx lr
+    .ltorg
+
+    .arm
+    .align 2
+iw_code_start:
+iw_arm:
+    stmfd sp!, {r4, lr}
+    mov r4, #100
+2:
+iw_patch:
+    mov r0, #0
+    add r9, r9, r0
+    eor r9, r9, r9, ror #13
+    movs r1, r9, lsl #1
+    addcs r9, r9, #5
+    subs r4, r4, #1
+    bne 2b
+    adr r0, 6f
+    ldr r1, 7f
+    and r2, r10, #1
+    add r1, r1, r2
+    str r1, [r0]
+    mov r0, r0
+6:
+    add r9, r9, #2
+    ldmfd sp!, {r4, lr}
+    bx lr
+7:
+    .word 0xE2899001
+    .thumb
+    .align 2
+    .thumb_func
+iw_thumb:
+    push {r4, lr}
+    movs r4, #80
+8:
+    mov r0, r9
+    lsrs r1, r0, #7
+    eors r0, r1
+    adds r0, #9
+    mov r9, r0
+    ldr r1, 9f
+    str r0, [r1]
+    ldr r2, [r1]
+    adds r2, r2, r4
+    mov r0, r9
+    adds r0, r2
+    mov r9, r0
+    subs r4, #1
+    bne 8b
+    pop {r4}
+    pop {r0}
+    bx r0
+    .align 2
+9:
+    .word 0x03004600
+    .arm
+    .align 2
+iw_code_end:
+    .include "core-test-data.s"
@@ -0,0 +1,155 @@
+// The frontend side of the core for the tests: no window, no sound, no
+// input, and messages go to stderr.
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "../System.h"
+#include "../common/SoundDriver.h"
+#include "../gba/Sound.h"
+
+int emulating = 0;
+int systemSpeed = 0;
+int systemRedShift = 19;
+int systemGreenShift = 11;
+int systemBlueShift = 3;
+int systemColorDepth = 32;
+int systemVerbose = 0;
+int systemFrameSkip = 0;
+int systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
+uint32_t systemColorMap32[0x10000];
+uint16_t systemColorMap16[0x10000];
+uint16_t systemGbPalette[24];
+
+class SilentSound : public SoundDriver {
+public:
+    bool init(long) { return true; }
+    void pause() {}
+    void reset() {}
+    void resume() {}
+    void write(uint16_t*, int) {}
+    void setThrottle(unsigned short) {}
+};
+
+void systemMessage(int, const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vfprintf(stderr, msg, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+void log(const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vfprintf(stderr, msg, args);
+    va_end(args);
+}
+
+void systemFrame()
+{
+}
+
+bool systemPauseOnFrame()
+{
+    return false;
+}
+
+void systemDrawScreen()
+{
+}
+
+void systemSendScreen()
+{
+}
+
+SoundDriver* systemSoundInit()
+{
+    soundShutdown();
+    return new SilentSound();
+}
+
+uint32_t systemReadJoypad(int)
+{
+    return 0;
+}
+
+bool systemReadJoypads()
+{
+    return true;
+}
+
+uint32_t systemGetClock()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void systemOnWriteDataToSoundBuffer(const uint16_t*, int)
+{
+}
+
+void systemOnSoundShutdown()
+{
+}
+
+bool systemCanChangeSoundQuality()
+{
+    return false;
+}
+
+void systemShowSpeed(int)
+{
+}
+
+void system10Frames(int)
+{
+}
+
+void systemScreenCapture(int)
+{
+}
+
+void systemScreenMessage(const char*)
+{
+}
+
+void systemGbPrint(uint8_t*, int, int, int, int, int)
+{
+}
+
+void systemGbBorderOn()
+{
+}
+
+void systemUpdateMotionSensor()
+{
+}
+
+int systemGetSensorX()
+{
+    return 0;
+}
+
+int systemGetSensorY()
+{
+    return 0;
+}
+
+int systemGetSensorZ()
+{
+    return 0;
+}
+
+uint8_t systemGetSensorDarkness()
+{
+    return 0xE8;
+}
+
+void systemCartridgeRumble(bool)
+{
+}
@@ -896,8 +896,11 @@ EVT_HANDLER_MASK(ImportBatteryFile, "Import battery file...", CMDEN_GB | CMDEN_G
         return;
 
     wxString fn = dlg.GetPath();
-    ret = wxMessageBox(_("Importing a battery file will erase any saved games (permanently after the next write).  Do you want to continue?"),
-        _("Confirm import"), wxYES_NO | wxICON_EXCLAMATION);
+    {
+        EmuThread::Unhold unhold(panel->emu_thread);
+        ret = wxMessageBox(_("Importing a battery file will erase any saved games (permanently after the next write).  Do you want to continue?"),
+            _("Confirm import"), wxYES_NO | wxICON_EXCLAMATION);
+    }
 
     if (ret == wxYES) {
         wxString msg;
@@ -924,8 +927,11 @@ EVT_HANDLER_MASK(ImportGamesharkCodeFile, "Import GameShark code file...", CMDEN
         return;
 
     wxString fn = dlg.GetPath();
-    ret = wxMessageBox(_("Importing a code file will replace any loaded cheats.  Do you want to continue?"),
-        _("Confirm import"), wxYES_NO | wxICON_EXCLAMATION);
+    {
+        EmuThread::Unhold unhold(panel->emu_thread);
+        ret = wxMessageBox(_("Importing a code file will replace any loaded cheats.  Do you want to continue?"),
+            _("Confirm import"), wxYES_NO | wxICON_EXCLAMATION);
+    }
 
     if (ret == wxYES) {
         wxString msg;
@@ -1044,8 +1050,11 @@ EVT_HANDLER_MASK(ImportGamesharkActionReplaySnapshot,
         return;
 
     wxString fn = dlg.GetPath();
-    ret = wxMessageBox(_("Importing a snapshot file will erase any saved games (permanently after the next write).  Do you want to continue?"),
-        _("Confirm import"), wxYES_NO | wxICON_EXCLAMATION);
+    {
+        EmuThread::Unhold unhold(panel->emu_thread);
+        ret = wxMessageBox(_("Importing a snapshot file will erase any saved games (permanently after the next write).  Do you want to continue?"),
+            _("Confirm import"), wxYES_NO | wxICON_EXCLAMATION);
+    }
 
     if (ret == wxYES) {
         wxString msg;
@@ -1409,7 +1418,7 @@ EVT_HANDLER_MASK(EmulatorSpeedupToggle, "Turbo mode (toggle)", CMDEN_GB | CMDEN_
 
 EVT_HANDLER_MASK(Reset, "Reset", CMDEN_GB | CMDEN_GBA)
 {
-    panel->emusys->emuReset();
+    panel->emu_thread.call(panel->emusys->emuReset);
     // systemScreenMessage("Reset");
 }
 
@@ -1818,38 +1827,33 @@ EVT_HANDLER_MASK(Rewind, "Rewind", CMDEN_REWIND)
 {
     MainFrame* mf = wxGetApp().frame;
     GameArea* panel = mf->GetPanel();
-    int rew_st = (panel->next_rewind_state + NUM_REWINDS - 1) % NUM_REWINDS;
+    size_t size;
+    char* state = panel->rewind_states.rewind((uint32_t)(gopts.rewind_interval * REWIND_FRAMES_PER_SECOND + 0.5), size);
 
-    // if within 5 seconds of last one, and > 1 state, delete last state & move back
-    // FIXME: 5 should actually be user-configurable
-    // maybe instead of 5, 10% of rewind_interval
-    if (panel->num_rewind_states > 1 && (gopts.rewind_interval <= 5 || (int)panel->rewind_time / 6 > gopts.rewind_interval - 5)) {
-        --panel->num_rewind_states;
-        panel->next_rewind_state = rew_st;
-
-        if (gopts.rewind_interval > 5)
-            rew_st = (rew_st + NUM_REWINDS - 1) % NUM_REWINDS;
+    if (state) {
+        panel->emusys->emuReadMemState(state, (int)size);
+        // the frames rewound are gone from the history
+        panel->emulated_frames = panel->rewind_states.frame();
     }
 
-    panel->emusys->emuReadMemState(&panel->rewind_mem[rew_st * REWIND_SIZE],
-        REWIND_SIZE);
     InterframeCleanup();
     // FIXME: if(paused) blank screen
     panel->do_rewind = false;
-    panel->rewind_time = gopts.rewind_interval * 6;
     //    systemScreenMessage(_("Rewinded"));
 }
 
 EVT_HANDLER_MASK(CheatsList, "List cheats...", CMDEN_GB | CMDEN_GBA)
 {
     wxDialog* dlg = GetXRCDialog("CheatList");
-    ShowModal(dlg);
+    // it edits the cheats of the running game
+    ShowModal(dlg, true);
 }
 
 EVT_HANDLER_MASK(CheatsSearch, "Create cheat...", CMDEN_GB | CMDEN_GBA)
 {
     wxDialog* dlg = GetXRCDialog("CheatCreate");
-    ShowModal(dlg);
+    // it searches and adds cheats in the game's memory
+    ShowModal(dlg, true);
 }
 
 // new
@@ -2193,6 +2197,7 @@ extern int remotePort;
 int GetGDBPort(MainFrame* mf)
 {
     ModalPause mp;
+    EmuThread::Unhold unhold(mf->GetPanel()->emu_thread);
     return wxGetNumberFromUser(
 #ifdef __WXMSW__
         wxEmptyString,
@@ -2347,19 +2352,15 @@ EVT_HANDLER(GeneralConfigure, "General options...")
 
     if (rew != gopts.rewind_interval) {
         if (!gopts.rewind_interval) {
-            if (panel->num_rewind_states) {
+            if (panel->rewind_states.count()) {
                 cmd_enable &= ~CMDEN_REWIND;
                 enable_menus();
             }
 
-            panel->num_rewind_states = 0;
+            panel->rewind_states.clear();
             panel->do_rewind = false;
-        } else {
-            if (!panel->num_rewind_states)
-                panel->do_rewind = true;
-
-            panel->rewind_time = gopts.rewind_interval * 6;
-        }
+        } else if (!panel->rewind_states.count())
+            panel->do_rewind = true;
     }
 }
 
@@ -2801,8 +2802,13 @@ EVT_HANDLER(FactoryReset, "Factory Reset...")
 "YOUR CONFIGURATION WILL BE DELETED!\n\n")) + wxString(wxT(
 "Are you sure?")),
                         wxT("FACTORY RESET"), wxYES_NO | wxNO_DEFAULT | wxCENTRE);
+    int ret;
+    {
+        EmuThread::Unhold unhold(panel->emu_thread);
+        ret = dlg.ShowModal();
+    }
 
-    if (dlg.ShowModal() == wxID_YES) {
+    if (ret == wxID_YES) {
         wxGetApp().cfg->DeleteAll();
 
         wxExecute(wxStandardPaths::Get().GetExecutablePath(), wxEXEC_ASYNC);
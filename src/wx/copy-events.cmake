@@ -34,11 +34,10 @@ FOREACH(EV ${MW})
     STRING(REGEX REPLACE "^[^\"]*\\(" "void On" P1 "${EV}")
     STRING(REGEX REPLACE ",.*" "(wxCommandEvent&);\n" P1 "${P1}")
     FILE(APPEND "${EVPROTO}" "${P1}")
-    IF(EV MATCHES "EVT_HANDLER_MASK")
-        STRING(REGEX REPLACE "^[^\"]*\\(" "void Do" P1 "${EV}")
-        STRING(REGEX REPLACE ",.*" "();\n" P1 "${P1}")
-        FILE(APPEND "${EVPROTO}" "${P1}")
-    ENDIF(EV MATCHES "EVT_HANDLER_MASK")
+    # the body of every handler is in Do<n>(), On<n>() wraps it
+    STRING(REGEX REPLACE "^[^\"]*\\(" "void Do" P1 "${EV}")
+    STRING(REGEX REPLACE ",.*" "();\n" P1 "${P1}")
+    FILE(APPEND "${EVPROTO}" "${P1}")
 ENDFOREACH(EV)
 
 # cmd-evtable.h has the event table entries for all handlers
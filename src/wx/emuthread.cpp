@@ -0,0 +1,337 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <wx/app.h>
+
+#include "emuthread.h"
+
+EmuThread::EmuThread()
+    : m_gui_call(NULL)
+    , m_gui_done(false)
+    , m_holds(0)
+    , m_busy(0)
+    , m_parked(false)
+    , m_run(false)
+    , m_stop(false)
+{
+}
+
+EmuThread::~EmuThread()
+{
+    stop();
+}
+
+void EmuThread::start(const std::function<void()>& step)
+{
+    stop();
+
+    // the thread waits for m_id before it does anything
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_step = step;
+    m_run = false;
+    m_stop = false;
+    m_thread = std::thread(&EmuThread::worker, this);
+    m_id = m_thread.get_id();
+}
+
+void EmuThread::stop()
+{
+    if (!m_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    m_id = std::thread::id();
+}
+
+bool EmuThread::on_thread() const
+{
+    return m_thread.joinable() && std::this_thread::get_id() == m_id;
+}
+
+void EmuThread::set_running(bool run)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_run = run;
+    }
+    m_wake.notify_one();
+}
+
+void EmuThread::call(const std::function<void()>& f)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    // the GUI holding it has the core to itself already
+    if (!m_thread.joinable() || m_holds || on_thread()) {
+        lock.unlock();
+        f();
+        return;
+    }
+
+    m_queue.push_back(f);
+    m_wake.notify_one();
+    for (;;) {
+        m_done.wait(lock, [this] { return (m_queue.empty() && !m_busy) || m_gui_call; });
+        if (!m_gui_call)
+            break;
+        // the emulator waits on the GUI in the middle of a frame
+        run_gui_call(lock);
+    }
+}
+
+void EmuThread::post(const std::function<void()>& f)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    if (!m_thread.joinable() || m_holds) {
+        lock.unlock();
+        f();
+        return;
+    }
+
+    m_queue.push_back(f);
+    m_wake.notify_one();
+}
+
+void EmuThread::to_gui(const std::function<void()>& f)
+{
+    if (!on_thread()) {
+        f();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_gui_lock);
+        m_gui.push_back(f);
+    }
+    wxWakeUpIdle();
+}
+
+void EmuThread::call_gui(const std::function<void()>& f)
+{
+    if (!on_thread()) {
+        f();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_gui_call = &f;
+    m_gui_done = false;
+    m_parked = true;
+    m_done.notify_all();
+    wxWakeUpIdle();
+
+    m_wake.wait(lock, [this] {
+        return m_stop ? m_gui_call || m_gui_done : m_gui_done && !m_holds;
+    });
+    m_parked = false;
+
+    if (m_gui_call) {
+        m_gui_call = NULL;
+        lock.unlock();
+        to_gui(f);
+    }
+}
+
+void EmuThread::run_gui_call(std::unique_lock<std::mutex>& lock)
+{
+    const std::function<void()>* f = m_gui_call;
+
+    // taken, f may wait on the emulator itself
+    m_gui_call = NULL;
+    lock.unlock();
+    (*f)();
+    lock.lock();
+    m_gui_done = true;
+    m_wake.notify_one();
+}
+
+void EmuThread::run_gui()
+{
+    std::vector<std::function<void()> > todo;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (m_gui_call)
+            run_gui_call(lock);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_gui_lock);
+        todo.swap(m_gui);
+    }
+
+    for (size_t i = 0; i < todo.size(); i++)
+        todo[i]();
+}
+
+void EmuThread::run_queue(std::unique_lock<std::mutex>& lock)
+{
+    while (!m_queue.empty()) {
+        std::function<void()> f;
+        f.swap(m_queue.front());
+        m_queue.pop_front();
+        m_busy++;
+
+        lock.unlock();
+        f();
+        lock.lock();
+
+        m_busy--;
+    }
+    m_done.notify_all();
+}
+
+void EmuThread::worker()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    for (;;) {
+        // the GUI waits in stop() and does not touch the core, so whatever
+        // it queued runs even if it forgot a hold
+        if (m_stop) {
+            run_queue(lock);
+            break;
+        }
+
+        if (m_holds) {
+            m_parked = true;
+            m_done.notify_all();
+            m_wake.wait(lock, [this] { return m_stop || !m_holds; });
+            m_parked = false;
+            continue;
+        }
+
+        if (!m_queue.empty()) {
+            run_queue(lock);
+            continue;
+        }
+
+        if (!m_run) {
+            m_wake.wait(lock, [this] { return m_stop || m_holds || m_run || !m_queue.empty(); });
+            continue;
+        }
+
+        lock.unlock();
+        m_step();
+        lock.lock();
+    }
+
+    m_parked = false;
+    m_done.notify_all();
+}
+
+EmuThread::Hold::Hold(EmuThread& emu)
+    : m_emu(emu)
+    , m_held(!emu.on_thread())
+{
+    if (!m_held)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_emu.m_lock);
+    if (m_emu.m_holds++)
+        return;
+
+    m_emu.m_wake.notify_one();
+    m_emu.wait_parked(lock);
+}
+
+EmuThread::Hold::~Hold()
+{
+    if (!m_held)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_emu.m_lock);
+        if (--m_emu.m_holds)
+            return;
+    }
+    m_emu.m_wake.notify_one();
+}
+
+EmuThread::Unhold::Unhold(EmuThread& emu)
+    : m_emu(emu)
+    , m_holds(0)
+{
+    if (m_emu.on_thread())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_emu.m_lock);
+        m_holds = m_emu.m_holds;
+        m_emu.m_holds = 0;
+    }
+    if (m_holds)
+        m_emu.m_wake.notify_one();
+}
+
+EmuThread::Unhold::~Unhold()
+{
+    if (!m_holds)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_emu.m_lock);
+    bool parked = m_emu.m_holds != 0; // by a hold taken meanwhile
+    m_emu.m_holds += m_holds;
+    if (parked)
+        return;
+
+    m_emu.m_wake.notify_one();
+    m_emu.wait_parked(lock);
+}
+
+void EmuThread::wait_parked(std::unique_lock<std::mutex>& lock)
+{
+    m_done.wait(lock, [this] { return m_parked || m_stop || !m_thread.joinable(); });
+}
+
+FrameHandoff::FrameHandoff()
+    : m_size(0)
+    , m_back(0)
+    , m_front(1)
+    , m_middle(2)
+{
+    for (int i = 0; i < 3; i++)
+        m_buffers[i] = NULL;
+}
+
+FrameHandoff::~FrameHandoff()
+{
+    for (int i = 0; i < 3; i++)
+        free(m_buffers[i]);
+}
+
+void FrameHandoff::reset(size_t size)
+{
+    if (size != m_size) {
+        for (int i = 0; i < 3; i++) {
+            free(m_buffers[i]);
+            m_buffers[i] = (uint8_t*)calloc(1, size);
+        }
+        m_size = size;
+    }
+
+    m_back = 0;
+    m_front = 1;
+    m_middle.store(2, std::memory_order_relaxed);
+}
+
+void FrameHandoff::put(const uint8_t* frame)
+{
+    memcpy(m_buffers[m_back], frame, m_size);
+    m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+uint8_t** FrameHandoff::take()
+{
+    if (!(m_middle.load(std::memory_order_relaxed) & FRESH))
+        return NULL;
+
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & ~FRESH;
+    return &m_buffers[m_front];
+}
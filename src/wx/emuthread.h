@@ -0,0 +1,141 @@
+#ifndef EMUTHREAD_H
+#define EMUTHREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The thread the emulator runs on, away from the GUI.
+//
+// While it is running the thread calls its step function, which emulates a
+// frame, over and over.  Between two frames it runs the commands queued
+// with call() and post(), and it parks while it is paused or the GUI holds
+// it (see Hold), so the GUI never waits for more than a frame and the
+// emulator never waits for the GUI.  What the core asks of the GUI goes the
+// other way through to_gui().
+//
+// Only the GUI thread may hold the emulator or call() into it.
+class EmuThread {
+public:
+    EmuThread();
+    ~EmuThread();
+
+    // Starts the thread, paused, with the function that emulates a frame
+    void start(const std::function<void()>& step);
+    // Runs what is still queued and stops the thread
+    void stop();
+    bool active() const { return m_thread.joinable(); }
+    // true if the caller is the emulator's thread
+    bool on_thread() const;
+
+    // Whether to keep emulating, takes effect at the end of the frame
+    void set_running(bool run);
+
+    // Runs f between two frames and returns once it has
+    void call(const std::function<void()>& f);
+    // Queues f to run between two frames and returns at once
+    void post(const std::function<void()>& f);
+
+    // Runs f on the GUI thread: at once if that is the caller, otherwise
+    // the next time the GUI is idle
+    void to_gui(const std::function<void()>& f);
+    // Runs f on the GUI thread and returns once it has, for a change the
+    // core must see before it goes on.  The emulator counts as parked
+    // meanwhile, so f may hold it, and stays so until the GUI's holds are
+    // gone.  If the thread is stopping f is left to run_gui() instead.
+    void call_gui(const std::function<void()>& f);
+    // Runs what to_gui() and call_gui() queued, called by the GUI when it
+    // is idle
+    void run_gui();
+
+    // Keeps the emulator parked between two frames for as long as it
+    // exists, so the GUI may use the core directly.  Holds nest, and do
+    // nothing on the emulator's thread or while it is not started.
+    class Hold {
+    public:
+        Hold(EmuThread& emu);
+        ~Hold();
+
+    private:
+        EmuThread& m_emu;
+        bool m_held;
+    };
+
+    // Lets the emulator run for as long as it exists although the GUI
+    // holds it, around a modal dialog for instance.  The core is off
+    // limits until it is gone and the holds are back.
+    class Unhold {
+    public:
+        Unhold(EmuThread& emu);
+        ~Unhold();
+
+    private:
+        EmuThread& m_emu;
+        int m_holds;
+    };
+
+private:
+    void worker();
+    void run_queue(std::unique_lock<std::mutex>& lock);
+    void run_gui_call(std::unique_lock<std::mutex>& lock);
+    void wait_parked(std::unique_lock<std::mutex>& lock);
+
+    std::thread m_thread;
+    std::thread::id m_id;
+    std::function<void()> m_step;
+
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::deque<std::function<void()> > m_queue;
+    const std::function<void()>* m_gui_call;
+    bool m_gui_done;
+    int m_holds;
+    int m_busy;
+    bool m_parked;
+    bool m_run;
+    bool m_stop;
+
+    std::mutex m_gui_lock;
+    std::vector<std::function<void()> > m_gui;
+};
+
+// Hands frames from the emulator to the GUI without either side waiting on
+// the other.  Of three buffers the emulator owns one, the GUI another, and
+// the one left is the newest frame: put() fills the emulator's buffer and
+// trades it for that one, take() trades the GUI's buffer for it if it is
+// newer than the last one taken.
+class FrameHandoff {
+public:
+    FrameHandoff();
+    ~FrameHandoff();
+
+    // Makes room for frames of size bytes and forgets the last one.  Not
+    // while either side is using it.
+    void reset(size_t size);
+
+    // Emulator side, copies the frame and publishes it
+    void put(const uint8_t* frame);
+
+    // GUI side, the buffer holding the newest frame, NULL if there was no
+    // new one since the last call.  The buffer may be traded for another
+    // of the same size, as DrawingPanelBase::DrawArea() does.
+    uint8_t** take();
+
+private:
+    enum { FRESH = 4 };
+
+    uint8_t* m_buffers[3];
+    size_t m_size;
+    int m_back;
+    int m_front;
+    std::atomic<int> m_middle;
+};
+
+#endif // EMUTHREAD_H
@@ -70,5 +70,8 @@ void xbrz3x32(uint8_t* src, uint32_t spitch, uint8_t*, uint8_t* dst, uint32_t ds
 void xbrz4x32(uint8_t* src, uint32_t spitch, uint8_t*, uint8_t* dst, uint32_t dstp, int w, int h);
 void xbrz5x32(uint8_t* src, uint32_t spitch, uint8_t*, uint8_t* dst, uint32_t dstp, int w, int h);
 void xbrz6x32(uint8_t* src, uint32_t spitch, uint8_t*, uint8_t* dst, uint32_t dstp, int w, int h);
+// rows [first, last) of a w x h picture scaled factor times, src and dst
+// being the top of the pictures
+void xbrz32Rows(int factor, uint8_t* src, uint32_t spitch, uint8_t* dst, uint32_t dstp, int w, int h, int first, int last);
 
 #endif /* FILTERS_H */
@@ -47,6 +47,7 @@ extern struct opts_t {
     /// General
     bool autoload_state, autoload_cheats;
     wxString battery_dir;
+    bool emulation_thread;
     long last_update;
     wxString last_updated_filename;
     bool recent_freeze;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
@@ -44,10 +45,8 @@ GameArea::GameArea()
     , panel(NULL)
     , emusys(NULL)
     , was_paused(false)
-    , rewind_time(0)
     , do_rewind(false)
-    , rewind_mem(0)
-    , num_rewind_states(0)
+    , emulated_frames(0)
     , loaded(IMAGE_UNKNOWN)
     , basic_width(GBAWidth)
     , basic_height(GBAHeight)
@@ -252,6 +251,7 @@ void GameArea::LoadGame(const wxString& name)
             // don't use real rom size or it might try to resize rom[]
             // instead, use known size of rom[]
             int size = 0x2000000 < rom_size ? 0x2000000 : rom_size;
+            gbaDetachRom();
             applyPatch(UTF8(pfn.GetFullPath()), &rom, &size);
             // that means we no longer really know rom_size either <sigh>
 
@@ -332,6 +332,9 @@ void GameArea::LoadGame(const wxString& name)
         GameArea::ShowFullScreen(true);
 
     loaded = t;
+    // frames are as large as the core's pix, which has room for a border
+    handoff.reset(loaded == IMAGE_GB ? 4 * (SGBWidth + 1) * (SGBHeight + 2)
+                                     : 4 * (GBAWidth + 1) * (GBAHeight + 2));
     SetFrameTitle();
     SetFocus();
     // Use custom geometry
@@ -516,6 +519,9 @@ void GameArea::UnloadGame(bool destruct)
     if (!emulating)
         return;
 
+    // whatever it was doing is finished, the core is ours from here on
+    emu_thread.stop();
+
     // last opportunity to autosave cheats
     if (gopts.autoload_cheats && cheats_dirty) {
         wxFileName cfn = loaded_game;
@@ -594,8 +600,7 @@ void GameArea::UnloadGame(bool destruct)
     mf->SetJoystick();
     mf->ResetCheatSearch();
 
-    if (rewind_mem)
-        num_rewind_states = 0;
+    rewind_states.clear();
 }
 
 bool GameArea::LoadState()
@@ -617,19 +622,20 @@ bool GameArea::LoadState(int slot)
 
 bool GameArea::LoadState(const wxFileName& fname)
 {
+    // the rewind buffer and the screen change along with the core
+    EmuThread::Hold hold(emu_thread);
     // FIXME: first save to backup state if not backup state
     bool ret = emusys->emuReadState(UTF8(fname.GetFullPath()));
 
-    if (ret && num_rewind_states) {
+    if (ret && rewind_states.count()) {
         MainFrame* mf = wxGetApp().frame;
         mf->cmd_enable &= ~CMDEN_REWIND;
         mf->enable_menus();
-        num_rewind_states = 0;
+        rewind_states.clear();
         // do an immediate rewind save
         // even if loaded from state file: not smart enough yet to just
         // do a reset or load from state file when # rewinds == 0
         do_rewind = true;
-        rewind_time = gopts.rewind_interval * 6;
     }
 
     if (ret) {
@@ -665,7 +671,8 @@ bool GameArea::SaveState(int slot)
 bool GameArea::SaveState(const wxFileName& fname)
 {
     // FIXME: first copy to backup state if not backup state
-    bool ret = emusys->emuWriteState(UTF8(fname.GetFullPath()));
+    bool ret = false;
+    emu_thread.call([&] { ret = emusys->emuWriteState(UTF8(fname.GetFullPath())); });
     wxGetApp().frame->update_state_ts(true);
     wxString msg;
     msg.Printf(ret ? _("Saved state %s") : _("Error saving state %s"),
@@ -674,7 +681,7 @@ bool GameArea::SaveState(const wxFileName& fname)
     return ret;
 }
 
-void GameArea::SaveBattery()
+void GameArea::SaveBattery(bool background)
 {
     // MakeInstanceFilename doesn't do wxString, so just add slave ID here
     wxString bname = game_name();
@@ -695,7 +702,10 @@ void GameArea::SaveBattery()
     // FIXME: add option to support ring of backups
     // of course some games just write battery way too often for such
     // a thing to be useful
-    if (!emusys->emuWriteBattery(UTF8(fn)))
+    if (background) {
+        // failures are reported by the writer
+        emusys->emuWriteBatteryAsync(UTF8(fn));
+    } else if (!emusys->emuWriteBattery(UTF8(fn)))
         wxLogError(_("Error writing battery %s"), fn.mb_str());
 
     systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
@@ -706,6 +716,8 @@ void GameArea::AddBorder()
     if (basic_width != GBWidth)
         return;
 
+    EmuThread::Hold hold(emu_thread);
+
     basic_width = SGBWidth;
     basic_height = SGBHeight;
     gbBorderLineSkip = SGBWidth;
@@ -726,6 +738,8 @@ void GameArea::DelBorder()
     if (basic_width != SGBWidth)
         return;
 
+    EmuThread::Hold hold(emu_thread);
+
     basic_width = GBWidth;
     basic_height = GBHeight;
     gbBorderLineSkip = GBWidth;
@@ -942,9 +956,6 @@ GameArea::~GameArea()
 {
     UnloadGame(true);
 
-    if (rewind_mem)
-        free(rewind_mem);
-
     if (gopts.fs_mode.w && gopts.fs_mode.h && fullscreen) {
         MainFrame* tlw = wxGetApp().frame;
         int dno = wxDisplay::GetFromWindow(tlw);
@@ -966,11 +977,15 @@ void GameArea::Pause()
 
     // don't pause when linked
 #ifndef NO_LINK
-    if (GetLinkMode() != LINK_DISCONNECTED)
+    if (GetLinkMode() != LINK_DISCONNECTED) {
+        // systemPauseOnFrame() may have stopped it already
+        emu_thread.set_running(true);
         return;
+    }
 #endif
 
     paused = was_paused = true;
+    emu_thread.set_running(false);
 
     // when the game is paused like this, we should not allow any
     // input to remain pressed, because they could be released
@@ -978,7 +993,7 @@ void GameArea::Pause()
     clear_input_press();
 
     if (loaded != IMAGE_UNKNOWN)
-        soundPause();
+        emu_thread.call(soundPause);
 
     wxGetApp().frame->StartJoyPollTimer();
 }
@@ -992,8 +1007,9 @@ void GameArea::Resume()
     SetExtraStyle(GetExtraStyle() | wxWS_EX_PROCESS_IDLE);
 
     if (loaded != IMAGE_UNKNOWN)
-        soundResume();
+        emu_thread.call(soundResume);
 
+    emu_thread.set_running(true);
     wxGetApp().frame->StopJoyPollTimer();
 
     SetFocus();
@@ -1004,6 +1020,8 @@ void GameArea::OnIdle(wxIdleEvent& event)
     wxString pl = wxGetApp().pending_load;
     MainFrame* mf = wxGetApp().frame;
 
+    emu_thread.run_gui();
+
     if (pl.size()) {
         // sometimes this gets into a loop if LoadGame() called before
         // clearing pending_load.  weird.
@@ -1136,14 +1154,17 @@ void GameArea::OnIdle(wxIdleEvent& event)
     }
 
     mf->PollJoysticks();
+    DrawFrame();
 
     if (!paused) {
         HidePointer();
         HideMenuBar();
-        event.RequestMore();
 
 #ifndef NO_DEBUGGER
         if (debugger) {
+            // the debugger runs the core itself, here
+            emu_thread.stop();
+            event.RequestMore();
             was_paused = true;
             dbgMain();
 
@@ -1156,13 +1177,21 @@ void GameArea::OnIdle(wxIdleEvent& event)
         }
 #endif
 
-        emusys->emuMain(emusys->emuCount);
-#ifndef NO_LINK
-
-        if (loaded == IMAGE_GBA && GetLinkMode() != LINK_DISCONNECTED)
-            CheckLinkConnection();
-
-#endif
+        if (gopts.emulation_thread) {
+            // frames are handed over without waiting, vsync does not
+            // pace the thread
+            soundSetExternalPacing(false);
+            // it wakes the GUI up when it has a frame to draw
+            if (!emu_thread.active()) {
+                emu_thread.start([this] { RunFrame(); });
+                emu_thread.set_running(true);
+            }
+        } else {
+            emu_thread.stop();
+            soundSetExternalPacing(vsync != 0);
+            event.RequestMore();
+            RunFrame();
+        }
     } else {
         was_paused = true;
 
@@ -1171,41 +1200,72 @@ void GameArea::OnIdle(wxIdleEvent& event)
 
         ShowMenuBar();
     }
+}
 
-    if (do_rewind && emusys->emuWriteMemState) {
-        if (!rewind_mem) {
-            rewind_mem = (char*)malloc(NUM_REWINDS * REWIND_SIZE);
-            num_rewind_states = next_rewind_state = 0;
-        }
+// Emulates a frame, on the emulator's thread if there is one
+void GameArea::RunFrame()
+{
+    MainFrame* mf = wxGetApp().frame;
 
-        if (!rewind_mem) {
-            wxLogError(_("No memory for rewinding"));
-            wxGetApp().frame->Close(true);
+    uint32_t frames = emulated_frames;
+    emusys->emuMain(emusys->emuCount);
+
+    // a snapshot per finished frame, emuMain() may stop short of one
+    if (gopts.rewind_interval && emulated_frames != frames)
+        do_rewind = true;
+#ifndef NO_LINK
+
+    if (loaded == IMAGE_GBA && GetLinkMode() != LINK_DISCONNECTED)
+        CheckLinkConnection();
+
+#endif
+
+    if (do_rewind && emusys->emuWriteMemStateRaw) {
+        if (!rewind_states.stateSize() && !rewind_states.reset(REWIND_SIZE, REWIND_STATE_SIZE, REWIND_KEYFRAME_INTERVAL)) {
+            emu_thread.set_running(false);
+            emu_thread.to_gui([mf] {
+                wxLogError(_("No memory for rewinding"));
+                mf->Close(true);
+            });
             return;
         }
 
-        long resize;
+        long size;
 
-        if (!emusys->emuWriteMemState(&rewind_mem[REWIND_SIZE * next_rewind_state],
-                REWIND_SIZE, resize /* actual size */))
-            // if you see a lot of these, maybe increase REWIND_SIZE
+        if (!emusys->emuWriteMemStateRaw(rewind_states.state(), rewind_states.stateSize(), size) || !rewind_states.push(size, emulated_frames))
+            // if you see a lot of these, maybe increase REWIND_STATE_SIZE
             wxLogInfo(_("Error writing rewind state"));
-        else {
-            if (!num_rewind_states) {
+        else if (rewind_states.count() == 1) {
+            // the first one since the buffer was cleared
+            emu_thread.to_gui([mf] {
                 mf->cmd_enable |= CMDEN_REWIND;
                 mf->enable_menus();
-            }
-
-            if (num_rewind_states < NUM_REWINDS)
-                ++num_rewind_states;
-
-            next_rewind_state = (next_rewind_state + 1) % NUM_REWINDS;
+            });
         }
 
         do_rewind = false;
     }
 }
 
+// Draws the newest frame the emulator's thread has sent
+void GameArea::DrawFrame()
+{
+    uint8_t** frame = handoff.take();
+
+    if (!frame)
+        return;
+
+    MainFrame* mf = wxGetApp().frame;
+
+    if (!mf->popups.empty()) {
+        EmuThread::Hold hold(emu_thread);
+        mf->UpdateViewers();
+    }
+
+    if (panel)
+        panel->DrawArea(frame);
+}
+
 // Note: keys will get stuck if they are released while window has no focus
 // can't really do anything about it, except scan for pressed keys on
 // activate events.  Maybe later.
@@ -1563,235 +1623,260 @@ void DrawingPanelBase::EraseBackground(wxEraseEvent& ev)
     // do nothing, do not allow propagation
 }
 
-// In order to run filters in parallel, they have to run from the method of
-// a wxThread-derived class
-//   threads are only created once, if possible, to avoid thread creation
-//   overhead every frame; mutex+cond used to signal start and sem for end
+// In order to run filters in parallel, the image is cut into bands of a few
+// lines each, which the threads of a WorkPool take on as they become free
+//   the threads are only created once, if possible, to avoid thread
+//   creation overhead every frame
 
-//   when threading, there _will_ be bands for any nontrivial filter
-//   usually the top and bottom line(s) of each region will look a little
-//   different.  To ease this a tiny bit, 2 extra lines are generated at
-//   the top of each region, so hopefully only the bottom of the previous
-//   region will look screwed up.  The only correct way to handle this
-//   is to draw an increasingly larger band around the seam until the
-//   seam cover matches a line in both top & bottom regions, and then apply
-//   cover to seam.   Way too much trouble for this, though.
+//   most filters read the lines around the ones they make from the input
+//   buffer itself, but some take the first and last lines they are given
+//   for the edges of the picture.  Those get the lines around their band as
+//   well and only the band is kept (see FilterJob::Context()), and xBRZ
+//   scales its band out of the whole picture, so the bands do not show.
+//   Plugins may look any distance around, they get one band per thread.
 
 //   another issue to consider is whether or not these filters are thread-
 //   safe to begin with.  The built-in ones are verifyable (I didn't verify
 //   them, though).  The plugins cannot be verified.  However, unlike the MFC
 //   interface, I will allow them to be threaded at user's discretion.
-class FilterThread : public wxThread {
-public:
-    FilterThread()
-        : wxThread(wxTHREAD_JOINABLE)
-        , lock()
-        , sig(lock)
-    {
-    }
 
-    wxMutex lock;
-    wxCondition sig;
-    wxSemaphore* done;
+// lines per band when filtering in parallel
+#define FILTER_BAND_LINES 8
 
-    // Set these params before running
-    int nthreads, threadno;
-    int width, height;
+struct FilterJob {
+    int bands;
+    int width, frameheight;
     double scale;
     const RENDER_PLUGIN_INFO* rpi;
-    uint8_t *dst, *delta;
+    uint8_t *inbuf, *outbuf, *deltabuf;
 
-    // set this param every round
-    // if NULL, end thread
-    uint8_t* src;
+    // Lines of the band
+    void Band(int band, int& procy, int& height) const
+    {
+        procy = frameheight * band / bands;
+        height = frameheight * (band + 1) / bands - procy;
+    }
 
-    ExitCode Entry()
+    int InStride() const
     {
-        // This is the band this thread will process
-        // threadno == -1 means just do a dummy round on the border line
-        int procy = height * threadno / nthreads;
-        height = height * (threadno + 1) / nthreads - procy;
         int inbpp = systemColorDepth >> 3;
         int inrb = systemColorDepth == 16 ? 2 : systemColorDepth == 24 ? 0 : 1;
-        int instride = (width + inrb) * inbpp;
-        int outbpp = out_16 ? 2 : systemColorDepth == 24 ? 3 : 4;
-        int outrb = systemColorDepth == 24 ? 0 : 4;
-        int outstride = std::ceil(width * outbpp * scale) + outrb;
-        delta += instride * procy;
-
-        // FIXME: fugly hack
-        if(gopts.render_method == RND_OPENGL)
-            dst += (int)std::ceil(outstride * (procy + 1) * scale);
-        else
-            dst += (int)std::ceil(outstride * (procy + (1 / scale)) * scale);
-
-        while (nthreads == 1 || sig.Wait() == wxCOND_NO_ERROR) {
-            if (!src /* && nthreads > 1 */) {
-                lock.Unlock();
-                return 0;
-            }
-
-            src += instride;
-
-            // interframe blending filter
-            // definitely not thread safe by default
-            // added procy param to provide offset into accum buffers
-            if (gopts.ifb != IFB_NONE) {
-                switch (gopts.ifb) {
-                case IFB_SMART:
-                    if (systemColorDepth == 16)
-                        SmartIB(src, instride, width, procy, height);
-                    else
-                        SmartIB32(src, instride, width, procy, height);
-
-                    break;
+        return (width + inrb) * inbpp;
+    }
 
-                case IFB_MOTION_BLUR:
+    // Blending changes the input in place, so all of it is done before any
+    // band is filtered, which also reads the lines around it
+    void Blend(int band) const
+    {
+        int procy, height;
+        Band(band, procy, height);
+        int instride = InStride();
+        // skip the border line
+        uint8_t* src = inbuf + instride;
+
+        // interframe blending filter
+        // definitely not thread safe by default
+        // added procy param to provide offset into accum buffers
+        if (gopts.ifb != IFB_NONE) {
+            switch (gopts.ifb) {
+            case IFB_SMART:
+                if (systemColorDepth == 16)
+                    SmartIB(src, instride, width, procy, height);
+                else
+                    SmartIB32(src, instride, width, procy, height);
 
-                    // FIXME: if(renderer == d3d/gl && filter == NONE) break;
-                    if (systemColorDepth == 16)
-                        MotionBlurIB(src, instride, width, procy, height);
-                    else
-                        MotionBlurIB32(src, instride, width, procy, height);
+                break;
 
-                    break;
-                }
-            }
+            case IFB_MOTION_BLUR:
 
-            if (gopts.filter == FF_NONE) {
-                if (nthreads == 1)
-                    return 0;
+                // FIXME: if(renderer == d3d/gl && filter == NONE) break;
+                if (systemColorDepth == 16)
+                    MotionBlurIB(src, instride, width, procy, height);
+                else
+                    MotionBlurIB32(src, instride, width, procy, height);
 
-                done->Post();
-                continue;
+                break;
             }
+        }
+    }
 
-            //src += instride * procy;
+    int OutStride() const
+    {
+        int outbpp = out_16 ? 2 : systemColorDepth == 24 ? 3 : 4;
+        int outrb = systemColorDepth == 24 ? 0 : 4;
+        return std::ceil(width * outbpp * scale) + outrb;
+    }
 
-            // naturally, any of these with accumulation buffers like those of
-            // the IFB filters will screw up royally as well
-            switch (gopts.filter) {
-            case FF_2XSAI:
-                _2xSaI32(src, instride, delta, dst, outstride, width, height);
-                break;
+    // Where line y of the frame goes
+    uint8_t* Dst(int y) const
+    {
+        int outstride = OutStride();
 
-            case FF_SUPER2XSAI:
-                Super2xSaI32(src, instride, delta, dst, outstride, width, height);
-                break;
+        // FIXME: fugly hack
+        if(gopts.render_method == RND_OPENGL)
+            return outbuf + (int)std::ceil(outstride * (y + 1) * scale);
+        else
+            return outbuf + (int)std::ceil(outstride * (y + (1 / scale)) * scale);
+    }
 
-            case FF_SUPEREAGLE:
-                SuperEagle32(src, instride, delta, dst, outstride, width, height);
-                break;
+    // Lines above and below a band the filter has to be given.  These
+    // filters take the first and last lines they get for the edges of the
+    // picture, and scale by whole numbers.
+    int Context() const
+    {
+        if (bands == 1)
+            return 0;
+
+        switch (gopts.filter) {
+        case FF_ADVMAME:
+        case FF_BILINEAR:
+        case FF_BILINEARPLUS:
+        case FF_LQ2X:
+        case FF_HQ2X:
+        case FF_HQ3X:
+        case FF_HQ4X:
+            return 1;
 
-            case FF_PIXELATE:
-                Pixelate32(src, instride, delta, dst, outstride, width, height);
-                break;
+        default:
+            return 0;
+        }
+    }
 
-            case FF_ADVMAME:
-                AdMame2x32(src, instride, delta, dst, outstride, width, height);
-                break;
+    void Filter(int band) const
+    {
+        int procy, height;
+        Band(band, procy, height);
+        int instride = InStride();
+        int outstride = OutStride();
+        uint8_t* src = inbuf + instride * (procy + 1);
+        uint8_t* delta = deltabuf + instride * procy;
+        uint8_t* dst = Dst(procy);
+
+        if (gopts.filter >= FF_XBRZ2X && gopts.filter <= FF_XBRZ6X) {
+            xbrz32Rows(gopts.filter - FF_XBRZ2X + 2, inbuf + instride, instride, Dst(0),
+                outstride, width, frameheight, procy, procy + height);
+            return;
+        }
 
-            case FF_BILINEAR:
-                Bilinear32(src, instride, delta, dst, outstride, width, height);
-                break;
+        int context = Context();
+        if (context == 0) {
+            Apply(src, delta, dst, height);
+            return;
+        }
 
-            case FF_BILINEARPLUS:
-                BilinearPlus32(src, instride, delta, dst, outstride, width, height);
-                break;
+        // the band and its surroundings are filtered aside, then the band's
+        // lines are copied out
+        static thread_local std::vector<uint8_t> aside;
+        int above = std::min(procy, context);
+        int below = std::min(frameheight - procy - height, context);
+        size_t line = (size_t)outstride * (int)scale;
+        aside.resize(line * (above + height + below));
+        Apply(src - instride * above, delta - instride * above, &aside[0],
+            above + height + below);
+        memcpy(dst, &aside[line * above], line * height);
+    }
 
-            case FF_SCANLINES:
-                Scanlines32(src, instride, delta, dst, outstride, width, height);
-                break;
+    // Runs the filter over height lines from src into dst
+    void Apply(uint8_t* src, uint8_t* delta, uint8_t* dst, int height) const
+    {
+        int instride = InStride();
+        int outstride = OutStride();
+
+        // naturally, any of these with accumulation buffers like those of
+        // the IFB filters will screw up royally as well
+        switch (gopts.filter) {
+        case FF_2XSAI:
+            _2xSaI32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_TV:
-                ScanlinesTV32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_SUPER2XSAI:
+            Super2xSaI32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_LQ2X:
-                lq2x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_SUPEREAGLE:
+            SuperEagle32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_SIMPLE2X:
-                Simple2x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_PIXELATE:
+            Pixelate32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_SIMPLE3X:
-                Simple3x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_ADVMAME:
+            AdMame2x32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_SIMPLE4X:
-                Simple4x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_BILINEAR:
+            Bilinear32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_HQ2X:
-                hq2x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_BILINEARPLUS:
+            BilinearPlus32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_HQ3X:
-                hq3x32_32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_SCANLINES:
+            Scanlines32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_HQ4X:
-                hq4x32_32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_TV:
+            ScanlinesTV32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_XBRZ2X:
-                xbrz2x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_LQ2X:
+            lq2x32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_XBRZ3X:
-                xbrz3x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_SIMPLE2X:
+            Simple2x32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_XBRZ4X:
-                xbrz4x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_SIMPLE3X:
+            Simple3x32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_XBRZ5X:
-                xbrz5x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_SIMPLE4X:
+            Simple4x32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_XBRZ6X:
-                xbrz6x32(src, instride, delta, dst, outstride, width, height);
-                break;
+        case FF_HQ2X:
+            hq2x32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            case FF_PLUGIN:
-                // MFC interface did not do plugins in parallel
-                // Probably because it's almost certain they carry state or do
-                // other non-thread-safe things
-                // But the user can always turn mt off of it's not working..
-                RENDER_PLUGIN_OUTP outdesc;
-                outdesc.Size = sizeof(outdesc);
-                outdesc.Flags = rpi->Flags;
-                outdesc.SrcPtr = src;
-                outdesc.SrcPitch = instride;
-                outdesc.SrcW = width;
-                // FIXME: win32 code adds to H, saying that frame isn't fully
-                // rendered otherwise
-                // I need to verify that statement before I go adding stuff that
-                // may make it crash.
-                outdesc.SrcH = height; // + scale / 2
-                outdesc.DstPtr = dst;
-                outdesc.DstPitch = outstride;
-                outdesc.DstW = std::ceil(width * scale);
-                // on the other hand, there is at least 1 line below, so I'll add
-                // that to dest in case safety checks in plugin use < instead of <=
-                outdesc.DstH = std::ceil(height * scale); // + scale * (scale / 2)
-                rpi->Output(&outdesc);
-                break;
+        case FF_HQ3X:
+            hq3x32_32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            default:
-                break;
-            }
+        case FF_HQ4X:
+            hq4x32_32(src, instride, delta, dst, outstride, width, height);
+            break;
 
-            if (nthreads == 1)
-                return 0;
+        case FF_PLUGIN:
+            // MFC interface did not do plugins in parallel
+            // Probably because it's almost certain they carry state or do
+            // other non-thread-safe things
+            // But the user can always turn mt off of it's not working..
+            RENDER_PLUGIN_OUTP outdesc;
+            outdesc.Size = sizeof(outdesc);
+            outdesc.Flags = rpi->Flags;
+            outdesc.SrcPtr = src;
+            outdesc.SrcPitch = instride;
+            outdesc.SrcW = width;
+            // FIXME: win32 code adds to H, saying that frame isn't fully
+            // rendered otherwise
+            // I need to verify that statement before I go adding stuff that
+            // may make it crash.
+            outdesc.SrcH = height; // + scale / 2
+            outdesc.DstPtr = dst;
+            outdesc.DstPitch = outstride;
+            outdesc.DstW = std::ceil(width * scale);
+            // on the other hand, there is at least 1 line below, so I'll add
+            // that to dest in case safety checks in plugin use < instead of <=
+            outdesc.DstH = std::ceil(height * scale); // + scale * (scale / 2)
+            rpi->Output(&outdesc);
+            break;
 
-            done->Post();
-            continue;
+        default:
+            break;
         }
-
-        return 0;
     }
 };
 
@@ -1824,78 +1909,37 @@ void DrawingPanelBase::DrawArea(uint8_t** data)
     } else
         todraw = pixbuf2;
 
-    // FIXME: filters race condition?
-    gopts.max_threads = 1;
-
     // First, apply filters, if applicable, in parallel, if enabled
     if (gopts.filter != FF_NONE || gopts.ifb != FF_NONE /* FIXME: && (gopts.ifb != FF_MOTION_BLUR || !renderer_can_motion_blur) */) {
-        if (nthreads != gopts.max_threads) {
-            if (nthreads) {
-                if (nthreads > 1)
-                    for (int i = 0; i < nthreads; i++) {
-                        threads[i].lock.Lock();
-                        threads[i].src = NULL;
-                        threads[i].sig.Signal();
-                        threads[i].lock.Unlock();
-                        threads[i].Wait();
-                    }
-
-                delete[] threads;
-            }
+        FilterJob job;
+        job.bands = 1;
+        job.width = width;
+        job.frameheight = height;
+        job.scale = scale;
+        job.rpi = rpi;
+        job.inbuf = *data;
+        job.outbuf = todraw;
+        job.deltabuf = delta;
 
+        if (nthreads != gopts.max_threads) {
             nthreads = gopts.max_threads;
-            threads = new FilterThread[nthreads];
+            filter_pool.start(nthreads);
             // first time around, no threading in order to avoid
             // static initializer conflicts
-            threads[0].threadno = 0;
-            threads[0].nthreads = 1;
-            threads[0].width = width;
-            threads[0].height = height;
-            threads[0].scale = scale;
-            threads[0].src = *data;
-            threads[0].dst = todraw;
-            threads[0].delta = delta;
-            threads[0].rpi = rpi;
-            threads[0].Entry();
-
-            // go ahead and start the threads up, though
-            if (nthreads > 1) {
-                for (int i = 0; i < nthreads; i++) {
-                    threads[i].threadno = i;
-                    threads[i].nthreads = nthreads;
-                    threads[i].width = width;
-                    threads[i].height = height;
-                    threads[i].scale = scale;
-                    threads[i].dst = todraw;
-                    threads[i].delta = delta;
-                    threads[i].rpi = rpi;
-                    threads[i].done = &filt_done;
-                    threads[i].lock.Lock();
-                    threads[i].Create();
-                    threads[i].Run();
-                }
-            }
-        } else if (nthreads == 1) {
-            threads[0].threadno = 0;
-            threads[0].nthreads = 1;
-            threads[0].width = width;
-            threads[0].height = height;
-            threads[0].scale = scale;
-            threads[0].src = *data;
-            threads[0].dst = todraw;
-            threads[0].delta = delta;
-            threads[0].rpi = rpi;
-            threads[0].Entry();
+            job.Blend(0);
+            job.Filter(0);
         } else {
-            for (int i = 0; i < nthreads; i++) {
-                threads[i].lock.Lock();
-                threads[i].src = *data;
-                threads[i].sig.Signal();
-                threads[i].lock.Unlock();
-            }
+            // plugins keep one band per thread, see above
+            if (nthreads > 1 && gopts.filter == FF_PLUGIN)
+                job.bands = nthreads;
+            else if (nthreads > 1)
+                job.bands = std::max(height / FILTER_BAND_LINES, nthreads);
 
-            for (int i = 0; i < nthreads; i++)
-                filt_done.Wait();
+            if (gopts.ifb != IFB_NONE)
+                filter_pool.run(job.bands, [&job](int band) { job.Blend(band); });
+
+            if (gopts.filter != FF_NONE)
+                filter_pool.run(job.bands, [&job](int band) { job.Filter(band); });
         }
     }
 
@@ -2064,18 +2108,7 @@ DrawingPanelBase::~DrawingPanelBase()
     }
     InterframeCleanup();
 
-    if (nthreads) {
-        if (nthreads > 1)
-            for (int i = 0; i < nthreads; i++) {
-                threads[i].lock.Lock();
-                threads[i].src = NULL;
-                threads[i].sig.Signal();
-                threads[i].lock.Unlock();
-                threads[i].Wait();
-            }
-
-        delete[] threads;
-    }
+    filter_pool.stop();
 
     disableKeyboardBackgroundInput();
 }
@@ -2464,6 +2497,12 @@ void GameArea::StartVidRecording(const wxString& fname)
 void GameArea::StopVidRecording()
 {
     vid_rec.Stop();
+
+    recording::MediaStats stats = vid_rec.GetStats();
+    if (stats.dropped)
+        wxLogWarning(_("%d video frames were dropped because encoding was too slow"),
+            stats.dropped);
+
     MainFrame* mf = wxGetApp().frame;
     mf->cmd_enable &= ~CMDEN_VREC;
     mf->cmd_enable |= CMDEN_NVREC;
@@ -36,6 +36,18 @@ bool turbo;
 // and this is from MFC interface
 bool soundBufferLow;
 
+// Runs f on the GUI thread, later if the emulator's thread is asking
+static void gui_call(const std::function<void()>& f)
+{
+    MainFrame* mf = wxGetApp().frame;
+    GameArea* panel = mf ? mf->GetPanel() : NULL;
+
+    if (panel)
+        panel->emu_thread.to_gui(f);
+    else
+        f();
+}
+
 void systemMessage(int id, const char* fmt, ...)
 {
     (void)id; // unused params
@@ -85,7 +97,6 @@ void systemDrawScreen()
 {
     frames++;
     MainFrame* mf = wxGetApp().frame;
-    mf->UpdateViewers();
     // FIXME: Sm60FPS crap and sondBufferLow crap
     GameArea* ga = mf->GetPanel();
 #ifndef NO_FFMPEG
@@ -95,6 +106,15 @@ void systemDrawScreen()
 
 #endif
 
+    // the GUI draws it, and updates the viewers, when it gets to it
+    if (ga && ga->emu_thread.on_thread()) {
+        ga->handoff.put(pix);
+        wxWakeUpIdle();
+        return;
+    }
+
+    mf->UpdateViewers();
+
     if (ga && ga->panel)
         ga->panel->DrawArea(&pix);
 }
@@ -335,26 +355,31 @@ uint32_t systemReadJoypad(int joy)
 
 void systemShowSpeed(int speed)
 {
-    MainFrame* f = wxGetApp().frame;
-    wxString s;
-    s.Printf(_("%d%%(%d, %d fps)"), speed, systemFrameSkip, frames * speed / 100);
+    int fps = frames * speed / 100;
+    int skip = systemFrameSkip;
+    frames = 0;
 
-    switch (showSpeed) {
-    case SS_NONE:
-        f->GetPanel()->osdstat.clear();
-        break;
+    gui_call([speed, fps, skip] {
+        MainFrame* f = wxGetApp().frame;
+        wxString s;
+        s.Printf(_("%d%%(%d, %d fps)"), speed, skip, fps);
 
-    case SS_PERCENT:
-        f->GetPanel()->osdstat.Printf(_("%d%%"), speed);
-        break;
+        switch (showSpeed) {
+        case SS_NONE:
+            f->GetPanel()->osdstat.clear();
+            break;
 
-    case SS_DETAILED:
-        f->GetPanel()->osdstat = s;
-        break;
-    }
+        case SS_PERCENT:
+            f->GetPanel()->osdstat.Printf(_("%d%%"), speed);
+            break;
 
-    wxGetApp().frame->SetStatusText(s, 1);
-    frames = 0;
+        case SS_DETAILED:
+            f->GetPanel()->osdstat = s;
+            break;
+        }
+
+        wxGetApp().frame->SetStatusText(s, 1);
+    });
 }
 
 int systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
@@ -399,21 +424,19 @@ void system10Frames(int rate)
         panel->was_paused = false;
     }
 
-    if (gopts.rewind_interval) {
-        if (!panel->rewind_time)
-            panel->rewind_time = gopts.rewind_interval * 6;
-        else if (!--panel->rewind_time)
-            panel->do_rewind = true;
-    }
-
     if (--systemSaveUpdateCounter == SYSTEM_SAVE_NOT_UPDATED)
-        panel->SaveBattery();
+        panel->SaveBattery(true);
     else if (systemSaveUpdateCounter < SYSTEM_SAVE_NOT_UPDATED)
         systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
 }
 
 void systemFrame()
 {
+    GameArea* panel = wxGetApp().frame->GetPanel();
+
+    if (panel)
+        panel->emulated_frames++;
+
     if (game_recording || game_playback)
         game_frame++;
 }
@@ -467,7 +490,7 @@ uint32_t systemGetClock()
 
 void systemCartridgeRumble(bool b)
 {
-    wxGetApp().frame->SetJoystickRumble(b);
+    gui_call([b] { wxGetApp().frame->SetJoystickRumble(b); });
 }
 
 static uint8_t sensorDarkness = 0xE8; // total darkness (including daylight on rainy days)
@@ -907,6 +930,18 @@ void PrintDialog::DoPrint(wxCommandEvent&)
 
 void systemGbPrint(uint8_t* data, int len, int pages, int feed, int pal, int cont)
 {
+    GameArea* ga = wxGetApp().frame->GetPanel();
+
+    // the printer has dialogs, it runs on the GUI thread while the game
+    // goes on
+    if (ga->emu_thread.on_thread()) {
+        std::vector<uint8_t> copy(data, data + len);
+        ga->emu_thread.to_gui([copy, len, pages, feed, pal, cont]() mutable {
+            systemGbPrint(copy.data(), len, pages, feed, pal, cont);
+        });
+        return;
+    }
+
     (void)pages; // unused params
     (void)cont; // unused params
     ModalPause mp; // this might take a while, so signal a pause
@@ -1038,6 +1073,14 @@ void systemGbPrint(uint8_t* data, int len, int pages, int feed, int pal, int con
 
 void systemScreenMessage(const wxString& msg)
 {
+    MainFrame* mf = wxGetApp().frame;
+    GameArea* ga = mf ? mf->GetPanel() : NULL;
+
+    if (ga && ga->emu_thread.on_thread()) {
+        ga->emu_thread.to_gui([msg] { systemScreenMessage(msg); });
+        return;
+    }
+
     if (wxGetApp().frame && wxGetApp().frame->IsShown()) {
         wxPuts(UTF8(msg)); // show **something** on terminal
         MainFrame* f = wxGetApp().frame;
@@ -1076,8 +1119,10 @@ bool systemPauseOnFrame()
 {
     if (pause_next) {
         pause_next = false;
-        MainFrame* fr = wxGetApp().frame;
-        fr->GetPanel()->Pause();
+        GameArea* panel = wxGetApp().frame->GetPanel();
+        // stop at this very frame, the GUI catches up
+        panel->emu_thread.set_running(false);
+        panel->emu_thread.to_gui([panel] { panel->Pause(); });
         return true;
     }
 
@@ -1088,8 +1133,10 @@ void systemGbBorderOn()
 {
     GameArea* panel = wxGetApp().frame->GetPanel();
 
+    // the core draws the border from the next line on, so the geometry
+    // changes before it goes on
     if (panel)
-        panel->AddBorder();
+        panel->emu_thread.call_gui([panel] { panel->AddBorder(); });
 }
 
 class SoundDriver;
@@ -1320,15 +1367,18 @@ void log(const char* defaultMsg, ...)
     vsnprintf(buf, 2048, defaultMsg, valist);
     wxString msg = wxString(buf, wxConvUTF8);
     va_end(valist);
-    wxGetApp().log.append(msg);
 
-    if (wxGetApp().IsMainLoopRunning()) {
-        LogDialog* d = wxGetApp().frame->logdlg;
+    gui_call([msg] {
+        wxGetApp().log.append(msg);
 
-        if (d && d->IsShown()) {
-            d->Update();
-        }
+        if (wxGetApp().IsMainLoopRunning()) {
+            LogDialog* d = wxGetApp().frame->logdlg;
 
-        systemScreenMessage(msg);
-    }
+            if (d && d->IsShown()) {
+                d->Update();
+            }
+
+            systemScreenMessage(msg);
+        }
+    });
 }
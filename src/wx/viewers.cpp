@@ -862,6 +862,9 @@ public:
             CPUWriteMemoryQuick(mv->writeaddr, mv->writeval);
             break;
         }
+
+        codeCacheInvalidate(mv->writeaddr);
+        tileCacheInvalidate(mv->writeaddr);
     }
 
     void MemLoad(wxString& name, uint32_t addr, uint32_t len)
@@ -884,6 +887,9 @@ public:
             len -= wlen;
             addr += wlen;
         }
+
+        codeCacheFlush();
+        tileCacheFlush();
     }
 
     void MemSave(wxString& name, uint32_t addr, uint32_t len)
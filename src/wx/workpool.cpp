@@ -0,0 +1,191 @@
+#include <chrono>
+
+#include "workpool.h"
+
+// how long a thread keeps polling for the next run before it sleeps
+#define WORKPOOL_POLL_TIME std::chrono::microseconds(1000)
+
+static inline uint64_t rangePack(uint32_t first, uint32_t last)
+{
+    return first | (uint64_t)last << 32;
+}
+
+static inline uint32_t rangeFirst(uint64_t range)
+{
+    return (uint32_t)range;
+}
+
+static inline uint32_t rangeLast(uint64_t range)
+{
+    return (uint32_t)(range >> 32);
+}
+
+WorkPool::WorkPool()
+    : m_count(0)
+    , m_job(NULL)
+    , m_pending(0)
+    , m_generation(0)
+    , m_sleeping(0)
+    , m_stop(false)
+{
+}
+
+WorkPool::~WorkPool()
+{
+    stop();
+}
+
+void WorkPool::start(int threads)
+{
+    stop();
+
+    if (threads < 1)
+        threads = 1;
+
+    m_ranges.reset(new Range[threads]);
+    m_count = threads;
+    for (int i = 0; i < threads; i++)
+        m_ranges[i].tiles.store(0);
+
+    m_stop = false;
+    for (int i = 1; i < threads; i++)
+        m_threads.push_back(std::thread(&WorkPool::worker, this, i, m_generation.load()));
+}
+
+void WorkPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    for (size_t i = 0; i < m_threads.size(); i++)
+        m_threads[i].join();
+
+    m_threads.clear();
+    m_ranges.reset();
+    m_count = 0;
+}
+
+void WorkPool::run(int tiles, const std::function<void(int)>& job)
+{
+    if (m_count <= 1 || tiles <= 1) {
+        for (int i = 0; i < tiles; i++)
+            job(i);
+        return;
+    }
+
+    // a thread that finds a tile in the new ranges also finds the job
+    m_job = &job;
+    m_pending.store(tiles, std::memory_order_relaxed);
+    for (int i = 0; i < m_count; i++)
+        m_ranges[i].tiles.store(rangePack(tiles * i / m_count, tiles * (i + 1) / m_count), std::memory_order_release);
+
+    m_generation++;
+    if (m_sleeping.load()) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_wake.notify_all();
+    }
+
+    work(0);
+
+    // the remaining tiles are being worked on
+    while (m_pending.load(std::memory_order_acquire))
+        std::this_thread::yield();
+}
+
+void WorkPool::worker(int index, unsigned generation)
+{
+    for (;;) {
+        std::chrono::steady_clock::time_point poll = std::chrono::steady_clock::now() + WORKPOOL_POLL_TIME;
+
+        while (m_generation.load(std::memory_order_acquire) == generation && std::chrono::steady_clock::now() < poll)
+            std::this_thread::yield();
+
+        if (m_generation.load() == generation) {
+            m_sleeping++;
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_wake.wait(lock, [&] { return m_generation.load() != generation; });
+            m_sleeping--;
+        }
+
+        generation = m_generation.load(std::memory_order_acquire);
+        if (m_stop)
+            return;
+
+        work(index);
+    }
+}
+
+void WorkPool::work(int index)
+{
+    int tile;
+    uint64_t own;
+
+    do {
+        while (take(index, tile, own)) {
+            (*m_job)(tile);
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    } while (steal(index, own));
+}
+
+bool WorkPool::take(int index, int& tile, uint64_t& range)
+{
+    std::atomic<uint64_t>& tiles = m_ranges[index].tiles;
+    range = tiles.load(std::memory_order_acquire);
+
+    for (;;) {
+        uint32_t first = rangeFirst(range), last = rangeLast(range);
+        if (first >= last)
+            return false;
+
+        if (tiles.compare_exchange_weak(range, rangePack(first + 1, last), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            tile = first;
+            return true;
+        }
+    }
+}
+
+// Moves the back half of the busiest range into the thread's own, which was
+// own when it ran out.  False when there is nothing left to steal.
+bool WorkPool::steal(int index, uint64_t own)
+{
+    for (;;) {
+        int victim = -1;
+        uint64_t range = 0;
+        uint32_t most = 0;
+
+        for (int i = 0; i < m_count; i++) {
+            if (i == index)
+                continue;
+
+            uint64_t r = m_ranges[i].tiles.load(std::memory_order_acquire);
+            if (rangeFirst(r) < rangeLast(r) && rangeLast(r) - rangeFirst(r) > most) {
+                victim = i;
+                range = r;
+                most = rangeLast(r) - rangeFirst(r);
+            }
+        }
+
+        if (victim < 0)
+            return false;
+
+        uint32_t split = rangeLast(range) - (most + 1) / 2;
+        if (!m_ranges[victim].tiles.compare_exchange_strong(range, rangePack(rangeFirst(range), split), std::memory_order_acq_rel, std::memory_order_acquire))
+            continue;
+
+        // a new run may have handed this thread tiles in the meantime,
+        // then the stolen ones are done right here
+        if (!m_ranges[index].tiles.compare_exchange_strong(own, rangePack(split, rangeLast(range)), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            for (uint32_t tile = split; tile < rangeLast(range); tile++) {
+                (*m_job)(tile);
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent threads that split a job of numbered tiles between them.
+//
+// Every thread starts a run with an equal share of the tiles and, once its
+// own share is done, steals half of what is left of the busiest one, so a
+// few expensive tiles do not hold up the others.  The thread calling run()
+// works as well.  Between runs the threads keep polling for a short while
+// before they go to sleep, so at frame rate they are usually awake when the
+// next run starts and nobody waits on a condition.
+class WorkPool {
+public:
+    WorkPool();
+    ~WorkPool();
+
+    // Changes the number of threads, counting the caller of run()
+    void start(int threads);
+    void stop();
+    int threads() const { return m_count; }
+
+    // Calls job(tile) for every tile in [0, tiles) and returns when all of
+    // them are done
+    void run(int tiles, const std::function<void(int)>& job);
+
+private:
+    // [first, last) of the tiles a thread still owns, first in the low half.
+    // Each one has a cache line to itself.
+    struct alignas(64) Range {
+        std::atomic<uint64_t> tiles;
+    };
+
+    void worker(int index, unsigned generation);
+    void work(int index);
+    bool take(int index, int& tile, uint64_t& range);
+    bool steal(int index, uint64_t own);
+
+    std::unique_ptr<Range[]> m_ranges;
+    int m_count;
+    std::vector<std::thread> m_threads;
+    const std::function<void(int)>* m_job;
+    std::atomic<int> m_pending;
+
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::atomic<unsigned> m_generation;
+    std::atomic<int> m_sleeping;
+    std::atomic<bool> m_stop;
+};
+
+#endif // WORKPOOL_H
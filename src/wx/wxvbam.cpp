@@ -1157,9 +1157,9 @@ void MainFrame::SetMenusOpened(bool state)
     }
 }
 
-// ShowModal that also disables emulator loop
+// ShowModal that also shows the pointer and lets the emulator's thread run
 // uses dialog_opened as a nesting counter
-int MainFrame::ShowModal(wxDialog* dlg)
+int MainFrame::ShowModal(wxDialog* dlg, bool keep_held)
 {
     dlg->SetWindowStyle(dlg->GetWindowStyle() | wxCAPTION | wxRESIZE_BORDER);
 
@@ -1170,7 +1170,15 @@ int MainFrame::ShowModal(wxDialog* dlg)
 
     CheckPointer(dlg);
     StartModal();
-    int ret = dlg->ShowModal();
+    int ret;
+    if (keep_held)
+        ret = dlg->ShowModal();
+    else {
+        // the game goes on behind the dialog, the menu command showing it
+        // gets the core back when it is closed
+        EmuThread::Unhold unhold(panel->emu_thread);
+        ret = dlg->ShowModal();
+    }
     StopModal();
     return ret;
 }
@@ -19,6 +19,7 @@
 
 /* yeah, they aren't needed globally, but I'm too lazy to limit where needed */
 #include "../common/ConfigManager.h"
+#include "../common/Rewind.h"
 
 #include "../System.h"
 #include "../Util.h"
@@ -35,6 +36,7 @@
 #include "../common/ffmpeg.h"
 #endif
 
+#include "emuthread.h"
 #include "wxlogdebug.h"
 #include "wxutil.h"
 
@@ -153,13 +155,22 @@ DECLARE_APP(wxvbamApp);
 // menu event handlers are declared with these macros in mainwind.cpp
 // and mainwind-handlers.h, mainwind-cmd.cpp, and mainwind-evt.cpp are
 // auto-generated from them
-#define EVT_HANDLER(n, x) void MainFrame::On##n(wxCommandEvent& WXUNUSED(event))
+// the emulator is held between two frames while they run, so they may use
+// the core directly
+#define EVT_HANDLER(n, x)                                  \
+    void MainFrame::On##n(wxCommandEvent& WXUNUSED(event)) \
+    {                                                      \
+        EmuThread::Hold hold(panel->emu_thread);           \
+        Do##n();                                           \
+    }                                                      \
+    void MainFrame::Do##n()
 // some commands are masked under some conditions
 #define EVT_HANDLER_MASK(n, x, m)                          \
     void MainFrame::On##n(wxCommandEvent& WXUNUSED(event)) \
     {                                                      \
         if (!(cmd_enable & (m)))                           \
             return;                                        \
+        EmuThread::Hold hold(panel->emu_thread);           \
         Do##n();                                           \
     }                                                      \
     void MainFrame::Do##n()
@@ -239,7 +250,9 @@ public:
     // wxMSW pauses the game for menu popups and modal dialogs, but wxGTK
     // does not.  It's probably desirable to pause the game.  To do this for
     // dialogs, use this function instead of dlg->ShowModal()
-    int ShowModal(wxDialog* dlg);
+    // The emulator's thread goes on while the dialog is up unless
+    // keep_held is set, for dialogs that change the core themselves.
+    int ShowModal(wxDialog* dlg, bool keep_held = false);
     // and here are the wrapper functions for use when ShowModal() isn't
     // possible
     void StartModal();
@@ -553,8 +566,9 @@ public:
     bool SaveState(int slot);
     bool SaveState(const wxFileName& fname);
 
-    // save to default location
-    void SaveBattery();
+    // save to default location, in the background it is only copied here
+    // and written to disk on another thread
+    void SaveBattery(bool background = false);
 
     // true if file at default location may not match memory
     bool cheats_dirty;
@@ -581,14 +595,17 @@ public:
     wxString osdtext;
     uint32_t osdtime;
 
-    // Rewind: count down to 0 and rewind
-    uint32_t rewind_time;
-    // Rewind: flag to OnIdle to do a rewind
+    // Rewind: flag to OnIdle to take a rewind snapshot
     bool do_rewind;
-    // Rewind: rewind states
-    char* rewind_mem; // should be uint8_t, really
-    int num_rewind_states;
-    int next_rewind_state;
+    // Rewind: one snapshot per emulated frame
+    RewindBuffer rewind_states;
+    // frames the core finished, counted by systemFrame()
+    uint32_t emulated_frames;
+
+    // the emulator runs on emu_thread unless gopts.emulation_thread is off
+    // or the debugger is on, and sends its frames through handoff
+    EmuThread emu_thread;
+    FrameHandoff handoff;
 
     // Loaded rom information
     IMAGE_TYPE loaded;
@@ -599,10 +616,12 @@ public:
     wxString rom_scene_rls_name;
     uint32_t rom_size;
 
-// FIXME: size this properly
-#define NUM_REWINDS 8
-#define REWIND_SIZE 1024 * 512 * NUM_REWINDS
-    // FIXME: make this a config option
+// FIXME: make these config options
+#define REWIND_SIZE 32 * 1024 * 1024
+#define REWIND_STATE_SIZE 4 * 1024 * 1024
+#define REWIND_KEYFRAME_INTERVAL 60
+// the GBA and the GB both show 16777216 / 280896 frames a second
+#define REWIND_FRAMES_PER_SECOND 59.7275
 
     void ShowFullScreen(bool full);
     bool IsFullScreen()
@@ -645,6 +664,8 @@ protected:
 
     bool paused;
     void OnIdle(wxIdleEvent&);
+    void RunFrame();
+    void DrawFrame();
     void OnKeyDown(wxKeyEvent& ev);
     void OnKeyUp(wxKeyEvent& ev);
     void OnSDLJoy(wxSDLJoyEvent& ev);
@@ -699,10 +720,9 @@ cmditem new_cmditem(const wxString cmd = wxT(""), const wxString name = wxT(""),
 extern bool cmditem_lt(const struct cmditem& cmd1, const struct cmditem& cmd2);
 
 #include "rpi.h"
+#include "workpool.h"
 #include <wx/dynlib.h>
 
-class FilterThread;
-
 class DrawingPanelBase : public HiDPIAware {
 public:
     DrawingPanelBase(int _width, int _height);
@@ -723,9 +743,9 @@ protected:
     bool did_init;
     uint8_t* todraw;
     uint8_t *pixbuf1, *pixbuf2;
-    FilterThread* threads;
+    // runs the filters, nthreads is the size it was started with
+    WorkPool filter_pool;
     int nthreads;
-    wxSemaphore filt_done;
     wxDynamicLibrary filt_plugin;
     const RENDER_PLUGIN_INFO* rpi; // also flag indicating plugin loaded
     // largest buffer required is 32-bit * (max width + 1) * (max height + 2)